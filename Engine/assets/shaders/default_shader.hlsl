@@ -99,6 +99,22 @@ Texture2D emissiveTexture  : register(t6);
 
 SamplerState mainSampler : register(s0);
 
+// ============================================================
+// Compact vertices (SLEAK_COMPACT_VERTEX): the normal arrives as an
+// octahedral snorm pair, see VertexFormat.hpp
+// ============================================================
+float3 DecodeNormal(float3 normal)
+{
+#ifdef SLEAK_COMPACT_VERTEX
+    float3 n = float3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0) ? -t : t;
+    return normalize(n);
+#else
+    return normal;
+#endif
+}
+
 // ============================================================
 // Vertex Shader
 // ============================================================
@@ -112,7 +128,7 @@ VS_OUTPUT VS_Main(VS_INPUT input)
     float4 worldPos = mul(float4(input.POSITION, 1.0), World);
     output.WorldPos = worldPos.xyz;
 
-    output.WorldNorm = normalize(mul(input.NORMAL,
+    output.WorldNorm = normalize(mul(DecodeNormal(input.NORMAL),
                                      (float3x3) World));
     output.WorldTan = normalize(mul(input.TANGENT.xyz,
                                     (float3x3) World));
@@ -11,12 +11,31 @@ layout(location = 2) in vec4 inTangent;
 layout(location = 3) in vec4 inColor;
 layout(location = 4) in vec2 inUV;
 
+// Set for pipelines fed StaticCompact/SkinnedCompact vertices: the normal
+// then arrives as an octahedral snorm pair (see VertexFormat.hpp)
+layout(constant_id = 0) const bool COMPACT_VERTEX = false;
+
+vec3 OctDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
 // Transform push constant
 layout(push_constant) uniform TransformPC {
     mat4 WVP;
     mat4 World;
 };
 
+// Set for instanced draws: the WVP, World pair of each instance comes from
+// the queue's instance buffer (set 4, binding 0) instead of TransformPC
+layout(constant_id = 1) const bool INSTANCED = false;
+
+layout(std430, set = 4, binding = 0) readonly buffer InstanceData {
+    mat4 Instances[];
+};
+
 // Light/Shadow UBO (set 2, binding 0)
 layout(set = 2, binding = 0) uniform ShadowLightUBO {
     vec4  uLightDir;       // xyz = direction, w = pad
@@ -39,15 +58,25 @@ layout(location = 5) out vec2 fragUV;
 layout(location = 6) out vec4 fragShadowCoord;
 
 void main() {
-    gl_Position = WVP * vec4(inPosition, 1.0);
+    vec3 normal = COMPACT_VERTEX ? OctDecode(inNormal.xy) : inNormal;
+
+    mat4 wvp = WVP;
+    mat4 world = World;
+    if (INSTANCED) {
+        int index = gl_InstanceIndex * 2;
+        wvp = Instances[index];
+        world = Instances[index + 1];
+    }
+
+    gl_Position = wvp * vec4(inPosition, 1.0);
     gl_Position.y = -gl_Position.y;  // Vulkan Y-axis flip
 
     // World-space position and basis vectors for lighting
-    vec4 worldPos = World * vec4(inPosition, 1.0);
+    vec4 worldPos = world * vec4(inPosition, 1.0);
     fragWorldPos = worldPos.xyz;
 
-    mat3 worldMat3 = mat3(World);
-    fragWorldNorm = normalize(worldMat3 * inNormal);
+    mat3 worldMat3 = mat3(world);
+    fragWorldNorm = normalize(worldMat3 * normal);
     fragWorldTan  = normalize(worldMat3 * inTangent.xyz);
     fragWorldBit  = cross(fragWorldNorm, fragWorldTan)
                     * inTangent.w;
@@ -10,12 +10,32 @@ layout(location = 2) in vec4 inTangent;
 layout(location = 3) in vec4 inColor;
 layout(location = 4) in vec2 inUV;
 
+// Constant attribute, 1 for StaticCompact/SkinnedCompact buffers: the
+// normal then arrives as an octahedral snorm pair (see VertexFormat.hpp)
+layout(location = 7) in float inCompactVertex;
+
+vec3 OctDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
 // Transform UBO (binding 0) - matches TransformBuffer layout
 layout(std140, binding = 0) uniform TransformUBO {
     mat4 WVP;
     mat4 World;
 };
 
+// Instanced draws (binding 4): WVP, World pair per instance. Used instead
+// of TransformUBO while uInstanced is set.
+layout(std430, binding = 4) readonly buffer InstanceSSBO {
+    mat4 Instances[];
+};
+
+uniform int uInstanced;
+uniform uint uInstanceBase;
+
 out vec3 fragWorldPos;
 out vec3 fragWorldNorm;
 out vec3 fragWorldTan;
@@ -24,14 +44,24 @@ out vec4 fragColor;
 out vec2 fragUV;
 
 void main() {
-    gl_Position = WVP * vec4(inPosition, 1.0);
+    vec3 normal = inCompactVertex != 0.0 ? OctDecode(inNormal.xy) : inNormal;
+
+    mat4 wvp = WVP;
+    mat4 world = World;
+    if (uInstanced != 0) {
+        uint index = (uInstanceBase + uint(gl_InstanceID)) * 2u;
+        wvp = Instances[index];
+        world = Instances[index + 1u];
+    }
+
+    gl_Position = wvp * vec4(inPosition, 1.0);
 
     // World-space position and basis vectors for lighting
-    vec4 worldPos = World * vec4(inPosition, 1.0);
+    vec4 worldPos = world * vec4(inPosition, 1.0);
     fragWorldPos = worldPos.xyz;
 
-    mat3 worldMat3 = mat3(World);
-    fragWorldNorm = normalize(worldMat3 * inNormal);
+    mat3 worldMat3 = mat3(world);
+    fragWorldNorm = normalize(worldMat3 * normal);
     fragWorldTan  = normalize(worldMat3 * inTangent.xyz);
     fragWorldBit  = cross(fragWorldNorm, fragWorldTan)
                     * inTangent.w;
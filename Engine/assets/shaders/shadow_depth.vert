@@ -3,13 +3,8 @@
 // Shadow Depth Pass - Vertex Only
 // Renders geometry from light's perspective to generate shadow map
 
+// Only the position is read, so one shader serves every vertex layout
 layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
-layout(location = 2) in vec4 inTangent;
-layout(location = 3) in vec4 inColor;
-layout(location = 4) in vec2 inUV;
-layout(location = 5) in ivec4 inBoneIDs;
-layout(location = 6) in vec4 inBoneWeights;
 
 // Push constant: LightVP*World in slot 0, World in slot 1
 layout(push_constant) uniform TransformPC {
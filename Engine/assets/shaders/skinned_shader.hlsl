@@ -107,6 +107,22 @@ Texture2D emissiveTexture  : register(t6);
 
 SamplerState mainSampler : register(s0);
 
+// ============================================================
+// Compact vertices (SLEAK_COMPACT_VERTEX): the normal arrives as an
+// octahedral snorm pair, see VertexFormat.hpp
+// ============================================================
+float3 DecodeNormal(float3 normal)
+{
+#ifdef SLEAK_COMPACT_VERTEX
+    float3 n = float3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0) ? -t : t;
+    return normalize(n);
+#else
+    return normal;
+#endif
+}
+
 // ============================================================
 // Vertex Shader
 // ============================================================
@@ -143,7 +159,7 @@ VS_OUTPUT VS_Main(VS_INPUT input)
     float3x3 skinMat3 = (float3x3) skinMatrix;
     float3x3 worldMat3 = (float3x3) World;
 
-    output.WorldNorm = normalize(mul(mul(input.NORMAL, skinMat3), worldMat3));
+    output.WorldNorm = normalize(mul(mul(DecodeNormal(input.NORMAL), skinMat3), worldMat3));
     output.WorldTan  = normalize(mul(mul(input.TANGENT.xyz, skinMat3), worldMat3));
     output.WorldBit  = cross(output.WorldNorm, output.WorldTan) * input.TANGENT.w;
 
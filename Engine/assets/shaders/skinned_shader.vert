@@ -10,9 +10,20 @@ layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec4 inTangent;
 layout(location = 3) in vec4 inColor;
 layout(location = 4) in vec2 inUV;
-layout(location = 5) in ivec4 inBoneIDs;
+layout(location = 5) in uvec4 inBoneIDs;   // Unused slots hold ~0u or weigh 0
 layout(location = 6) in vec4 inBoneWeights;
 
+// Set for pipelines fed StaticCompact/SkinnedCompact vertices: the normal
+// then arrives as an octahedral snorm pair (see VertexFormat.hpp)
+layout(constant_id = 0) const bool COMPACT_VERTEX = false;
+
+vec3 OctDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
 // Transform push constant
 layout(push_constant) uniform TransformPC {
     mat4 WVP;
@@ -47,6 +58,8 @@ layout(location = 5) out vec2 fragUV;
 layout(location = 6) out vec4 fragShadowCoord;
 
 void main() {
+    vec3 normal = COMPACT_VERTEX ? OctDecode(inNormal.xy) : inNormal;
+
     // Compute skinned position
     float totalWeight = inBoneWeights[0] + inBoneWeights[1] +
                         inBoneWeights[2] + inBoneWeights[3];
@@ -55,7 +68,7 @@ void main() {
     if (totalWeight > 0.01) {
         skinMatrix = mat4(0.0);
         for (int i = 0; i < 4; i++) {
-            if (inBoneIDs[i] >= 0 && inBoneIDs[i] < MAX_BONES)
+            if (inBoneIDs[i] < uint(MAX_BONES))
                 skinMatrix += boneMatrices[inBoneIDs[i]] * inBoneWeights[i];
         }
     } else {
@@ -74,7 +87,7 @@ void main() {
     mat3 worldMat3 = mat3(World);
     mat3 finalNormalMat = worldMat3 * skinMat3;
 
-    fragWorldNorm = normalize(finalNormalMat * inNormal);
+    fragWorldNorm = normalize(finalNormalMat * normal);
     fragWorldTan  = normalize(finalNormalMat * inTangent.xyz);
     fragWorldBit  = cross(fragWorldNorm, fragWorldTan) * inTangent.w;
 
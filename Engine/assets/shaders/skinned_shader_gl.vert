@@ -12,6 +12,17 @@ layout(location = 4) in vec2 inUV;
 layout(location = 5) in ivec4 inBoneIDs;
 layout(location = 6) in vec4 inBoneWeights;
 
+// Constant attribute, 1 for StaticCompact/SkinnedCompact buffers: the
+// normal then arrives as an octahedral snorm pair (see VertexFormat.hpp)
+layout(location = 7) in float inCompactVertex;
+
+vec3 OctDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
 // Transform UBO (binding 0) - matches TransformBuffer layout
 layout(std140, binding = 0) uniform TransformUBO {
     mat4 WVP;
@@ -32,6 +43,8 @@ out vec4 fragColor;
 out vec2 fragUV;
 
 void main() {
+    vec3 normal = inCompactVertex != 0.0 ? OctDecode(inNormal.xy) : inNormal;
+
     // Compute skinned position
     float totalWeight = inBoneWeights[0] + inBoneWeights[1] +
                         inBoneWeights[2] + inBoneWeights[3];
@@ -58,7 +71,7 @@ void main() {
     mat3 worldMat3 = mat3(World);
     mat3 finalNormalMat = worldMat3 * skinMat3;
 
-    fragWorldNorm = normalize(finalNormalMat * inNormal);
+    fragWorldNorm = normalize(finalNormalMat * normal);
     fragWorldTan  = normalize(finalNormalMat * inTangent.xyz);
     fragWorldBit  = cross(fragWorldNorm, fragWorldTan) * inTangent.w;
 
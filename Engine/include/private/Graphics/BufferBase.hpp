@@ -3,6 +3,7 @@
 
 #include "ResourceBase.hpp"
 #include <Core/OSDef.hpp>
+#include <Runtime/MeshData.hpp>
 
 namespace Sleak {
     namespace RenderEngine {
@@ -31,12 +32,42 @@ namespace Sleak {
                 Slot = slot;
             }
 
+            // How a vertex buffer's contents are laid out, see VertexFormat.hpp
+            inline VertexLayout GetVertexLayout() const { return Layout; }
+
+            inline void SetVertexLayout(VertexLayout layout)
+            {
+                Layout = layout;
+            }
+
+            // Width of an index buffer's indices, read when it is bound
+            inline IndexFormat GetIndexFormat() const { return Format; }
+
+            inline void SetIndexFormat(IndexFormat format)
+            {
+                Format = format;
+            }
+
+            // Set by the RenderCommandQueue while it holds a transform
+            // upload it deferred for this buffer, NO_DEFERRED_SLOT otherwise
+            static constexpr uint32_t NO_DEFERRED_SLOT = ~0u;
+
+            inline uint32_t GetDeferredSlot() const { return DeferredSlot; }
+
+            inline void SetDeferredSlot(uint32_t slot)
+            {
+                DeferredSlot = slot;
+            }
+
         protected:
             BufferType Type;
             size_t Size = 0;
             int Slot = 0;
+            VertexLayout Layout = VertexLayout::Standard;
+            IndexFormat Format = IndexFormat::UInt32;
             void* Data = nullptr;
             bool bIsMapped = false;        
+            uint32_t DeferredSlot = NO_DEFERRED_SLOT;
         };
     };    
 };
@@ -13,6 +13,7 @@
 #include <Window.hpp>
 #include <imgui.h>
 #include <backends/imgui_impl_dx11.h>
+#include <array>
 #include <chrono>
 #include <Core/Timer.hpp>
 #include <Utility/Container/Queue.hpp>
@@ -36,9 +37,10 @@ public:
     virtual void Resize(uint32_t width, uint32_t height) override;
 
     virtual void Draw(uint32_t vertexCount) override;
-    virtual void DrawIndexed(uint32_t indexCount) override;
+    virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex = 0, int32_t baseVertex = 0) override;
     virtual void DrawInstance(uint32_t instanceCount, uint32_t vertexPerInstance) override;
-    virtual void DrawIndexedInstance(uint32_t instanceCount, uint32_t indexPerInstance) override;
+    virtual void DrawIndexedInstance(uint32_t instanceCount, uint32_t indexPerInstance,
+                                     uint32_t startIndex = 0, int32_t baseVertex = 0) override;
 
     // State management
     virtual void SetRenderMode(RenderMode mode) override;
@@ -110,6 +112,11 @@ public:
     ID3D11RenderTargetView* renderTargetView; // Render target view
     ID3D11InputLayout* layout;
 
+    // Input layouts of the compact vertex layouts, created on first use
+    std::array<ID3D11InputLayout*, static_cast<size_t>(VertexLayout::Count)> compactLayouts = {};
+    VertexLayout m_vertexLayout = VertexLayout::Standard;
+    void SetVertexLayout(VertexLayout vertexLayout);
+
     ID3D11DepthStencilState* depthStencilState;
     ID3D11DepthStencilView* depthStencilView;
     ID3D11Texture2D* depthStencilBuffer;
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "../Shader.hpp"
+#include <Runtime/VertexFormat.hpp>
 
 namespace Sleak {
 namespace RenderEngine {
@@ -26,7 +27,12 @@ class DirectX11Shader : public Shader {
     void bind() override;
 
     ID3DBlob* getVertexShaderBlob() const;
-    ID3D11InputLayout* createInputLayout();
+    ID3D11InputLayout* createInputLayout(VertexLayout layout = VertexLayout::Standard);
+
+    // Layout of the bound vertex buffer. Compact layouts switch the bound
+    // shader to its SLEAK_COMPACT_VERTEX vertex shader.
+    static void SetVertexLayout(VertexLayout layout);
+    static DirectX11Shader* GetBound() { return s_bound; }
 
    private:
     template <typename T>
@@ -34,7 +40,10 @@ class DirectX11Shader : public Shader {
                        const std::string& entryPoint,
                        const std::string& profile,
                        Microsoft::WRL::ComPtr<T>& shader,
-                       Microsoft::WRL::ComPtr<ID3DBlob>& blob);
+                       Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+                       const D3D_SHADER_MACRO* defines = nullptr);
+
+    ID3D11VertexShader* getVertexShader(VertexLayout layout);
 
    private:
     Microsoft::WRL::ComPtr<ID3D11Device> m_device;
@@ -48,16 +57,15 @@ class DirectX11Shader : public Shader {
         m_vertexShaderBlob;  // For input layout creation
     Microsoft::WRL::ComPtr<ID3DBlob> m_pixelShaderBlob;
 
-    D3D11_INPUT_ELEMENT_DESC DefaultLayout[7] = {
-    // Semantic        Index  Format                          Slot  Offset  Class                        Step Rate
-    {"POSITION",      0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 0,  D3D11_INPUT_PER_VERTEX_DATA, 0},
-    {"NORMAL",        0, DXGI_FORMAT_R32G32B32_FLOAT,    0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
-    {"TANGENT",       0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
-    {"COLOR",         0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 40, D3D11_INPUT_PER_VERTEX_DATA, 0},
-    {"TEXCOORD",      0, DXGI_FORMAT_R32G32_FLOAT,       0, 56, D3D11_INPUT_PER_VERTEX_DATA, 0},
-    {"BLENDINDICES",  0, DXGI_FORMAT_R32G32B32A32_SINT,  0, 64, D3D11_INPUT_PER_VERTEX_DATA, 0},
-    {"BLENDWEIGHT",   0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 80, D3D11_INPUT_PER_VERTEX_DATA, 0}
-    };
+    // Compact vertex variant, compiled on first use
+    Microsoft::WRL::ComPtr<ID3D11VertexShader> m_compactVertexShader;
+    Microsoft::WRL::ComPtr<ID3DBlob> m_compactVertexShaderBlob;
+    bool m_compactCompiled = false;
+    std::string m_vertexPath;
+    std::string m_vertexEntry;
+
+    static DirectX11Shader* s_bound;
+    static VertexLayout s_layout;
 };
 
 }  // namespace RenderEngine
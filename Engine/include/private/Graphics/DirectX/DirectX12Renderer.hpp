@@ -42,11 +42,14 @@ public:
 
     // RenderContext interface
     virtual void Draw(uint32_t vertexCount) override;
-    virtual void DrawIndexed(uint32_t indexCount) override;
+    virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex = 0,
+                             int32_t baseVertex = 0) override;
     virtual void DrawInstance(uint32_t instanceCount,
                               uint32_t vertexPerInstance) override;
     virtual void DrawIndexedInstance(uint32_t instanceCount,
-                                     uint32_t indexPerInstance) override;
+                                     uint32_t indexPerInstance,
+                                     uint32_t startIndex = 0,
+                                     int32_t baseVertex = 0) override;
 
     virtual void SetRenderFace(RenderFace face) override;
     virtual void SetRenderMode(RenderMode mode) override;
@@ -94,6 +97,10 @@ private:
     bool CreatePipelineState();
     bool CreatePipelineStateFromShader(ID3DBlob* vertexShaderBlob,
                                        ID3DBlob* pixelShaderBlob);
+    bool CreatePipelineStateFromShader(ID3DBlob* vertexShaderBlob,
+                                       ID3DBlob* pixelShaderBlob,
+                                       VertexLayout layout,
+                                       Microsoft::WRL::ComPtr<ID3D12PipelineState>& pso);
 
     virtual void ConfigureRenderMode() override;
     virtual void ConfigureRenderFace() override;
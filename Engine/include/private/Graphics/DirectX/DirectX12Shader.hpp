@@ -10,6 +10,8 @@
 #include <vector>
 
 #include "../Shader.hpp"
+#include <Runtime/VertexFormat.hpp>
+#include <array>
 
 namespace Sleak {
 namespace RenderEngine {
@@ -27,22 +29,42 @@ public:
     ID3DBlob* getVertexShaderBlob() const;
     ID3DBlob* getPixelShaderBlob() const;
 
+    // Vertex shader reading the layout; compact layouts compile the
+    // SLEAK_COMPACT_VERTEX variant on first use
+    ID3DBlob* getVertexShaderBlob(VertexLayout layout);
+
     void SetPSO(Microsoft::WRL::ComPtr<ID3D12PipelineState> pso);
+    void SetPSO(VertexLayout layout, Microsoft::WRL::ComPtr<ID3D12PipelineState> pso);
+    bool HasPSO(VertexLayout layout) const;
     void SetCommandList(ID3D12GraphicsCommandList* cmdList);
 
+    // Layout of the bound vertex buffer; rebinds the bound shader's PSO
+    static void SetVertexLayout(VertexLayout layout);
+    static DirectX12Shader* GetBound() { return s_bound; }
+
 private:
     bool compileShader(const std::string& filePath,
                       const std::string& entryPoint,
                       const std::string& profile,
-                      Microsoft::WRL::ComPtr<ID3DBlob>& blob);
+                      Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+                      const D3D_SHADER_MACRO* defines = nullptr);
 
     Microsoft::WRL::ComPtr<ID3D12Device> m_device;
 
     Microsoft::WRL::ComPtr<ID3DBlob> m_vertexShaderBlob;
     Microsoft::WRL::ComPtr<ID3DBlob> m_pixelShaderBlob;
+    Microsoft::WRL::ComPtr<ID3DBlob> m_compactVertexShaderBlob;
+    bool m_compactCompiled = false;
+    std::string m_vertexPath;
+    std::string m_vertexEntry;
 
-    Microsoft::WRL::ComPtr<ID3D12PipelineState> m_pso;
+    // Indexed by VertexLayout
+    std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>,
+               static_cast<size_t>(VertexLayout::Count)> m_psos;
     ID3D12GraphicsCommandList* m_commandList = nullptr;
+
+    static DirectX12Shader* s_bound;
+    static VertexLayout s_layout;
 };
 
 }  // namespace RenderEngine
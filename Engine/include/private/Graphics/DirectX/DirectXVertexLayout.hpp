@@ -0,0 +1,50 @@
+#ifndef _DIRECTX_VERTEX_LAYOUT_H_
+#define _DIRECTX_VERTEX_LAYOUT_H_
+
+#include <dxgiformat.h>
+#include <Runtime/MeshData.hpp>
+
+namespace Sleak {
+namespace RenderEngine {
+
+// Input element and index formats and semantics shared by the DirectX 11
+// and 12 input assemblers, see VertexFormat.hpp
+
+inline DXGI_FORMAT ToDXGIFormat(VertexAttributeFormat format) {
+    switch (format) {
+        case VertexAttributeFormat::Float2:    return DXGI_FORMAT_R32G32_FLOAT;
+        case VertexAttributeFormat::Float3:    return DXGI_FORMAT_R32G32B32_FLOAT;
+        case VertexAttributeFormat::Float4:    return DXGI_FORMAT_R32G32B32A32_FLOAT;
+        case VertexAttributeFormat::Int4:      return DXGI_FORMAT_R32G32B32A32_SINT;
+        case VertexAttributeFormat::Half2:     return DXGI_FORMAT_R16G16_FLOAT;
+        case VertexAttributeFormat::Half4:     return DXGI_FORMAT_R16G16B16A16_FLOAT;
+        case VertexAttributeFormat::Snorm16x2: return DXGI_FORMAT_R16G16_SNORM;
+        case VertexAttributeFormat::Unorm8x4:  return DXGI_FORMAT_R8G8B8A8_UNORM;
+        case VertexAttributeFormat::Uint8x4:   return DXGI_FORMAT_R8G8B8A8_UINT;
+    }
+    return DXGI_FORMAT_UNKNOWN;
+}
+
+inline DXGI_FORMAT ToDXGIFormat(IndexFormat format) {
+    return format == IndexFormat::UInt16 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+}
+
+inline const char* GetVertexSemantic(uint8_t location) {
+    switch (location) {
+        case VERTEX_POSITION:     return "POSITION";
+        case VERTEX_NORMAL:       return "NORMAL";
+        case VERTEX_TANGENT:      return "TANGENT";
+        case VERTEX_COLOR:        return "COLOR";
+        case VERTEX_TEXCOORD:     return "TEXCOORD";
+        case VERTEX_BONE_IDS:     return "BLENDINDICES";
+        default:                  return "BLENDWEIGHT";
+    }
+}
+
+// Shader define selecting the compact vertex input of the HLSL shaders
+static constexpr const char* COMPACT_VERTEX_DEFINE = "SLEAK_COMPACT_VERTEX";
+
+}  // namespace RenderEngine
+}  // namespace Sleak
+
+#endif  // _DIRECTX_VERTEX_LAYOUT_H_
@@ -0,0 +1,156 @@
+#ifndef _FRAME_GRAPH_HPP_
+#define _FRAME_GRAPH_HPP_
+
+#include <Core/OSDef.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Sleak {
+    namespace RenderEngine {
+        class RenderContext;
+
+        enum class FrameGraphAccess : uint8_t {
+            None,
+            Read,
+            Write
+        };
+
+        // Memory a transient resource needs, as the backend reports it
+        struct FrameGraphResourceDesc {
+            uint64_t size = 0;
+            uint64_t alignment = 1;
+            uint32_t typeMask = ~0u;    // Memory types it can be placed in
+        };
+
+        // A pass must wait for an earlier pass's access to the resource
+        struct FrameGraphBarrier {
+            uint32_t resource;
+            FrameGraphAccess before;
+            FrameGraphAccess after;
+        };
+
+        // One allocation that transient resources with disjoint lifetimes share
+        struct FrameGraphMemorySlot {
+            uint64_t size = 0;
+            uint64_t alignment = 1;
+            uint32_t typeMask = ~0u;
+        };
+
+        struct FrameGraphStats {
+            uint32_t passes = 0;
+            uint32_t culledPasses = 0;
+            uint32_t barriers = 0;
+            uint32_t memorySlots = 0;
+            uint64_t transientBytes = 0;    // Sum of the live transient resources
+            uint64_t allocatedBytes = 0;    // Sum of the memory slots
+            uint64_t GetSavedBytes() const {
+                return transientBytes > allocatedBytes ? transientBytes - allocatedBytes : 0;
+            }
+        };
+
+        /**
+         * @class FrameGraph
+         * @brief Schedules a frame's passes from the resources they declare.
+         *
+         * Passes run in the order they are added. Each declares what it
+         * reads and writes; Compile then works on the CPU only:
+         *  - culls passes whose writes nobody reads. Writes to retained
+         *    imported resources (the swapchain) and passes marked with
+         *    KeepPass are always kept.
+         *  - lists, per pass, the barriers against earlier accesses:
+         *    read after write, write after read and write after write.
+         *  - places transient resources in memory slots. Resources whose
+         *    first-to-last-use ranges do not overlap share a slot, and
+         *    GetStats reports how many bytes that saved.
+         *
+         * The backend allocates one block per memory slot and binds each
+         * transient resource to its slot; Execute then runs the kept passes,
+         * handing each pass's barriers to the backend to record first.
+         */
+        class ENGINE_API FrameGraph {
+        public:
+            using ExecuteFunction = std::function<void(RenderContext*)>;
+            using BarrierFunction = std::function<void(const std::vector<FrameGraphBarrier>&)>;
+            static constexpr uint32_t INVALID = UINT32_MAX;
+
+            uint32_t CreateTransient(const std::string& name, const FrameGraphResourceDesc& desc);
+            // A resource the graph does not allocate. Retained ones are read
+            // after the frame (swapchain image), so writes to them are kept.
+            uint32_t Import(const std::string& name, bool retained = true);
+
+            uint32_t AddPass(const std::string& name, ExecuteFunction execute);
+            void Read(uint32_t pass, uint32_t resource);
+            void Write(uint32_t pass, uint32_t resource);
+            void KeepPass(uint32_t pass);
+
+            // False when a declaration referenced a missing pass or resource
+            bool Compile();
+
+            // Runs the passes Compile kept, in order. A pass with barriers
+            // has them passed to recordBarriers right before it runs.
+            void Execute(RenderContext* context, const BarrierFunction& recordBarriers = nullptr);
+
+            // Removes every pass and resource
+            void Clear();
+
+            bool IsCompiled() const { return m_compiled; }
+            bool IsCulled(uint32_t pass) const;
+            const std::vector<FrameGraphBarrier>& GetBarriers(uint32_t pass) const;
+
+            // INVALID for imported resources and unused transient ones
+            uint32_t GetMemorySlot(uint32_t resource) const;
+            const std::vector<FrameGraphMemorySlot>& GetMemorySlots() const { return m_slots; }
+
+            const std::string& GetPassName(uint32_t pass) const { return m_passes[pass].name; }
+            const std::string& GetResourceName(uint32_t resource) const { return m_resources[resource].name; }
+            uint32_t GetPassCount() const { return static_cast<uint32_t>(m_passes.size()); }
+            uint32_t GetResourceCount() const { return static_cast<uint32_t>(m_resources.size()); }
+
+            const FrameGraphStats& GetStats() const { return m_stats; }
+
+        private:
+            struct Resource {
+                std::string name;
+                FrameGraphResourceDesc desc;
+                bool imported = false;
+                bool retained = false;
+
+                // Filled by Compile: range of kept passes using it
+                uint32_t firstUse = INVALID;
+                uint32_t lastUse = INVALID;
+                uint32_t slot = INVALID;
+            };
+
+            struct Access {
+                uint32_t resource;
+                FrameGraphAccess access;
+            };
+
+            struct Pass {
+                std::string name;
+                ExecuteFunction execute;
+                std::vector<Access> accesses;
+                bool keep = false;
+
+                bool culled = false;
+                std::vector<FrameGraphBarrier> barriers;
+            };
+
+            void Declare(uint32_t pass, uint32_t resource, FrameGraphAccess access);
+            void CullPasses();
+            void BuildBarriers();
+            void AssignMemory();
+
+            std::vector<Pass> m_passes;
+            std::vector<Resource> m_resources;
+            std::vector<FrameGraphMemorySlot> m_slots;
+            FrameGraphStats m_stats;
+            bool m_compiled = false;
+            bool m_invalid = false;
+        };
+    }
+}
+
+#endif // _FRAME_GRAPH_HPP_
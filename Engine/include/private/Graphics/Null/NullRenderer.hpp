@@ -0,0 +1,128 @@
+#ifndef _NULLRENDERER_H
+#define _NULLRENDERER_H
+
+#include <Core/OSDef.hpp>
+#include "../Renderer.hpp"
+#include "../RenderContext.hpp"
+#include <array>
+
+namespace Sleak {
+
+namespace RenderEngine {
+
+/**
+ * @struct NullRenderStats
+ * @brief What the headless renderer was asked to do during one frame.
+ */
+struct NullRenderStats {
+    uint64_t drawCalls = 0;
+    uint64_t instances = 0;
+    uint64_t vertices = 0;
+    uint64_t triangles = 0;
+    uint64_t bufferBinds = 0;
+    uint64_t textureBinds = 0;
+    uint64_t resourcesCreated = 0;
+
+    NullRenderStats& operator+=(const NullRenderStats& other);
+};
+
+/**
+ * @class NullRenderer
+ * @brief Headless renderer selected with "-r null".
+ *
+ * Needs no window, display or GPU. Every draw, bind and create call is a
+ * no-op that only updates counters, and created resources are empty
+ * placeholders, so games, scenes, physics, animation and the render
+ * command queue run unchanged on machines without graphics.
+ */
+class ENGINE_API NullRenderer : public Renderer, public RenderContext {
+public:
+    NullRenderer(uint32_t width, uint32_t height);
+    virtual ~NullRenderer();
+
+    bool Initialize() override;
+    void BeginRender() override;
+    void EndRender() override;
+    void Cleanup() override;
+
+    virtual void Resize(uint32_t width, uint32_t height) override;
+
+    // ImGui context without platform or render backend: UI code keeps
+    // working, its output is dropped
+    virtual bool CreateImGUI() override;
+
+    virtual RenderContext* GetContext() override { return this; }
+
+    // Nothing is bound to the creating thread
+    virtual bool SupportsRenderThread() const override { return true; }
+
+    // Counters of the last finished frame and of the whole run
+    const NullRenderStats& GetFrameStats() const { return m_lastFrame; }
+    const NullRenderStats& GetTotalStats() const { return m_total; }
+    uint64_t GetFrameCount() const { return m_framesRendered; }
+
+    // RenderContext interface
+    virtual void Draw(uint32_t vertexCount) override;
+    virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex = 0,
+                             int32_t baseVertex = 0) override;
+    virtual void DrawInstance(uint32_t instanceCount,
+                              uint32_t vertexPerInstance) override;
+    virtual void DrawIndexedInstance(uint32_t instanceCount,
+                                     uint32_t indexPerInstance,
+                                     uint32_t startIndex = 0,
+                                     int32_t baseVertex = 0) override;
+
+    virtual void SetRenderFace(RenderFace face) override;
+    virtual void SetRenderMode(RenderMode mode) override;
+    virtual void SetViewport(float x, float y, float width, float height,
+                             float minDepth = 0.0f,
+                             float maxDepth = 1.0f) override;
+    virtual void ClearRenderTarget(float r, float g, float b,
+                                   float a) override;
+    virtual void ClearDepthStencil(bool clearDepth, bool clearStencil,
+                                   float depth, uint8_t stencil) override;
+
+    virtual void BindTexture(RefPtr<Sleak::Texture> texture, uint32_t slot = 0) override;
+    virtual void BindTextureRaw(Sleak::Texture* texture, uint32_t slot = 0) override;
+
+    virtual void BindVertexBuffer(RefPtr<BufferBase> buffer,
+                                  uint32_t slot = 0) override;
+    virtual void BindIndexBuffer(RefPtr<BufferBase> buffer,
+                                 uint32_t slot = 0) override;
+    virtual void BindConstantBuffer(RefPtr<BufferBase> buffer,
+                                    uint32_t slot = 0) override;
+    virtual void BindBoneBuffer(RefPtr<BufferBase> buffer) override;
+
+    virtual bool SupportsInstancing() const override { return true; }
+    virtual bool BeginInstancedDraw(RefPtr<BufferBase> instances,
+                                    uint32_t firstInstance) override;
+
+    virtual BufferBase* CreateBuffer(BufferType Type, uint32_t size,
+                                     void* data) override;
+    virtual Shader* CreateShader(const std::string& shaderSource) override;
+    virtual Texture* CreateTexture(const std::string& TexturePath) override;
+    virtual Texture* CreateTextureFromData(uint32_t width, uint32_t height,
+                                           void* data) override;
+
+    Texture* CreateCubemapTexture(const std::array<std::string, 6>& facePaths);
+    Texture* CreateCubemapTextureFromPanorama(const std::string& panoramaPath);
+
+private:
+    NullRenderStats m_frame;
+    NullRenderStats m_lastFrame;
+    NullRenderStats m_total;
+    uint64_t m_framesRendered = 0;
+    uint32_t m_width;
+    uint32_t m_height;
+    bool m_Initialized = false;
+
+    void CountDraw(uint32_t instanceCount, uint32_t verticesPerInstance);
+
+    virtual void ConfigureRenderMode() override {}
+    virtual void ConfigureRenderFace() override {}
+};
+
+}  // namespace RenderEngine
+}  // namespace Sleak
+
+#endif  // _NULLRENDERER_H
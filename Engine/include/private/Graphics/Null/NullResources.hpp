@@ -0,0 +1,70 @@
+#ifndef _NULLRESOURCES_HPP_
+#define _NULLRESOURCES_HPP_
+
+#include "../BufferBase.hpp"
+#include "../Shader.hpp"
+#include <Runtime/Texture.hpp>
+
+namespace Sleak {
+namespace RenderEngine {
+
+/**
+ * @class NullBuffer
+ * @brief Buffer of the headless renderer. Remembers its type and size,
+ * never allocates or copies the contents.
+ */
+class ENGINE_API NullBuffer : public BufferBase {
+public:
+    NullBuffer(uint32_t size, BufferType type);
+    ~NullBuffer() override = default;
+
+    bool Initialize(void* data) override;
+    void Update() override {}
+    void Update(void* data, size_t size) override;
+    void Cleanup() override {}
+
+    bool Map() override { return false; }
+    void Unmap() override {}
+
+    void* GetData() override { return nullptr; }
+};
+
+// Compiles nothing; every shader is valid
+class ENGINE_API NullShader : public Shader {
+public:
+    bool compile(const std::string& shaderPath) override;
+    bool compile(const std::string& vert, const std::string& frag) override;
+    void bind() override {}
+};
+
+// Keeps the size and format it was given, never reads pixels or files
+class ENGINE_API NullTexture : public Texture {
+public:
+    explicit NullTexture(TextureType type = TextureType::Texture2D);
+
+    bool LoadFromMemory(const void* data, uint32_t width, uint32_t height,
+                        TextureFormat format) override;
+    bool LoadFromFile(const std::string& filePath) override;
+
+    void Bind(uint32_t slot = 0) const override { (void)slot; }
+    void Unbind() const override {}
+
+    void SetFilter(TextureFilter filter) override { (void)filter; }
+    void SetWrapMode(TextureWrapMode wrapMode) override { (void)wrapMode; }
+
+    uint32_t GetWidth() const override { return m_width; }
+    uint32_t GetHeight() const override { return m_height; }
+    TextureFormat GetFormat() const override { return m_format; }
+    TextureType GetType() const override { return m_type; }
+
+private:
+    uint32_t m_width = 1;
+    uint32_t m_height = 1;
+    TextureFormat m_format = TextureFormat::RGBA8;
+    TextureType m_type;
+};
+
+}  // namespace RenderEngine
+}  // namespace Sleak
+
+#endif  // _NULLRESOURCES_HPP_
@@ -35,11 +35,14 @@ public:
 
     // RenderContext interface
     virtual void Draw(uint32_t vertexCount) override;
-    virtual void DrawIndexed(uint32_t indexCount) override;
+    virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex = 0,
+                             int32_t baseVertex = 0) override;
     virtual void DrawInstance(uint32_t instanceCount,
                               uint32_t vertexPerInstance) override;
     virtual void DrawIndexedInstance(uint32_t instanceCount,
-                                     uint32_t indexPerInstance) override;
+                                     uint32_t indexPerInstance,
+                                     uint32_t startIndex = 0,
+                                     int32_t baseVertex = 0) override;
 
     virtual void SetRenderFace(RenderFace face) override;
     virtual void SetRenderMode(RenderMode mode) override;
@@ -64,6 +67,11 @@ public:
                                     uint32_t slot = 0) override;
     virtual void BindBoneBuffer(RefPtr<BufferBase> buffer) override;
 
+    virtual bool SupportsInstancing() const override { return true; }
+    virtual bool BeginInstancedDraw(RefPtr<BufferBase> instances,
+                                    uint32_t firstInstance) override;
+    virtual void EndInstancedDraw() override;
+
     virtual void BeginDebugLinePass() override;
     virtual void EndDebugLinePass() override;
 
@@ -84,6 +92,11 @@ private:
 
     GLuint m_VAO = 0;
     bool m_debugLineMode = false;
+    IndexFormat m_indexFormat = IndexFormat::UInt32;   // Of the bound element buffer
+
+    // Program and uInstanced location of the instanced draw in flight
+    GLint m_instancedProgram = 0;
+    GLint m_instancedLocation = -1;
 
     // MSAA FBO resources
     GLuint m_msaaFBO = 0;
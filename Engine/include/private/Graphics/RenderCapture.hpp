@@ -0,0 +1,184 @@
+#ifndef _RENDER_CAPTURE_HPP_
+#define _RENDER_CAPTURE_HPP_
+
+#include <Core/OSDef.hpp>
+#include <Memory/RefPtr.h>
+#include <Utility/Container/Queue.hpp>
+#include <Math/Matrix.hpp>
+#include "RenderCommands.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Sleak {
+    class Material;
+
+    namespace RenderEngine {
+        class RenderCommandQueue;
+
+        /**
+         * Capture file layout (little-endian, as written by the host):
+         *
+         *   header:  magic "SLKC", u16 version, u16 reserved
+         *   records: u8 tag, then its fields
+         *
+         * Tags below 0xF0 are a CommandType followed by its arguments.
+         * Resources are referred to by IDs the capture hands out; a Define
+         * record precedes the first command using one. Buffers keep their
+         * type and size but not their contents, which replay fills with
+         * zeros: enough to reproduce command processing, not the image.
+         */
+        namespace RenderCaptureFormat {
+            static constexpr uint32_t MAGIC = 0x434B4C53;   // "SLKC"
+            static constexpr uint16_t VERSION = 3;
+
+            static constexpr uint8_t TAG_FRAME = 0xF0;      // u64 frame, u32 command count
+            static constexpr uint8_t TAG_BUFFER = 0xF1;     // u32 id, u8 BufferType, u32 size, u8 VertexLayout, u8 IndexFormat
+            static constexpr uint8_t TAG_MATERIAL = 0xF2;   // u32 id, u8 render mode, u8 instancing
+
+            // Flags of a draw record
+            static constexpr uint8_t DRAW_SORT_KEY = 1 << 0;    // u64 key follows
+            static constexpr uint8_t DRAW_WORLD = 1 << 1;       // 16 floats follow
+        }
+
+        /**
+         * @class RenderCaptureWriter
+         * @brief Writes recorded frames of the RenderCommandQueue to a
+         * capture file, see RenderCaptureFormat.
+         *
+         * Frames are written as recorded, before sorting and batching, so a
+         * replay exercises those again. Custom commands only keep their tag:
+         * their function cannot be stored and replay skips them.
+         */
+        class ENGINE_API RenderCaptureWriter {
+        public:
+            ~RenderCaptureWriter();
+
+            bool Open(const std::string& path);
+            void Close();
+            bool IsOpen() const { return m_file.is_open(); }
+
+            void WriteFrame(uint64_t frame, const Queue<RenderCommandBase*>& commands);
+
+            uint32_t GetFramesWritten() const { return m_framesWritten; }
+
+        private:
+            uint32_t BufferID(BufferBase* buffer);
+            uint32_t MaterialID(::Sleak::Material* material);
+            void WriteCommand(RenderCommandBase* command);
+            void WriteBuffers(const BufferSpan& buffers);
+            void WriteDraw(RenderCommandBase* command, const Math::Matrix4* world);
+
+            template <typename T>
+            void Put(const T& value) {
+                const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+                m_record.insert(m_record.end(), bytes, bytes + sizeof(T));
+            }
+
+            struct BufferEntry {
+                uint32_t id;
+                BufferType type;
+                size_t size;
+                VertexLayout layout;
+                IndexFormat format;
+            };
+
+            std::ofstream m_file;
+            std::vector<uint8_t> m_record;      // Frame being encoded
+            std::vector<uint8_t> m_defines;     // Resources it introduced
+            std::unordered_map<const void*, BufferEntry> m_buffers;
+            std::unordered_map<const void*, uint32_t> m_materials;
+            uint32_t m_nextID = 1;
+            uint32_t m_framesWritten = 0;
+        };
+
+        /**
+         * @class RenderCapturePlayer
+         * @brief Loads a capture file and re-issues its frames into a
+         * RenderCommandQueue.
+         *
+         * Load decodes the whole file up front, so replaying a frame costs
+         * only the queue's own work. Buffers are created through the
+         * ResourceManager of whatever renderer is active; materials are
+         * empty placeholders with the captured render mode and instancing.
+         */
+        class ENGINE_API RenderCapturePlayer {
+        public:
+            ~RenderCapturePlayer();
+
+            bool Load(const std::string& path);
+
+            // Creates the captured buffers and materials on the active renderer
+            bool CreateResources();
+            void ReleaseResources();
+
+            // Submits one frame's commands; executing them is up to the caller
+            void SubmitFrame(uint32_t frame, RenderCommandQueue* queue);
+
+            uint32_t GetFrameCount() const { return static_cast<uint32_t>(m_frames.size()); }
+            uint64_t GetCapturedFrame(uint32_t frame) const { return m_frames[frame].frame; }
+            uint32_t GetCommandCount(uint32_t frame) const { return m_frames[frame].count; }
+
+            // Custom commands in the capture, which replay cannot run
+            uint32_t GetSkippedCommands() const { return m_skipped; }
+
+        private:
+            struct BufferDefine {
+                uint32_t id;
+                BufferType type;
+                uint32_t size;
+                VertexLayout layout;
+                IndexFormat format;
+            };
+
+            struct MaterialDefine {
+                uint32_t id;
+                uint8_t renderMode;
+                bool instancing;
+            };
+
+            struct Command {
+                CommandType type;
+                uint32_t buffer = 0;            // Vertex buffer of draws
+                uint32_t indexBuffer = 0;
+                uint32_t material = 0;
+                uint32_t firstBuffer = 0;       // Constant buffers in m_bufferIDs
+                uint32_t bufferCount = 0;
+                uint32_t count = 0;             // Vertices or indices
+                uint32_t start = 0;
+                int32_t baseVertex = 0;
+                uint32_t payload = 0;           // Offset in m_payload
+                uint16_t payloadSize = 0;
+                uint8_t value = 0;              // Slot, render mode or face
+                uint8_t flags = 0;
+                uint64_t sortKey = 0;
+                Math::Matrix4 world;
+            };
+
+            struct Frame {
+                uint64_t frame;
+                uint32_t first;                 // In m_commands
+                uint32_t count;
+            };
+
+            RefPtr<BufferBase> GetBuffer(uint32_t id) const;
+
+            std::vector<Frame> m_frames;
+            std::vector<Command> m_commands;
+            std::vector<uint32_t> m_bufferIDs;
+            std::vector<uint8_t> m_payload;
+            std::vector<BufferDefine> m_bufferDefines;
+            std::vector<MaterialDefine> m_materialDefines;
+            uint32_t m_skipped = 0;
+
+            // Indexed by capture ID
+            std::vector<RefPtr<BufferBase>> m_buffers;
+            std::vector<::Sleak::Material*> m_materials;
+            List<RefPtr<BufferBase>> m_constantBuffers;
+        };
+    }
+}
+
+#endif // _RENDER_CAPTURE_HPP_
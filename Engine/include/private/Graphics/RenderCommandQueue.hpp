@@ -3,25 +3,60 @@
 
 #include <Graphics/Renderer.hpp>
 #include "RenderCommands.hpp"
+#include "RenderStateCache.hpp"
 #include <Utility/Container/Queue.hpp>
 #include <Memory/ObjectPtr.h>
+#include <Memory/FrameAllocator.h>
+#include <string>
+#include <vector>
 
 namespace Sleak {
     namespace RenderEngine {
-        class RenderCommandQueue {
+        // Resource kinds that get their own per-frame sort IDs
+        class RenderCaptureWriter;
+
+        enum class SortResource : uint8_t {
+            Shader = 0,
+            Material = 1,
+            Mesh = 2,
+            Count = 3
+        };
+
+        /**
+         * @class RenderCommandQueue
+         * @brief Collects a frame's render commands and executes them in
+         * order.
+         *
+         * Commands and their payloads (constant buffer data, buffer lists)
+         * are placed in a FrameAllocator instead of the heap. There are
+         * three, used in turn: one for the frame being recorded, one for
+         * the frame submitted for execution, and one for the frame before,
+         * whose draws the submitted frame's shadow pass replays. Submitting
+         * resets the oldest for the next frame, so a steady frame allocates
+         * nothing.
+         *
+         * Recording and execution use separate command lists, so a
+         * RenderThread can execute one frame while the next is recorded.
+         *
+         * BeginCapture writes the next submitted frames to a file as they
+         * were recorded, for RenderCapturePlayer to replay offline.
+         */
+        class ENGINE_API RenderCommandQueue {
         public:
-        void SubmitDrawIndexed(
+        // Draw submissions return the queued command so the caller can set
+        // its owner and sort key. Valid until the queue executes.
+        RenderCommandBase* SubmitDrawIndexed(
             RefPtr<BufferBase> vertexBuffer,
             RefPtr<BufferBase> indexBuffer,
-            List<RefPtr<BufferBase>> constantBuffers,
+            const List<RefPtr<BufferBase>>& constantBuffers,
             uint32_t indexCount,
             uint32_t startIndexLocation = 0,
             int32_t baseVertexLocation = 0
         );
 
-        void SubmitDraw(
+        RenderCommandBase* SubmitDraw(
             RefPtr<BufferBase> vertexBuffer,
-            List<RefPtr<BufferBase>> constantBuffers,
+            const List<RefPtr<BufferBase>>& constantBuffers,
             uint32_t vertexCount,
             uint32_t startVertexLocation = 0
         );
@@ -31,9 +66,10 @@ namespace Sleak {
             uint8_t slot
         );
 
+        // Data is copied, the caller's memory can be reused right away
         void SubmitUpdateConstantBuffer(
             RefPtr<BufferBase> buffer,
-            void* Data,
+            const void* Data,
             uint16_t Size
         );
 
@@ -45,14 +81,80 @@ namespace Sleak {
 
         void SubmitCustomCommand(CustomCommand::ExecuteFunction function);
 
+        // Submits and executes the recorded frame on the calling thread.
+        // Binds that would not change the context's state are dropped.
         void ExecuteCommands(RenderContext* context);
 
+        // Hands the recorded commands over for execution and starts a new
+        // frame. Must not run while ExecuteSubmitted does.
+        void SubmitFrame();
+
+        // Executes the last submitted frame, may run on another thread
+        // than the one recording
+        void ExecuteSubmitted(RenderContext* context);
+
+        // Adds the last executed frame's counters to the renderer's metrics
+        void AddFrameStats(Renderer* renderer) const;
+
         void ExecuteShadowPass(RenderContext* context);
 
         void Clear();
 
+        // Writes the next frameCount submitted frames to path. Stops on its
+        // own after them; EndCapture stops early.
+        bool BeginCapture(const std::string& path, uint32_t frameCount = 1);
+        void EndCapture();
+        bool IsCapturing() const { return m_captureFramesLeft != 0; }
+
+        /**
+         * Reorders the frame's draws by sort key. A draw and the state
+         * commands submitted since the previous draw (constant buffer
+         * updates and binds, material) move as one group. Custom commands,
+         * render mode / face changes and draws without a key are barriers:
+         * they keep their place and groups never cross them.
+         */
         void SortCommands();
-        void OptimizeBatching();
+
+        /**
+         * Moves every draw that only needs its transform (after sorting) to
+         * the per-frame instance buffer, and merges runs of them that use the
+         * same vertex buffer, index buffer and material into one instanced
+         * draw. A lone draw becomes an instanced draw of one.
+         *
+         * Their transform buffer binds are dropped and their uploads
+         * deferred: the data is kept and only sent if the buffer is bound
+         * on its own later. Only done when the context supports instancing;
+         * materials can opt out with Material::SetInstancing(false).
+         */
+        void OptimizeBatching(RenderContext* context);
+
+        // Small stable ID for a resource for the rest of this frame, 0 for null.
+        // The sort key holds 1023 shader IDs and 4095 material or mesh IDs;
+        // later ones share key values with earlier ones and sort less well.
+        uint32_t GetSortID(SortResource kind, const void* resource);
+
+        // IDs the last submitted frame handed out past their key field
+        uint32_t GetSortIDsFolded() const { return m_sortIDsFolded; }
+
+        // Shader, material and mesh switches the last sort avoided
+        int32_t GetStateChangesSaved() const { return m_stateChangesSaved; }
+
+        // Draw calls the last OptimizeBatching folded into instanced draws
+        int32_t GetDrawsMerged() const { return m_drawsMerged; }
+
+        // Transform uploads the last OptimizeBatching deferred
+        int32_t GetTransformUploadsDeferred() const { return m_transformUploadsDeferred; }
+
+        // State commands the last ExecuteCommands dropped as redundant
+        int32_t GetRedundantStateFiltered() const { return m_redundantStateFiltered; }
+
+        // Heap allocations between the last two submits (one frame recorded,
+        // the one before executed): frame allocator blocks plus growth of
+        // the queue's own arrays. Zero once the scene's load is steady.
+        uint32_t GetFrameHeapAllocations() const { return m_frameHeapAllocations; }
+
+        // Bytes the last executed frame used in its frame allocator
+        size_t GetFrameMemoryUsed() const { return m_frameMemoryUsed; }
         
         inline static RenderCommandQueue* GetInstance() 
         {
@@ -61,14 +163,159 @@ namespace Sleak {
         }
 
         struct ShadowDrawEntry {
-            RefPtr<RenderCommandBase> command;
+            RenderCommandBase* command;         // Lives in the previous frame's allocator
             RefPtr<BufferBase> transformBuffer;  // last-bound slot-0 buffer
         };
 
         private:
+            struct SortEntry {
+                uint64_t key;
+                uint32_t group;
+            };
+
+            struct CommandGroup {
+                uint32_t first;
+                uint32_t count;
+            };
+
+            // A group OptimizeBatching can turn into an instance
+            struct InstanceGroup {
+                uint32_t first;         // First state command
+                uint32_t draw;          // The DrawIndexedCommand closing it
+                uint32_t bindMaterial;  // Index of its BindMaterialCommand
+                ::Sleak::Material* material;
+                RefPtr<BufferBase> transform;
+            };
+
+            /**
+             * Open-addressing pointer -> ID map for GetSortID. Clearing keeps
+             * the slots, so unlike a node-based map it stops allocating once
+             * it has seen a frame's worth of resources.
+             */
+            struct SortIDTable {
+                std::vector<const void*> keys;
+                std::vector<uint32_t> ids;
+                uint32_t count = 0;
+
+                uint32_t Get(const void* resource);
+                void Clear();
+
+            private:
+                void Grow();
+            };
+
             static RenderCommandQueue* Instance;
-            Queue<RefPtr<RenderCommandBase>> commands;
+            Queue<RenderCommandBase*> commands;      // Being recorded
+            Queue<RenderCommandBase*> m_submitted;   // Being executed
             List<ShadowDrawEntry> cachedShadowDraws;
+
+            // Recorded commands go to m_allocators[m_current], the submitted
+            // ones live in m_submittedFrame, and the third still holds what
+            // cachedShadowDraws points to
+            static constexpr uint32_t FRAME_ALLOCATORS = 3;
+            FrameAllocator m_allocators[FRAME_ALLOCATORS];
+            std::vector<RenderCommandBase*> m_allocated[FRAME_ALLOCATORS];
+            uint32_t m_current = 0;
+            uint32_t m_submittedFrame = 0;
+
+            // Camera of the submitted frame: the main camera may already
+            // have moved on for the next one
+            Math::Matrix4 m_submittedViewProjection = Math::Matrix4::Identity();
+
+            uint32_t m_frameHeapAllocations = 0;
+            size_t m_frameMemoryUsed = 0;
+            uint64_t m_lastBlockAllocations = 0;
+            std::vector<size_t> m_lastCapacities;
+
+            // Sort scratch, kept between frames to avoid reallocating
+            std::vector<SortEntry> m_sortEntries;
+            std::vector<SortEntry> m_sortScratch;
+            std::vector<CommandGroup> m_groups;
+            std::vector<RenderCommandBase*> m_sorted;
+
+            SortIDTable m_sortIDs[static_cast<size_t>(SortResource::Count)];
+            int32_t m_stateChangesSaved = 0;
+            uint32_t m_sortIDsFolded = 0;
+
+            // Latest transform data of a buffer whose upload was dropped
+            // because its draws read the instance buffer instead. Found
+            // through BufferBase::GetDeferredSlot, without a lookup.
+            struct DeferredUpload {
+                RefPtr<BufferBase> buffer;
+                uint8_t data[sizeof(Math::Matrix4) * 2];
+                uint16_t size = 0;
+                bool pending = false;
+            };
+
+            // Instance buffers written by one frame while the GPU may still
+            // read the previous one's
+            static constexpr uint32_t FRAMES_IN_FLIGHT = 2;
+
+            // Per-frame instance data: {WVP, World} per instance
+            std::vector<InstanceGroup> m_instanceRun;
+            std::vector<Math::Matrix4> m_instanceData;
+            std::vector<DrawIndexedInstancedCommand*> m_instancedDraws;
+            RefPtr<BufferBase> m_instanceBuffers[FRAMES_IN_FLIGHT];
+            uint32_t m_instanceFrame = 0;
+            // What the last executed frame's context said; until then, assumed
+            bool m_instancingSupported = true;
+            int32_t m_drawsMerged = 0;
+
+            // Instance buffer of the frame cachedShadowDraws holds: its
+            // merged draws replay from there, see DrawIndexedCommand::GetInstance
+            RefPtr<BufferBase> m_shadowInstances;
+
+            // Indexed by the buffers' deferred slot; free slots are reused
+            std::vector<DeferredUpload> m_deferredUploads;
+            std::vector<uint32_t> m_freeDeferredSlots;
+            size_t m_deferredPruneSize = 64;
+            int32_t m_transformUploadsDeferred = 0;
+
+            RenderStateCache m_stateCache;
+            int32_t m_redundantStateFiltered = 0;
+
+            RenderCaptureWriter* m_capture = nullptr;
+            uint32_t m_captureFramesLeft = 0;
+            uint64_t m_submittedFrames = 0;
+
+            bool GetInstanceGroup(uint32_t first, uint32_t draw, InstanceGroup& group) const;
+            void FlushInstanceRun();
+            // Sizes the next instance buffer for the submitted frame, on the
+            // recording side so that executing it allocates nothing
+            void ReserveInstanceBuffer();
+            void UploadInstanceData();
+
+            // False when the update cannot be deferred and must still run
+            bool DeferUpload(const RefPtr<BufferBase>& buffer, const UpdateConstantBufferCommand* update);
+            // Sends a buffer's deferred data before it is bound on its own
+            void ApplyDeferredUpload(BufferBase* buffer);
+            // The buffer got a newer upload of its own
+            void DropDeferredUpload(BufferBase* buffer);
+            void ReleaseDeferredSlot(uint32_t slot);
+            void PruneDeferredUploads();
+
+            // Places a command in the recording frame's allocator
+            template <typename T, typename... Args>
+            T* Allocate(Args&&... args) {
+                return AllocateIn<T>(m_current, std::forward<Args>(args)...);
+            }
+
+            template <typename T, typename... Args>
+            T* AllocateIn(uint32_t frame, Args&&... args) {
+                T* command = m_allocators[frame].New<T>(std::forward<Args>(args)...);
+                m_allocated[frame].push_back(command);
+                return command;
+            }
+
+            // Copies buffers into the current frame allocator
+            BufferSpan AllocateBuffers(const List<RefPtr<BufferBase>>& buffers);
+
+            // Destroys the commands of one allocator and rewinds it
+            void ReleaseFrame(uint32_t index);
+            void CountFrameAllocations();
+
+            static void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+            static int32_t CountStateChanges(const std::vector<SortEntry>& entries);
         };
     }
 }
@@ -3,8 +3,10 @@
 
 #include <mutex>
 #include <Memory/RefPtr.h>
+#include <Memory/Handle.h>
 #include <Utility/Container/List.hpp>
 #include <Graphics/ConstantBuffer.hpp>
+#include <Math/Matrix.hpp>
 #include "BufferBase.hpp"
 #include <Graphics/Renderer.hpp>
 
@@ -13,6 +15,7 @@
 
 namespace Sleak {
     class Texture;
+    class GameObject;
 
     namespace RenderEngine {
 
@@ -45,6 +48,82 @@ namespace Sleak {
             BindMaterial = 16
         };
 
+        // Coarse draw order, before any state. Background draws first.
+        enum class SortPass : uint8_t {
+            Background = 0,
+            Main = 1,
+            Overlay = 2
+        };
+
+        /**
+         * @struct RenderSortKey
+         * @brief Packs the state a draw binds into 64 bits, most significant first:
+         *
+         *   pass(2) | mode(2) | far depth(16) | shader(10) | material(12) | mesh(12) | near depth(10)
+         *
+         * Mode is the MaterialRenderMode (opaque, cutout, transparent).
+         * Opaque and cutout draws leave the far field empty, so they group by
+         * shader, material and mesh, front to back within a group. Transparent
+         * draws fill it with inverted depth and sort back to front first.
+         * Shader, material and mesh are small per-frame IDs handed out by
+         * RenderCommandQueue::GetSortID. An ID too large for its field wraps
+         * around to a smaller one: draws sharing a field value sort together
+         * but batching still compares the real resources.
+         */
+        struct RenderSortKey {
+            static constexpr uint32_t PASS_SHIFT = 62;
+            static constexpr uint32_t MODE_SHIFT = 60;
+            static constexpr uint32_t FAR_DEPTH_SHIFT = 44;
+            static constexpr uint32_t SHADER_SHIFT = 34;
+            static constexpr uint32_t MATERIAL_SHIFT = 22;
+            static constexpr uint32_t MESH_SHIFT = 10;
+
+            static constexpr uint32_t SHADER_BITS = 10;
+            static constexpr uint32_t MATERIAL_BITS = 12;
+            static constexpr uint32_t MESH_BITS = 12;
+            static constexpr uint32_t FAR_DEPTH_BITS = 16;
+            static constexpr uint32_t NEAR_DEPTH_BITS = 10;
+
+            static constexpr uint8_t TRANSPARENT_MODE = 2;
+
+            // depth: distance from the camera, >= 0
+            static uint64_t Make(SortPass pass, uint8_t mode, uint32_t shader,
+                                 uint32_t material, uint32_t mesh, float depth);
+
+            // Monotonic: larger depth never gives a smaller value
+            static uint32_t QuantizeDepth(float depth, uint32_t bits);
+
+            static uint32_t GetShader(uint64_t key) { return Field(key, SHADER_SHIFT, SHADER_BITS); }
+            static uint32_t GetMaterial(uint64_t key) { return Field(key, MATERIAL_SHIFT, MATERIAL_BITS); }
+            static uint32_t GetMesh(uint64_t key) { return Field(key, MESH_SHIFT, MESH_BITS); }
+
+        private:
+            static uint32_t Field(uint64_t key, uint32_t shift, uint32_t bits) {
+                return static_cast<uint32_t>((key >> shift) & ((1ull << bits) - 1));
+            }
+        };
+
+        /**
+         * @struct BufferSpan
+         * @brief Buffers a command refers to, stored in the queue's frame
+         * allocator. The owning command destroys the elements; the memory
+         * is released with the rest of the frame.
+         */
+        struct BufferSpan {
+            RefPtr<BufferBase>* data = nullptr;
+            uint32_t count = 0;
+
+            RefPtr<BufferBase>* begin() const { return data; }
+            RefPtr<BufferBase>* end() const { return data + count; }
+            uint32_t GetSize() const { return count; }
+
+            void Destroy() {
+                for (uint32_t i = 0; i < count; ++i)
+                    data[i].~RefPtr<BufferBase>();
+                count = 0;
+            }
+        };
+
         class RenderCommandBase {
         public:
             virtual ~RenderCommandBase() = default;
@@ -52,28 +131,45 @@ namespace Sleak {
             virtual CommandType GetType() const = 0;
             virtual void ExecuteShadow(RenderContext* context) { /* no-op for non-draw commands */ }
 
-            void SetOwnerObjectID(uint32_t id) { m_ownerObjectID = id; }
-            uint32_t GetOwnerObjectID() const { return m_ownerObjectID; }
+            // Resolve with GameObject::Resolve; null once the object is gone
+            void SetOwner(Handle<GameObject> owner) { m_owner = owner; }
+            Handle<GameObject> GetOwner() const { return m_owner; }
+
+            // Draws with a key are reordered together with the state
+            // commands submitted right before them, see SortCommands
+            void SetSortKey(uint64_t key) { m_sortKey = key; m_hasSortKey = true; }
+            uint64_t GetSortKey() const { return m_sortKey; }
+            bool HasSortKey() const { return m_hasSortKey; }
 
         private:
-            uint32_t m_ownerObjectID = 0;
+            Handle<GameObject> m_owner;
+            uint64_t m_sortKey = 0;
+            bool m_hasSortKey = false;
         };
 
         class DrawCommand : public RenderCommandBase {
             public:
                 DrawCommand(
                     RefPtr<BufferBase> vertexBuffer,
-                    List<RefPtr<BufferBase>> constantBuffers,
+                    BufferSpan constantBuffers,
                     uint32_t vertexCount,
                     uint32_t startVertexLocation = 0
                 );
+                ~DrawCommand() override { m_constantBuffers.Destroy(); }
 
                 RENDER_COMMAND(Draw)
                 void ExecuteShadow(RenderContext* context) override;
 
+                bool HasConstantBuffers() const { return m_constantBuffers.GetSize() != 0; }
+
+                const RefPtr<BufferBase>& GetVertexBuffer() const { return m_vertexBuffer; }
+                const BufferSpan& GetConstantBuffers() const { return m_constantBuffers; }
+                uint32_t GetVertexCount() const { return m_vertexCount; }
+                uint32_t GetStartVertexLocation() const { return m_startVertexLocation; }
+
             private:
                 RefPtr<BufferBase> m_vertexBuffer;
-                List<RefPtr<BufferBase>> m_constantBuffers;
+                BufferSpan m_constantBuffers;
                 uint32_t m_vertexCount;
                 uint32_t m_startVertexLocation;
         };
@@ -82,28 +178,99 @@ namespace Sleak {
         public:
             DrawIndexedCommand(RefPtr<BufferBase> vertexBuffer,
                  RefPtr<BufferBase> indexBuffer,
-                 List<RefPtr<BufferBase>> constantBuffers,
+                 BufferSpan constantBuffers,
                  uint32_t indexCount,
                  uint32_t startIndexLocation = 0,
                  int32_t baseVertexLocation = 0
                 );
+            ~DrawIndexedCommand() override { m_constantBuffers.Destroy(); }
 
             RENDER_COMMAND(DrawIndexed)
             void ExecuteShadow(RenderContext* context) override;
-            
+
+            // World matrix of the drawn object, lets OptimizeBatching
+            // turn this draw into an instance
+            void SetWorldMatrix(const Math::Matrix4& world) { m_world = world; m_hasWorld = true; }
+            const Math::Matrix4& GetWorldMatrix() const { return m_world; }
+            bool HasWorldMatrix() const { return m_hasWorld; }
+
+            // Where OptimizeBatching put this draw's transforms in the
+            // frame's instance data, so the shadow pass can read them there
+            static constexpr uint32_t NO_INSTANCE = ~0u;
+            void SetInstance(uint32_t instance) { m_instance = instance; }
+            uint32_t GetInstance() const { return m_instance; }
+
+            // Shadow replay of a merged draw; BeginInstancedDraw has
+            // pointed the context at its instance
+            void ExecuteShadowInstance(RenderContext* context);
+
+            const RefPtr<BufferBase>& GetVertexBuffer() const { return m_vertexBuffer; }
+            const RefPtr<BufferBase>& GetIndexBuffer() const { return m_indexBuffer; }
+            uint32_t GetIndexCount() const { return m_indexCount; }
+            uint32_t GetStartIndexLocation() const { return m_startIndexLocation; }
+            int32_t GetBaseVertexLocation() const { return m_baseVertexLocation; }
+            bool HasConstantBuffers() const { return m_constantBuffers.GetSize() != 0; }
+            const BufferSpan& GetConstantBuffers() const { return m_constantBuffers; }
+
+        private:
+            RefPtr<BufferBase> m_vertexBuffer;
+            RefPtr<BufferBase> m_indexBuffer;
+            BufferSpan m_constantBuffers;
+            uint32_t m_indexCount;
+            uint32_t m_startIndexLocation;
+            int32_t m_baseVertexLocation;
+            Math::Matrix4 m_world;
+            bool m_hasWorld = false;
+            uint32_t m_instance = NO_INSTANCE;
+        };
+
+        /**
+         * @class DrawIndexedInstancedCommand
+         * @brief One mesh drawn for several objects, built by OptimizeBatching.
+         *
+         * Instance matrices live in the queue's per-frame instance buffer.
+         * Keeps each object's transform buffer to fall back to separate
+         * draws when the bound shader has no instancing path; their uploads
+         * were deferred, so the fallback fills them from the instance data.
+         */
+        class DrawIndexedInstancedCommand : public RenderCommandBase {
+        public:
+            DrawIndexedInstancedCommand(RefPtr<BufferBase> vertexBuffer,
+                                        RefPtr<BufferBase> indexBuffer,
+                                        uint32_t indexCount,
+                                        uint32_t startIndexLocation,
+                                        int32_t baseVertexLocation,
+                                        uint32_t firstInstance,
+                                        BufferSpan transformBuffers);
+            ~DrawIndexedInstancedCommand() override { m_transformBuffers.Destroy(); }
+
+            RENDER_COMMAND(DrawInstanced)
+
+            // Set once the frame's instance data has been uploaded. data is
+            // the CPU copy, valid until the queue builds the next frame
+            void SetInstanceBuffer(RefPtr<BufferBase> buffer, const Math::Matrix4* data) {
+                m_instanceBuffer = buffer;
+                m_instanceData = data;
+            }
+
+            uint32_t GetInstanceCount() const { return static_cast<uint32_t>(m_transformBuffers.GetSize()); }
+
         private:
             RefPtr<BufferBase> m_vertexBuffer;
             RefPtr<BufferBase> m_indexBuffer;
-            List<RefPtr<BufferBase>> m_constantBuffers;
             uint32_t m_indexCount;
             uint32_t m_startIndexLocation;
             int32_t m_baseVertexLocation;
+            RefPtr<BufferBase> m_instanceBuffer;
+            const Math::Matrix4* m_instanceData = nullptr;
+            uint32_t m_firstInstance;
+            BufferSpan m_transformBuffers;
         };
 
         class UpdateConstantBufferCommand : public RenderCommandBase {
             public:
+                // Data is a copy owned by the queue's frame allocator
                 UpdateConstantBufferCommand(RefPtr<BufferBase> buffer, void* Data, uint16_t Size);
-                ~UpdateConstantBufferCommand() override { free(Data); }
 
                 RENDER_COMMAND(UpdateConstantBuffer)
 
@@ -112,6 +279,10 @@ namespace Sleak {
                     return Data;
                 }
 
+                BufferBase* GetBuffer() const { return constantBuffer.get(); }
+
+                uint16_t GetSize() const { return Size; }
+
             private:
                 RefPtr<BufferBase> constantBuffer;
                 void* Data;
@@ -124,7 +295,7 @@ namespace Sleak {
 
                 RENDER_COMMAND(BindConstantBuffer)
 
-                RefPtr<BufferBase> GetBuffer() const { return constantBuffer; }
+                const RefPtr<BufferBase>& GetBuffer() const { return constantBuffer; }
                 int GetSlot() const { return slot; }
 
             private:
@@ -138,6 +309,8 @@ namespace Sleak {
 
                 RENDER_COMMAND(SetTexture)
 
+                const RefPtr<Texture>& GetTexture() const { return texture; }
+
             private:
                 RefPtr<Texture> texture;
         };
@@ -148,6 +321,8 @@ namespace Sleak {
 
                 RENDER_COMMAND(SetShader)
 
+                const RefPtr<Shader>& GetShader() const { return shader; }
+
             private:
                 RefPtr<Shader> shader;
         };
@@ -158,6 +333,8 @@ namespace Sleak {
 
                 RENDER_COMMAND(SetMode)
 
+                RenderMode GetMode() const { return mode; }
+
             private:
                 RenderMode mode;
         };
@@ -168,6 +345,8 @@ namespace Sleak {
 
                 RENDER_COMMAND(SetFace)
 
+                RenderFace GetFace() const { return face; }
+
             private:
                 RenderFace face;
         };
@@ -179,6 +358,8 @@ namespace Sleak {
                 void Execute(RenderContext* context) override;
                 CommandType GetType() const override { return CommandType::BindMaterial; }
 
+                ::Sleak::Material* GetMaterial() const { return m_material; }
+
             private:
                 ::Sleak::Material* m_material;
         };
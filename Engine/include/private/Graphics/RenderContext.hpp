@@ -51,9 +51,11 @@ enum class DepthCompare {
         public:
             // Rendering commands
             virtual void Draw(uint32_t vertexCount) = 0;
-            virtual void DrawIndexed(uint32_t indexCount) = 0;
+            // startIndex and baseVertex select a range of shared buffers
+            virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex = 0, int32_t baseVertex = 0) = 0;
             virtual void DrawInstance(uint32_t instanceCount, uint32_t vertexPerInstance) = 0;
-            virtual void DrawIndexedInstance(uint32_t instanceCount, uint32_t indexPerInstance) = 0;
+            virtual void DrawIndexedInstance(uint32_t instanceCount, uint32_t indexPerInstance,
+                                             uint32_t startIndex = 0, int32_t baseVertex = 0) = 0;
 
             // State management
             virtual void SetRenderFace(RenderFace face) = 0;
@@ -84,11 +86,25 @@ enum class DepthCompare {
             virtual void BeginDebugLinePass() {}
             virtual void EndDebugLinePass() {}
 
+            // Instancing: the shader reads {WVP, World} matrix pairs from the
+            // instance buffer, starting at firstInstance. Begin returns false
+            // when the bound shader cannot, and the caller then draws each
+            // instance with its own transform buffer instead. The shadow
+            // pass replays merged draws this way, one instance at a time.
+            virtual bool SupportsInstancing() const { return false; }
+            virtual bool BeginInstancedDraw(RefPtr<BufferBase> instances, uint32_t firstInstance) { (void)instances; (void)firstInstance; return false; }
+            virtual void EndInstancedDraw() {}
+
             // Shadow pass support
             virtual void BeginShadowPass() {}
             virtual void EndShadowPass() {}
             virtual bool IsShadowPassActive() const { return false; }
 
+            // Whether each constant buffer slot keeps its own binding. False
+            // when all slots write the same storage (Vulkan push constants),
+            // so binding one slot overwrites what the others set.
+            virtual bool HasIndependentConstantBufferSlots() const { return true; }
+
             // Buffer binding
             virtual void BindVertexBuffer(RefPtr<BufferBase> buffer, uint32_t slot = 0) = 0;
             virtual void BindIndexBuffer(RefPtr<BufferBase> buffer, uint32_t slot = 0) = 0;
@@ -0,0 +1,52 @@
+#ifndef _RENDER_STATE_CACHE_HPP_
+#define _RENDER_STATE_CACHE_HPP_
+
+#include <cstdint>
+
+namespace Sleak {
+    namespace RenderEngine {
+        class RenderCommandBase;
+        class BufferBase;
+
+        /**
+         * @class RenderStateCache
+         * @brief Remembers what the executed commands left bound, so the
+         * queue can drop binds that would not change anything.
+         *
+         * Tracks the shader, material, texture and constant buffer per slot,
+         * render mode and render face. A null resource is "unknown": it
+         * never matches, so a bind after it always reaches the context.
+         * Commands whose effect cannot be predicted (custom commands,
+         * draws that bind their own buffers or switch pipelines) forget
+         * the affected state instead of guessing.
+         *
+         * Some backends share one storage between all constant buffer
+         * slots (Vulkan push constants); with independentSlots false a bind
+         * to one slot forgets the others.
+         */
+        class RenderStateCache {
+        public:
+            static constexpr uint32_t MAX_SLOTS = 16;
+
+            void Reset(bool independentSlots);
+
+            // True when the command is redundant; otherwise records its effect
+            bool Filter(const RenderCommandBase* command);
+
+        private:
+            void ForgetConstantBuffers();
+            void ForgetTextures();
+            void BindConstantBuffer(uint32_t slot, const BufferBase* buffer);
+
+            const void* m_shader = nullptr;
+            const void* m_material = nullptr;
+            const void* m_textures[MAX_SLOTS] = {};
+            const BufferBase* m_constantBuffers[MAX_SLOTS] = {};
+            int32_t m_mode = -1;            // -1: unknown
+            int32_t m_face = -1;
+            bool m_independentSlots = true;
+        };
+    }
+}
+
+#endif // _RENDER_STATE_CACHE_HPP_
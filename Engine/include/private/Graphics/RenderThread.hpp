@@ -0,0 +1,72 @@
+#ifndef _RENDER_THREAD_HPP_
+#define _RENDER_THREAD_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace Sleak {
+    namespace RenderEngine {
+
+        class Renderer;
+        class RenderCommandQueue;
+
+        /**
+         * @class RenderThread
+         * @brief Runs the backend side of a frame (BeginRender, the command
+         * queue, EndRender) on its own thread, so the main thread records
+         * frame N+1 while frame N is translated for the backend.
+         *
+         * The queue records into one command list while the other one is
+         * executed. Submit waits for the frame in flight, hands the recorded
+         * one over and returns right away.
+         *
+         * Creating or destroying resources and resizing are only allowed
+         * while no frame is in flight. Those paths call Sync, which waits
+         * for it; between two Submits the main thread then owns the backend.
+         *
+         * Only started on renderers that report SupportsRenderThread().
+         */
+        class RenderThread {
+        public:
+            ~RenderThread();
+
+            bool Start(Renderer* renderer);
+
+            // Finishes the frame in flight, then joins the thread
+            void Stop();
+
+            // Hands the frame recorded since the last Submit to the thread
+            void Submit();
+
+            bool IsRunning() const { return m_thread.joinable(); }
+            uint64_t GetFramesRendered() const { return m_framesRendered; }
+
+            // Waits until no frame is in flight. Returns right away when no
+            // render thread runs or when called from the render thread.
+            static void Sync();
+
+        private:
+            void Run();
+            void WaitIdle();
+
+            static std::atomic<RenderThread*> s_active;
+
+            Renderer* m_renderer = nullptr;
+            RenderCommandQueue* m_queue = nullptr;
+
+            std::thread m_thread;
+            std::mutex m_mutex;
+            std::condition_variable m_wake;   // A frame was submitted, or stop
+            std::condition_variable m_idle;   // The frame in flight finished
+            bool m_pending = false;
+            bool m_stop = false;
+
+            std::atomic<uint64_t> m_framesRendered = 0;
+        };
+    }
+}
+
+#endif // _RENDER_THREAD_HPP_
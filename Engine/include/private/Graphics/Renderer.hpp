@@ -13,7 +13,8 @@ enum class RendererType {
     Vulkan,
     OpenGL,
     DirectX11,
-    DirectX12
+    DirectX12,
+    Null        // Headless: no window or GPU, see NullRenderer
 };
 
 class ENGINE_API Renderer {
@@ -31,6 +32,10 @@ public:
 
     virtual RenderContext* GetContext() = 0;
 
+    // Whether BeginRender, the queue and EndRender may run on a thread
+    // other than the one that created the renderer (see RenderThread)
+    virtual bool SupportsRenderThread() const { return false; }
+
     inline RendererType GetType() const
     {
         return Type;
@@ -43,6 +48,7 @@ public:
             case RendererType::DirectX11: return "DirectX 11";
             case RendererType::Vulkan:    return "Vulkan";
             case RendererType::OpenGL:    return "OpenGL";
+            case RendererType::Null:      return "Null";
             default: return "Unknown!";
         }
     }
@@ -85,6 +91,53 @@ public:
         return DisplayTriangles;
     }
 
+    // Average per frame over the last metric interval
+    inline int GetStateChangesSaved() const {
+        return DisplayStateChangesSaved;
+    }
+
+    // Reported by the application after the command queue sorted a frame
+    inline void AddStateChangesSaved(int count) {
+        StateChangesSaved += count;
+    }
+
+    // Draw calls folded into instanced draws, average per frame
+    inline int GetDrawsMerged() const {
+        return DisplayDrawsMerged;
+    }
+
+    inline void AddDrawsMerged(int count) {
+        DrawsMerged += count;
+    }
+
+    // Binds dropped because the state was already bound, average per frame
+    inline int GetRedundantStateFiltered() const {
+        return DisplayRedundantStateFiltered;
+    }
+
+    inline void AddRedundantStateFiltered(int count) {
+        RedundantStateFiltered += count;
+    }
+
+    // Transform uploads replaced by the instance buffer, average per frame
+    inline int GetTransformUploadsDeferred() const {
+        return DisplayTransformUploadsDeferred;
+    }
+
+    inline void AddTransformUploadsDeferred(int count) {
+        TransformUploadsDeferred += count;
+    }
+
+    // Heap allocations the command queue made, total over the last
+    // metric interval. Stays at zero while the scene's load is steady.
+    inline int GetRenderAllocations() const {
+        return DisplayRenderAllocations;
+    }
+
+    inline void AddRenderAllocations(int count) {
+        RenderAllocations += count;
+    }
+
     inline bool GetIsPerformanceCounter() {
         return bEnabledPerformanceCounter;
     }
@@ -129,10 +182,20 @@ public:
             frameTime = (elapsed / m_frameCount) * 1000.0f; // ms per frame
             DisplayVertices = DrawnVertices;
             DisplayTriangles = DrawnTriangles;
+            DisplayStateChangesSaved = StateChangesSaved / static_cast<int>(m_frameCount);
+            DisplayDrawsMerged = DrawsMerged / static_cast<int>(m_frameCount);
+            DisplayRedundantStateFiltered = RedundantStateFiltered / static_cast<int>(m_frameCount);
+            DisplayTransformUploadsDeferred = TransformUploadsDeferred / static_cast<int>(m_frameCount);
+            DisplayRenderAllocations = RenderAllocations;
             m_frameCount = 0;
             m_frameTimer.Reset();
             DrawnVertices = 0;
             DrawnTriangles = 0;
+            StateChangesSaved = 0;
+            DrawsMerged = 0;
+            RedundantStateFiltered = 0;
+            TransformUploadsDeferred = 0;
+            RenderAllocations = 0;
         }
     }
 
@@ -146,6 +209,16 @@ public:
     int DrawnTriangles = 0;
     int DisplayVertices = 0;
     int DisplayTriangles = 0;
+    int StateChangesSaved = 0;
+    int DisplayStateChangesSaved = 0;
+    int DrawsMerged = 0;
+    int DisplayDrawsMerged = 0;
+    int RedundantStateFiltered = 0;
+    int DisplayRedundantStateFiltered = 0;
+    int TransformUploadsDeferred = 0;
+    int DisplayTransformUploadsDeferred = 0;
+    int RenderAllocations = 0;
+    int DisplayRenderAllocations = 0;
     Timer m_frameTimer;
     uint32_t m_frameCount = 0;
 
@@ -6,6 +6,7 @@
 #include <Graphics/OpenGL/OpenGLRenderer.hpp>
 #include <Graphics/DirectX/DirectX11Renderer.hpp>
 #include <Graphics/DirectX/DirectX12Renderer.hpp>
+#include <Graphics/Null/NullRenderer.hpp>
 #include <Window.hpp>
 #include <memory>
 
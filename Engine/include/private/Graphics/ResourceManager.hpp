@@ -84,7 +84,9 @@ namespace Sleak {
                 };
             }
 
-            static BufferBase* CreateBuffer(BufferType Type, uint32_t Size, void* Data);
+            // Format only applies to index buffers
+            static BufferBase* CreateBuffer(BufferType Type, uint32_t Size, void* Data,
+                                            IndexFormat Format = IndexFormat::UInt32);
             static Shader* CreateShader(const std::string& ShaderPath);
             static Sleak::Texture* CreateTexture(const std::string& TexturePath);
             static Sleak::Texture* CreateTextureFromMemory(const void* data, uint32_t width, uint32_t height, TextureFormat format);
@@ -3,6 +3,7 @@
 
 #include "../Renderer.hpp"
 #include "../RenderContext.hpp"
+#include "../FrameGraph.hpp"
 #include "Graphics/Vulkan/VulkanShader.hpp"
 #include "Graphics/Vulkan/VulkanTexture.hpp"
 #include "Logger.hpp"
@@ -61,11 +62,14 @@ public:
 
     // RenderContext interface
     virtual void Draw(uint32_t vertexCount) override;
-    virtual void DrawIndexed(uint32_t indexCount) override;
+    virtual void DrawIndexed(uint32_t indexCount, uint32_t startIndex = 0,
+                             int32_t baseVertex = 0) override;
     virtual void DrawInstance(uint32_t instanceCount,
                               uint32_t vertexPerInstance) override;
     virtual void DrawIndexedInstance(uint32_t instanceCount,
-                                     uint32_t indexPerInstance) override;
+                                     uint32_t indexPerInstance,
+                                     uint32_t startIndex = 0,
+                                     int32_t baseVertex = 0) override;
 
     virtual void SetRenderFace(RenderFace face) override;
     virtual void SetRenderMode(RenderMode mode) override;
@@ -83,6 +87,8 @@ public:
                                  uint32_t slot = 0) override;
     virtual void BindConstantBuffer(RefPtr<BufferBase> buffer,
                                     uint32_t slot = 0) override;
+    // Every slot is pushed to the same push constant range
+    virtual bool HasIndependentConstantBufferSlots() const override { return false; }
 
     virtual BufferBase* CreateBuffer(BufferType Type, uint32_t size,
                                      void* data) override;
@@ -99,6 +105,10 @@ public:
     virtual void BeginSkyboxPass() override;
     virtual void EndSkyboxPass() override;
     virtual void BindBoneBuffer(RefPtr<BufferBase> buffer) override;
+    virtual bool SupportsInstancing() const override { return m_instancingSupported; }
+    virtual bool BeginInstancedDraw(RefPtr<BufferBase> instances,
+                                    uint32_t firstInstance) override;
+    virtual void EndInstancedDraw() override;
     virtual void BeginSkinnedPass() override;
     virtual void EndSkinnedPass() override;
     virtual void BeginDebugLinePass() override;
@@ -149,6 +159,14 @@ private:
     void CleanupSwapChain();
     void CleanupDepthResources();
 
+    // Frame graph: declares the passes, then allocates the transient
+    // attachments' memory and creates their views
+    bool BuildFrameGraph();
+    void CleanupTransientMemory();
+    void RecordBarriers(const std::vector<FrameGraphBarrier>& barriers);
+    void RecordShadowPass();
+    void BeginMainPass();
+
     // MSAA resources
     bool CreateMSAAColorResources();
     void CleanupMSAAColorResources();
@@ -211,18 +229,35 @@ private:
     VulkanShader* simpleShader = nullptr;
     VkClearValue clearColor;
 
-    // Depth buffer
+    // Depth buffer (memory from the frame graph)
     VkImage depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
     VkImageView depthImageView = VK_NULL_HANDLE;
     VkFormat depthFormat;
 
-    // MSAA color buffer (multisample resolve target)
+    // MSAA color buffer (multisample resolve target, memory from the frame graph)
     VkSampleCountFlagBits m_msaaSamples = VK_SAMPLE_COUNT_1_BIT;
     VkImage m_msaaColorImage = VK_NULL_HANDLE;
-    VkDeviceMemory m_msaaColorImageMemory = VK_NULL_HANDLE;
     VkImageView m_msaaColorImageView = VK_NULL_HANDLE;
 
+    // Passes of a frame; one allocation per memory slot it compiled
+    FrameGraph m_frameGraph;
+    std::vector<VkDeviceMemory> m_transientMemory;
+
+    // How the passes access an image of the graph, for the barriers
+    // between them. Indexed by resource; images only one pass touches
+    // are left to their render pass and keep a null image.
+    struct FrameGraphImage {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageAspectFlags aspect = 0;
+        VkImageLayout writeLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags writeStage = 0;
+        VkAccessFlags writeAccess = 0;
+        VkImageLayout readLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags readStage = 0;
+        VkAccessFlags readAccess = 0;
+    };
+    std::vector<FrameGraphImage> m_frameGraphImages;
+
     // Descriptor sets for uniform buffers
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
@@ -289,8 +324,29 @@ private:
     bool m_shadowPassActive = false;
     bool m_shadowResourcesCreated = false;
 
+    // Compact vertex layout variants of the main, skinned and shadow
+    // pipelines, indexed by VertexLayout. The Standard slot stays empty:
+    // the base pipeline serves it.
+    using PipelineVariants = std::array<VkPipeline, static_cast<size_t>(VertexLayout::Count)>;
+    PipelineVariants m_mainVariants = {};
+    PipelineVariants m_skinnedVariants = {};
+    PipelineVariants m_shadowVariants = {};
+    VertexLayout m_vertexLayout = VertexLayout::Standard;   // Of the bound vertex buffer
+    bool m_skinnedPassActive = false;
+    void CreateLayoutVariants(const VkGraphicsPipelineCreateInfo& baseInfo,
+                              const VulkanShader& shader,
+                              PipelineVariants& variants,
+                              std::initializer_list<VertexLayout> layouts,
+                              bool instanced = false);
+    void DestroyLayoutVariants(PipelineVariants& variants);
+    VkPipeline GetLayoutPipeline(VkPipeline base, const PipelineVariants& variants) const;
+    bool HasLayoutPipeline() const;
+    void SetVertexLayout(VertexLayout layout);
+
     // Light VP matrix (stored as raw floats for push constant computation)
     float m_lightVP[16] = {};
+    // Pushes {LightVP * World, World} for the shadow pipeline
+    void PushShadowTransform(const float* world);
 
     // Light/Shadow UBO (set 2, binding 0)
     VkDescriptorSetLayout m_lightUBODescriptorSetLayout = VK_NULL_HANDLE;
@@ -305,6 +361,20 @@ private:
     VkDescriptorPool m_shadowSamplerDescriptorPool = VK_NULL_HANDLE;
     std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> m_shadowSamplerDescriptorSets = {};
     bool m_lightUBOCreated = false;
+
+    // Instanced draws: main pipeline variants with INSTANCED (constant_id 1)
+    // set, one per layout including Standard, reading WVP/World pairs from
+    // the queue's instance buffer (set 4, binding 0) by instance index
+    PipelineVariants m_instancedVariants = {};
+    bool m_instancingSupported = false;     // default_shader.vert.spv has INSTANCED
+    VkDescriptorSetLayout m_instanceDescriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool m_instanceDescriptorPool = VK_NULL_HANDLE;
+    std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> m_instanceDescriptorSets = {};
+    std::array<VkBuffer, MAX_FRAMES_IN_FLIGHT> m_instanceSetBuffers = {};   // What each set points at
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> m_instanceSetBound = {};        // Bound this frame, no rewrites
+    uint32_t m_firstInstance = 0;
+    bool m_instancedDrawActive = false;
+    bool CreateInstanceDescriptorSets();
 };
 
 }  // namespace RenderEngine
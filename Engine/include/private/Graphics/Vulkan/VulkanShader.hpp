@@ -24,6 +24,12 @@ public:
     inline VkPipelineShaderStageCreateInfo GetVertexInfo() { return vertexInfo;}
     inline VkPipelineShaderStageCreateInfo GetFragInfo() { return fragmentInfo;}
 
+    // What the vertex module declares: specialization constant ids and the
+    // attribute locations it reads. Binaries built from older sources differ
+    // from the current ones until glslc rebuilds them.
+    bool HasVertexSpecConstant(uint32_t id) const;
+    const std::vector<uint32_t>& GetVertexInputs() const { return vertexInputs; }
+
 private:
     VkDevice device = nullptr;
     VkShaderModule vertShader = nullptr;
@@ -31,9 +37,12 @@ private:
 
     VkPipelineShaderStageCreateInfo vertexInfo{};
     VkPipelineShaderStageCreateInfo fragmentInfo{};
+    std::vector<uint32_t> vertexSpecIds;
+    std::vector<uint32_t> vertexInputs;
 
     VkShaderModule createShaderModule(const std::vector<char>& code);
     std::vector<char> ReadFile(const std::string& path);
+    void ReflectVertex(const std::vector<char>& code);
 
 };
 
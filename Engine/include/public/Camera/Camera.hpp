@@ -67,6 +67,11 @@ namespace Sleak {
             return Camera::s_frustum;
         }
 
+        // Bumped whenever the main view or projection matrix changes value
+        static uint64_t GetMainVersion() {
+            return Camera::s_version;
+        }
+
     protected:
         void RecalculateViewMatrix();
         void RecalculateProjectionMatrix();
@@ -87,6 +92,7 @@ namespace Sleak {
         static Math::Matrix4 Projection;
         static Math::Vector3D MainPosition;
         static ViewFrustum s_frustum;
+        static uint64_t s_version;
     };
 }
 
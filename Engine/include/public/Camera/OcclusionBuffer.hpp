@@ -0,0 +1,97 @@
+#ifndef _OCCLUSION_BUFFER_HPP_
+#define _OCCLUSION_BUFFER_HPP_
+
+#include <Core/OSDef.hpp>
+#include <Math/Matrix.hpp>
+#include <Physics/Colliders.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Sleak {
+
+    /**
+     * @class OcclusionBuffer
+     * @brief Low-resolution CPU depth buffer for occlusion culling.
+     *
+     * Occluder triangles are transformed, clipped against the near plane
+     * and binned into screen tiles. Rasterize then fills the tiles in
+     * parallel on the JobSystem and builds a min-depth hierarchy (HiZ)
+     * over the result, so IsVisible can test a box against a handful of
+     * texels whatever its size on screen.
+     *
+     * Depth is stored as 1/w: it interpolates linearly in screen space and
+     * does not depend on the projection's depth range. Larger is nearer,
+     * cleared to 0. With an orthographic projection w is constant and
+     * nothing is ever reported occluded.
+     *
+     * Usage per frame: Begin, AddOccluder for each occluder, Rasterize,
+     * then IsVisible for each candidate.
+     */
+    class ENGINE_API OcclusionBuffer {
+    public:
+        static constexpr uint32_t TILE_WIDTH = 64;
+        static constexpr uint32_t TILE_HEIGHT = 32;
+
+        // Multiples of the tile size
+        OcclusionBuffer(uint32_t width = 256, uint32_t height = 128);
+
+        // Clears depth and the bins; viewProjection maps world to clip (row vectors)
+        void Begin(const Math::Matrix4& viewProjection);
+
+        // positions: xyz triples in object space, three indices per triangle
+        void AddOccluder(const float* positions, uint32_t vertexCount,
+                         const uint32_t* indices, uint32_t indexCount,
+                         const Math::Matrix4& world);
+
+        void Rasterize();
+
+        // False only when every pixel the box covers has an occluder in front of it
+        bool IsVisible(const Physics::AABB& worldBounds) const;
+
+        uint32_t GetWidth() const { return m_width; }
+        uint32_t GetHeight() const { return m_height; }
+        uint32_t GetTriangleCount() const { return static_cast<uint32_t>(m_triangles.size()); }
+
+        // 1/w of the nearest occluder at a pixel, 0 when empty
+        float GetDepth(uint32_t x, uint32_t y) const { return m_depth[y * m_width + x]; }
+
+    private:
+        struct ClipVertex {
+            float x, y, z, w;
+        };
+
+        // Edge functions e(x, y) = a * x + b * y + c, >= 0 inside, and the depth plane
+        struct Triangle {
+            float edgeA[3], edgeB[3], edgeC[3];
+            float depthA, depthB, depthC;
+            int minX, minY, maxX, maxY;
+        };
+
+        void AddTriangle(const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2);
+        void SetupTriangle(const ClipVertex* vertices);
+        void RasterizeTile(uint32_t tile);
+        void BuildTileHiZ(uint32_t tile);
+        void BuildCoarseHiZ();
+
+        const float* Level(uint32_t level) const { return m_depth.data() + m_levelOffsets[level]; }
+        float* Level(uint32_t level) { return m_depth.data() + m_levelOffsets[level]; }
+
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_tilesX;
+        uint32_t m_tilesY;
+        uint32_t m_tileLevels;              // HiZ levels built inside each tile
+
+        // Level 0 (the depth buffer) followed by each HiZ level
+        std::vector<float> m_depth;
+        std::vector<uint32_t> m_levelOffsets;
+
+        Math::Matrix4 m_viewProjection;
+        std::vector<ClipVertex> m_clipVertices;
+        std::vector<Triangle> m_triangles;
+        std::vector<std::vector<uint32_t>> m_bins;      // Triangle indices per tile
+    };
+
+}
+
+#endif // _OCCLUSION_BUFFER_HPP_
@@ -4,6 +4,8 @@
 #include <Math/Matrix.hpp>
 #include <Math/Vector.hpp>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace Sleak {
 
@@ -89,6 +91,59 @@ public:
         }
         return true;
     }
+
+    enum class Containment { Outside, Intersecting, Inside };
+    static constexpr uint32_t ALL_PLANES = (1u << COUNT) - 1;
+
+    // Hierarchical form of IsAABBVisible. planeMask holds the planes the
+    // box still has to be tested against; planes it lies fully in front of
+    // are cleared, so boxes nested in it can skip them. An empty mask means
+    // Inside without any test.
+    Containment ClassifyAABB(const Math::Vector3D& min, const Math::Vector3D& max,
+                             uint32_t& planeMask) const {
+        for (int i = 0; i < COUNT; ++i) {
+            if (!(planeMask & (1u << i))) continue;
+            const Plane& plane = planes[i];
+
+            float px = (plane.a >= 0.0f) ? max.GetX() : min.GetX();
+            float py = (plane.b >= 0.0f) ? max.GetY() : min.GetY();
+            float pz = (plane.c >= 0.0f) ? max.GetZ() : min.GetZ();
+            if (plane.a * px + plane.b * py + plane.c * pz + plane.d < 0.0f)
+                return Containment::Outside;
+
+            // Negative vertex in front too: the whole box is
+            float nx = (plane.a >= 0.0f) ? min.GetX() : max.GetX();
+            float ny = (plane.b >= 0.0f) ? min.GetY() : max.GetY();
+            float nz = (plane.c >= 0.0f) ? min.GetZ() : max.GetZ();
+            if (plane.a * nx + plane.b * ny + plane.c * nz + plane.d >= 0.0f)
+                planeMask &= ~(1u << i);
+        }
+        return planeMask ? Containment::Intersecting : Containment::Inside;
+    }
+
+    // Same test for count AABBs stored as separate coordinate arrays.
+    // Runs plane by plane over all boxes: the positive vertex choice only
+    // depends on the plane, so the inner loop is branch-free and the
+    // compiler can test several boxes per instruction. visible[i] is set
+    // to 1 or 0.
+    void TestAABBs(const float* minX, const float* minY, const float* minZ,
+                   const float* maxX, const float* maxY, const float* maxZ,
+                   size_t count, uint8_t* visible) const {
+        for (size_t i = 0; i < count; ++i)
+            visible[i] = 1;
+
+        for (int p = 0; p < COUNT; ++p) {
+            const Plane& plane = planes[p];
+            const float* xs = plane.a >= 0.0f ? maxX : minX;
+            const float* ys = plane.b >= 0.0f ? maxY : minY;
+            const float* zs = plane.c >= 0.0f ? maxZ : minZ;
+
+            for (size_t i = 0; i < count; ++i) {
+                float distance = plane.a * xs[i] + plane.b * ys[i] + plane.c * zs[i] + plane.d;
+                visible[i] &= static_cast<uint8_t>(distance >= 0.0f);
+            }
+        }
+    }
 };
 
 } // namespace Sleak
@@ -3,6 +3,7 @@
 
 #include <Core/OSDef.hpp>
 #include <GameBase.hpp>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <Events/ApplicationEvent.h>
@@ -50,7 +51,7 @@ struct ENGINE_API ApplicationDefaults {
 
 class Window;
 class DebugOverlay;
-namespace RenderEngine { class Renderer; }
+namespace RenderEngine { class Renderer; class RenderThread; }
 
 class ENGINE_API Application {
    public:
@@ -62,6 +63,15 @@ class ENGINE_API Application {
 
     int Run(GameBase* game);
 
+    // Ends the main loop after the current frame
+    void Quit() { m_quitRequested = true; }
+
+    // True when running with the Null renderer: no window, no GPU
+    bool IsHeadless() const { return m_headless; }
+    // True while frames execute on a dedicated render thread
+    bool IsRenderThreaded() const { return m_renderThread != nullptr; }
+    uint64_t GetFrameCount() const { return m_frameCount; }
+
     Window& GetWindow();
 
     RenderEngine::Renderer* GetRenderer() { return renderer; }
@@ -76,12 +86,33 @@ class ENGINE_API Application {
     void onMouseClick(const Sleak::Events::Input::MouseButtonPressedEvent& e);
 
    private:
+    int RunHeadless();
+    bool BeginGame();
+    void StartRenderThread();
+    void BeginFrame();
+    void UpdateFrame(float deltaTime);
+    void EndFrame();
+    bool ShouldStop() const;
+
     ApplicationDefaults Specification;
     Window* CoreWindow;
     GameBase* Game;
     RenderEngine::Renderer* renderer;
     DebugOverlay* m_DebugOverlay = nullptr;
+    RenderEngine::RenderThread* m_renderThread = nullptr;
     float DeltaTime;
+    float m_accumulator = 0.0f;
+
+    bool m_headless = false;
+    bool m_quitRequested = false;
+    bool m_renderThreadRequested = false;
+    float m_headlessStep = 1.0f / 60.0f;
+    uint64_t m_frameLimit = 0;
+    uint64_t m_frameCount = 0;
+
+    std::string m_captureFile;
+    uint64_t m_captureStart = 0;
+    uint32_t m_captureFrames = 1;
 
     Timer FrameTimer;
 
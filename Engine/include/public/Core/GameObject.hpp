@@ -4,74 +4,132 @@
 #include "Object.hpp"
 #include <Logger.hpp>
 #include <ECS/Component.hpp>
+#include <ECS/ComponentStorage.hpp>
 #include <Utility/Container/List.hpp>
 #include <Memory/RefPtr.h>
+#include <Memory/Handle.h>
 #include <type_traits>
 #include <string>
 
 namespace Sleak {
     namespace Math {class Vector3D;};
+    class SceneBase;
+    class GameObject;
+
+    using GameObjectHandle = Handle<GameObject>;
+
     class ENGINE_API GameObject : public Object {
     public:
-        GameObject(const std::string& name = "GameObject")
-            : Object(name), m_isActive(true), bIsInitialized(false),
-              m_pendingDestroy(false), m_parent(nullptr) {}
+        GameObject(const std::string& name = "GameObject");
 
         ~GameObject() override;
 
+        // Objects (and subclasses) live in the pooled ObjectAllocator
+        static void* operator new(size_t size);
+        static void operator delete(void* memory, size_t size);
+
+        // --- Handles ---
+
+        // Stays valid for the object's lifetime; never reused afterwards
+        GameObjectHandle GetHandle() const { return m_handle; }
+
+        // nullptr when the object was destroyed
+        static GameObject* Resolve(GameObjectHandle handle);
+
         // --- Component management ---
 
         template<typename T, typename... Args>
         void AddComponent(Args&&... args) {
             static_assert(std::is_base_of<Component, T>::value, "T must derive from Component!");
 
-            if (GetComponent<T>() != nullptr) {
+            ComponentTypeID type = ComponentTypeRegistry::Get<T>();
+            if (m_componentMask & ComponentTypeRegistry::MaskOf(type)) {
                 SLEAK_WARN("The component already exists!");
                 return;
             }
 
-            RefPtr<Component> newComponent = RefPtr<T>(new T(this, std::forward<Args>(args)...));
-            if (bIsInitialized) newComponent->Initialize();
-            if (m_isActive && bIsInitialized) newComponent->OnEnable();
-            Components.add(std::move(newComponent));
+            auto& storage = ComponentStorage::Get();
+            auto allocation = storage.GetPool<T>().Create(this, std::forward<Args>(args)...);
+
+            ComponentTypeRegistry::Classify(type, allocation.component);
+            m_componentSlots[type] = static_cast<uint8_t>(Components.GetSize());
+            m_componentMask |= ComponentTypeRegistry::MaskOf(type);
+            Components.add({type, allocation.index, allocation.component});
+            storage.Attach(this, type, allocation.component);
+
+            if (bIsInitialized) allocation.component->Initialize();
+            if (m_isActive && bIsInitialized) allocation.component->OnEnable();
         }
 
         template<typename T>
         void RemoveComponent() {
             static_assert(std::is_base_of<Component, T>::value, "T must derive from Component!");
 
-            for (size_t i = 0; i < Components.GetSize(); ++i) {
-                if (dynamic_cast<T*>(Components[i].get()) != nullptr) {
-                    Components[i]->OnDestroy();
-                    Components.erase(i);
-                    break;
-                }
-            }
+            ComponentTypeID type = ComponentTypeRegistry::Get<T>();
+            if (!(m_componentMask & ComponentTypeRegistry::MaskOf(type))) return;
+
+            size_t slot = m_componentSlots[type];
+            ComponentRecord record = Components[slot];
+            record.component->OnDestroy();
+
+            Components.erase(slot);
+            m_componentMask &= ~ComponentTypeRegistry::MaskOf(type);
+            for (size_t i = slot; i < Components.GetSize(); ++i)
+                m_componentSlots[Components[i].type] = static_cast<uint8_t>(i);
+
+            ComponentStorage::Get().Detach(this, type);
+            ComponentStorage::Get().GetPool(type)->Destroy(record.poolIndex);
         }
 
+        // Exact type first: one bit test and one slot table read. A non-final
+        // T also matches components that derive from it
+        // (GetComponent<CameraController>() finds a FirstPersonController);
+        // a miss is still a single mask test
         template <typename T>
         T* GetComponent() {
             static_assert(std::is_base_of_v<Component, T>,
                           "T must derive from Component!");
 
-            for (size_t i = 0; i < Components.GetSize(); ++i) {
-                Component* rawPtr = Components[i].get();
-                if (!rawPtr) continue;
-
-                T* component = dynamic_cast<T*>(rawPtr);
-                if (component) return component;
+            ComponentTypeID type = ComponentTypeRegistry::Get<T>();
+            if (m_componentMask & ComponentTypeRegistry::MaskOf(type))
+                return static_cast<T*>(Components[m_componentSlots[type]].component);
+
+            if constexpr (!std::is_final_v<T>) {
+                const ComponentMask derived = m_componentMask & ComponentTypeRegistry::DerivedMaskOf<T>();
+                if (derived) {
+                    for (size_t i = 0; i < Components.GetSize(); ++i) {
+                        if (derived & ComponentTypeRegistry::MaskOf(Components[i].type))
+                            return static_cast<T*>(Components[i].component);
+                    }
+                }
             }
-
             return nullptr;
         }
 
+        // Null handle when T is not attached
         template <typename T>
-        bool HasComponent() {
+        Handle<T> GetComponentHandle() const {
+            ComponentTypeID type = ComponentTypeRegistry::Get<T>();
+            if (!(m_componentMask & ComponentTypeRegistry::MaskOf(type)))
+                return {};
+
+            return ComponentStorage::Get().GetPool<T>().GetHandle(
+                Components[m_componentSlots[type]].poolIndex);
+        }
+
+        // Matches derived components like GetComponent
+        template <typename T>
+        bool HasComponent() const {
             static_assert(std::is_base_of_v<Component, T>,
                           "T must derive from Component!");
-            return GetComponent<T>() != nullptr;
+            if constexpr (std::is_final_v<T>)
+                return (m_componentMask & ComponentTypeRegistry::MaskOf(ComponentTypeRegistry::Get<T>())) != 0;
+            else
+                return (m_componentMask & ComponentTypeRegistry::DerivedMaskOf<T>()) != 0;
         }
 
+        ComponentMask GetComponentMask() const { return m_componentMask; }
+
         // --- Lifecycle ---
 
         virtual void Initialize();
@@ -82,9 +140,12 @@ namespace Sleak {
         void SetActive(bool active);
         bool IsActive() const { return m_isActive; }
 
+        // Renaming keeps the owning scene's name index current
+        void SetName(const std::string& value) override;
+
         // --- Tag system ---
 
-        void SetTag(const std::string& tag) { m_tag = tag; }
+        void SetTag(const std::string& tag);
         const std::string& GetTag() const { return m_tag; }
 
         // --- Parent-child hierarchy ---
@@ -106,6 +167,22 @@ namespace Sleak {
         void MarkForDestroy() { m_pendingDestroy = true; }
         bool IsPendingDestroy() const { return m_pendingDestroy; }
 
+        // Set by the scene's CullingSystem when the object's mesh is outside
+        // the view, and kept set while a static batch draws the mesh: its
+        // transform, material and mesh submit nothing
+        void SetCulled(bool culled) { m_culled = culled; }
+        bool IsCulled() const { return m_culled; }
+
+        // Geometry that never moves. Set before the scene activates, its
+        // mesh is merged into the scene's static batches; later changes to
+        // the transform, material or mesh are not reflected.
+        void SetStatic(bool isStatic) { m_static = isStatic; }
+        bool IsStatic() const { return m_static; }
+
+        // --- Scene membership ---
+
+        SceneBase* GetScene() const { return m_scene; }
+
         // --- Factory methods ---
 
         static GameObject* CreatePlane(Math::Vector3D position, int width = 100, int height = 100);
@@ -119,17 +196,47 @@ namespace Sleak {
         bool bIsInitialized;
 
     private:
+        friend class ComponentStorage;
+        friend class SceneBase;
+
+        // Components in insertion order (drives per-object update order)
+        struct ComponentRecord {
+            ComponentTypeID type = INVALID_COMPONENT_TYPE;
+            uint32_t poolIndex = 0;
+            Component* component = nullptr;
+        };
+
         bool m_isActive;
         bool m_pendingDestroy;
+        bool m_culled = false;
+        bool m_static = false;
         std::string m_tag = "Untagged";
+        SceneBase* m_scene = nullptr;
+        GameObjectHandle m_handle;
+
+        // Scene index bookkeeping
+        uint64_t m_sceneOrder = 0;     // insertion order within the scene
+        uint32_t m_sceneSlot = 0;      // index in the scene's object list
+        uint32_t m_tagSlot = 0;        // position in the scene's tag set
+        bool m_pendingAdd = false;     // recorded mid-update, not inserted yet
+
+        List<ComponentRecord> Components;
+
+        // Bit per owned component type, and type ID -> index into Components
+        ComponentMask m_componentMask = 0;
+        uint8_t m_componentSlots[MAX_COMPONENT_TYPES] = {};
 
-        List<RefPtr<Component>> Components;
+        // Location of this object's row in the component archetype tables
+        Archetype* m_archetype = nullptr;
+        uint32_t m_archetypeRow = 0;
 
         // Hierarchy
         GameObject* m_parent;
         List<GameObject*> m_children;
 
         void DestroyComponents();
+        void SetSceneRecursive(SceneBase* scene);
+        void OnParentChanged();
     };
 }
 
@@ -0,0 +1,129 @@
+#ifndef _JOBSYSTEM_HPP_
+#define _JOBSYSTEM_HPP_
+
+#include <Core/OSDef.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Sleak {
+
+    struct Job;
+
+    using JobFunction = std::function<void()>;
+
+    enum class JobAffinity {
+        Any,        // Any worker (or the main thread while it waits)
+        MainThread  // Only run by the main thread (window, GPU API calls...)
+    };
+
+    /**
+     * @class JobCounter
+     * @brief Tracks a group of jobs. Reaches zero when all of them finished.
+     *
+     * Pass the same counter to several Schedule calls, then Wait on it, or
+     * use it as the dependency of follow-up jobs. A counter must outlive
+     * every job scheduled against it.
+     */
+    class ENGINE_API JobCounter {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+        uint32_t GetPending() const { return m_pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_pending{0};
+
+        // Jobs waiting for this counter to reach zero
+        std::mutex m_lock;
+        std::vector<Job*> m_continuations;
+    };
+
+    /**
+     * @class JobSystem
+     * @brief Work-stealing thread pool shared by the whole engine.
+     *
+     * Every worker owns a deque: it pushes and pops its own jobs LIFO and
+     * steals from the other deques FIFO when it runs dry. The main thread
+     * owns deque 0 and helps out while it waits on a counter. Jobs with
+     * JobAffinity::MainThread go to a separate queue that only the main
+     * thread drains (RunMainThreadJobs, or Wait on the main thread).
+     *
+     * When the system is not initialized every call runs inline, so code
+     * using it still works in tools or single-threaded builds.
+     */
+    class ENGINE_API JobSystem {
+    public:
+        // workerCount 0 uses one worker per hardware thread minus the main one
+        static void Initialize(uint32_t workerCount = 0);
+        static void Shutdown();
+
+        static bool IsInitialized() { return Instance != nullptr; }
+        static bool IsMainThread();
+        static uint32_t GetWorkerCount();
+
+        static void Schedule(JobFunction function, JobCounter* counter = nullptr,
+                             JobAffinity affinity = JobAffinity::Any);
+
+        // Runs function once dependency reaches zero
+        static void ScheduleAfter(JobCounter* dependency, JobFunction function,
+                                  JobCounter* counter = nullptr,
+                                  JobAffinity affinity = JobAffinity::Any);
+
+        // Executes other jobs until the counter reaches zero
+        static void Wait(JobCounter* counter);
+
+        /**
+         * Splits [0, count) into ranges of at most grainSize and calls
+         * fn(begin, end) for each range across the workers. Blocks until
+         * every range is done.
+         */
+        static void ParallelFor(uint32_t count, uint32_t grainSize,
+                                const std::function<void(uint32_t, uint32_t)>& fn);
+
+        // Drains jobs scheduled with JobAffinity::MainThread
+        static void RunMainThreadJobs();
+
+    private:
+        struct WorkerQueue {
+            std::mutex lock;
+            std::deque<Job*> jobs;
+        };
+
+        JobSystem(uint32_t workerCount);
+        ~JobSystem();
+
+        void WorkerLoop(uint32_t index);
+        void Push(Job* job);
+        Job* PopOrSteal(uint32_t index);
+        Job* PopMainThread();
+        void Execute(Job* job);
+        void Finish(JobCounter* counter);
+
+        std::vector<std::thread> m_workers;
+        std::vector<WorkerQueue*> m_queues;     // [0] = main thread
+
+        std::mutex m_mainThreadLock;
+        std::deque<Job*> m_mainThreadJobs;
+
+        std::mutex m_sleepLock;
+        std::condition_variable m_wake;
+        std::atomic<uint32_t> m_queued{0};
+        std::atomic<bool> m_running{true};
+
+        static JobSystem* Instance;
+    };
+
+}
+
+#endif // _JOBSYSTEM_HPP_
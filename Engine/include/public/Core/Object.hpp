@@ -21,7 +21,7 @@ namespace Sleak {
 
         const std::string& GetName() const { return m_name; }
 
-        inline void SetName(const std::string& value) { m_name = value; }
+        virtual void SetName(const std::string& value) { m_name = value; }
 
     private:
         std::string m_name;
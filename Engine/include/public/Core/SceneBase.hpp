@@ -2,10 +2,18 @@
 #define _SCENE_BASE_HPP_
 
 #include <string>
+#include <string_view>
+#include <span>
+#include <unordered_map>
 #include <Memory/RefPtr.h>
 #include <Core/OSDef.hpp>
 #include <Utility/Container/List.hpp>
 #include <Memory/ObjectPtr.h>
+#include <ECS/SystemScheduler.hpp>
+#include <ECS/TransformHierarchy.hpp>
+#include <ECS/CullingSystem.hpp>
+#include <ECS/StaticBatcher.hpp>
+#include <vector>
 
 namespace Sleak {
 
@@ -23,14 +31,13 @@ namespace Sleak {
     class LightManager;
     class Skybox;
     class ColliderComponent;
+    class AnimatorComponent;
 
     namespace Physics { class PhysicsWorld; }
 
     class ENGINE_API SceneBase {
     public:
-        explicit SceneBase(const std::string& name)
-            : name(name), state(SceneState::Unloaded),
-              bInitialized(false), bActive(false) {}
+        explicit SceneBase(const std::string& name);
 
         virtual ~SceneBase();
 
@@ -65,18 +72,30 @@ namespace Sleak {
         void Pause();
         void Resume();
 
-        // Object management — scene takes ownership of added objects
+        // Object management — scene takes ownership of added objects.
+        // During Update / FixedUpdate / LateUpdate, adds and removals are
+        // recorded and applied in one batch when the phase ends.
         virtual void AddObject(GameObject* object);
         virtual void RemoveObject(GameObject* object);
         void DestroyObject(GameObject* object);
+
+        // Unordered: removal moves the last object into the freed slot
         const List<GameObject*>& GetObjects() const { return Objects; }
 
-        // Object queries
+        // Object queries (hash lookups, kept current by the index below)
         GameObject* FindObjectByName(const std::string& name);
         GameObject* FindObjectByID(uint64_t id);
         List<GameObject*> FindObjectsByTag(const std::string& tag);
         size_t GetObjectCount() const { return Objects.GetSize(); }
 
+        // Non-allocating view of every object with the tag, in no particular
+        // order. Invalidated by any add, remove or retag.
+        std::span<GameObject* const> GetObjectsWithTag(std::string_view tag) const;
+
+        // Called by GameObject::SetName / SetTag to keep the indices current
+        void OnObjectRenamed(GameObject* object, const std::string& oldName);
+        void OnObjectRetagged(GameObject* object, const std::string& oldTag);
+
         Camera* GetDebugCamera() const {
             return DebugCamera.IsValid() ? DebugCamera.get()
                                          : nullptr;
@@ -93,6 +112,19 @@ namespace Sleak {
         void SetSkybox(Skybox* skybox);
         Skybox* GetSkybox() const { return m_skybox; }
 
+        // Update systems; games may add their own with declared access
+        SystemScheduler& GetScheduler() { return m_scheduler; }
+        const SystemScheduler& GetScheduler() const { return m_scheduler; }
+
+        // Cached world matrices, refreshed at the start of Update
+        TransformHierarchy& GetTransformHierarchy() { return m_transformHierarchy; }
+
+        // Frustum culling of the scene's meshes, run after the transforms
+        CullingSystem& GetCullingSystem() { return m_culling; }
+
+        // Static meshes merged when the scene first activates
+        StaticBatcher& GetStaticBatcher() { return m_staticBatcher; }
+
     protected:
         std::string name;
         SceneState state;
@@ -100,7 +132,11 @@ namespace Sleak {
         bool bActive;
 
         List<GameObject*> Objects;
+
+        // Structural changes recorded while a phase is running
+        List<GameObject*> m_pendingAdd;
         List<GameObject*> m_pendingDestroy;
+        bool m_inUpdate = false;
 
         ObjectPtr<Camera> DebugCamera;
 
@@ -108,11 +144,47 @@ namespace Sleak {
         Physics::PhysicsWorld* m_physicsWorld = nullptr;
         Skybox* m_skybox = nullptr;
 
+        SystemScheduler m_scheduler;
+        TransformHierarchy m_transformHierarchy;
+        CullingSystem m_culling;
+        StaticBatcher m_staticBatcher;
+
+        void FlushPendingAdds();
         void ProcessPendingDestroy();
         void DestroyAllObjects();
 
     private:
         void InitializeDebugCamera();
+        void RegisterDefaultSystems();
+        void PrepareAnimationSystems();
+        void DrawDebugColliders();
+
+        // Animators evaluated by the scheduler this frame
+        std::vector<AnimatorComponent*> m_animators;
+
+        // --- Object indices ---
+
+        struct StringHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view value) const {
+                return std::hash<std::string_view>{}(value);
+            }
+        };
+
+        template <typename V>
+        using StringMap = std::unordered_map<std::string, V, StringHash, std::equal_to<>>;
+
+        void InsertObject(GameObject* object);
+        void SwapRemoveObject(GameObject* object);
+
+        void IndexObject(GameObject* object);
+        void UnindexObject(GameObject* object);
+        bool IsIndexed(const GameObject* object) const;
+
+        std::unordered_map<uint64_t, GameObject*> m_idIndex;
+        StringMap<std::vector<GameObject*>> m_nameIndex;   // each bucket in scene order
+        StringMap<std::vector<GameObject*>> m_tagIndex;    // dense, swap-remove
+        uint64_t m_nextSceneOrder = 0;
     };
 
 } // namespace Sleak
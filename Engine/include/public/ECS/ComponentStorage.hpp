@@ -0,0 +1,399 @@
+#ifndef _COMPONENT_STORAGE_HPP_
+#define _COMPONENT_STORAGE_HPP_
+
+#include <Core/OSDef.hpp>
+#include <ECS/Component.hpp>
+#include <Memory/Handle.h>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace Sleak {
+
+    class GameObject;
+
+    class TransformComponent;
+    class MeshComponent;
+    class MaterialComponent;
+    class AnimatorComponent;
+    class ColliderComponent;
+    class RigidbodyComponent;
+    class CameraController;
+    class FirstPersonController;
+    class FreeLookCameraController;
+    class OccluderComponent;
+
+    using ComponentTypeID = uint32_t;
+    using ComponentMask = uint64_t;
+
+    static constexpr ComponentTypeID INVALID_COMPONENT_TYPE = 0xFFFFFFFF;
+
+    // One bit per type in ComponentMask
+    static constexpr ComponentTypeID MAX_COMPONENT_TYPES = 64;
+
+    // Number of components packed into one pool chunk (one bit per slot)
+    static constexpr uint32_t COMPONENT_CHUNK_CAPACITY = 64;
+
+    /**
+     * Engine components get fixed IDs known at compile time. Keep the list
+     * dense; BUILTIN_COMPONENT_COUNT must be one past the last entry.
+     */
+    template <typename T>
+    struct BuiltinComponentID {
+        static constexpr ComponentTypeID value = INVALID_COMPONENT_TYPE;
+    };
+
+#define SLEAK_BUILTIN_COMPONENT(Type, ID)                           \
+    template <>                                                     \
+    struct BuiltinComponentID<Type> {                               \
+        static constexpr ComponentTypeID value = ID;                \
+    };
+
+    SLEAK_BUILTIN_COMPONENT(TransformComponent, 0)
+    SLEAK_BUILTIN_COMPONENT(MeshComponent, 1)
+    SLEAK_BUILTIN_COMPONENT(MaterialComponent, 2)
+    SLEAK_BUILTIN_COMPONENT(AnimatorComponent, 3)
+    SLEAK_BUILTIN_COMPONENT(ColliderComponent, 4)
+    SLEAK_BUILTIN_COMPONENT(RigidbodyComponent, 5)
+    SLEAK_BUILTIN_COMPONENT(CameraController, 6)
+    SLEAK_BUILTIN_COMPONENT(FirstPersonController, 7)
+    SLEAK_BUILTIN_COMPONENT(FreeLookCameraController, 8)
+    SLEAK_BUILTIN_COMPONENT(OccluderComponent, 9)
+
+#undef SLEAK_BUILTIN_COMPONENT
+
+    static constexpr ComponentTypeID BUILTIN_COMPONENT_COUNT = 10;
+
+    /**
+     * @class ComponentTypeRegistry
+     * @brief Hands out a small dense integer ID per Component subclass.
+     *
+     * Engine components resolve to a constant. Other (game) components are
+     * registered on first use, keyed by std::type_index inside the engine
+     * library so the engine and the game module agree on the same ID.
+     *
+     * Lookups by a base class (GetComponent<CameraController>() finding a
+     * FirstPersonController) need no declarations. The first lookup of a
+     * non-final type tracks it; every concrete type is tested against the
+     * tracked types once, with dynamic_cast on one of its instances, and
+     * the result is kept as a mask of the concrete types deriving from each.
+     */
+    class ENGINE_API ComponentTypeRegistry {
+    public:
+        using InstanceTest = bool (*)(const Component*);
+
+        static ComponentTypeID Register(const std::type_index& type);
+
+        template <typename T>
+        static ComponentTypeID Get() {
+            if constexpr (BuiltinComponentID<T>::value != INVALID_COMPONENT_TYPE) {
+                return BuiltinComponentID<T>::value;
+            } else {
+                static const ComponentTypeID id = Register(typeid(T));
+                return id;
+            }
+        }
+
+        static constexpr ComponentMask MaskOf(ComponentTypeID type) {
+            return ComponentMask(1) << type;
+        }
+
+        // Concrete types attached so far that are a T, T's own bit included
+        template <typename T>
+        static ComponentMask DerivedMaskOf() {
+            static const ComponentTypeID type = Track(Get<T>(), &IsInstance<T>);
+            return DerivedMask(type);
+        }
+
+        // Tests a component of a concrete type against the tracked types the
+        // type was not tested against yet. AddComponent calls it before attaching.
+        static void Classify(ComponentTypeID type, const Component* component);
+
+    private:
+        template <typename T>
+        static bool IsInstance(const Component* component) {
+            return dynamic_cast<const T*>(component) != nullptr;
+        }
+
+        static ComponentTypeID Track(ComponentTypeID type, InstanceTest test);
+        static ComponentMask DerivedMask(ComponentTypeID type);
+    };
+
+    class ComponentPoolBase {
+    public:
+        virtual ~ComponentPoolBase() = default;
+
+        virtual void Destroy(uint32_t index) = 0;
+        virtual size_t GetCount() const = 0;
+    };
+
+    /**
+     * @class ComponentPool
+     * @brief Stores every component of one type contiguously in fixed-size
+     * chunks.
+     *
+     * Chunks are never moved or shrunk, so a component keeps its address for
+     * its whole life and raw pointers handed out by GetComponent stay valid.
+     * Freed slots are reused before a new chunk is allocated; each reuse
+     * bumps the slot's generation so old Handle<T>s stop resolving.
+     */
+    template <typename T>
+    class ComponentPool : public ComponentPoolBase {
+        struct Chunk {
+            alignas(T) unsigned char storage[sizeof(T) * COMPONENT_CHUNK_CAPACITY];
+            uint64_t occupied = 0;  // bit i set when slot i holds a live T
+            uint32_t generations[COMPONENT_CHUNK_CAPACITY];
+
+            Chunk() {
+                for (uint32_t& generation : generations) generation = 1;
+            }
+
+            T* Slot(uint32_t i) {
+                return std::launder(reinterpret_cast<T*>(storage + sizeof(T) * i));
+            }
+        };
+
+    public:
+        struct Allocation {
+            T* component = nullptr;
+            uint32_t index = 0;     // chunk * COMPONENT_CHUNK_CAPACITY + slot
+            uint32_t generation = 0;
+        };
+
+        ComponentPool() = default;
+        ComponentPool(const ComponentPool&) = delete;
+        ComponentPool& operator=(const ComponentPool&) = delete;
+
+        ~ComponentPool() override {
+            for (Chunk* chunk : m_chunks) {
+                for (uint32_t i = 0; i < COMPONENT_CHUNK_CAPACITY; ++i) {
+                    if (chunk->occupied & (uint64_t(1) << i))
+                        chunk->Slot(i)->~T();
+                }
+                delete chunk;
+            }
+        }
+
+        template <typename... Args>
+        Allocation Create(Args&&... args) {
+            uint32_t chunkIndex = m_firstFreeChunk;
+            while (chunkIndex < m_chunks.size() &&
+                   m_chunks[chunkIndex]->occupied == ~uint64_t(0)) {
+                ++chunkIndex;
+            }
+            if (chunkIndex == m_chunks.size())
+                m_chunks.push_back(new Chunk());
+
+            Chunk* chunk = m_chunks[chunkIndex];
+            uint32_t slot = FirstFreeSlot(chunk->occupied);
+
+            T* component = new (chunk->storage + sizeof(T) * slot)
+                T(std::forward<Args>(args)...);
+            chunk->occupied |= uint64_t(1) << slot;
+            m_firstFreeChunk = chunkIndex;
+            ++m_count;
+
+            return {component, chunkIndex * COMPONENT_CHUNK_CAPACITY + slot,
+                    chunk->generations[slot]};
+        }
+
+        void Destroy(uint32_t index) override {
+            uint32_t chunkIndex = index / COMPONENT_CHUNK_CAPACITY;
+            uint32_t slot = index % COMPONENT_CHUNK_CAPACITY;
+            if (chunkIndex >= m_chunks.size()) return;
+
+            Chunk* chunk = m_chunks[chunkIndex];
+            uint64_t bit = uint64_t(1) << slot;
+            if (!(chunk->occupied & bit)) return;
+
+            chunk->Slot(slot)->~T();
+            chunk->occupied &= ~bit;
+            if (++chunk->generations[slot] == 0) chunk->generations[slot] = 1;
+            if (chunkIndex < m_firstFreeChunk) m_firstFreeChunk = chunkIndex;
+            --m_count;
+        }
+
+        Handle<T> GetHandle(uint32_t index) const {
+            uint32_t chunkIndex = index / COMPONENT_CHUNK_CAPACITY;
+            if (chunkIndex >= m_chunks.size()) return {};
+            return {index, m_chunks[chunkIndex]->generations[index % COMPONENT_CHUNK_CAPACITY]};
+        }
+
+        // nullptr once the component was destroyed, even if the slot is reused
+        T* Resolve(Handle<T> handle) const {
+            uint32_t chunkIndex = handle.index / COMPONENT_CHUNK_CAPACITY;
+            uint32_t slot = handle.index % COMPONENT_CHUNK_CAPACITY;
+            if (chunkIndex >= m_chunks.size()) return nullptr;
+
+            Chunk* chunk = m_chunks[chunkIndex];
+            if (!(chunk->occupied & (uint64_t(1) << slot)) ||
+                chunk->generations[slot] != handle.generation) {
+                return nullptr;
+            }
+            return chunk->Slot(slot);
+        }
+
+        // Visit every live component in memory order
+        template <typename Func>
+        void ForEach(Func&& fn) {
+            for (Chunk* chunk : m_chunks) {
+                uint64_t live = chunk->occupied;
+                while (live) {
+                    uint32_t slot = LowestSetBit(live);
+                    fn(chunk->Slot(slot));
+                    live &= live - 1;
+                }
+            }
+        }
+
+        size_t GetCount() const override { return m_count; }
+        size_t GetChunkCount() const { return m_chunks.size(); }
+
+    private:
+        static uint32_t LowestSetBit(uint64_t bits) {
+            uint32_t index = 0;
+            while (!(bits & 1)) {
+                bits >>= 1;
+                ++index;
+            }
+            return index;
+        }
+
+        static uint32_t FirstFreeSlot(uint64_t occupied) {
+            return LowestSetBit(~occupied);
+        }
+
+        std::vector<Chunk*> m_chunks;
+        uint32_t m_firstFreeChunk = 0;
+        size_t m_count = 0;
+    };
+
+    /**
+     * @struct Archetype
+     * @brief All game objects that own exactly the same set of component types.
+     *
+     * Rows are packed: row i of every column belongs to objects[i]. Adding or
+     * removing a component moves the object's row to another archetype; the
+     * components themselves stay where their pool put them.
+     */
+    struct Archetype {
+        std::vector<ComponentTypeID> signature;          // sorted ascending
+        ComponentMask mask = 0;                          // same set as bits
+        std::vector<GameObject*> objects;
+        std::vector<std::vector<Component*>> columns;    // parallel to signature
+
+        int ColumnOf(ComponentTypeID type) const {
+            size_t low = 0, high = signature.size();
+            while (low < high) {
+                size_t mid = (low + high) / 2;
+                if (signature[mid] < type) low = mid + 1;
+                else high = mid;
+            }
+            if (low < signature.size() && signature[low] == type)
+                return static_cast<int>(low);
+            return -1;
+        }
+
+        size_t GetSize() const { return objects.size(); }
+    };
+
+    /**
+     * @class ComponentStorage
+     * @brief Owns the component pools and the archetype tables.
+     *
+     * GameObject::AddComponent / RemoveComponent go through here; systems
+     * that touch many objects should iterate with ForEach instead of calling
+     * GetComponent per object.
+     */
+    class ENGINE_API ComponentStorage {
+    public:
+        static ComponentStorage& Get();
+
+        template <typename T>
+        ComponentPool<T>& GetPool() {
+            ComponentTypeID type = ComponentTypeRegistry::Get<T>();
+            if (type >= m_pools.size()) m_pools.resize(type + 1, nullptr);
+            if (!m_pools[type]) m_pools[type] = new ComponentPool<T>();
+            return *static_cast<ComponentPool<T>*>(m_pools[type]);
+        }
+
+        ComponentPoolBase* GetPool(ComponentTypeID type) const {
+            return type < m_pools.size() ? m_pools[type] : nullptr;
+        }
+
+        template <typename T>
+        T* Resolve(Handle<T> handle) const {
+            auto* pool = GetPool(ComponentTypeRegistry::Get<T>());
+            return pool ? static_cast<ComponentPool<T>*>(pool)->Resolve(handle) : nullptr;
+        }
+
+        // Archetype bookkeeping for GameObject
+        void Attach(GameObject* object, ComponentTypeID type, Component* component);
+        void Detach(GameObject* object, ComponentTypeID type);
+        void DetachAll(GameObject* object);
+
+        /**
+         * Calls fn(GameObject*, Ts*...) for every object that owns all of Ts.
+         * The callback must not add or remove components while iterating.
+         */
+        template <typename... Ts, typename Func>
+        void ForEach(Func&& fn) {
+            ForEachImpl<Ts...>(std::forward<Func>(fn),
+                               std::index_sequence_for<Ts...>{});
+        }
+
+        size_t GetArchetypeCount() const { return m_archetypes.size(); }
+
+        // Any attached component of the type, nullptr when none is
+        Component* FindAttached(ComponentTypeID type) const;
+
+        // Union of the types owned by at least one live object
+        ComponentMask GetLiveComponentMask() const {
+            ComponentMask mask = 0;
+            for (const Archetype* archetype : m_archetypes) {
+                if (!archetype->objects.empty()) mask |= archetype->mask;
+            }
+            return mask;
+        }
+
+    private:
+        ComponentStorage() = default;
+
+        template <typename... Ts, typename Func, size_t... I>
+        void ForEachImpl(Func&& fn, std::index_sequence<I...>) {
+            const ComponentTypeID types[] = {ComponentTypeRegistry::Get<Ts>()...};
+            ComponentMask required = 0;
+            for (ComponentTypeID type : types)
+                required |= ComponentTypeRegistry::MaskOf(type);
+
+            for (Archetype* archetype : m_archetypes) {
+                if ((archetype->mask & required) != required) continue;
+
+                int columns[sizeof...(Ts)];
+                for (size_t i = 0; i < sizeof...(Ts); ++i)
+                    columns[i] = archetype->ColumnOf(types[i]);
+
+                for (size_t row = 0; row < archetype->objects.size(); ++row) {
+                    fn(archetype->objects[row],
+                       static_cast<Ts*>(archetype->columns[columns[I]][row])...);
+                }
+            }
+        }
+
+        Archetype* FindOrCreateArchetype(const std::vector<ComponentTypeID>& signature);
+        void MoveObject(GameObject* object, Archetype* target,
+                        ComponentTypeID addedType, Component* added);
+        void RemoveRow(Archetype* archetype, uint32_t row);
+
+        std::vector<ComponentPoolBase*> m_pools;
+        std::vector<Archetype*> m_archetypes;
+
+        static ComponentStorage* Instance;
+    };
+
+} // namespace Sleak
+
+#endif // _COMPONENT_STORAGE_HPP_
@@ -26,6 +26,12 @@ namespace Sleak {
         virtual bool Initialize() override;
         virtual void Update(float deltaTime) override;
 
+        // Update split in two for the scene's animation systems:
+        // Evaluate only touches this component (safe on a worker thread),
+        // UploadBones writes the GPU buffer and must run on the main thread
+        void Evaluate(float deltaTime);
+        void UploadBones();
+
         // Animation control
         void Play(const std::string& clipName, bool loop = true);
         void Play(int clipIndex, bool loop = true);
@@ -90,6 +96,7 @@ namespace Sleak {
         std::vector<Math::Matrix4> m_boneMatrices;
         std::vector<Math::Matrix4> m_boneMatricesB;  // second pose for blending
         RefPtr<RenderEngine::BufferBase> m_boneBuffer;
+        bool m_bonesDirty = false;
 
         // State machine (owned)
         AnimationStateMachine* m_stateMachine = nullptr;
@@ -7,11 +7,18 @@
 #include <Math/Color.hpp>
 
 namespace Sleak {
+
+    enum class MaterialSharing : uint8_t {
+        Shared,         // Changes through this component affect every user
+        CopyOnWrite     // The first change clones the material for this object
+    };
+
     class ENGINE_API MaterialComponent : public Component {
     public:
         // Construct with a shared material (RefPtr copy - safe for sharing)
         MaterialComponent(GameObject* object,
-                          const RefPtr<Material>& material);
+                          const RefPtr<Material>& material,
+                          MaterialSharing sharing = MaterialSharing::Shared);
 
         // Construct with a raw pointer (takes ownership)
         MaterialComponent(GameObject* object, Material* material);
@@ -32,7 +39,8 @@ namespace Sleak {
         void OnEnable() override;
         void OnDisable() override;
 
-        // Material access
+        // Material access. The material may be shared with other objects;
+        // the shortcuts below respect MaterialSharing, direct edits do not.
         void SetMaterial(const RefPtr<Material>& material);
         void SetMaterial(Material* material);
         const RefPtr<Material>& GetMaterial() const;
@@ -47,8 +55,12 @@ namespace Sleak {
         void SetRoughness(float roughness);
 
     private:
+        // Clones a copy-on-write material before the first change
+        void MakeMaterialUnique();
+
         RefPtr<Material> m_material;
         bool m_enabled = true;
+        bool m_copyOnWrite = false;
     };
 }
 
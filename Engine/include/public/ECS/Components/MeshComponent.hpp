@@ -5,12 +5,15 @@
 #include <Utility/Container/List.hpp>
 #include <Memory/ObjectPtr.h>
 #include <Memory/RefPtr.h>
+#include <Physics/Colliders.hpp>
+#include <memory>
 
 namespace Sleak {
     class MeshData;
     namespace RenderEngine {
         class TransformBuffer;
         class BufferBase;
+        class RenderCommandQueue;
     }  // namespace RenderEngine
 
     struct VoidData {
@@ -20,9 +23,17 @@ namespace Sleak {
 
     class MeshComponent : public Component {
     public:
-        MeshComponent(GameObject* object) : Component(object) {}
+        MeshComponent(GameObject* object);
         MeshComponent(GameObject*, MeshData data);
 
+        // Shares already uploaded buffers (e.g. from PrimitiveCache)
+        MeshComponent(GameObject* object,
+                      const RefPtr<RenderEngine::BufferBase>& vertexBuffer,
+                      const RefPtr<RenderEngine::BufferBase>& indexBuffer,
+                      uint32_t vertexCount, uint32_t indexCount);
+
+        ~MeshComponent() override;
+
         virtual bool Initialize() override;
         
         virtual void Update(float deltaTime) override;
@@ -35,6 +46,27 @@ namespace Sleak {
 
         void AddConstantBuffer(RefPtr<RenderEngine::BufferBase>& buffer);
 
+        // Object-space bounds of the vertices. Computed from MeshData;
+        // components built from shared buffers get them from the caller.
+        void SetLocalBounds(const Physics::AABB& bounds);
+        const Physics::AABB& GetLocalBounds() const { return m_localBounds; }
+
+        // Whether frustum culling may skip this mesh. Meshes without bounds
+        // and skinned meshes (extra constant buffers), whose vertices move
+        // outside their bind-pose bounds, are always drawn.
+        bool IsCullable() const { return m_hasBounds && ConstantBuffers.GetSize() == 0; }
+
+        // CPU copy of the vertices for the scene's static batching. Kept
+        // from the MeshData constructor until the batches are built; shared
+        // buffers can point at data their owner keeps alive.
+        void SetMeshData(const MeshData* data) { m_meshData = data; }
+        const MeshData* GetMeshData() const { return m_meshData; }
+        void ReleaseMeshData();
+
+        // Merged into a static batch, which draws it from then on
+        void SetBatched(bool batched) { m_batched = batched; }
+        bool IsBatched() const { return m_batched; }
+
     private:
         RefPtr<RenderEngine::BufferBase> VertexBuffer{};
         RefPtr<RenderEngine::BufferBase> IndexBuffer{};
@@ -43,6 +75,16 @@ namespace Sleak {
        uint32_t VertexCount;
        uint32_t IndexCount;
 
+       Physics::AABB m_localBounds;
+       bool m_hasBounds = false;
+
+       const MeshData* m_meshData = nullptr;
+       std::unique_ptr<MeshData> m_ownedMeshData;
+       bool m_batched = false;
+
+       // Material, mesh and camera distance packed for SortCommands
+       uint64_t BuildSortKey(RenderEngine::RenderCommandQueue* queue) const;
+
     };
 }
 
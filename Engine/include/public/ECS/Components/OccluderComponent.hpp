@@ -0,0 +1,55 @@
+#ifndef _OCCLUDERCOMPONENT_HPP_
+#define _OCCLUDERCOMPONENT_HPP_
+
+#include <ECS/Component.hpp>
+#include <Core/OSDef.hpp>
+#include <Physics/Colliders.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Sleak {
+
+    struct MeshData;
+
+    /**
+     * @class OccluderComponent
+     * @brief Marks an object as hiding what is behind it.
+     *
+     * Holds object-space triangles that the CullingSystem rasterizes into
+     * its OcclusionBuffer each frame. The geometry must lie inside the
+     * visible surface of the object (a wall's box, a simplified hull):
+     * anything it covers is culled, so an occluder larger than the mesh
+     * hides objects that should be seen. Keep it to a few dozen triangles.
+     */
+    class ENGINE_API OccluderComponent : public Component {
+    public:
+        // Positions as xyz triples, three indices per triangle
+        OccluderComponent(GameObject* object,
+                          std::vector<float> positions,
+                          std::vector<uint32_t> indices);
+
+        // Uses the render mesh itself; only for low-poly meshes
+        OccluderComponent(GameObject* object, const MeshData& data);
+
+        // Solid box, e.g. the bounds of a wall
+        OccluderComponent(GameObject* object, const Physics::AABB& box);
+
+        bool Initialize() override { return true; }
+        void Update(float deltaTime) override {}
+
+        const std::vector<float>& GetPositions() const { return m_positions; }
+        const std::vector<uint32_t>& GetIndices() const { return m_indices; }
+        uint32_t GetVertexCount() const { return static_cast<uint32_t>(m_positions.size() / 3); }
+        uint32_t GetTriangleCount() const { return static_cast<uint32_t>(m_indices.size() / 3); }
+
+        const Physics::AABB& GetLocalBounds() const { return m_localBounds; }
+
+    private:
+        std::vector<float> m_positions;
+        std::vector<uint32_t> m_indices;
+        Physics::AABB m_localBounds;
+    };
+
+}
+
+#endif // _OCCLUDERCOMPONENT_HPP_
@@ -6,6 +6,7 @@
 #include "Math/Quaternion.hpp"
 #include "Math/Matrix.hpp"
 #include <Memory/RefPtr.h>
+#include <cstdint>
 
 namespace Sleak {
 
@@ -13,14 +14,17 @@ namespace Sleak {
 
     namespace RenderEngine { class BufferBase; };
 
+    class TransformHierarchy;
+
     /**
      * @class TransformComponent
      * @brief Represents the position, rotation, and scale of an entity in 3D space.
      *
-     * This component is essential for positioning and orienting entities
-     * within the game world. It provides functionalities for setting and
-     * retrieving the transform properties, as well as calculating transformation
-     * matrices for rendering and physics calculations.
+     * Position, rotation and scale are local to the nearest parent object
+     * that has a transform. The local and world matrices are cached: any
+     * change marks this transform and its children dirty, and the scene's
+     * TransformHierarchy recomputes the dirty ones once per frame, parents
+     * before children. Objects that did not move cost nothing.
      */
     class TransformComponent : public Component {
     public:
@@ -35,8 +39,10 @@ namespace Sleak {
         bool Initialize() override;
         void Update(float DeltaTime) override;
 
-        // Transformation matrix calculation
+        // World transformation matrix (row vectors: local * parent world)
         Matrix4 GetTransformMatrix();
+        Matrix4 GetWorldMatrix() const;
+        Matrix4 GetLocalMatrix() const;
 
         // Transformations
         void Translate(const Vector3D& translation);
@@ -61,33 +67,47 @@ namespace Sleak {
         void LookAt(const Vector3D& target);
 
         // Getters
+        const Vector3D& GetLocalPosition() const { return position; }
+        const Quaternion& GetLocalRotation() const { return rotation; }
+        const Vector3D& GetLocalScale() const { return scale; }
+
         Vector3D GetWorldPosition() const;
         Quaternion GetWorldRotation() const;
-        Vector3D GetWorldScale() const;
+        Vector3D GetWorldScale() const;     // Per-axis product, ignores skew
 
-        struct TransformMatrix {
-            
-            TransformMatrix() : Translation(Matrix4::Identity()), Rotation(Matrix4::Identity()), Scaling(Matrix4::Identity()) {}
+        // Nearest ancestor object with a transform, nullptr for roots
+        TransformComponent* GetParentTransform() const;
 
-            Math::Matrix4 CalculateTransformMatrix() const {
-                return (Scaling * Rotation) * Translation ;
-            }
+        // Marks this transform and every descendant for recomputation.
+        // Called by the setters and when the object is reparented.
+        void MarkDirty();
+        bool IsDirty() const { return m_dirty; }
 
-            Math::Matrix4 Translation;
-            Math::Matrix4 Rotation;
-            Math::Matrix4 Scaling;
-
-        };
+        // Bumped every time the cached world matrix is recomputed
+        uint32_t GetWorldVersion() const { return m_worldVersion; }
 
     protected:
         Vector3D position = Vector3D(0.0f, 0.0f, 0.0f);
-        Quaternion rotation = Quaternion(); 
+        Quaternion rotation = Quaternion();
         Vector3D scale = Vector3D(1.0f, 1.0f, 1.0f);
-        TransformMatrix* Transform;
 
     private:
+        friend class TransformHierarchy;
+
         RefPtr<RenderEngine::BufferBase> ConstantBuffer;
 
+        // Cached results, valid while m_dirty is false
+        Matrix4 m_localMatrix;
+        Matrix4 m_worldMatrix;
+        Quaternion m_worldRotation;
+        Vector3D m_worldScale = Vector3D(1.0f, 1.0f, 1.0f);
+        bool m_dirty = true;
+        uint32_t m_worldVersion = 0;
+
+        // What the constant buffer was last filled with
+        uint32_t m_uploadedWorldVersion = 0;
+        uint64_t m_uploadedCameraVersion = 0;
+
         void UpdateConstantBuffer();
         void UpdateTransform();
         Math::Matrix4 GetMVP();
@@ -96,4 +116,3 @@ namespace Sleak {
 } // namespace Sleak
 
 #endif // _TRANSFORM_COMPONENT_H_
-
@@ -0,0 +1,169 @@
+#ifndef _CULLING_SYSTEM_HPP_
+#define _CULLING_SYSTEM_HPP_
+
+#include <Core/OSDef.hpp>
+#include <Camera/OcclusionBuffer.hpp>
+#include <Math/Matrix.hpp>
+#include <Memory/Handle.h>
+#include <Physics/DynamicAABBTree.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Sleak {
+
+    class GameObject;
+    class OccluderComponent;
+    class TransformComponent;
+    class TransformHierarchy;
+    class ViewFrustum;
+
+    /**
+     * @class CullingSystem
+     * @brief Marks objects whose mesh is outside the view frustum as culled,
+     * so their transform upload, material bind and draw are skipped.
+     *
+     * Renderables (objects with a transform and a cullable MeshComponent)
+     * live in two DynamicAABBTrees keyed by their world-space AABB.
+     * Objects marked GameObject::IsStatic start in the static tree, other
+     * new and moving objects go to the dynamic tree; once an object has
+     * not moved for STATIC_AFTER_FRAMES it is handed to the static tree,
+     * which only changes when something is promoted or starts moving again.
+     *
+     * Culling walks both trees with ViewFrustum::ClassifyAABB: subtrees
+     * outside are skipped, subtrees inside are accepted without further
+     * tests, and only leaves the frustum cuts get an exact test, batched
+     * with ViewFrustum::TestAABBs. Bounds are refreshed for the objects the
+     * TransformHierarchy reports as moved, so the per-frame cost follows
+     * the visible and moving sets, not the size of the scene.
+     *
+     * Objects that pass the frustum are then tested against the
+     * OcclusionBuffer, into which the OccluderComponents in view were
+     * rasterized, and culled when occluders cover them completely.
+     *
+     * With a shadow frustum (the shadow light's view-projection), objects
+     * the camera does not see but the shadow map does stay submitted as
+     * shadow casters: the shadow pass replays the main pass draws.
+     *
+     * Runs after the world matrices are updated and before the objects
+     * submit their render commands.
+     */
+    class ENGINE_API CullingSystem {
+    public:
+        static constexpr uint32_t STATIC_AFTER_FRAMES = 120;
+
+        void Update(TransformHierarchy& hierarchy, const ViewFrustum& frustum,
+                    const Math::Matrix4& viewProjection,
+                    const ViewFrustum* shadowFrustum = nullptr);
+
+        // Disabled: nothing is culled, counters report every object submitted
+        void SetEnabled(bool enabled) { m_enabled = enabled; }
+        bool IsEnabled() const { return m_enabled; }
+
+        void SetOcclusionEnabled(bool enabled) { m_occlusionEnabled = enabled; }
+        bool IsOcclusionEnabled() const { return m_occlusionEnabled; }
+
+        // Objects with a mesh in the last pass
+        uint32_t GetSubmittedCount() const { return m_submitted; }
+        uint32_t GetCulledCount() const { return m_culled; }
+        // Part of the culled ones hidden by occluders rather than the frustum
+        uint32_t GetOccludedCount() const { return m_occluded; }
+        // Submitted only for the shadow pass: out of view or occluded
+        uint32_t GetShadowCasterCount() const { return static_cast<uint32_t>(m_shadowCasters.size()); }
+        uint32_t GetOccluderCount() const { return static_cast<uint32_t>(m_occluders.size()); }
+        const OcclusionBuffer& GetOcclusionBuffer() const { return m_occlusion; }
+
+        uint32_t GetStaticCount() const { return m_staticCount; }
+        uint32_t GetRenderableCount() const { return static_cast<uint32_t>(m_renderables.size()); }
+
+        // Cullable renderables whose bounds overlap the box, visible or not
+        void Query(const Physics::AABB& bounds, std::vector<GameObject*>& out) const;
+
+        // Whether this frame's occluders hide the box. False when no
+        // occlusion pass ran, so callers only ever skip what is hidden.
+        bool IsOccluded(const Physics::AABB& worldBounds) const;
+
+    private:
+        struct Renderable {
+            GameObject* object;
+            TransformComponent* transform;
+            Handle<GameObject> handle;
+            Physics::AABB bounds;       // World space
+            int proxy = Physics::NULL_NODE;
+            bool cullable = false;
+            bool isStatic = false;
+            uint32_t lastMoved = 0;     // Frame number
+            uint32_t seen = 0;          // Sync stamp
+        };
+
+        struct Occluder {
+            OccluderComponent* occluder;
+            TransformComponent* transform;
+        };
+
+        Physics::DynamicAABBTree& TreeOf(const Renderable& renderable) {
+            return renderable.isStatic ? m_staticTree : m_dynamicTree;
+        }
+
+        using MarkFunc = void (CullingSystem::*)(uint32_t);
+
+        Renderable* Find(Handle<GameObject> handle);
+
+        void Sync(const TransformHierarchy& hierarchy);
+        void Add(GameObject* object, TransformComponent* transform, bool cullable);
+        void Remove(uint32_t index);
+        void SetCullable(uint32_t index, bool cullable);
+        void SetStatic(uint32_t index, bool isStatic);
+        void ComputeBounds(Renderable& renderable) const;
+
+        void ApplyMoves(TransformHierarchy& hierarchy);
+        void PromoteStatic();
+        void Cull(const ViewFrustum& frustum, const ViewFrustum* shadowFrustum);
+        void CullAgainst(const ViewFrustum& frustum, MarkFunc mark);
+        void Traverse(const Physics::DynamicAABBTree& tree, const ViewFrustum& frustum, MarkFunc mark);
+        void MarkVisible(uint32_t index);
+        void MarkShadowCaster(uint32_t index);
+        void Occlude(const ViewFrustum& frustum, const Math::Matrix4& viewProjection,
+                     const ViewFrustum* shadowFrustum);
+
+        std::vector<Renderable> m_renderables;
+        std::unordered_map<Handle<GameObject>, uint32_t> m_index;
+
+        Physics::DynamicAABBTree m_staticTree;
+        Physics::DynamicAABBTree m_dynamicTree;
+
+        std::vector<Handle<GameObject>> m_dynamic;     // Promotion candidates
+        std::vector<Handle<GameObject>> m_visible;     // Visible after the last pass
+        std::vector<Handle<GameObject>> m_shadowCasters;  // Submitted for the shadow pass only
+
+        // Leaves the frustum cuts, tested exactly in one batch
+        std::vector<uint32_t> m_candidates;
+        std::vector<float> m_minX, m_minY, m_minZ;
+        std::vector<float> m_maxX, m_maxY, m_maxZ;
+        std::vector<uint8_t> m_candidateVisible;
+
+        std::vector<Occluder> m_occluders;
+        OcclusionBuffer m_occlusion;
+
+        // Traversal stack: node and the planes it still straddles
+        std::vector<std::pair<int, uint32_t>> m_stack;
+
+        uint32_t m_frame = 0;
+        uint32_t m_syncStamp = 0;
+        uint32_t m_structureVersion = 0;
+        bool m_built = false;
+        bool m_enabled = true;
+        bool m_wasEnabled = true;
+        bool m_occlusionEnabled = true;
+        bool m_occlusionReady = false;      // Buffer rasterized this frame
+
+        uint32_t m_cullableCount = 0;
+        uint32_t m_staticCount = 0;
+        uint32_t m_submitted = 0;
+        uint32_t m_culled = 0;
+        uint32_t m_occluded = 0;
+    };
+
+}
+
+#endif // _CULLING_SYSTEM_HPP_
@@ -0,0 +1,87 @@
+#ifndef _STATIC_BATCHER_HPP_
+#define _STATIC_BATCHER_HPP_
+
+#include <Core/OSDef.hpp>
+#include <Memory/RefPtr.h>
+#include <Physics/Colliders.hpp>
+#include <Runtime/Material.hpp>
+#include <Utility/Container/List.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Sleak {
+
+    class GameObject;
+    class CullingSystem;
+    class ViewFrustum;
+
+    namespace RenderEngine {
+        class BufferBase;
+    }
+
+    /**
+     * @class StaticBatcher
+     * @brief Merges the meshes of static objects (GameObject::SetStatic)
+     * into shared vertex and index buffers when the scene activates.
+     *
+     * Objects are grouped by material and by a CELL_SIZE grid cell of
+     * their position. Each group becomes one batch: a range of the shared
+     * buffers holding its meshes already in world space, drawn with one
+     * call. A batch is split when it would pass MAX_BATCH_VERTICES.
+     *
+     * Batches keep their world bounds and are tested against the view
+     * frustum and the CullingSystem's occlusion buffer before they submit.
+     * The merged objects stay in the scene, but their transform, material
+     * and mesh no longer submit anything.
+     *
+     * Only meshes with a CPU copy (MeshComponent::GetMeshData), bounds, a
+     * material and no extra constant buffers (skinned meshes) are merged.
+     */
+    class ENGINE_API StaticBatcher {
+    public:
+        static constexpr float CELL_SIZE = 32.0f;
+        static constexpr uint32_t MAX_BATCH_VERTICES = 65535;
+
+        ~StaticBatcher();
+
+        // Merges the static meshes under the objects, then drops every CPU
+        // mesh copy, which was only kept for this. Runs once per scene.
+        void Build(const List<GameObject*>& objects);
+
+        // Submits the batches the camera sees
+        void Submit(const ViewFrustum& frustum, const CullingSystem& culling);
+
+        // Releases the GPU buffers; merged objects are not restored
+        void Clear();
+
+        bool IsBuilt() const { return m_built; }
+
+        uint32_t GetBatchCount() const { return static_cast<uint32_t>(m_batches.size()); }
+        uint32_t GetBatchedObjectCount() const { return m_batchedObjects; }
+        // Batches submitted in the last frame
+        uint32_t GetSubmittedCount() const { return m_submitted; }
+
+    private:
+        struct Batch {
+            RefPtr<Material> material;
+            RefPtr<RenderEngine::BufferBase> transform;  // Identity world
+            Physics::AABB bounds;
+            uint32_t startIndex = 0;
+            uint32_t indexCount = 0;
+            int32_t baseVertex = 0;
+            bool hasOccluder = false;      // Not tested against its own occluders
+            uint64_t uploadedCameraVersion = 0;
+        };
+
+        RefPtr<RenderEngine::BufferBase> m_vertexBuffer;
+        RefPtr<RenderEngine::BufferBase> m_indexBuffer;
+        std::vector<Batch> m_batches;
+
+        uint32_t m_batchedObjects = 0;
+        uint32_t m_submitted = 0;
+        bool m_built = false;
+    };
+
+}
+
+#endif // _STATIC_BATCHER_HPP_
@@ -0,0 +1,178 @@
+#ifndef _SYSTEM_SCHEDULER_HPP_
+#define _SYSTEM_SCHEDULER_HPP_
+
+#include <Core/OSDef.hpp>
+#include <ECS/ComponentStorage.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Sleak {
+
+    enum class SystemPhase : uint8_t {
+        Update,
+        FixedUpdate,
+        LateUpdate
+    };
+
+    // Shared engine state that does not live in a component. Resources are
+    // always exclusive: two systems using the same one never overlap.
+    enum class SystemResource : uint32_t {
+        None        = 0,
+        RenderQueue = 1 << 0,   // RenderCommandQueue submission order
+        GPU         = 1 << 1,   // Direct buffer / texture updates
+        Input       = 1 << 2,   // SDL input state, cursor
+        Camera      = 1 << 3,   // Camera objects and the main view/projection
+        Physics     = 1 << 4,   // PhysicsWorld broadphase and contacts
+        Scene       = 1 << 5,   // Object lists, lights, object creation
+        All         = 0xFFFFFFFF
+    };
+
+    inline SystemResource operator|(SystemResource a, SystemResource b) {
+        return static_cast<SystemResource>(static_cast<uint32_t>(a) |
+                                           static_cast<uint32_t>(b));
+    }
+
+    /**
+     * @struct SystemAccess
+     * @brief What a system (or a component's per-object update) touches.
+     *
+     * Two accesses conflict when one writes a component type the other
+     * reads or writes, or when both use the same resource. Conflicting
+     * systems keep their registration order; the others may overlap.
+     */
+    struct SystemAccess {
+        ComponentMask reads = 0;
+        ComponentMask writes = 0;
+        uint32_t resources = 0;
+        bool mainThread = false;    // Must run on the main thread
+
+        template <typename T>
+        SystemAccess& Read() {
+            reads |= ComponentTypeRegistry::MaskOf(ComponentTypeRegistry::Get<T>());
+            return *this;
+        }
+
+        template <typename T>
+        SystemAccess& Write() {
+            writes |= ComponentTypeRegistry::MaskOf(ComponentTypeRegistry::Get<T>());
+            return *this;
+        }
+
+        SystemAccess& Use(SystemResource resource) {
+            resources |= static_cast<uint32_t>(resource);
+            return *this;
+        }
+
+        SystemAccess& OnMainThread() {
+            mainThread = true;
+            return *this;
+        }
+
+        SystemAccess& operator|=(const SystemAccess& other) {
+            reads |= other.reads;
+            writes |= other.writes;
+            resources |= other.resources;
+            mainThread |= other.mainThread;
+            return *this;
+        }
+
+        bool ConflictsWith(const SystemAccess& other) const {
+            return (writes & (other.reads | other.writes)) != 0 ||
+                   (other.writes & reads) != 0 ||
+                   (resources & other.resources) != 0;
+        }
+
+        // Conservative default for components that declared nothing
+        static SystemAccess Everything() {
+            SystemAccess access;
+            access.reads = ~ComponentMask(0);
+            access.writes = ~ComponentMask(0);
+            access.resources = static_cast<uint32_t>(SystemResource::All);
+            access.mainThread = true;
+            return access;
+        }
+    };
+
+    struct System {
+        std::string name;
+        SystemPhase phase = SystemPhase::Update;
+        SystemAccess access;
+        std::function<void(float)> run;
+
+        // Optional: recomputed every frame, replaces 'access' when set
+        std::function<SystemAccess()> resolveAccess = {};
+    };
+
+    /**
+     * @class SystemScheduler
+     * @brief Runs a scene's update systems, overlapping the ones that do
+     * not conflict.
+     *
+     * Systems run in registration order when executed serially. Every frame
+     * the scheduler rebuilds a dependency graph from the declared accesses
+     * (an edge from each earlier conflicting system) and hands it to the
+     * JobSystem. Since only non-conflicting systems overlap, results match
+     * the serial order exactly; SetParallel(false) forces that order for
+     * comparison.
+     */
+    class ENGINE_API SystemScheduler {
+    public:
+        void AddSystem(System system);
+        void RemoveSystem(const std::string& name);
+        size_t GetSystemCount() const { return m_systems.size(); }
+
+        // Must be called on the main thread
+        void Run(SystemPhase phase, float deltaTime);
+
+        void SetParallel(bool parallel) { m_parallel = parallel; }
+        bool IsParallel() const { return m_parallel; }
+
+        // Runs serially, in the order the declared accesses allow that
+        // moves systems furthest back: each one runs as late as its
+        // conflicting successors permit. Results must still match the
+        // registration order; a difference points at a missing access
+        // declaration, without depending on thread timing.
+        void SetReverseOrder(bool reverse) { m_reverseOrder = reverse; }
+        bool IsReverseOrder() const { return m_reverseOrder; }
+
+        // Component types whose per-object Update is done by a system instead
+        template <typename T>
+        void SetUpdatedBySystem() {
+            m_systemUpdated |= ComponentTypeRegistry::MaskOf(ComponentTypeRegistry::Get<T>());
+        }
+        template <typename T>
+        void ClearUpdatedBySystem() {
+            m_systemUpdated &= ~ComponentTypeRegistry::MaskOf(ComponentTypeRegistry::Get<T>());
+        }
+        ComponentMask GetSystemUpdatedComponents() const { return m_systemUpdated; }
+
+        /**
+         * Declares what T's Update / FixedUpdate / LateUpdate touch. Types
+         * without a declaration are treated as SystemAccess::Everything(),
+         * which keeps scenes using them fully serial.
+         */
+        template <typename T>
+        static void DeclareComponentAccess(const SystemAccess& access) {
+            DeclareComponentAccess(ComponentTypeRegistry::Get<T>(), access);
+        }
+        static void DeclareComponentAccess(ComponentTypeID type, const SystemAccess& access);
+
+        static SystemAccess GetComponentAccess(ComponentTypeID type);
+
+        // Union of the accesses of every type set in the mask
+        static SystemAccess GetAccessForComponents(ComponentMask types);
+
+    private:
+        void RunSerial(const std::vector<System*>& systems, float deltaTime);
+
+        std::vector<System> m_systems;
+        ComponentMask m_systemUpdated = 0;
+        bool m_parallel = true;
+        bool m_reverseOrder = false;
+    };
+
+}
+
+#endif // _SYSTEM_SCHEDULER_HPP_
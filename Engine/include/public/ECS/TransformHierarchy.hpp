@@ -0,0 +1,67 @@
+#ifndef _TRANSFORM_HIERARCHY_HPP_
+#define _TRANSFORM_HIERARCHY_HPP_
+
+#include <Core/OSDef.hpp>
+#include <Memory/Handle.h>
+#include <Utility/Container/List.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Sleak {
+
+    class GameObject;
+    class TransformComponent;
+
+    /**
+     * @class TransformHierarchy
+     * @brief Recomputes a scene's dirty world matrices in one linear pass.
+     *
+     * Keeps every transform of the scene in a flat array sorted by depth,
+     * so a parent is always visited before its children. The array is only
+     * rebuilt after objects are added, removed or reparented. Each frame
+     * the pass recomputes the transforms marked dirty; when nothing moved
+     * since the last pass it returns without touching the array.
+     */
+    class ENGINE_API TransformHierarchy {
+    public:
+        // The set of transforms or their parents changed
+        void Invalidate() { m_structureDirty = true; m_changed = true; }
+
+        // A transform was marked dirty since the last pass
+        void MarkChanged() { m_changed = true; }
+
+        // Objects whose world matrix changed since ClearMoved, recorded by
+        // TransformComponent::MarkDirty. Lets the CullingSystem refresh
+        // only the bounds that moved. Each dirty period adds an object once.
+        void RecordMoved(Handle<GameObject> object) { m_moved.push_back(object); }
+        const std::vector<Handle<GameObject>>& GetMoved() const { return m_moved; }
+        void ClearMoved() { m_moved.clear(); }
+
+        // Must not overlap with anything that writes transforms
+        void Update(const List<GameObject*>& objects);
+
+        size_t GetTransformCount() const { return m_transforms.size(); }
+        uint32_t GetLastUpdatedCount() const { return m_lastUpdated; }
+
+        // Every transform of the scene, parents before children
+        const std::vector<TransformComponent*>& GetTransforms() const { return m_transforms; }
+
+        // Bumped each time the array is rebuilt
+        uint32_t GetStructureVersion() const { return m_structureVersion; }
+
+    private:
+        void Rebuild(const List<GameObject*>& objects);
+
+        std::vector<TransformComponent*> m_transforms;     // parents before children
+        std::vector<GameObject*> m_level;
+        std::vector<GameObject*> m_nextLevel;
+        std::vector<Handle<GameObject>> m_moved;
+        bool m_structureDirty = true;
+        bool m_changed = true;
+        uint32_t m_lastUpdated = 0;
+        uint32_t m_structureVersion = 0;
+    };
+
+}
+
+#endif // _TRANSFORM_HIERARCHY_HPP_
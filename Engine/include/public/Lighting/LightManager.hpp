@@ -4,6 +4,7 @@
 #include <Core/OSDef.hpp>
 #include <Utility/Container/List.hpp>
 #include <Math/Vector.hpp>
+#include <Math/Matrix.hpp>
 #include <Memory/RefPtr.h>
 
 namespace Sleak {
@@ -25,9 +26,15 @@ namespace Sleak {
         void RegisterLight(Light* light);
         void UnregisterLight(Light* light);
 
+        // Single pass over the registered lights
+        void UnregisterLights(const List<Light*>& lights);
+
         void UpdateAndBind();
         void UpdateShadowData();
 
+        // View-projection of the shadow map; false without a shadow light
+        bool GetShadowViewProjection(Math::Matrix4& out) const;
+
         void SetAmbientColor(float r, float g, float b);
         void SetAmbientIntensity(float intensity) {
             m_ambientIntensity = intensity;
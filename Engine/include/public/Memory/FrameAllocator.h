@@ -0,0 +1,76 @@
+#ifndef _FRAME_ALLOCATOR_H_
+#define _FRAME_ALLOCATOR_H_
+
+#include <Core/OSDef.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Sleak {
+
+    /**
+     * @class FrameAllocator
+     * @brief Linear arena for memory that lives for one frame.
+     *
+     * Allocate bumps an offset into the current block; nothing is freed
+     * individually. Reset rewinds everything at once and keeps the memory.
+     * When a frame outgrows the block a new one is chained on, and the next
+     * Reset replaces the chain with a single block big enough for it, so
+     * after a few frames of the same load the arena stops touching the
+     * system allocator.
+     *
+     * Objects created with New are not destroyed by Reset: owners that
+     * place non-trivial types here run their destructors first.
+     */
+    class ENGINE_API FrameAllocator {
+    public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit FrameAllocator(size_t blockSize = DEFAULT_BLOCK_SIZE);
+        ~FrameAllocator();
+
+        FrameAllocator(const FrameAllocator&) = delete;
+        FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T, typename... Args>
+        T* New(Args&&... args) {
+            return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // Uninitialized storage for count Ts
+        template <typename T>
+        T* NewArray(size_t count) {
+            return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        }
+
+        void Reset();
+
+        size_t GetUsed() const { return m_used; }
+        size_t GetCapacity() const { return m_capacity; }
+
+        // Blocks requested from the system since construction
+        uint64_t GetBlockAllocations() const { return m_blockAllocations; }
+
+    private:
+        struct Block {
+            uint8_t* memory;
+            size_t size;
+        };
+
+        void AddBlock(size_t minimumSize);
+
+        std::vector<Block> m_blocks;
+        size_t m_blockSize;
+        size_t m_offset = 0;        // Into m_blocks.back()
+        size_t m_used = 0;          // Across every block, padding included
+        size_t m_capacity = 0;
+        uint64_t m_blockAllocations = 0;
+    };
+
+}
+
+#endif // _FRAME_ALLOCATOR_H_
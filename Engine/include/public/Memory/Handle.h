@@ -0,0 +1,115 @@
+#ifndef _HANDLE_H_
+#define _HANDLE_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Sleak {
+
+    /**
+     * @struct Handle
+     * @brief 32-bit slot index + 32-bit generation referring to a T.
+     *
+     * A handle does not keep its target alive. Once the target is destroyed
+     * its slot's generation changes, so resolving an old handle yields
+     * nullptr instead of a dangling pointer.
+     */
+    template <typename T>
+    struct Handle {
+        static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+        uint32_t index = INVALID_INDEX;
+        uint32_t generation = 0;
+
+        bool IsNull() const { return index == INVALID_INDEX; }
+        explicit operator bool() const { return !IsNull(); }
+
+        uint64_t ToUInt64() const {
+            return (uint64_t(generation) << 32) | index;
+        }
+
+        static Handle FromUInt64(uint64_t value) {
+            return {static_cast<uint32_t>(value), static_cast<uint32_t>(value >> 32)};
+        }
+
+        bool operator==(const Handle& other) const {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    /**
+     * @class SlotMap
+     * @brief Maps handles to T pointers. Freed slots are reused with a new
+     * generation; lookups are one bounds check and one compare.
+     *
+     * Not synchronized: insert and remove must not race with Get.
+     */
+    template <typename T>
+    class SlotMap {
+    public:
+        Handle<T> Insert(T* value) {
+            uint32_t index;
+            if (m_freeHead != Handle<T>::INVALID_INDEX) {
+                index = m_freeHead;
+                m_freeHead = m_slots[index].nextFree;
+            } else {
+                index = static_cast<uint32_t>(m_slots.size());
+                m_slots.push_back({});
+            }
+
+            Slot& slot = m_slots[index];
+            slot.value = value;
+            slot.nextFree = Handle<T>::INVALID_INDEX;
+            ++m_count;
+            return {index, slot.generation};
+        }
+
+        // Returns false for stale or null handles
+        bool Remove(Handle<T> handle) {
+            if (!Get(handle)) return false;
+
+            Slot& slot = m_slots[handle.index];
+            slot.value = nullptr;
+            // Generation 0 is never live, so a wrapped counter skips it
+            if (++slot.generation == 0) slot.generation = 1;
+            slot.nextFree = m_freeHead;
+            m_freeHead = handle.index;
+            --m_count;
+            return true;
+        }
+
+        T* Get(Handle<T> handle) const {
+            if (handle.index >= m_slots.size()) return nullptr;
+            const Slot& slot = m_slots[handle.index];
+            return slot.generation == handle.generation ? slot.value : nullptr;
+        }
+
+        void Reserve(size_t count) { m_slots.reserve(count); }
+        size_t GetCount() const { return m_count; }
+
+    private:
+        struct Slot {
+            T* value = nullptr;
+            uint32_t generation = 1;
+            uint32_t nextFree = Handle<T>::INVALID_INDEX;
+        };
+
+        std::vector<Slot> m_slots;
+        uint32_t m_freeHead = Handle<T>::INVALID_INDEX;
+        size_t m_count = 0;
+    };
+
+}
+
+namespace std {
+    template <typename T>
+    struct hash<Sleak::Handle<T>> {
+        size_t operator()(const Sleak::Handle<T>& handle) const {
+            return std::hash<uint64_t>{}(handle.ToUInt64());
+        }
+    };
+}
+
+#endif // _HANDLE_H_
@@ -0,0 +1,39 @@
+#ifndef _OBJECT_ALLOCATOR_H_
+#define _OBJECT_ALLOCATOR_H_
+
+#include <Core/OSDef.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Sleak {
+
+    /**
+     * @class ObjectAllocator
+     * @brief Size-class pool behind GameObject's operator new / delete.
+     *
+     * Requests are rounded up to a multiple of GRANULARITY and served from
+     * a free list per size, refilled BLOCKS_PER_CHUNK blocks at a time.
+     * Freed blocks go back to their list and are never returned to the
+     * system, so creating and destroying many objects of the same kinds
+     * stops touching the system allocator after the first batch. Sizes
+     * above MAX_POOLED_SIZE fall through to the global operator new.
+     */
+    class ENGINE_API ObjectAllocator {
+    public:
+        static constexpr size_t GRANULARITY = 64;
+        static constexpr size_t MAX_POOLED_SIZE = 2048;
+        static constexpr size_t BLOCKS_PER_CHUNK = 64;
+
+        static void* Allocate(size_t size);
+        static void Free(void* memory, size_t size);
+
+        // Pre-allocates room for count objects of the given size
+        static void Reserve(size_t size, size_t count);
+
+        static size_t GetLiveCount();
+        static size_t GetChunkCount();
+    };
+
+}
+
+#endif // _OBJECT_ALLOCATOR_H_
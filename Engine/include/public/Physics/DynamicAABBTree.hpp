@@ -37,6 +37,11 @@ namespace Physics {
 
         const AABB& GetFatAABB(int proxyId) const { return m_nodes[proxyId].fatAABB; }
         void* GetUserData(int proxyId) const { return m_nodes[proxyId].userData; }
+        void SetUserData(int proxyId, void* userData) { m_nodes[proxyId].userData = userData; }
+
+        // For custom traversals (e.g. frustum culling); NULL_NODE when empty
+        int GetRoot() const { return m_root; }
+        const TreeNode& GetNode(int nodeId) const { return m_nodes[nodeId]; }
 
     private:
         int AllocateNode();
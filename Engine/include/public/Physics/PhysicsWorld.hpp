@@ -4,6 +4,7 @@
 #include <Physics/Colliders.hpp>
 #include <Physics/CollisionDetection.hpp>
 #include <Physics/DynamicAABBTree.hpp>
+#include <Memory/Handle.h>
 #include <vector>
 #include <cstdint>
 
@@ -45,6 +46,9 @@ namespace Sleak {
             void RegisterCollider(ColliderComponent* collider);
             void UnregisterCollider(ColliderComponent* collider);
 
+            // Removes many colliders with a single pass over the collider list
+            void UnregisterColliders(const std::vector<ColliderComponent*>& colliders);
+
             // Query API
             std::vector<CollisionPair> OverlapSphere(const Vector3D& center, float radius, uint32_t layerMask = 0xFFFFFFFF) const;
             std::vector<CollisionPair> OverlapAABB(const AABB& aabb, uint32_t layerMask = 0xFFFFFFFF) const;
@@ -53,12 +57,25 @@ namespace Sleak {
             RayHit Raycast(const Vector3D& origin, const Vector3D& direction,
                            float maxDist, uint32_t layerMask = 0xFFFFFFFF) const;
 
+            size_t GetColliderCount() const { return m_colliders.size(); }
+
         private:
+            // Colliders are tracked by handle so one destroyed without being
+            // unregistered is dropped instead of dereferenced
+            struct ColliderEntry {
+                ColliderComponent* collider = nullptr;
+                Handle<ColliderComponent> handle;
+                int proxyId = -1;
+            };
+
+            void PruneStaleColliders();
             void UpdateBroadphase();
             void FindPairsAndResolve();
+            ColliderComponent* ResolveProxy(int proxyId) const;
 
             DynamicAABBTree m_tree;
-            std::vector<ColliderComponent*> m_colliders;
+            std::vector<ColliderEntry> m_colliders;
+            std::vector<Handle<ColliderComponent>> m_proxyHandles;  // by proxy id
         };
 
     } // namespace Physics
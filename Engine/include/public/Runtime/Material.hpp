@@ -20,6 +20,9 @@
 #define TEXTURE_SLOT_AO         5
 #define TEXTURE_SLOT_EMISSIVE   6
 
+// Constant buffer slot of the material properties
+#define CONSTANT_SLOT_MATERIAL  1
+
 namespace Sleak {
 
     namespace RenderEngine {
@@ -43,6 +46,10 @@ namespace Sleak {
         void Initialize();
         void Bind();
 
+        // New material with the same properties, sharing the shader and
+        // textures. The GPU constant buffer is the clone's own.
+        Material* Clone() const;
+
         // --- Shader ---
 
         void SetShader(RenderEngine::Shader* shader);
@@ -146,24 +153,29 @@ namespace Sleak {
         void SetTwoSided(bool twoSided);
         bool IsTwoSided() const;
 
+        // Lets the render queue merge draws of the same mesh with this
+        // material into one instanced draw (on by default)
+        void SetInstancing(bool enabled);
+        bool IsInstancingEnabled() const;
+
     private:
         // Build GPU-aligned data struct from current properties
         RenderEngine::MaterialGPUData BuildGPUData() const;
 
-        // Shader
-        ObjectPtr<RenderEngine::Shader> m_shader;
+        // Shader and textures are shared with clones
+        RefPtr<RenderEngine::Shader> m_shader;
 
         // GPU constant buffer (slot 1)
         ObjectPtr<RenderEngine::BufferBase> m_materialBuffer;
 
         // Texture maps
-        ObjectPtr<Texture> m_diffuseTexture;
-        ObjectPtr<Texture> m_normalTexture;
-        ObjectPtr<Texture> m_specularTexture;
-        ObjectPtr<Texture> m_roughnessTexture;
-        ObjectPtr<Texture> m_metallicTexture;
-        ObjectPtr<Texture> m_aoTexture;
-        ObjectPtr<Texture> m_emissiveTexture;
+        RefPtr<Texture> m_diffuseTexture;
+        RefPtr<Texture> m_normalTexture;
+        RefPtr<Texture> m_specularTexture;
+        RefPtr<Texture> m_roughnessTexture;
+        RefPtr<Texture> m_metallicTexture;
+        RefPtr<Texture> m_aoTexture;
+        RefPtr<Texture> m_emissiveTexture;
 
         // Color properties (stored as 0-255 Color, converted to float for GPU)
         Math::Color m_diffuseColor  {255, 255, 255, 255};
@@ -189,6 +201,7 @@ namespace Sleak {
         // Rendering state
         MaterialRenderMode m_renderMode = MaterialRenderMode::Opaque;
         bool m_twoSided = false;
+        bool m_instancing = true;
     };
 };
 
@@ -4,12 +4,21 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <vector>
 #include <Utility/Container/List.hpp>
+#include <Runtime/VertexFormat.hpp>
 
 namespace Sleak {
 
     using IndexType = uint32_t;
-    using IndexGroup = List<IndexType>;
+
+    // Width of the indices in an index buffer
+    enum class IndexFormat : uint8_t { UInt16, UInt32 };
+
+    inline constexpr size_t GetIndexSize(IndexFormat format) {
+        return format == IndexFormat::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+    }
 
     struct Vertex {
         float px, py, pz;
@@ -91,9 +100,74 @@ namespace Sleak {
         Sleak::List<Vertex> vertices;
     };
 
+    /**
+     * @class IndexGroup
+     * @brief Triangle indices stored at the narrowest width that holds them.
+     *
+     * Starts out 16-bit and widens to 32-bit on the first index above
+     * 0xFFFF, so GetRawData() is ready to upload with GetFormat().
+     */
+    class IndexGroup {
+    public:
+        IndexGroup() = default;
+
+        IndexGroup(std::initializer_list<IndexType> indexList) {
+            for (IndexType index : indexList) add(index);
+        }
+
+        void add(IndexType index) {
+            if (format == IndexFormat::UInt16 && index > 0xFFFF) Widen();
+
+            if (format == IndexFormat::UInt16)
+                indices16.add(static_cast<uint16_t>(index));
+            else
+                indices32.add(index);
+        }
+
+        void add(std::initializer_list<IndexType> indexList) {
+            for (IndexType index : indexList) add(index);
+        }
+
+        IndexType operator[](size_t index) const {
+            return format == IndexFormat::UInt16 ? IndexType(indices16[index]) : indices32[index];
+        }
+
+        // Copy widened to 32-bit, for CPU users such as colliders
+        std::vector<IndexType> ToVector() const {
+            std::vector<IndexType> result(GetSize());
+            for (size_t i = 0; i < result.size(); ++i) result[i] = (*this)[i];
+            return result;
+        }
+
+        IndexFormat GetFormat() const { return format; }
+        size_t GetSize() const {
+            return format == IndexFormat::UInt16 ? indices16.GetSize() : indices32.GetSize();
+        }
+        size_t GetByteSize() const { return GetSize() * GetIndexSize(format); }
+        void* GetRawData() {
+            return format == IndexFormat::UInt16 ? indices16.GetRawData() : indices32.GetRawData();
+        }
+        const void* GetRawData() const {
+            return format == IndexFormat::UInt16 ? indices16.GetRawData() : indices32.GetRawData();
+        }
+
+    private:
+        void Widen() {
+            indices32.resize(indices16.GetCapacity());
+            for (uint16_t index : indices16) indices32.add(index);
+            indices16 = List<uint16_t>();
+            format = IndexFormat::UInt32;
+        }
+
+        List<uint16_t> indices16;
+        List<IndexType> indices32;
+        IndexFormat format = IndexFormat::UInt16;
+    };
+
     struct MeshData {
         VertexGroup vertices;
         IndexGroup indices;
+        VertexLayout layout = VertexLayout::Standard;   // What MeshComponent uploads
     };
 
 }
@@ -30,6 +30,8 @@ namespace Sleak {
         bool flipUVs = true;
         bool flipNormals = false;
         bool flipWinding = false;
+        // Upload meshes in StaticCompact/SkinnedCompact layouts (VertexFormat.hpp)
+        bool compactVertices = false;
         Math::Vector3D position = Math::Vector3D(0.0f, 0.0f, 0.0f);
         Math::Quaternion rotation = Math::Quaternion();
     };
@@ -0,0 +1,63 @@
+#ifndef _PRIMITIVE_CACHE_HPP_
+#define _PRIMITIVE_CACHE_HPP_
+
+#include <Core/OSDef.hpp>
+#include <Memory/RefPtr.h>
+#include <Physics/Colliders.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Sleak {
+
+    struct MeshData;
+    class Material;
+
+    namespace RenderEngine {
+        class BufferBase;
+    }
+
+    /**
+     * @struct PrimitiveMesh
+     * @brief GPU buffers of one generated primitive, shared by every object
+     * created with the same parameters.
+     */
+    struct PrimitiveMesh {
+        RefPtr<RenderEngine::BufferBase> vertexBuffer;
+        RefPtr<RenderEngine::BufferBase> indexBuffer;
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+
+        // CPU copy for collider fitting, owned by the cache
+        const MeshData* meshData = nullptr;
+
+        // Object-space vertex bounds, for MeshComponent::SetLocalBounds
+        Physics::AABB bounds;
+    };
+
+    /**
+     * @class PrimitiveCache
+     * @brief Generates each primitive mesh once per set of parameters and
+     * hands out the same ref-counted buffers afterwards. Also owns the
+     * default material the GameObject::Create* factories share.
+     *
+     * Entries live until Clear(), which must run before the renderer is
+     * destroyed. Returned references stay valid until then.
+     */
+    class ENGINE_API PrimitiveCache {
+    public:
+        static const PrimitiveMesh& GetPlane(int width, int height);
+        static const PrimitiveMesh& GetCube();
+        static const PrimitiveMesh& GetSphere(int stacks, int slices);
+        static const PrimitiveMesh& GetCapsule(int segments, int rings, float height, float radius);
+        static const PrimitiveMesh& GetCylinder(int segments, float height, float radius);
+
+        // Loaded on first use; objects use it copy-on-write
+        static RefPtr<Material> GetDefaultMaterial();
+
+        static void Clear();
+        static size_t GetMeshCount();
+    };
+
+}
+
+#endif // _PRIMITIVE_CACHE_HPP_
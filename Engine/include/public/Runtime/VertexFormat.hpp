@@ -0,0 +1,124 @@
+#ifndef _VERTEXFORMAT_HPP_
+#define _VERTEXFORMAT_HPP_
+
+#include <Core/OSDef.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Sleak {
+
+    struct Vertex;
+
+    /**
+     * How a mesh's vertices are stored on the GPU. The CPU side always
+     * keeps full Vertex data; the layout only decides what MeshComponent
+     * uploads.
+     *
+     *  - Standard:       Vertex as is, 96 bytes
+     *  - StaticCompact:  octahedral normal, half tangent, 8-bit color and
+     *                    half UVs, 32 bytes. Meshes without bones.
+     *  - SkinnedCompact: StaticCompact plus 8-bit bone indices and 8-bit
+     *                    unorm weights, 40 bytes
+     */
+    enum class VertexLayout : uint8_t {
+        Standard = 0,
+        StaticCompact = 1,
+        SkinnedCompact = 2,
+        Count = 3
+    };
+
+    // Attribute formats, as the input assembler reads them
+    enum class VertexAttributeFormat : uint8_t {
+        Float2,
+        Float3,
+        Float4,
+        Int4,       // 32-bit signed integers
+        Half2,
+        Half4,
+        Snorm16x2,  // Read as floats in [-1, 1]
+        Unorm8x4,   // Read as floats in [0, 1]
+        Uint8x4     // Read as integers
+    };
+
+    // Shader input locations, shared by every backend and layout
+    enum VertexAttributeLocation : uint8_t {
+        VERTEX_POSITION = 0,
+        VERTEX_NORMAL = 1,
+        VERTEX_TANGENT = 2,
+        VERTEX_COLOR = 3,
+        VERTEX_TEXCOORD = 4,
+        VERTEX_BONE_IDS = 5,
+        VERTEX_BONE_WEIGHTS = 6
+    };
+
+    struct VertexAttribute {
+        uint8_t location;
+        VertexAttributeFormat format;
+        uint16_t offset;
+    };
+
+    struct VertexLayoutDesc {
+        uint32_t stride;
+        const VertexAttribute* attributes;
+        uint32_t attributeCount;
+    };
+
+    // Normal packed into two snorm16 values on the octahedron
+    struct StaticCompactVertex {
+        float px, py, pz;           // 12
+        int16_t normal[2];          // 4
+        uint16_t tangent[4];        // 8, half floats
+        uint8_t color[4];           // 4, unorm
+        uint16_t uv[2];             // 4, half floats
+    };
+
+    struct SkinnedCompactVertex {
+        float px, py, pz;
+        int16_t normal[2];
+        uint16_t tangent[4];
+        uint8_t color[4];
+        uint16_t uv[2];
+        uint8_t boneIDs[4];         // 4, unused slots are bone 0 weighted 0
+        uint8_t boneWeights[4];     // 4, unorm, sum to 255
+    };
+
+    static_assert(sizeof(StaticCompactVertex) == 32, "StaticCompactVertex must stay 32 bytes");
+    static_assert(sizeof(SkinnedCompactVertex) == 40, "SkinnedCompactVertex must stay 40 bytes");
+
+    namespace VertexFormat {
+        ENGINE_API const VertexLayoutDesc& GetLayoutDesc(VertexLayout layout);
+        ENGINE_API uint32_t GetStride(VertexLayout layout);
+        ENGINE_API uint32_t GetComponentCount(VertexAttributeFormat format);
+
+        // Highest bone index a SkinnedCompact vertex can hold
+        static constexpr int MAX_COMPACT_BONE = 255;
+
+        // Largest UV magnitude the compact layouts store. Half floats step
+        // by 1/1024 up to 2, coarser past it: tiled UVs would swim.
+        static constexpr float MAX_COMPACT_UV = 2.0f;
+
+        // Whether every vertex can be stored in the layout without loss
+        // beyond its precision (bone indices fitting in 8 bits, UVs within
+        // MAX_COMPACT_UV)
+        ENGINE_API bool CanEncode(const Vertex* vertices, size_t count, VertexLayout layout);
+
+        ENGINE_API uint16_t FloatToHalf(float value);
+        ENGINE_API float HalfToFloat(uint16_t value);
+
+        // Unit normal <-> octahedral snorm16 pair
+        ENGINE_API void EncodeOctahedral(float x, float y, float z, int16_t out[2]);
+        ENGINE_API void DecodeOctahedral(const int16_t in[2], float& x, float& y, float& z);
+
+        ENGINE_API void Encode(const Vertex& vertex, StaticCompactVertex& out);
+        ENGINE_API void Encode(const Vertex& vertex, SkinnedCompactVertex& out);
+        ENGINE_API void Decode(const StaticCompactVertex& vertex, Vertex& out);
+        ENGINE_API void Decode(const SkinnedCompactVertex& vertex, Vertex& out);
+
+        // Packs vertices in the layout, ready for upload
+        ENGINE_API std::vector<uint8_t> EncodeVertices(const Vertex* vertices, size_t count,
+                                                       VertexLayout layout);
+    }
+}
+
+#endif
@@ -2,11 +2,14 @@
 #define _QUEUE_H_
 
 #include "List.hpp"
-#include <sstream>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace Sleak
 {
-	
+
 	/**
 	 * @class Queue
 	 * @brief Implements a FIFO (First-In, First-Out) queue data structure.
@@ -23,70 +26,213 @@ namespace Sleak
 	 * - Simulating real-world queues, such as waiting lines.
 	 *
 	 * Implementation Details:
-	 * - Uses an underlying List to store the queue elements.
-	 * - Provides methods for enqueueing (adding) and dequeueing (removing) elements.
-	 * - Maintains the FIFO order of elements.
+	 * - Stores the elements in a ring buffer whose capacity is a power of two,
+	 *   so push and pop are O(1) and never shift the other elements.
+	 * - Grows by doubling when full; clear, pop and drain keep the memory.
+	 * - Elements only need to be move constructible, move-only types work.
+	 * - operator[] and the iterators index from the front of the queue.
 	 */
 	template <typename T>
 	class Queue {
 	public:
 	    Queue() = default;
-	
+
+	    Queue(const Queue& other) {
+	        reserve(other.count);
+	        for (size_t i = 0; i < other.count; ++i)
+	            push(other[i]);
+	    }
+
+	    Queue(Queue&& other) noexcept
+	        : data(other.data), head(other.head), count(other.count), cap(other.cap) {
+	        other.data = nullptr;
+	        other.head = other.count = other.cap = 0;
+	    }
+
+	    Queue& operator=(const Queue& other) {
+	        if (this != &other) {
+	            Queue copy(other);
+	            swap(copy);
+	        }
+	        return *this;
+	    }
+
+	    Queue& operator=(Queue&& other) noexcept {
+	        if (this != &other) {
+	            Queue moved(std::move(other));
+	            swap(moved);
+	        }
+	        return *this;
+	    }
+
+	    ~Queue() {
+	        clear();
+	        ::operator delete(data, std::align_val_t(alignof(T)));
+	    }
+
 	    void push(const T& value) {
-	        data.add(value);
+	        emplace(value);
+	    }
+
+	    void push(T&& value) {
+	        emplace(std::move(value));
+	    }
+
+	    template <typename... Args>
+	    T& emplace(Args&&... args) {
+	        if (count == cap) grow(cap ? cap * 2 : MIN_CAPACITY);
+	        T* slot = new (data + ((head + count) & (cap - 1))) T(std::forward<Args>(args)...);
+	        ++count;
+	        return *slot;
 	    }
-	
+
 	    T pop() {
 	        if (isEmpty()) {
 	            throw Sleak::EmptyContainerException();
 	        }
-	
-	        T front = std::move(data[0]);
-	
-	        data.erase(0);
-	
+
+	        T front = std::move(data[head]);
+	        data[head].~T();
+	        head = (head + 1) & (cap - 1);
+	        --count;
+
 	        return front;
 	    }
-	
+
+	    /**
+	     * Pops every element in order, handing each to fn as an rvalue.
+	     * Cheaper than a pop() loop and keeps the capacity. Elements pushed
+	     * by fn are drained too.
+	     */
+	    template <typename Fn>
+	    void drain(Fn&& fn) {
+	        while (count > 0) {
+	            T& front = data[head];
+	            head = (head + 1) & (cap - 1);
+	            --count;
+
+	            // Unlinked before the call: fn may push, which can move the storage
+	            T value = std::move(front);
+	            front.~T();
+	            fn(std::move(value));
+	        }
+	        head = 0;
+	    }
+
 	    T& front() {
 	        if (isEmpty()) {
 	            throw Sleak::EmptyContainerException();
 	        }
-	        return data[0];
+	        return data[head];
 	    }
-	
+
 	    const T& front() const {
 	        if (isEmpty()) {
 	            throw Sleak::EmptyContainerException();
 	        }
-	        return data[0];
+	        return data[head];
 	    }
 
+	    // i-th element from the front, unchecked
+	    T& operator[](size_t i) { return data[(head + i) & (cap - 1)]; }
+	    const T& operator[](size_t i) const { return data[(head + i) & (cap - 1)]; }
+
 		const void reverse() {
-			data.reverse();
+			for (size_t i = 0, j = count; i + 1 < j; ++i, --j) {
+				using std::swap;
+				swap((*this)[i], (*this)[j - 1]);
+			}
 		}
-	
+
 	    bool isEmpty() const {
-	        return data.GetSize() == 0;
+	        return count == 0;
+	    }
+
+	    size_t size() const { return count; }
+	    size_t capacity() const { return cap; }
+
+	    // Makes room for at least n elements without further allocation
+	    void reserve(size_t n) {
+	        if (n <= cap) return;
+	        size_t newCap = cap ? cap : MIN_CAPACITY;
+	        while (newCap < n) newCap *= 2;
+	        grow(newCap);
 	    }
-	
-	    size_t size() const { return data.GetSize(); }
-	
+
 	    void clear() {
-	        data.clear();
+	        if constexpr (!std::is_trivially_destructible_v<T>) {
+	            for (size_t i = 0; i < count; ++i)
+	                (*this)[i].~T();
+	        }
+	        head = 0;
+	        count = 0;
 	    }
 
-		List<T> GetData() { return data; }
+		List<T> GetData() {
+			List<T> result;
+			for (size_t i = 0; i < count; ++i)
+				result.add((*this)[i]);
+			return result;
+		}
+
+		void swap(Queue& other) noexcept {
+			std::swap(data, other.data);
+			std::swap(head, other.head);
+			std::swap(count, other.count);
+			std::swap(cap, other.cap);
+		}
+
+		template <typename Q, typename V>
+		class Iterator {
+		public:
+			Iterator(Q* queue, size_t index) : queue(queue), index(index) {}
+
+			V& operator*() const { return (*queue)[index]; }
+			V* operator->() const { return &(*queue)[index]; }
+			Iterator& operator++() { ++index; return *this; }
+			bool operator==(const Iterator& other) const { return index == other.index; }
+			bool operator!=(const Iterator& other) const { return index != other.index; }
+
+		private:
+			Q* queue;
+			size_t index;
+		};
+
+		using iterator = Iterator<Queue, T>;
+		using const_iterator = Iterator<const Queue, const T>;
 
 		// Iterators
-		T* begin() { return data.begin(); }
-		const T* begin() const { return data.begin(); }
-		T* end() { return data.end(); }
-		const T* end() const { return data.end(); }
+		iterator begin() { return iterator(this, 0); }
+		const_iterator begin() const { return const_iterator(this, 0); }
+		iterator end() { return iterator(this, count); }
+		const_iterator end() const { return const_iterator(this, count); }
 
 	private:
-	    List<T> data;
+	    static constexpr size_t MIN_CAPACITY = 16;
+
+	    // newCap: power of two, > count
+	    void grow(size_t newCap) {
+	        T* newData = static_cast<T*>(
+	            ::operator new(newCap * sizeof(T), std::align_val_t(alignof(T))));
+
+	        // Unwrap so the front lands at index 0
+	        for (size_t i = 0; i < count; ++i) {
+	            T& element = (*this)[i];
+	            new (newData + i) T(std::move_if_noexcept(element));
+	            element.~T();
+	        }
+
+	        ::operator delete(data, std::align_val_t(alignof(T)));
+	        data = newData;
+	        head = 0;
+	        cap = newCap;
+	    }
+
+	    T* data = nullptr;
+	    size_t head = 0;
+	    size_t count = 0;
+	    size_t cap = 0;
 	};
 }
 
-#endif // _QUEUE_H_
\ No newline at end of file
+#endif // _QUEUE_H_
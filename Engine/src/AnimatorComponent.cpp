@@ -55,6 +55,11 @@ bool AnimatorComponent::Initialize() {
 }
 
 void AnimatorComponent::Update(float deltaTime) {
+    Evaluate(deltaTime);
+    UploadBones();
+}
+
+void AnimatorComponent::Evaluate(float deltaTime) {
     if (!bIsInitialized)
         return;
 
@@ -76,10 +81,7 @@ void AnimatorComponent::Update(float deltaTime) {
             ComputeBoneTransformsForClip(req.clipA, req.timeA, m_boneMatrices);
         }
 
-        // Upload bone matrices to GPU
-        uint32_t bufferSize = static_cast<uint32_t>(
-            m_skeleton->GetBoneCount() * sizeof(Math::Matrix4));
-        m_boneBuffer->Update(m_boneMatrices.data(), bufferSize);
+        m_bonesDirty = true;
         return;
     }
 
@@ -104,11 +106,18 @@ void AnimatorComponent::Update(float deltaTime) {
     }
 
     ComputeBoneTransforms(m_currentTime);
+    m_bonesDirty = true;
+}
+
+void AnimatorComponent::UploadBones() {
+    if (!m_bonesDirty)
+        return;
 
     // Upload bone matrices to GPU
     uint32_t bufferSize = static_cast<uint32_t>(
         m_skeleton->GetBoneCount() * sizeof(Math::Matrix4));
     m_boneBuffer->Update(m_boneMatrices.data(), bufferSize);
+    m_bonesDirty = false;
 }
 
 // --- State machine ---
@@ -1,11 +1,15 @@
 #include "../../include/public/Core/Application.hpp"
 #include "../../include/private/Graphics/RendererFactory.hpp" 
 #include "../../include/private/Graphics/RenderCommandQueue.hpp" 
+#include "../../include/private/Graphics/RenderThread.hpp"
 #include <WindowHelper.hpp>
 #include <Graphics/Renderer.hpp>
 #include <Window.hpp>
+#include <charconv>
+#include <cmath>
 #include <cstring>
 #include <exception>
+#include <limits>
 #include <stdexcept>
 #include "Graphics/Vulkan/VulkanRenderer.hpp"
 #include "Logger.hpp"
@@ -14,6 +18,7 @@
 #include <Runtime/InternalGeometry.hpp>
 #include <Camera/Camera.hpp>
 #include <Core/GameObject.hpp>
+#include <Core/JobSystem.hpp>
 #include <Math/Quaternion.hpp>
 #include <Math/Random.hpp>
 #include <Utility/Container/List.hpp>
@@ -27,6 +32,7 @@
 #include "ECS/Components/FirstPersonController.hpp"
 #include <Runtime/Skybox.hpp>
 #include <Runtime/Material.hpp>
+#include <Runtime/PrimitiveCache.hpp>
 #include <Debug/DebugOverlay.hpp>
 
 using namespace Sleak;
@@ -36,6 +42,29 @@ int width = 1200;
 int height = 800;
 
 namespace Sleak {
+    namespace {
+        // Reads "<flag> <number>" into value. A value that is not a number
+        // or outside [min, max] is reported and leaves the default.
+        template<typename T>
+        void ReadNumberArg(const Arguments& args, const char* flag, T& value, T min, T max) {
+            const std::string text = args[flag];
+            if (text.empty()) return;
+
+            T parsed{};
+            const char* end = text.data() + text.size();
+            auto [last, error] = std::from_chars(text.data(), end, parsed);
+            bool valid = error == std::errc() && last == end && parsed >= min && parsed <= max;
+            if constexpr (std::is_floating_point_v<T>) valid = valid && std::isfinite(parsed);
+
+            if (!valid) {
+                SLEAK_ERROR("Invalid value '{}' for {}: expected a number from {} to {}, keeping {}",
+                            text, flag, min, max, value);
+                return;
+            }
+            value = parsed;
+        }
+    }
+
     Application* Application::Instance = nullptr;
 
     Application::Application(const char* Name) : 
@@ -50,15 +79,34 @@ namespace Sleak {
         }
         Instance = this;
 
+        const Arguments& args = Specification.CommandLineArgs;
         int width = 1200, height = 800;
-        if (Specification.CommandLineArgs.Size > 1) {
-            if (!Specification.CommandLineArgs["-w"].empty())
-                width = std::stoi(Specification.CommandLineArgs["-w"]);
-            if (!Specification.CommandLineArgs["-h"].empty())
-                height = std::stoi(Specification.CommandLineArgs["-h"]);
-            if (!Specification.CommandLineArgs["-t"].empty())
-                Specification.Name = Specification.CommandLineArgs["-t"];
-        }
+        ReadNumberArg(args, "-w", width, 1, 16384);
+        ReadNumberArg(args, "-h", height, 1, 16384);
+        if (!args["-t"].empty())
+            Specification.Name = args["-t"];
+
+        // Worker threads: "-j <count>", defaults to one per spare core
+        uint32_t workerCount = 0;
+        ReadNumberArg(args, "-j", workerCount, 0u, 256u);
+        JobSystem::Initialize(workerCount);
+
+        // Stop after "-frames <count>" frames, 0 runs until closed
+        ReadNumberArg(args, "-frames", m_frameLimit, uint64_t(0), std::numeric_limits<uint64_t>::max());
+
+        // Simulated seconds per headless frame: "-dt <seconds>"
+        ReadNumberArg(args, "-dt", m_headlessStep, 1e-6f, 10.0f);
+
+        // Execute frames on a dedicated render thread: "-render-thread 1"
+        int renderThread = m_renderThreadRequested ? 1 : 0;
+        ReadNumberArg(args, "-render-thread", renderThread, 0, 1);
+        m_renderThreadRequested = renderThread != 0;
+
+        // Write recorded frames for offline replay:
+        // "-capture <file> [-capture-start <frame>] [-capture-frames <count>]"
+        m_captureFile = args["-capture"];
+        ReadNumberArg(args, "-capture-start", m_captureStart, uint64_t(0), std::numeric_limits<uint64_t>::max());
+        ReadNumberArg(args, "-capture-frames", m_captureFrames, 1u, std::numeric_limits<uint32_t>::max());
 
         CoreWindow = new Window(width,height,Specification.Name);
         
@@ -83,6 +131,9 @@ namespace Sleak {
             renderer = RenderEngine::RendererFactory::CreateRenderer(RenderEngine::RendererType::Vulkan, CoreWindow);
         }
 
+        // "-r null": the window is only kept for its size, it is never opened
+        m_headless = renderer->GetType() == RenderEngine::RendererType::Null;
+
         EventDispatcher::RegisterEventHandler(this,&Application::OnKeyPressed);
         EventDispatcher::RegisterEventHandler(this, &Application::OnWindowResize);
         EventDispatcher::RegisterEventHandler(this, &Application::OnWindowFullScreen);
@@ -90,6 +141,10 @@ namespace Sleak {
     }
 
     Application::~Application() {
+        // The frame in flight still uses the renderer and the queue
+        delete m_renderThread;
+        m_renderThread = nullptr;
+
         // Wait for GPU to finish before destroying any resources
         if (renderer)
             renderer->Cleanup();
@@ -98,15 +153,23 @@ namespace Sleak {
         // whose components hold render resources (buffers, etc.)
         delete Game;
         delete m_DebugOverlay;
+
+        // Cached primitive buffers and the default material are GPU resources too
+        PrimitiveCache::Clear();
+        RenderEngine::RenderCommandQueue::GetInstance()->Clear();
         delete renderer;
         delete CoreWindow;
+
+        // Last: scene and renderer teardown may still wait on jobs
+        JobSystem::Shutdown();
         SLEAK_LOG("The application has been successfully closed, have a good day sir");
     }
 
     int Application::Run(GameBase* game) {
         Game = game;
 
-        float lastTime = FrameTimer.Elapsed();
+        if (m_headless)
+            return RunHeadless();
 
         if(CoreWindow && CoreWindow->InitializeWindow()) {
 
@@ -119,24 +182,15 @@ namespace Sleak {
             m_DebugOverlay = new DebugOverlay();
             m_DebugOverlay->Initialize(renderer, game);
 
-            auto context = renderer->GetContext();
-            auto queue = RenderEngine::RenderCommandQueue::GetInstance();
-
             float lastTime = FrameTimer.Elapsed();
-            float accumulator = 0.0f;
-            const float fixedTimestep = 1.0f / 60.0f;  
 
             // Initialize and begin the game (and scene)
-            if (Game) {
-                if (!Game->Initialize()) {
-                    SLEAK_FATAL("Game failed to initialize!");
-                    return -1;
-                }
+            if (!BeginGame())
+                return -1;
 
-                Game->Begin();
-            }
+            StartRenderThread();
 
-            while(!CoreWindow->ShouldClose()) {
+            while(!CoreWindow->ShouldClose() && !ShouldStop()) {
                 
                 float currentTime = FrameTimer.Elapsed();
                 DeltaTime = currentTime - lastTime;
@@ -148,37 +202,22 @@ namespace Sleak {
 
                 CoreWindow->Update();
 
-                renderer->BeginRender();
+                // Jobs that asked to run on the main thread (window, GPU...)
+                JobSystem::RunMainThreadJobs();
 
-                // Update active scene if present
-                if (Game && Game->GetActiveScene()) {
-                    auto* activeScene = Game->GetActiveScene();
+                BeginFrame();
 
-                    // Fixed timestep updates (physics, etc.)
-                    accumulator += DeltaTime;
-                    while (accumulator >= fixedTimestep) {
-                        activeScene->FixedUpdate(fixedTimestep);
-                        accumulator -= fixedTimestep;
-                    }
-
-                    // Per-frame update
-                    activeScene->Update(DeltaTime);
+                UpdateFrame(DeltaTime);
 
-                    // Late update (after all updates, e.g. camera follow)
-                    activeScene->LateUpdate(DeltaTime);
-                }
-
-                // Per-frame game logic
-                if (Game)
-                    Game->Loop(DeltaTime);
-                if (m_DebugOverlay)
+                // ImGui is driven by BeginRender / EndRender: only on this thread
+                if (m_DebugOverlay && !m_renderThread)
                     m_DebugOverlay->Render(DeltaTime);
 
-                if (queue && context)
-                    queue->ExecuteCommands(context);
-
-                renderer->EndRender();
+                EndFrame();
             }
+
+            if (m_renderThread)
+                m_renderThread->Stop();
         } 
         else{
             SLEAK_FATAL("Unable to initialize graphics!");
@@ -194,7 +233,128 @@ namespace Sleak {
         return 0;
     }
 
+    int Application::RunHeadless() {
+        if (!renderer || !renderer->Initialize()) {
+            SLEAK_FATAL("Unable to initialize the headless renderer!");
+            return -1;
+        }
+
+        renderer->CreateImGUI();
+
+        if (!BeginGame())
+            return -1;
+
+        StartRenderThread();
+
+        if (m_frameLimit == 0)
+            SLEAK_WARN("Running headless without a frame limit, stop with Application::Quit or -frames");
+
+        while (!ShouldStop()) {
+            // Nothing paces these frames: each one advances the simulation
+            // by a fixed step and the loop runs as fast as the CPU allows
+            DeltaTime = m_headlessStep;
+
+            JobSystem::RunMainThreadJobs();
+
+            BeginFrame();
+            UpdateFrame(DeltaTime);
+            EndFrame();
+        }
+
+        if (m_renderThread)
+            m_renderThread->Stop();
+
+        SLEAK_INFO("Headless run finished after {} frames ({:.2f}s real time)",
+                   m_frameCount, FrameTimer.Elapsed());
+        return 0;
+    }
+
+    bool Application::BeginGame() {
+        if (!Game)
+            return true;
+
+        if (!Game->Initialize()) {
+            SLEAK_FATAL("Game failed to initialize!");
+            return false;
+        }
+
+        Game->Begin();
+        return true;
+    }
+
+    void Application::StartRenderThread() {
+        if (!m_renderThreadRequested)
+            return;
+
+        m_renderThread = new RenderEngine::RenderThread();
+        if (!m_renderThread->Start(renderer)) {
+            SLEAK_WARN("Render thread unavailable, frames execute on the main thread");
+            delete m_renderThread;
+            m_renderThread = nullptr;
+        }
+    }
+
+    void Application::BeginFrame() {
+        if (!m_captureFile.empty() && m_frameCount == m_captureStart)
+            RenderEngine::RenderCommandQueue::GetInstance()->BeginCapture(m_captureFile, m_captureFrames);
+
+        // The render thread begins each frame itself, right before executing it
+        if (!m_renderThread)
+            renderer->BeginRender();
+    }
+
+    void Application::EndFrame() {
+        if (m_renderThread) {
+            // Waits for the previous frame, then returns while this one executes
+            m_renderThread->Submit();
+        }
+        else {
+            auto context = renderer->GetContext();
+            auto queue = RenderEngine::RenderCommandQueue::GetInstance();
+            if (queue && context) {
+                queue->ExecuteCommands(context);
+                queue->AddFrameStats(renderer);
+            }
+
+            renderer->EndRender();
+        }
+
+        m_frameCount++;
+    }
+
+    void Application::UpdateFrame(float deltaTime) {
+        const float fixedTimestep = 1.0f / 60.0f;
+
+        // Update active scene if present
+        if (Game && Game->GetActiveScene()) {
+            auto* activeScene = Game->GetActiveScene();
+
+            // Fixed timestep updates (physics, etc.)
+            m_accumulator += deltaTime;
+            while (m_accumulator >= fixedTimestep) {
+                activeScene->FixedUpdate(fixedTimestep);
+                m_accumulator -= fixedTimestep;
+            }
+
+            // Per-frame update
+            activeScene->Update(deltaTime);
+
+            // Late update (after all updates, e.g. camera follow)
+            activeScene->LateUpdate(deltaTime);
+        }
+
+        // Per-frame game logic
+        if (Game)
+            Game->Loop(deltaTime);
+    }
+
+    bool Application::ShouldStop() const {
+        return m_quitRequested || (m_frameLimit != 0 && m_frameCount >= m_frameLimit);
+    }
+
     void Application::OnWindowResize(const Sleak::Events::WindowResizeEvent& e) {
+        // Swapchain and targets are replaced: no frame may be in flight
+        RenderEngine::RenderThread::Sync();
         renderer->Resize(e.GetWidth(), e.GetHeight());
 
         width = e.GetWidth();
@@ -204,8 +364,10 @@ namespace Sleak {
     void Application::OnWindowFullScreen(const Sleak::Events::WindowFullScreen& e) {
         int w = Window::GetWidth();
         int h = Window::GetHeight();
-        if (w > 0 && h > 0)
+        if (w > 0 && h > 0) {
+            RenderEngine::RenderThread::Sync();
             renderer->Resize(w, h);
+        }
     }
 
     void Application::onMouseClick(const Sleak::Events::Input::MouseButtonPressedEvent& e) {
@@ -2,6 +2,7 @@
 #include <ECS/Components/TransformComponent.hpp>
 #include <Math/Math.hpp>
 #include <Window.hpp>
+#include <cstring>
 
 namespace Sleak {
 
@@ -9,6 +10,11 @@ namespace Sleak {
     Math::Matrix4 Camera::Projection = Math::Matrix4::Identity();
     Math::Vector3D Camera::MainPosition = Math::Vector3D(0, 0, 0);
     ViewFrustum Camera::s_frustum;
+    uint64_t Camera::s_version = 1;
+
+    static bool SameMatrix(const Math::Matrix4& a, const Math::Matrix4& b) {
+        return std::memcmp(&a, &b, sizeof(Math::Matrix4)) == 0;
+    }
 
     Camera::Camera(std::string Name, Math::Vector3D Position, float Fov, float Near, float Far) : GameObject(Name) {
         this->Position = Position;
@@ -51,9 +57,14 @@ namespace Sleak {
     void Camera::RecalculateViewMatrix() {
         MainPosition = Position;
 
-        View = Matrix4::LookAt(Position.BaseVector(),   // Position
-                               LookTarget.BaseVector(), // Target
-                               Up.BaseVector());        // Up
+        Math::Matrix4 view = Matrix4::LookAt(Position.BaseVector(),   // Position
+                                             LookTarget.BaseVector(), // Target
+                                             Up.BaseVector());        // Up
+
+        // Transforms re-upload their constant buffers only after a change
+        if (SameMatrix(view, View)) return;
+        View = view;
+        ++s_version;
 
         // Update view frustum from VP = View * Projection (row-vector convention)
         Math::Matrix4 VP = View * Projection;
@@ -61,14 +72,22 @@ namespace Sleak {
     }
 
     void Camera::RecalculateProjectionMatrix() {
+        Math::Matrix4 projection;
         if(type == ProjectionType::Perspective)
-            Projection = Matrix4::Perspective(fieldOfView * D2R, // Fov
+            projection = Matrix4::Perspective(fieldOfView * D2R, // Fov
                                               width/height,      // Aspect Ratio
                                               nearPlane,         // Near Plane
                                               farPlane);         // Far Plane
         else
-            Projection = Matrix4::Orthographic(-width / 2.0f, width / 2.0f, 
+            projection = Matrix4::Orthographic(-width / 2.0f, width / 2.0f, 
                                                -height / 2.0f, height / 2.0f, 
                                                 nearPlane, farPlane);
+
+        if (SameMatrix(projection, Projection)) return;
+        Projection = projection;
+        ++s_version;
+
+        // The frustum depends on both matrices
+        s_frustum.ExtractFromVP(View * Projection);
     }
 }
\ No newline at end of file
@@ -59,12 +59,11 @@ ColliderComponent::ColliderComponent(GameObject* owner, const MeshData& meshData
     if (asMesh) {
         const Vertex* verts = meshData.vertices.GetData();
         size_t vertCount = meshData.vertices.GetSize();
-        const IndexType* indices = meshData.indices.GetData();
-        size_t indexCount = meshData.indices.GetSize();
+        const std::vector<IndexType> indices = meshData.indices.ToVector();
 
         Physics::TriangleMesh mesh;
         mesh.Build(&verts[0].px, vertCount, sizeof(Vertex),
-                   indices, indexCount);
+                   indices.data(), indices.size());
         m_shape = std::move(mesh);
         m_type = Physics::ColliderType::Mesh;
     } else {
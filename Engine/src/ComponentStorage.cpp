@@ -0,0 +1,214 @@
+#include <ECS/ComponentStorage.hpp>
+#include <Core/GameObject.hpp>
+#include <Utility/Exception.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace Sleak {
+
+    ComponentStorage* ComponentStorage::Instance = nullptr;
+
+    // --- Type registry ---
+
+    ComponentTypeID ComponentTypeRegistry::Register(const std::type_index& type) {
+        static std::mutex lock;
+        static std::unordered_map<std::type_index, ComponentTypeID> ids;
+
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = ids.find(type);
+        if (it != ids.end()) return it->second;
+
+        ComponentTypeID id =
+            BUILTIN_COMPONENT_COUNT + static_cast<ComponentTypeID>(ids.size());
+        if (id >= MAX_COMPONENT_TYPES) {
+            SLEAK_ERROR("Too many component types (max {}), cannot register {}",
+                        MAX_COMPONENT_TYPES, type.name());
+            throw InvalidArgumentException("Component type limit reached");
+        }
+
+        ids.emplace(type, id);
+        return id;
+    }
+
+    namespace {
+        // Base-class lookup state, indexed by component type ID
+        struct LineageTable {
+            std::mutex lock;
+            ComponentTypeRegistry::InstanceTest tests[MAX_COMPONENT_TYPES] = {};
+            std::atomic<ComponentMask> tracked{0};      // Types with a test
+            std::atomic<ComponentMask> classified{0};   // Concrete types seen
+            // Per concrete type: the tracked types it was tested against
+            std::atomic<ComponentMask> tested[MAX_COMPONENT_TYPES] = {};
+            // Per tracked type: the concrete types that are one
+            std::atomic<ComponentMask> derived[MAX_COMPONENT_TYPES] = {};
+        };
+
+        LineageTable& GetLineageTable() {
+            static LineageTable table;
+            return table;
+        }
+    }
+
+    ComponentTypeID ComponentTypeRegistry::Track(ComponentTypeID type, InstanceTest test) {
+        LineageTable& table = GetLineageTable();
+        std::lock_guard<std::mutex> guard(table.lock);
+
+        const ComponentMask bit = MaskOf(type);
+        if (table.tracked & bit) return type;
+        table.tests[type] = test;
+
+        // Types attached before are tested on a live component now; a type
+        // with none left is tested when it is attached again
+        ComponentMask derived = bit;
+        const ComponentMask classified = table.classified;
+        for (ComponentTypeID concrete = 0; concrete < MAX_COMPONENT_TYPES; ++concrete) {
+            if (!(classified & MaskOf(concrete))) continue;
+            if (const Component* component = ComponentStorage::Get().FindAttached(concrete)) {
+                if (test(component)) derived |= MaskOf(concrete);
+                table.tested[concrete] |= bit;
+            }
+        }
+
+        table.derived[type] = derived;
+        table.tracked |= bit;
+        return type;
+    }
+
+    ComponentMask ComponentTypeRegistry::DerivedMask(ComponentTypeID type) {
+        return GetLineageTable().derived[type].load(std::memory_order_acquire);
+    }
+
+    void ComponentTypeRegistry::Classify(ComponentTypeID type, const Component* component) {
+        LineageTable& table = GetLineageTable();
+        const ComponentMask bit = MaskOf(type);
+
+        // Nothing was tracked since this type was last tested
+        if ((table.classified.load(std::memory_order_acquire) & bit) &&
+            table.tested[type].load(std::memory_order_acquire) == table.tracked.load(std::memory_order_acquire))
+            return;
+
+        std::lock_guard<std::mutex> guard(table.lock);
+        const ComponentMask untested = table.tracked & ~table.tested[type];
+        for (ComponentTypeID tracked = 0; tracked < MAX_COMPONENT_TYPES; ++tracked) {
+            if ((untested & MaskOf(tracked)) && table.tests[tracked](component))
+                table.derived[tracked] |= bit;
+        }
+        table.tested[type] |= untested;
+        table.classified |= bit;
+    }
+
+    // --- Storage ---
+
+    ComponentStorage& ComponentStorage::Get() {
+        // Never destroyed: game objects may outlive static destruction order
+        Instance = Instance ? Instance : new ComponentStorage();
+        return *Instance;
+    }
+
+    Component* ComponentStorage::FindAttached(ComponentTypeID type) const {
+        for (const Archetype* archetype : m_archetypes) {
+            int column = archetype->ColumnOf(type);
+            if (column >= 0 && !archetype->objects.empty())
+                return archetype->columns[column][0];
+        }
+        return nullptr;
+    }
+
+    void ComponentStorage::Attach(GameObject* object, ComponentTypeID type,
+                                  Component* component) {
+        std::vector<ComponentTypeID> signature;
+        if (object->m_archetype)
+            signature = object->m_archetype->signature;
+
+        auto pos = std::lower_bound(signature.begin(), signature.end(), type);
+        if (pos != signature.end() && *pos == type) return;
+        signature.insert(pos, type);
+
+        MoveObject(object, FindOrCreateArchetype(signature), type, component);
+    }
+
+    void ComponentStorage::Detach(GameObject* object, ComponentTypeID type) {
+        Archetype* current = object->m_archetype;
+        if (!current || current->ColumnOf(type) < 0) return;
+
+        std::vector<ComponentTypeID> signature = current->signature;
+        signature.erase(std::find(signature.begin(), signature.end(), type));
+
+        if (signature.empty()) {
+            DetachAll(object);
+            return;
+        }
+
+        MoveObject(object, FindOrCreateArchetype(signature),
+                   INVALID_COMPONENT_TYPE, nullptr);
+    }
+
+    void ComponentStorage::DetachAll(GameObject* object) {
+        if (!object->m_archetype) return;
+        RemoveRow(object->m_archetype, object->m_archetypeRow);
+        object->m_archetype = nullptr;
+        object->m_archetypeRow = 0;
+    }
+
+    Archetype* ComponentStorage::FindOrCreateArchetype(
+        const std::vector<ComponentTypeID>& signature) {
+        ComponentMask mask = 0;
+        for (ComponentTypeID type : signature)
+            mask |= ComponentTypeRegistry::MaskOf(type);
+
+        for (Archetype* archetype : m_archetypes) {
+            if (archetype->mask == mask) return archetype;
+        }
+
+        auto* archetype = new Archetype();
+        archetype->signature = signature;
+        archetype->mask = mask;
+        archetype->columns.resize(signature.size());
+        m_archetypes.push_back(archetype);
+        return archetype;
+    }
+
+    void ComponentStorage::MoveObject(GameObject* object, Archetype* target,
+                                      ComponentTypeID addedType,
+                                      Component* added) {
+        Archetype* source = object->m_archetype;
+        uint32_t sourceRow = object->m_archetypeRow;
+
+        // Append the row to the target, pulling existing columns from the source
+        for (size_t c = 0; c < target->signature.size(); ++c) {
+            ComponentTypeID type = target->signature[c];
+            Component* component = nullptr;
+            if (type == addedType) {
+                component = added;
+            } else if (source) {
+                int column = source->ColumnOf(type);
+                if (column >= 0) component = source->columns[column][sourceRow];
+            }
+            target->columns[c].push_back(component);
+        }
+        target->objects.push_back(object);
+
+        if (source) RemoveRow(source, sourceRow);
+
+        object->m_archetype = target;
+        object->m_archetypeRow = static_cast<uint32_t>(target->objects.size() - 1);
+    }
+
+    void ComponentStorage::RemoveRow(Archetype* archetype, uint32_t row) {
+        // Swap-remove keeps every column packed
+        uint32_t last = static_cast<uint32_t>(archetype->objects.size() - 1);
+        if (row != last) {
+            archetype->objects[row] = archetype->objects[last];
+            for (auto& column : archetype->columns)
+                column[row] = column[last];
+            archetype->objects[row]->m_archetypeRow = row;
+        }
+
+        archetype->objects.pop_back();
+        for (auto& column : archetype->columns)
+            column.pop_back();
+    }
+
+} // namespace Sleak
@@ -0,0 +1,419 @@
+#include <ECS/CullingSystem.hpp>
+#include <ECS/TransformHierarchy.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/OccluderComponent.hpp>
+#include <Camera/ViewFrustum.hpp>
+#include <Core/GameObject.hpp>
+#include <cmath>
+
+namespace Sleak {
+
+    static void* ToUserData(uint32_t index) {
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(index));
+    }
+
+    static uint32_t FromUserData(void* userData) {
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData));
+    }
+
+    static bool IsCullableMesh(GameObject* object) {
+        auto* mesh = object->GetComponent<MeshComponent>();
+        return mesh && mesh->IsCullable();
+    }
+
+    // Arvo: transform the center, take |M| times the extents
+    static Physics::AABB TransformBounds(const Physics::AABB& local, const Math::Matrix4& world) {
+        const Math::Vector3D center = local.GetCenter();
+        const Math::Vector3D extents = local.GetExtents();
+        const float c[3] = {center.GetX(), center.GetY(), center.GetZ()};
+        const float e[3] = {extents.GetX(), extents.GetY(), extents.GetZ()};
+
+        float worldCenter[3];
+        float worldExtents[3];
+        for (int column = 0; column < 3; ++column) {
+            worldCenter[column] = world(3, column);
+            worldExtents[column] = 0.0f;
+            for (int row = 0; row < 3; ++row) {
+                worldCenter[column] += c[row] * world(row, column);
+                worldExtents[column] += e[row] * std::fabs(world(row, column));
+            }
+        }
+
+        return Physics::AABB(
+            Math::Vector3D(worldCenter[0] - worldExtents[0],
+                           worldCenter[1] - worldExtents[1],
+                           worldCenter[2] - worldExtents[2]),
+            Math::Vector3D(worldCenter[0] + worldExtents[0],
+                           worldCenter[1] + worldExtents[1],
+                           worldCenter[2] + worldExtents[2]));
+    }
+
+    CullingSystem::Renderable* CullingSystem::Find(Handle<GameObject> handle) {
+        auto it = m_index.find(handle);
+        return it != m_index.end() ? &m_renderables[it->second] : nullptr;
+    }
+
+    void CullingSystem::Update(TransformHierarchy& hierarchy, const ViewFrustum& frustum,
+                               const Math::Matrix4& viewProjection,
+                               const ViewFrustum* shadowFrustum) {
+        ++m_frame;
+
+        if (!m_built || hierarchy.GetStructureVersion() != m_structureVersion)
+            Sync(hierarchy);
+
+        ApplyMoves(hierarchy);
+        PromoteStatic();
+
+        m_occluded = 0;
+        m_occlusionReady = false;
+        if (m_enabled) {
+            Cull(frustum, shadowFrustum);
+            if (m_occlusionEnabled && !m_occluders.empty())
+                Occlude(frustum, viewProjection, shadowFrustum);
+
+            const uint32_t kept = static_cast<uint32_t>(m_visible.size() + m_shadowCasters.size());
+            m_submitted = static_cast<uint32_t>(m_renderables.size()) - m_cullableCount + kept;
+            m_culled = m_cullableCount - kept;
+        } else {
+            if (m_wasEnabled) {
+                for (auto& renderable : m_renderables)
+                    renderable.object->SetCulled(false);
+                m_visible.clear();
+                m_shadowCasters.clear();
+            }
+            m_submitted = static_cast<uint32_t>(m_renderables.size());
+            m_culled = 0;
+        }
+        m_wasEnabled = m_enabled;
+    }
+
+    // --- Membership ---
+
+    void CullingSystem::Sync(const TransformHierarchy& hierarchy) {
+        ++m_syncStamp;
+        m_occluders.clear();
+
+        for (TransformComponent* transform : hierarchy.GetTransforms()) {
+            GameObject* object = transform->GetOwner();
+            if (auto* occluder = object->GetComponent<OccluderComponent>())
+                m_occluders.push_back({occluder, transform});
+
+            // Static batches cull their merged meshes themselves
+            auto* mesh = object->GetComponent<MeshComponent>();
+            if (!mesh || mesh->IsBatched()) continue;
+
+            auto it = m_index.find(object->GetHandle());
+            if (it == m_index.end()) {
+                Add(object, transform, IsCullableMesh(object));
+                continue;
+            }
+
+            Renderable& renderable = m_renderables[it->second];
+            renderable.transform = transform;
+            renderable.seen = m_syncStamp;
+            if (renderable.cullable != IsCullableMesh(object))
+                SetCullable(it->second, !renderable.cullable);
+        }
+
+        // Gone from the scene, or lost its mesh
+        for (size_t i = m_renderables.size(); i-- > 0;) {
+            if (m_renderables[i].seen == m_syncStamp) continue;
+
+            if (GameObject* object = GameObject::Resolve(m_renderables[i].handle)) {
+                auto* mesh = object->GetComponent<MeshComponent>();
+                if (!mesh || !mesh->IsBatched()) object->SetCulled(false);
+            }
+            Remove(static_cast<uint32_t>(i));
+        }
+
+        m_structureVersion = hierarchy.GetStructureVersion();
+        m_built = true;
+    }
+
+    void CullingSystem::Add(GameObject* object, TransformComponent* transform, bool cullable) {
+        const uint32_t index = static_cast<uint32_t>(m_renderables.size());
+
+        Renderable renderable;
+        renderable.object = object;
+        renderable.transform = transform;
+        renderable.handle = object->GetHandle();
+        renderable.seen = m_syncStamp;
+        m_renderables.push_back(renderable);
+        m_index[renderable.handle] = index;
+
+        if (cullable) SetCullable(index, true);
+    }
+
+    void CullingSystem::Remove(uint32_t index) {
+        Renderable& renderable = m_renderables[index];
+        if (renderable.cullable) SetCullable(index, false);
+        m_index.erase(renderable.handle);
+
+        // Swap-remove: the last renderable's proxy must follow it
+        const uint32_t last = static_cast<uint32_t>(m_renderables.size() - 1);
+        if (index != last) {
+            m_renderables[index] = m_renderables[last];
+            Renderable& moved = m_renderables[index];
+            m_index[moved.handle] = index;
+            if (moved.proxy != Physics::NULL_NODE)
+                TreeOf(moved).SetUserData(moved.proxy, ToUserData(index));
+        }
+        m_renderables.pop_back();
+    }
+
+    void CullingSystem::SetCullable(uint32_t index, bool cullable) {
+        Renderable& renderable = m_renderables[index];
+
+        if (cullable) {
+            ComputeBounds(renderable);
+            renderable.lastMoved = m_frame;
+
+            // Marked static: no need to wait for the promotion. If it moves
+            // anyway it goes back to the dynamic tree like any other object.
+            renderable.isStatic = renderable.object->IsStatic();
+            renderable.proxy = TreeOf(renderable).Insert(renderable.bounds, ToUserData(index));
+            if (renderable.isStatic)
+                ++m_staticCount;
+            else
+                m_dynamic.push_back(renderable.handle);
+            ++m_cullableCount;
+
+            // Hidden until a pass finds it in view
+            renderable.object->SetCulled(m_enabled);
+        } else {
+            TreeOf(renderable).Remove(renderable.proxy);
+            if (renderable.isStatic) --m_staticCount;
+            renderable.proxy = Physics::NULL_NODE;
+            renderable.isStatic = false;
+            --m_cullableCount;
+        }
+
+        renderable.cullable = cullable;
+    }
+
+    void CullingSystem::SetStatic(uint32_t index, bool isStatic) {
+        Renderable& renderable = m_renderables[index];
+        if (renderable.isStatic == isStatic) return;
+
+        TreeOf(renderable).Remove(renderable.proxy);
+        renderable.isStatic = isStatic;
+        renderable.proxy = TreeOf(renderable).Insert(renderable.bounds, ToUserData(index));
+
+        if (isStatic) {
+            ++m_staticCount;
+        } else {
+            --m_staticCount;
+            m_dynamic.push_back(renderable.handle);
+        }
+    }
+
+    // --- Bounds ---
+
+    void CullingSystem::ComputeBounds(Renderable& renderable) const {
+        renderable.bounds = TransformBounds(
+            renderable.object->GetComponent<MeshComponent>()->GetLocalBounds(),
+            renderable.transform->GetWorldMatrix());
+    }
+
+    void CullingSystem::ApplyMoves(TransformHierarchy& hierarchy) {
+        for (Handle<GameObject> handle : hierarchy.GetMoved()) {
+            auto it = m_index.find(handle);
+            if (it == m_index.end()) continue;
+
+            const uint32_t index = it->second;
+            Renderable& renderable = m_renderables[index];
+            if (!renderable.cullable || renderable.lastMoved == m_frame) continue;
+
+            Math::Vector3D oldCenter = renderable.bounds.GetCenter();
+            ComputeBounds(renderable);
+            renderable.lastMoved = m_frame;
+
+            // Back to the dynamic tree; the static one stays untouched otherwise
+            if (renderable.isStatic) {
+                SetStatic(index, false);
+                continue;
+            }
+
+            m_dynamicTree.MoveProxy(renderable.proxy, renderable.bounds,
+                                    renderable.bounds.GetCenter() - oldCenter);
+        }
+
+        hierarchy.ClearMoved();
+    }
+
+    void CullingSystem::PromoteStatic() {
+        size_t kept = 0;
+        for (Handle<GameObject> handle : m_dynamic) {
+            auto it = m_index.find(handle);
+            if (it == m_index.end()) continue;
+
+            Renderable& renderable = m_renderables[it->second];
+            if (!renderable.cullable || renderable.isStatic) continue;
+
+            if (m_frame - renderable.lastMoved >= STATIC_AFTER_FRAMES) {
+                SetStatic(it->second, true);
+                continue;
+            }
+            m_dynamic[kept++] = handle;
+        }
+        m_dynamic.resize(kept);
+    }
+
+    // --- Culling ---
+
+    void CullingSystem::MarkVisible(uint32_t index) {
+        Renderable& renderable = m_renderables[index];
+        renderable.object->SetCulled(false);
+        m_visible.push_back(renderable.handle);
+    }
+
+    void CullingSystem::MarkShadowCaster(uint32_t index) {
+        Renderable& renderable = m_renderables[index];
+        if (!renderable.object->IsCulled()) return;     // Already in view
+
+        renderable.object->SetCulled(false);
+        m_shadowCasters.push_back(renderable.handle);
+    }
+
+    void CullingSystem::Cull(const ViewFrustum& frustum, const ViewFrustum* shadowFrustum) {
+        // Everything submitted last pass starts hidden again
+        for (auto* handles : {&m_visible, &m_shadowCasters}) {
+            for (Handle<GameObject> handle : *handles) {
+                if (Renderable* renderable = Find(handle))
+                    renderable->object->SetCulled(true);
+            }
+            handles->clear();
+        }
+
+        CullAgainst(frustum, &CullingSystem::MarkVisible);
+
+        // The shadow pass replays the main pass draws, so objects out of
+        // view that can still throw a shadow into it are submitted as well
+        if (shadowFrustum)
+            CullAgainst(*shadowFrustum, &CullingSystem::MarkShadowCaster);
+    }
+
+    void CullingSystem::CullAgainst(const ViewFrustum& frustum, MarkFunc mark) {
+        m_candidates.clear();
+        Traverse(m_staticTree, frustum, mark);
+        Traverse(m_dynamicTree, frustum, mark);
+
+        // Exact bounds of the leaves the frustum cuts, tested together
+        const size_t count = m_candidates.size();
+        for (auto* values : {&m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ})
+            values->resize(count);
+        m_candidateVisible.resize(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const Physics::AABB& bounds = m_renderables[m_candidates[i]].bounds;
+            m_minX[i] = bounds.min.GetX();
+            m_minY[i] = bounds.min.GetY();
+            m_minZ[i] = bounds.min.GetZ();
+            m_maxX[i] = bounds.max.GetX();
+            m_maxY[i] = bounds.max.GetY();
+            m_maxZ[i] = bounds.max.GetZ();
+        }
+
+        frustum.TestAABBs(m_minX.data(), m_minY.data(), m_minZ.data(),
+                          m_maxX.data(), m_maxY.data(), m_maxZ.data(),
+                          count, m_candidateVisible.data());
+
+        for (size_t i = 0; i < count; ++i) {
+            if (m_candidateVisible[i]) (this->*mark)(m_candidates[i]);
+        }
+    }
+
+    void CullingSystem::Occlude(const ViewFrustum& frustum, const Math::Matrix4& viewProjection,
+                                const ViewFrustum* shadowFrustum) {
+        m_occlusion.Begin(viewProjection);
+
+        for (const Occluder& entry : m_occluders) {
+            const Math::Matrix4 world = entry.transform->GetWorldMatrix();
+            const OccluderComponent* occluder = entry.occluder;
+
+            Physics::AABB bounds = TransformBounds(occluder->GetLocalBounds(), world);
+            if (!frustum.IsAABBVisible(bounds.min, bounds.max)) continue;
+
+            m_occlusion.AddOccluder(occluder->GetPositions().data(), occluder->GetVertexCount(),
+                                    occluder->GetIndices().data(),
+                                    static_cast<uint32_t>(occluder->GetIndices().size()), world);
+        }
+        if (m_occlusion.GetTriangleCount() == 0) return;
+
+        m_occlusion.Rasterize();
+        m_occlusionReady = true;
+
+        size_t kept = 0;
+        for (Handle<GameObject> handle : m_visible) {
+            Renderable& renderable = *Find(handle);
+
+            // Occluders stand in for their own mesh and would hide it
+            if (renderable.object->HasComponent<OccluderComponent>() ||
+                m_occlusion.IsVisible(renderable.bounds)) {
+                m_visible[kept++] = handle;
+                continue;
+            }
+
+            // Hidden from the camera, but its shadow may not be
+            if (shadowFrustum && shadowFrustum->IsAABBVisible(renderable.bounds.min, renderable.bounds.max)) {
+                m_shadowCasters.push_back(handle);
+                continue;
+            }
+
+            renderable.object->SetCulled(true);
+            ++m_occluded;
+        }
+        m_visible.resize(kept);
+    }
+
+    bool CullingSystem::IsOccluded(const Physics::AABB& worldBounds) const {
+        return m_occlusionReady && !m_occlusion.IsVisible(worldBounds);
+    }
+
+    void CullingSystem::Traverse(const Physics::DynamicAABBTree& tree, const ViewFrustum& frustum,
+                                 MarkFunc mark) {
+        if (tree.GetRoot() == Physics::NULL_NODE) return;
+
+        m_stack.clear();
+        m_stack.push_back({tree.GetRoot(), ViewFrustum::ALL_PLANES});
+
+        while (!m_stack.empty()) {
+            auto [nodeId, planes] = m_stack.back();
+            m_stack.pop_back();
+
+            const Physics::TreeNode& node = tree.GetNode(nodeId);
+            auto containment = frustum.ClassifyAABB(node.fatAABB.min, node.fatAABB.max, planes);
+            if (containment == ViewFrustum::Containment::Outside) continue;
+
+            if (node.IsLeaf()) {
+                uint32_t index = FromUserData(node.userData);
+                // A fat box fully inside means the exact one is too
+                if (containment == ViewFrustum::Containment::Inside)
+                    (this->*mark)(index);
+                else
+                    m_candidates.push_back(index);
+                continue;
+            }
+
+            // Inside: planes is empty, children are accepted without tests
+            m_stack.push_back({node.left, planes});
+            m_stack.push_back({node.right, planes});
+        }
+    }
+
+    void CullingSystem::Query(const Physics::AABB& bounds, std::vector<GameObject*>& out) const {
+        auto collect = [&](const Physics::DynamicAABBTree& tree) {
+            tree.Query(bounds, [&](int proxy) {
+                const Renderable& renderable = m_renderables[FromUserData(tree.GetUserData(proxy))];
+                if (renderable.bounds.Overlaps(bounds))
+                    out.push_back(renderable.object);
+                return true;
+            });
+        };
+
+        collect(m_staticTree);
+        collect(m_dynamicTree);
+    }
+
+}
@@ -200,13 +200,11 @@ void DebugLineRenderer::Flush(Camera* camera) {
     uint32_t vertexCount = static_cast<uint32_t>(s_vertices.size());
     if (vertexCount > MAX_VERTICES) vertexCount = MAX_VERTICES;
 
-    // Update constant buffer with ViewProjection
+    // ViewProjection and vertices are uploaded when the command executes,
+    // which can be on the render thread after this frame's lines are gone
     DebugLineCBData cbData;
     cbData.ViewProjection = Camera::GetMainViewMatrix() * Camera::GetMainProjectionMatrix();
-    s_constantBuffer->Update(&cbData, sizeof(DebugLineCBData));
-
-    // Update vertex buffer
-    s_vertexBuffer->Update(s_vertices.data(), vertexCount * sizeof(Vertex));
+    std::vector<Vertex> vertices(s_vertices.begin(), s_vertices.begin() + vertexCount);
 
     // Capture for lambda
     auto shader = s_shader;
@@ -215,7 +213,10 @@ void DebugLineRenderer::Flush(Camera* camera) {
     uint32_t count = vertexCount;
 
     RenderEngine::RenderCommandQueue::GetInstance()->SubmitCustomCommand(
-        [shader, vb, cb, count](RenderEngine::RenderContext* ctx) {
+        [shader, vb, cb, count, cbData, vertices = std::move(vertices)](RenderEngine::RenderContext* ctx) mutable {
+            cb->Update(&cbData, sizeof(DebugLineCBData));
+            vb->Update(vertices.data(), count * sizeof(Vertex));
+
             ctx->BeginDebugLinePass();
 
             shader->bind();
@@ -173,6 +173,25 @@ void DebugOverlay::RenderPerformancePanel() {
     ImGui::Separator();
     ImGui::Text("Vertices:  %d", m_renderer->GetVertices());
     ImGui::Text("Triangles: %d", m_renderer->GetTriangles());
+    ImGui::Text("State changes saved: %d", m_renderer->GetStateChangesSaved());
+    ImGui::Text("Draws merged: %d", m_renderer->GetDrawsMerged());
+    ImGui::Text("Redundant binds filtered: %d", m_renderer->GetRedundantStateFiltered());
+    ImGui::Text("Transform uploads deferred: %d", m_renderer->GetTransformUploadsDeferred());
+    ImGui::Text("Render allocations: %d", m_renderer->GetRenderAllocations());
+
+    if (m_game && m_game->GetActiveScene()) {
+        auto& culling = m_game->GetActiveScene()->GetCullingSystem();
+        ImGui::Text("Objects submitted: %u (shadow casters: %u), culled: %u (occluded: %u)",
+                    culling.GetSubmittedCount(), culling.GetShadowCasterCount(),
+                    culling.GetCulledCount(), culling.GetOccludedCount());
+        ImGui::Text("Static renderables: %u / %u",
+                    culling.GetStaticCount(), culling.GetRenderableCount());
+
+        auto& batcher = m_game->GetActiveScene()->GetStaticBatcher();
+        ImGui::Text("Static batches: %u / %u (%u objects)",
+                    batcher.GetSubmittedCount(), batcher.GetBatchCount(),
+                    batcher.GetBatchedObjectCount());
+    }
 
     ImGui::Separator();
     ImGui::Text("CPU: %.1f%%", m_cachedMetrics.CpuUsagePercent);
@@ -1,5 +1,6 @@
 #include "../../include/private/Graphics/DirectX/DirectX11Buffer.hpp"
 #include <Graphics/Vertex.hpp>
+#include <Graphics/DirectX/DirectXVertexLayout.hpp>
 #include <cassert>
 #include "Graphics/ConstantBuffer.hpp"
 
@@ -144,7 +145,7 @@ void DirectX11Buffer::Update() {
             m_deviceContext->IASetVertexBuffers(Slot, 1, m_buffer.GetAddressOf(), &stride, &offset);
         break;
         case BufferType::Index:
-            m_deviceContext->IASetIndexBuffer(m_buffer.Get(),DXGI_FORMAT_R32_UINT,0);
+            m_deviceContext->IASetIndexBuffer(m_buffer.Get(),ToDXGIFormat(Format),0);
             break;
         case BufferType::Constant:
             m_deviceContext->VSSetConstantBuffers(Slot,1,m_buffer.GetAddressOf());
@@ -6,6 +6,7 @@
 #include <dxgidebug.h>
 #include <Graphics/DirectX/DirectX11Buffer.hpp>
 #include <Graphics/DirectX/DirectX11Shader.hpp>
+#include <Graphics/DirectX/DirectXVertexLayout.hpp>
 #include "Graphics/DirectX/DirectX11Texture.hpp"
 #include "Graphics/DirectX/DirectX11CubemapTexture.hpp"
 #include "Graphics/Vertex.hpp"
@@ -162,6 +163,8 @@ void DirectX11Renderer::BeginRender() {
 
     if (bIsLayoutCreated)
         deviceContext->IASetInputLayout(layout);
+    m_vertexLayout = VertexLayout::Standard;
+    DirectX11Shader::SetVertexLayout(VertexLayout::Standard);
 
     if(bImInitialized) {
             ImGui_ImplDX11_NewFrame();
@@ -228,6 +231,13 @@ void DirectX11Renderer::Cleanup() {
         blendState = nullptr;
     }
 
+    for (auto& compactLayout : compactLayouts) {
+        if (compactLayout) {
+            compactLayout->Release();
+            compactLayout = nullptr;
+        }
+    }
+
     if(query)
     {
         query->Release();
@@ -375,9 +385,10 @@ void DirectX11Renderer::Draw(uint32_t vertexCount) {
     deviceContext->Draw(vertexCount,0);
 }
 
-void DirectX11Renderer::DrawIndexed(uint32_t indexCount) {
+void DirectX11Renderer::DrawIndexed(uint32_t indexCount, uint32_t startIndex,
+                                    int32_t baseVertex) {
     
-    deviceContext->DrawIndexed(indexCount, 0, 0);
+    deviceContext->DrawIndexed(indexCount, startIndex, baseVertex);
     DrawnVertices += indexCount;
 }
     
@@ -387,8 +398,10 @@ void DirectX11Renderer::DrawInstance(uint32_t instanceCount,
 }
 
 void DirectX11Renderer::DrawIndexedInstance(uint32_t instanceCount,
-                                            uint32_t indexPerInstance) {
-    deviceContext->DrawIndexedInstanced(indexPerInstance, instanceCount, 0, 0, 0);
+                                            uint32_t indexPerInstance,
+                                            uint32_t startIndex,
+                                            int32_t baseVertex) {
+    deviceContext->DrawIndexedInstanced(indexPerInstance, instanceCount, startIndex, baseVertex, 0);
 }
 
 void DirectX11Renderer::ClearRenderTarget(float r, float g, float b, float a) {
@@ -415,9 +428,12 @@ void DirectX11Renderer::BindVertexBuffer(RefPtr<BufferBase> buffer, uint32_t slo
     if (!buffer) 
         return;
 
-    UINT stride = sizeof(Sleak::Vertex);
+    UINT stride = VertexFormat::GetStride(buffer->GetVertexLayout());
     UINT offset = 0;
 
+    if (slot == 0)
+        SetVertexLayout(buffer->GetVertexLayout());
+
     try
     {
         auto d3d11Buffer = dynamic_cast<DirectX11Buffer*>
@@ -433,6 +449,25 @@ void DirectX11Renderer::BindVertexBuffer(RefPtr<BufferBase> buffer, uint32_t slo
     }
 }
 
+// Switches the input layout and the bound shader's vertex shader to the
+// vertex buffer's layout
+void DirectX11Renderer::SetVertexLayout(VertexLayout vertexLayout) {
+    if (vertexLayout == m_vertexLayout) return;
+    m_vertexLayout = vertexLayout;
+    DirectX11Shader::SetVertexLayout(vertexLayout);
+
+    ID3D11InputLayout* inputLayout = layout;
+    if (vertexLayout != VertexLayout::Standard) {
+        auto& compactLayout = compactLayouts[static_cast<size_t>(vertexLayout)];
+        if (!compactLayout && DirectX11Shader::GetBound())
+            compactLayout = DirectX11Shader::GetBound()->createInputLayout(vertexLayout);
+        inputLayout = compactLayout;
+    }
+
+    if (inputLayout)
+        deviceContext->IASetInputLayout(inputLayout);
+}
+
 void DirectX11Renderer::BindIndexBuffer(RefPtr<BufferBase> buffer,
                              uint32_t slot) {
     if (!buffer) return;
@@ -443,7 +478,7 @@ void DirectX11Renderer::BindIndexBuffer(RefPtr<BufferBase> buffer,
         auto d3d11Buffer =
             dynamic_cast<DirectX11Buffer*>(buffer.get())->GetD3DBuffer();
 
-        deviceContext->IASetIndexBuffer(d3d11Buffer, DXGI_FORMAT_R32_UINT, 0);
+        deviceContext->IASetIndexBuffer(d3d11Buffer, ToDXGIFormat(buffer->GetIndexFormat()), 0);
 
     } catch (std::exception& e) {
         SLEAK_ERROR("Failed to cast Index Buffer! {}", e.what());
@@ -1,4 +1,5 @@
 #include "../../include/private/Graphics/DirectX/DirectX11Shader.hpp"
+#include "../../include/private/Graphics/DirectX/DirectXVertexLayout.hpp"
 
 #include <d3d11.h>
 #include <d3d11shader.h>
@@ -12,6 +13,9 @@
 namespace Sleak {
 namespace RenderEngine {
 
+DirectX11Shader* DirectX11Shader::s_bound = nullptr;
+VertexLayout DirectX11Shader::s_layout = VertexLayout::Standard;
+
 DirectX11Shader::DirectX11Shader(ID3D11Device* device) : m_device(device) {
     assert(m_device != nullptr);  // Ensure the device is valid
     m_device->GetImmediateContext(m_deviceContext.GetAddressOf());
@@ -19,9 +23,14 @@ DirectX11Shader::DirectX11Shader(ID3D11Device* device) : m_device(device) {
 
 DirectX11Shader::~DirectX11Shader() {
     // Resources are automatically released by ComPtr
+    if (s_bound == this)
+        s_bound = nullptr;
 }
 
 bool DirectX11Shader::compile(const std::string& shaderPath) {
+    m_vertexPath = shaderPath;
+    m_vertexEntry = "VS_Main";
+
     // Compile vertex shader
     if (!compileShader(shaderPath, "VS_Main", "vs_5_0", m_vertexShader,
                        m_vertexShaderBlob)) {
@@ -41,6 +50,9 @@ bool DirectX11Shader::compile(const std::string& shaderPath) {
 
 bool DirectX11Shader::compile(const std::string& vertPath,
                               const std::string& fragPath) {
+    m_vertexPath = vertPath;
+    m_vertexEntry = "Main";
+
     // Compile vertex shader
     if (!compileShader(vertPath, "Main", "vs_5_0", m_vertexShader,
                        m_vertexShaderBlob)) {
@@ -63,21 +75,61 @@ void DirectX11Shader::bind() {
         throw std::runtime_error("Shaders are not compiled!");
     }
 
-    m_deviceContext->VSSetShader(m_vertexShader.Get(), nullptr, 0);
+    m_deviceContext->VSSetShader(getVertexShader(s_layout), nullptr, 0);
     m_deviceContext->PSSetShader(m_pixelShader.Get(), nullptr, 0);
+    s_bound = this;
+}
+
+void DirectX11Shader::SetVertexLayout(VertexLayout layout) {
+    if (layout == s_layout) return;
+    s_layout = layout;
+
+    if (s_bound)
+        s_bound->m_deviceContext->VSSetShader(s_bound->getVertexShader(layout), nullptr, 0);
+}
+
+ID3D11VertexShader* DirectX11Shader::getVertexShader(VertexLayout layout) {
+    if (layout == VertexLayout::Standard)
+        return m_vertexShader.Get();
+
+    if (!m_compactCompiled) {
+        m_compactCompiled = true;
+        const D3D_SHADER_MACRO defines[] = {{COMPACT_VERTEX_DEFINE, "1"}, {nullptr, nullptr}};
+        if (!compileShader(m_vertexPath, m_vertexEntry, "vs_5_0", m_compactVertexShader,
+                           m_compactVertexShaderBlob, defines)) {
+            SLEAK_ERROR("Failed to compile the compact vertex shader of {}!", m_vertexPath);
+        }
+    }
+
+    // Without the variant normals read wrong, but the draw still goes through
+    return m_compactVertexShader ? m_compactVertexShader.Get() : m_vertexShader.Get();
 }
 
 ID3DBlob* DirectX11Shader::getVertexShaderBlob() const {
     return m_vertexShaderBlob.Get();
 }
 
-ID3D11InputLayout* DirectX11Shader::createInputLayout() {
+ID3D11InputLayout* DirectX11Shader::createInputLayout(VertexLayout layout) {
     ID3D11InputLayout* inputLayout = nullptr;
 
+    const VertexLayoutDesc& desc = VertexFormat::GetLayoutDesc(layout);
+    std::vector<D3D11_INPUT_ELEMENT_DESC> elements(desc.attributeCount);
+    for (uint32_t i = 0; i < desc.attributeCount; ++i) {
+        const VertexAttribute& attribute = desc.attributes[i];
+        elements[i] = {GetVertexSemantic(attribute.location), 0,
+                       ToDXGIFormat(attribute.format), 0, attribute.offset,
+                       D3D11_INPUT_PER_VERTEX_DATA, 0};
+    }
+
+    // Validated against the vertex shader reading the layout
+    getVertexShader(layout);
+    ID3DBlob* blob = layout != VertexLayout::Standard && m_compactVertexShaderBlob
+                         ? m_compactVertexShaderBlob.Get()
+                         : m_vertexShaderBlob.Get();
+
     HRESULT hr = m_device->CreateInputLayout(
-        DefaultLayout, ARRAYSIZE(DefaultLayout),
-        m_vertexShaderBlob->GetBufferPointer(),
-        m_vertexShaderBlob->GetBufferSize(), &inputLayout); // Here crashes!
+        elements.data(), static_cast<UINT>(elements.size()),
+        blob->GetBufferPointer(), blob->GetBufferSize(), &inputLayout);
 
     if (FAILED(hr)) {
         SLEAK_ERROR("Failed to create input layout: 0x{:08X}",
@@ -93,11 +145,12 @@ bool DirectX11Shader::compileShader(const std::string& filePath,
                                     const std::string& entryPoint,
                                     const std::string& profile,
                                     Microsoft::WRL::ComPtr<T>& shader,
-                                    Microsoft::WRL::ComPtr<ID3DBlob>& blob) {
+                                    Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+                                    const D3D_SHADER_MACRO* defines) {
     Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
     HRESULT hr = D3DCompileFromFile(
         std::wstring(filePath.begin(), filePath.end()).c_str(),  // File path
-        nullptr,                                                 // Defines
+        defines,                                                 // Defines
         D3D_COMPILE_STANDARD_FILE_INCLUDE,                       // Includes
         entryPoint.c_str(),                                      // Entry point
         profile.c_str(),               // Shader profile (e.g., "vs_5_0")
@@ -1,5 +1,6 @@
 #include "../../include/private/Graphics/DirectX/DirectX12Buffer.hpp"
 #include <Graphics/Vertex.hpp>
+#include <Graphics/DirectX/DirectXVertexLayout.hpp>
 #include <cassert>
 
 namespace Sleak {
@@ -263,7 +264,7 @@ void DirectX12Buffer::Update() {
             SetAsVertexBuffer(m_commandList.Get(),0, sizeof(Sleak::Vertex));
         break;
         case BufferType::Index:
-            SetAsIndexBuffer(m_commandList.Get(),DXGI_FORMAT_R32_UINT);
+            SetAsIndexBuffer(m_commandList.Get(),ToDXGIFormat(Format));
         break;
         case BufferType::Constant:
             SetAsConstantBuffer(m_commandList.Get(),0);
@@ -5,9 +5,11 @@
 #include <SDL3/SDL_system.h>
 #include <Graphics/Vertex.hpp>
 #include <Graphics/DirectX/DirectX12CubemapTexture.hpp>
+#include <Graphics/DirectX/DirectXVertexLayout.hpp>
 #include <Logger.hpp>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <locale>
 #include <codecvt>
 #include <d3dcompiler.h>
@@ -383,29 +385,28 @@ bool DirectX12Renderer::CreatePipelineState() {
 
 bool DirectX12Renderer::CreatePipelineStateFromShader(
     ID3DBlob* vertexShaderBlob, ID3DBlob* pixelShaderBlob) {
+    return CreatePipelineStateFromShader(vertexShaderBlob, pixelShaderBlob,
+                                         VertexLayout::Standard, pipelineState);
+}
+
+bool DirectX12Renderer::CreatePipelineStateFromShader(
+    ID3DBlob* vertexShaderBlob, ID3DBlob* pixelShaderBlob,
+    VertexLayout layout, Microsoft::WRL::ComPtr<ID3D12PipelineState>& pso) {
     if (!vertexShaderBlob || !pixelShaderBlob) return false;
 
-    // Input layout matching Sleak::Vertex
-    D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
-         static_cast<UINT>(offsetof(Sleak::Vertex, px)),
-         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
-         static_cast<UINT>(offsetof(Sleak::Vertex, nx)),
-         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"TANGENT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0,
-         static_cast<UINT>(offsetof(Sleak::Vertex, tx)),
-         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0,
-         static_cast<UINT>(offsetof(Sleak::Vertex, r)),
-         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0,
-         static_cast<UINT>(offsetof(Sleak::Vertex, u)),
-         D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-    };
+    // Input layout matching the vertex layout (the shaders skip bone data)
+    const VertexLayoutDesc& desc = VertexFormat::GetLayoutDesc(layout);
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout;
+    for (uint32_t i = 0; i < desc.attributeCount; ++i) {
+        const VertexAttribute& attribute = desc.attributes[i];
+        if (attribute.location > VERTEX_TEXCOORD) continue;
+        inputLayout.push_back({GetVertexSemantic(attribute.location), 0,
+                               ToDXGIFormat(attribute.format), 0, attribute.offset,
+                               D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0});
+    }
 
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
-    psoDesc.InputLayout = {inputLayout, _countof(inputLayout)};
+    psoDesc.InputLayout = {inputLayout.data(), static_cast<UINT>(inputLayout.size())};
     psoDesc.pRootSignature = rootSignature.Get();
     psoDesc.VS = {vertexShaderBlob->GetBufferPointer(),
                   vertexShaderBlob->GetBufferSize()};
@@ -463,7 +464,7 @@ bool DirectX12Renderer::CreatePipelineStateFromShader(
     psoDesc.SampleDesc.Count = 1;
 
     HRESULT hr = device->CreateGraphicsPipelineState(
-        &psoDesc, IID_PPV_ARGS(&pipelineState));
+        &psoDesc, IID_PPV_ARGS(&pso));
     if (FAILED(hr)) {
         SLEAK_ERROR("Failed to create pipeline state! HRESULT: 0x{:08X}",
                     static_cast<unsigned int>(hr));
@@ -486,6 +487,8 @@ void DirectX12Renderer::BeginRender() {
     commandList->Reset(commandAllocator.Get(),
                        pipelineState ? pipelineState.Get() : nullptr);
 
+    DirectX12Shader::SetVertexLayout(VertexLayout::Standard);
+
     // Set PSO if available (created by CreateShader)
     if (pipelineState) {
         commandList->SetPipelineState(pipelineState.Get());
@@ -673,8 +676,9 @@ void DirectX12Renderer::Draw(uint32_t vertexCount) {
     commandList->DrawInstanced(vertexCount, 1, 0, 0);
 }
 
-void DirectX12Renderer::DrawIndexed(uint32_t indexCount) {
-    commandList->DrawIndexedInstanced(indexCount, 1, 0, 0, 0);
+void DirectX12Renderer::DrawIndexed(uint32_t indexCount, uint32_t startIndex,
+                                    int32_t baseVertex) {
+    commandList->DrawIndexedInstanced(indexCount, 1, startIndex, baseVertex, 0);
 }
 
 void DirectX12Renderer::DrawInstance(uint32_t instanceCount,
@@ -683,9 +687,11 @@ void DirectX12Renderer::DrawInstance(uint32_t instanceCount,
 }
 
 void DirectX12Renderer::DrawIndexedInstance(uint32_t instanceCount,
-                                             uint32_t indexPerInstance) {
-    commandList->DrawIndexedInstanced(indexPerInstance, instanceCount, 0,
-                                      0, 0);
+                                             uint32_t indexPerInstance,
+                                             uint32_t startIndex,
+                                             int32_t baseVertex) {
+    commandList->DrawIndexedInstanced(indexPerInstance, instanceCount, startIndex,
+                                      baseVertex, 0);
 }
 
 // -----------------------------------------------------------------------
@@ -760,10 +766,25 @@ void DirectX12Renderer::BindVertexBuffer(RefPtr<BufferBase> buffer,
     auto* dx12Buf = dynamic_cast<DirectX12Buffer*>(buffer.get());
     if (!dx12Buf) return;
 
+    const VertexLayout layout = dx12Buf->GetVertexLayout();
+    if (slot == 0) {
+        // PSOs of compact layouts are created the first time a shader meets one
+        auto* shader = DirectX12Shader::GetBound();
+        if (shader && !shader->HasPSO(layout)) {
+            Microsoft::WRL::ComPtr<ID3D12PipelineState> pso;
+            if (!CreatePipelineStateFromShader(shader->getVertexShaderBlob(layout),
+                                               shader->getPixelShaderBlob(), layout, pso))
+                pso = pipelineState;    // Logged once, not retried every draw
+            shader->SetPSO(layout, pso);
+            shader->bind();
+        }
+        DirectX12Shader::SetVertexLayout(layout);
+    }
+
     D3D12_VERTEX_BUFFER_VIEW vbView = {};
     vbView.BufferLocation =
         dx12Buf->GetD3DBuffer()->GetGPUVirtualAddress();
-    vbView.StrideInBytes = sizeof(Sleak::Vertex);
+    vbView.StrideInBytes = VertexFormat::GetStride(layout);
     vbView.SizeInBytes = static_cast<UINT>(dx12Buf->GetSize());
 
     commandList->IASetVertexBuffers(slot, 1, &vbView);
@@ -777,7 +798,7 @@ void DirectX12Renderer::BindIndexBuffer(RefPtr<BufferBase> buffer,
     D3D12_INDEX_BUFFER_VIEW ibView = {};
     ibView.BufferLocation =
         dx12Buf->GetD3DBuffer()->GetGPUVirtualAddress();
-    ibView.Format = DXGI_FORMAT_R32_UINT;  // IndexType is uint32_t
+    ibView.Format = ToDXGIFormat(dx12Buf->GetIndexFormat());
     ibView.SizeInBytes = static_cast<UINT>(dx12Buf->GetSize());
 
     commandList->IASetIndexBuffer(&ibView);
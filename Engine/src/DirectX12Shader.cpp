@@ -1,4 +1,5 @@
 #include "../../include/private/Graphics/DirectX/DirectX12Shader.hpp"
+#include "../../include/private/Graphics/DirectX/DirectXVertexLayout.hpp"
 #include <d3d12.h>
 #include <d3dcompiler.h>
 #include <wrl/client.h>
@@ -7,11 +8,17 @@
 namespace Sleak {
 namespace RenderEngine {
 
+DirectX12Shader* DirectX12Shader::s_bound = nullptr;
+VertexLayout DirectX12Shader::s_layout = VertexLayout::Standard;
+
 DirectX12Shader::DirectX12Shader(ID3D12Device* device) : m_device(device) {
     assert(m_device != nullptr);
 }
 
-DirectX12Shader::~DirectX12Shader() = default;
+DirectX12Shader::~DirectX12Shader() {
+    if (s_bound == this)
+        s_bound = nullptr;
+}
 
 bool DirectX12Shader::compile(const std::string& shaderPath) {
     // Strip .hlsl extension if present, then use _dx12.hlsl
@@ -21,6 +28,8 @@ bool DirectX12Shader::compile(const std::string& shaderPath) {
         dx12Path = dx12Path.substr(0, hlslPos);
     }
     dx12Path += "_dx12.hlsl";
+    m_vertexPath = dx12Path;
+    m_vertexEntry = "VS_Main";
 
     // Compile shaders
     if (!compileShader(dx12Path, "VS_Main", "vs_5_0", m_vertexShaderBlob)) {
@@ -38,6 +47,9 @@ bool DirectX12Shader::compile(const std::string& shaderPath) {
 
 bool DirectX12Shader::compile(const std::string& vertPath,
                             const std::string& fragPath) {
+    m_vertexPath = vertPath;
+    m_vertexEntry = "Main";
+
     // Compile shaders
     if (!compileShader(vertPath, "Main", "vs_5_0", m_vertexShaderBlob)) {
         SLEAK_ERROR("Failed to compile vertex shader!");
@@ -53,13 +65,36 @@ bool DirectX12Shader::compile(const std::string& vertPath,
 }
 
 void DirectX12Shader::bind() {
-    if (m_pso && m_commandList) {
-        m_commandList->SetPipelineState(m_pso.Get());
+    // A layout without its PSO falls back to the standard one
+    ID3D12PipelineState* pso = m_psos[static_cast<size_t>(s_layout)].Get();
+    if (!pso)
+        pso = m_psos[static_cast<size_t>(VertexLayout::Standard)].Get();
+
+    if (pso && m_commandList) {
+        m_commandList->SetPipelineState(pso);
     }
+    s_bound = this;
+}
+
+void DirectX12Shader::SetVertexLayout(VertexLayout layout) {
+    if (layout == s_layout) return;
+    s_layout = layout;
+
+    if (s_bound)
+        s_bound->bind();
 }
 
 void DirectX12Shader::SetPSO(Microsoft::WRL::ComPtr<ID3D12PipelineState> pso) {
-    m_pso = pso;
+    SetPSO(VertexLayout::Standard, pso);
+}
+
+void DirectX12Shader::SetPSO(VertexLayout layout,
+                             Microsoft::WRL::ComPtr<ID3D12PipelineState> pso) {
+    m_psos[static_cast<size_t>(layout)] = pso;
+}
+
+bool DirectX12Shader::HasPSO(VertexLayout layout) const {
+    return m_psos[static_cast<size_t>(layout)] != nullptr;
 }
 
 void DirectX12Shader::SetCommandList(ID3D12GraphicsCommandList* cmdList) {
@@ -74,14 +109,28 @@ ID3DBlob* DirectX12Shader::getPixelShaderBlob() const {
     return m_pixelShaderBlob.Get();
 }
 
+ID3DBlob* DirectX12Shader::getVertexShaderBlob(VertexLayout layout) {
+    if (layout == VertexLayout::Standard)
+        return m_vertexShaderBlob.Get();
+
+    if (!m_compactCompiled) {
+        m_compactCompiled = true;
+        const D3D_SHADER_MACRO defines[] = {{COMPACT_VERTEX_DEFINE, "1"}, {nullptr, nullptr}};
+        if (!compileShader(m_vertexPath, m_vertexEntry, "vs_5_0", m_compactVertexShaderBlob, defines))
+            SLEAK_ERROR("Failed to compile the compact vertex shader of {}!", m_vertexPath);
+    }
+    return m_compactVertexShaderBlob.Get();
+}
+
 bool DirectX12Shader::compileShader(const std::string& filePath,
                                   const std::string& entryPoint,
                                   const std::string& profile,
-                                  Microsoft::WRL::ComPtr<ID3DBlob>& blob) {
+                                  Microsoft::WRL::ComPtr<ID3DBlob>& blob,
+                                  const D3D_SHADER_MACRO* defines) {
     Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
     HRESULT hr = D3DCompileFromFile(
         std::wstring(filePath.begin(), filePath.end()).c_str(),
-        nullptr,
+        defines,
         D3D_COMPILE_STANDARD_FILE_INCLUDE,
         entryPoint.c_str(),
         profile.c_str(),
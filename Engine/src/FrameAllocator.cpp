@@ -0,0 +1,62 @@
+#include <Memory/FrameAllocator.h>
+#include <algorithm>
+
+namespace Sleak {
+
+    static constexpr size_t BLOCK_ALIGNMENT = 64;
+
+    FrameAllocator::FrameAllocator(size_t blockSize)
+        : m_blockSize(std::max<size_t>(blockSize, BLOCK_ALIGNMENT)) {}
+
+    FrameAllocator::~FrameAllocator() {
+        for (const Block& block : m_blocks)
+            ::operator delete(block.memory, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+
+    void FrameAllocator::AddBlock(size_t minimumSize) {
+        size_t size = std::max(m_blockSize, minimumSize);
+        auto* memory = static_cast<uint8_t*>(
+            ::operator new(size, std::align_val_t(BLOCK_ALIGNMENT)));
+
+        m_blocks.push_back({memory, size});
+        m_capacity += size;
+        m_offset = 0;
+        ++m_blockAllocations;
+    }
+
+    void* FrameAllocator::Allocate(size_t size, size_t alignment) {
+        if (m_blocks.empty())
+            AddBlock(size + alignment);
+
+        const Block* block = &m_blocks.back();
+        size_t start = (m_offset + alignment - 1) & ~(alignment - 1);
+
+        if (start + size > block->size) {
+            // What is left of the old block is only reclaimed by Reset
+            m_used += block->size - m_offset;
+            AddBlock(size + alignment);
+            block = &m_blocks.back();
+            start = 0;
+        }
+
+        m_used += start + size - m_offset;
+        m_offset = start + size;
+        return block->memory + start;
+    }
+
+    void FrameAllocator::Reset() {
+        // Grow to what this frame needed, so the next one fits in one block
+        if (m_blocks.size() > 1) {
+            size_t total = m_capacity;
+            for (const Block& block : m_blocks)
+                ::operator delete(block.memory, std::align_val_t(BLOCK_ALIGNMENT));
+            m_blocks.clear();
+            m_capacity = 0;
+            AddBlock(total);
+        }
+
+        m_offset = 0;
+        m_used = 0;
+    }
+
+}
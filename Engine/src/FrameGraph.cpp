@@ -0,0 +1,246 @@
+#include "../../include/private/Graphics/FrameGraph.hpp"
+#include <Logger.hpp>
+#include <algorithm>
+
+namespace Sleak {
+    namespace RenderEngine {
+
+        uint32_t FrameGraph::CreateTransient(const std::string& name, const FrameGraphResourceDesc& desc) {
+            m_compiled = false;
+            Resource resource;
+            resource.name = name;
+            resource.desc = desc;
+            if (resource.desc.alignment == 0) resource.desc.alignment = 1;
+            m_resources.push_back(std::move(resource));
+            return static_cast<uint32_t>(m_resources.size() - 1);
+        }
+
+        uint32_t FrameGraph::Import(const std::string& name, bool retained) {
+            m_compiled = false;
+            Resource resource;
+            resource.name = name;
+            resource.imported = true;
+            resource.retained = retained;
+            m_resources.push_back(std::move(resource));
+            return static_cast<uint32_t>(m_resources.size() - 1);
+        }
+
+        uint32_t FrameGraph::AddPass(const std::string& name, ExecuteFunction execute) {
+            m_compiled = false;
+            Pass pass;
+            pass.name = name;
+            pass.execute = std::move(execute);
+            m_passes.push_back(std::move(pass));
+            return static_cast<uint32_t>(m_passes.size() - 1);
+        }
+
+        void FrameGraph::Read(uint32_t pass, uint32_t resource) {
+            Declare(pass, resource, FrameGraphAccess::Read);
+        }
+
+        void FrameGraph::Write(uint32_t pass, uint32_t resource) {
+            Declare(pass, resource, FrameGraphAccess::Write);
+        }
+
+        void FrameGraph::KeepPass(uint32_t pass) {
+            if (pass >= m_passes.size()) {
+                m_invalid = true;
+                return;
+            }
+            m_compiled = false;
+            m_passes[pass].keep = true;
+        }
+
+        void FrameGraph::Declare(uint32_t pass, uint32_t resource, FrameGraphAccess access) {
+            if (pass >= m_passes.size() || resource >= m_resources.size()) {
+                m_invalid = true;
+                return;
+            }
+            m_compiled = false;
+
+            // Reading and writing the same resource is one write
+            for (auto& existing : m_passes[pass].accesses) {
+                if (existing.resource == resource) {
+                    if (access == FrameGraphAccess::Write)
+                        existing.access = access;
+                    return;
+                }
+            }
+            m_passes[pass].accesses.push_back({resource, access});
+        }
+
+        bool FrameGraph::Compile() {
+            if (m_invalid) {
+                SLEAK_ERROR("FrameGraph: a pass declared a missing pass or resource");
+                return false;
+            }
+
+            m_stats = FrameGraphStats();
+            m_stats.passes = static_cast<uint32_t>(m_passes.size());
+
+            CullPasses();
+            BuildBarriers();
+            AssignMemory();
+
+            m_compiled = true;
+            return true;
+        }
+
+        void FrameGraph::CullPasses() {
+            // Walking backwards, a pass lives when it writes something a
+            // live pass after it reads, or a retained imported resource
+            std::vector<bool> needed(m_resources.size(), false);
+
+            for (size_t i = m_passes.size(); i-- > 0;) {
+                Pass& pass = m_passes[i];
+
+                bool live = pass.keep;
+                for (const auto& access : pass.accesses) {
+                    if (access.access != FrameGraphAccess::Write) continue;
+                    if (m_resources[access.resource].retained || needed[access.resource])
+                        live = true;
+                }
+
+                pass.culled = !live;
+                if (pass.culled) {
+                    m_stats.culledPasses++;
+                    continue;
+                }
+
+                for (const auto& access : pass.accesses) {
+                    if (access.access == FrameGraphAccess::Read)
+                        needed[access.resource] = true;
+                }
+            }
+        }
+
+        void FrameGraph::BuildBarriers() {
+            std::vector<FrameGraphAccess> last(m_resources.size(), FrameGraphAccess::None);
+
+            for (auto& resource : m_resources) {
+                resource.firstUse = INVALID;
+                resource.lastUse = INVALID;
+            }
+
+            for (uint32_t i = 0; i < m_passes.size(); ++i) {
+                Pass& pass = m_passes[i];
+                pass.barriers.clear();
+                if (pass.culled) continue;
+
+                for (const auto& access : pass.accesses) {
+                    FrameGraphAccess before = last[access.resource];
+
+                    // Only reads following reads run without waiting
+                    if (before == FrameGraphAccess::Write ||
+                        (before == FrameGraphAccess::Read && access.access == FrameGraphAccess::Write)) {
+                        pass.barriers.push_back({access.resource, before, access.access});
+                        m_stats.barriers++;
+                    }
+                    last[access.resource] = access.access;
+
+                    Resource& resource = m_resources[access.resource];
+                    if (resource.firstUse == INVALID) resource.firstUse = i;
+                    resource.lastUse = i;
+                }
+            }
+        }
+
+        void FrameGraph::AssignMemory() {
+            m_slots.clear();
+
+            std::vector<uint32_t> order;
+            for (uint32_t i = 0; i < m_resources.size(); ++i) {
+                Resource& resource = m_resources[i];
+                resource.slot = INVALID;
+                if (resource.imported || resource.firstUse == INVALID) continue;
+
+                order.push_back(i);
+                m_stats.transientBytes += resource.desc.size;
+            }
+
+            // Largest first, so smaller resources fill the gaps they leave
+            std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+                return m_resources[a].desc.size > m_resources[b].desc.size;
+            });
+
+            std::vector<std::vector<uint32_t>> residents;
+            for (uint32_t index : order) {
+                Resource& resource = m_resources[index];
+
+                uint32_t best = INVALID;
+                for (uint32_t slot = 0; slot < m_slots.size(); ++slot) {
+                    if ((m_slots[slot].typeMask & resource.desc.typeMask) == 0) continue;
+
+                    bool overlaps = false;
+                    for (uint32_t other : residents[slot]) {
+                        const Resource& used = m_resources[other];
+                        if (resource.firstUse <= used.lastUse && used.firstUse <= resource.lastUse) {
+                            overlaps = true;
+                            break;
+                        }
+                    }
+                    if (overlaps) continue;
+
+                    // Best fit: slots placed before are at least as large
+                    if (best == INVALID || m_slots[slot].size < m_slots[best].size)
+                        best = slot;
+                }
+
+                if (best == INVALID) {
+                    best = static_cast<uint32_t>(m_slots.size());
+                    m_slots.push_back(FrameGraphMemorySlot());
+                    residents.emplace_back();
+                }
+
+                FrameGraphMemorySlot& slot = m_slots[best];
+                slot.size = std::max(slot.size, resource.desc.size);
+                slot.alignment = std::max(slot.alignment, resource.desc.alignment);
+                slot.typeMask &= resource.desc.typeMask;
+                residents[best].push_back(index);
+                resource.slot = best;
+            }
+
+            for (auto& slot : m_slots) {
+                // Every resident starts at offset 0: the slot's size must
+                // be a multiple of the strictest alignment
+                slot.size = (slot.size + slot.alignment - 1) / slot.alignment * slot.alignment;
+                m_stats.allocatedBytes += slot.size;
+            }
+            m_stats.memorySlots = static_cast<uint32_t>(m_slots.size());
+        }
+
+        void FrameGraph::Execute(RenderContext* context, const BarrierFunction& recordBarriers) {
+            if (!m_compiled) return;
+
+            for (auto& pass : m_passes) {
+                if (pass.culled) continue;
+                if (recordBarriers && !pass.barriers.empty())
+                    recordBarriers(pass.barriers);
+                if (pass.execute)
+                    pass.execute(context);
+            }
+        }
+
+        void FrameGraph::Clear() {
+            m_passes.clear();
+            m_resources.clear();
+            m_slots.clear();
+            m_stats = FrameGraphStats();
+            m_compiled = false;
+            m_invalid = false;
+        }
+
+        bool FrameGraph::IsCulled(uint32_t pass) const {
+            return pass >= m_passes.size() || m_passes[pass].culled;
+        }
+
+        const std::vector<FrameGraphBarrier>& FrameGraph::GetBarriers(uint32_t pass) const {
+            static const std::vector<FrameGraphBarrier> none;
+            return pass < m_passes.size() ? m_passes[pass].barriers : none;
+        }
+
+        uint32_t FrameGraph::GetMemorySlot(uint32_t resource) const {
+            return resource < m_resources.size() ? m_resources[resource].slot : INVALID;
+        }
+    }
+}
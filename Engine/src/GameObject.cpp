@@ -1,5 +1,6 @@
 #include <Core/GameObject.hpp>
-#include <Runtime/InternalGeometry.hpp>
+#include <Core/SceneBase.hpp>
+#include <Runtime/PrimitiveCache.hpp>
 #include <Runtime/Material.hpp>
 #include <Math/Vector.hpp>
 #include <ECS/Components/MeshComponent.hpp>
@@ -8,12 +9,43 @@
 #include <Physics/ColliderComponent.hpp>
 #include <Physics/RigidbodyComponent.hpp>
 #include "../../include/private/Graphics/Vertex.hpp"
+#include <Memory/ObjectAllocator.h>
 
 namespace Sleak {
 
+    // Every live object, so handles can be checked without touching memory.
+    // Never destroyed: objects may outlive static destruction.
+    static SlotMap<GameObject>& GetHandleTable() {
+        static SlotMap<GameObject>* table = new SlotMap<GameObject>();
+        return *table;
+    }
+
+    // --- Construction ---
+
+    GameObject::GameObject(const std::string& name)
+        : Object(name), m_isActive(true), bIsInitialized(false),
+          m_pendingDestroy(false), m_parent(nullptr) {
+        m_handle = GetHandleTable().Insert(this);
+    }
+
+    void* GameObject::operator new(size_t size) {
+        return ObjectAllocator::Allocate(size);
+    }
+
+    void GameObject::operator delete(void* memory, size_t size) {
+        ObjectAllocator::Free(memory, size);
+    }
+
+    GameObject* GameObject::Resolve(GameObjectHandle handle) {
+        return GetHandleTable().Get(handle);
+    }
+
     // --- Destructor ---
 
     GameObject::~GameObject() {
+        // Handles fail from here on, even while components shut down
+        GetHandleTable().Remove(m_handle);
+
         DestroyComponents();
 
         // Detach from parent
@@ -26,6 +58,7 @@ namespace Sleak {
         for (size_t i = 0; i < m_children.GetSize(); ++i) {
             if (m_children[i]) {
                 m_children[i]->m_parent = nullptr;
+                m_children[i]->OnParentChanged();
             }
         }
         m_children.clear();
@@ -35,8 +68,7 @@ namespace Sleak {
 
     void GameObject::Initialize() {
         for (size_t i = 0; i < Components.GetSize(); ++i) {
-            if (Components[i])
-                Components[i]->Initialize();
+            Components[i].component->Initialize();
         }
         bIsInitialized = true;
     }
@@ -44,9 +76,12 @@ namespace Sleak {
     void GameObject::Update(float deltaTime) {
         if (!m_isActive || m_pendingDestroy) return;
 
+        // Types the scene's systems update in bulk are skipped here
+        ComponentMask skip = m_scene ? m_scene->GetScheduler().GetSystemUpdatedComponents() : 0;
+
         for (size_t i = 0; i < Components.GetSize(); ++i) {
-            if (Components[i])
-                Components[i]->Update(deltaTime);
+            if (skip & ComponentTypeRegistry::MaskOf(Components[i].type)) continue;
+            Components[i].component->Update(deltaTime);
         }
 
         // Recursively update children
@@ -60,8 +95,7 @@ namespace Sleak {
         if (!m_isActive || m_pendingDestroy) return;
 
         for (size_t i = 0; i < Components.GetSize(); ++i) {
-            if (Components[i])
-                Components[i]->FixedUpdate(fixedDeltaTime);
+            Components[i].component->FixedUpdate(fixedDeltaTime);
         }
 
         for (size_t i = 0; i < m_children.GetSize(); ++i) {
@@ -74,8 +108,7 @@ namespace Sleak {
         if (!m_isActive || m_pendingDestroy) return;
 
         for (size_t i = 0; i < Components.GetSize(); ++i) {
-            if (Components[i])
-                Components[i]->LateUpdate(deltaTime);
+            Components[i].component->LateUpdate(deltaTime);
         }
 
         for (size_t i = 0; i < m_children.GetSize(); ++i) {
@@ -90,12 +123,10 @@ namespace Sleak {
 
         // Notify components
         for (size_t i = 0; i < Components.GetSize(); ++i) {
-            if (Components[i]) {
-                if (active)
-                    Components[i]->OnEnable();
-                else
-                    Components[i]->OnDisable();
-            }
+            if (active)
+                Components[i].component->OnEnable();
+            else
+                Components[i].component->OnDisable();
         }
 
         // Propagate to children
@@ -105,6 +136,24 @@ namespace Sleak {
         }
     }
 
+    // --- Name / tag ---
+
+    void GameObject::SetName(const std::string& value) {
+        if (value == GetName()) return;
+
+        std::string oldName = GetName();
+        Object::SetName(value);
+        if (m_scene) m_scene->OnObjectRenamed(this, oldName);
+    }
+
+    void GameObject::SetTag(const std::string& tag) {
+        if (tag == m_tag) return;
+
+        std::string oldTag = std::move(m_tag);
+        m_tag = tag;
+        if (m_scene) m_scene->OnObjectRetagged(this, oldTag);
+    }
+
     // --- Parent-child hierarchy ---
 
     void GameObject::SetParent(GameObject* parent) {
@@ -123,7 +172,13 @@ namespace Sleak {
             if (m_parent->m_children.indexOf(this) == -1) {
                 m_parent->m_children.add(this);
             }
+
+            // Children are updated through their parent's scene
+            if (m_parent->m_scene)
+                SetSceneRecursive(m_parent->m_scene);
         }
+
+        OnParentChanged();
     }
 
     void GameObject::AddChild(GameObject* child) {
@@ -137,94 +192,101 @@ namespace Sleak {
         if (index != -1) {
             m_children.erase(index);
             child->m_parent = nullptr;
+            child->OnParentChanged();
         }
     }
 
     // --- Internal ---
 
+    void GameObject::SetSceneRecursive(SceneBase* scene) {
+        m_scene = scene;
+        for (size_t i = 0; i < m_children.GetSize(); ++i) {
+            if (m_children[i])
+                m_children[i]->SetSceneRecursive(scene);
+        }
+    }
+
+    // World transforms below this object now resolve against another parent
+    void GameObject::OnParentChanged() {
+        if (auto* transform = GetComponent<TransformComponent>()) {
+            transform->MarkDirty();
+        } else {
+            for (size_t i = 0; i < m_children.GetSize(); ++i) {
+                if (m_children[i])
+                    m_children[i]->OnParentChanged();
+            }
+        }
+
+        if (m_scene)
+            m_scene->GetTransformHierarchy().Invalidate();
+    }
+
     void GameObject::DestroyComponents() {
         for (size_t i = 0; i < Components.GetSize(); ++i) {
-            if (Components[i])
-                Components[i]->OnDestroy();
+            Components[i].component->OnDestroy();
         }
-        Components.clear();
-    }
 
-    // --- Factory methods ---
+        auto& storage = ComponentStorage::Get();
+        storage.DetachAll(this);
+        for (size_t i = 0; i < Components.GetSize(); ++i) {
+            storage.GetPool(Components[i].type)->Destroy(Components[i].poolIndex);
+        }
 
-    static Material* CreateDefaultMaterial() {
-        auto* mat = new Material();
-        mat->SetShader("assets/shaders/default_shader.hlsl");
-        return mat;
+        Components.clear();
+        m_componentMask = 0;
     }
 
-    GameObject* GameObject::CreatePlane(Math::Vector3D position, int width, int height) {
-        GameObject* object = new GameObject("Plane");
+    // --- Factory methods ---
 
-        MeshData meshData = GetPlaneMesh(width, height);
-        object->AddComponent<ColliderComponent>(meshData, Physics::ColliderType::AABB);
+    // Cached buffers and the shared default material: spawning many
+    // primitives creates no GPU resources after the first of each kind
+    static void AddPrimitiveComponents(GameObject* object, const PrimitiveMesh& mesh,
+                                       Physics::ColliderType colliderType,
+                                       const Math::Vector3D& position) {
+        object->AddComponent<ColliderComponent>(*mesh.meshData, colliderType);
         object->AddComponent<RigidbodyComponent>(BodyType::Static);
-        object->AddComponent<MaterialComponent>(CreateDefaultMaterial());
-        object->AddComponent<MeshComponent>(std::move(meshData));
         object->AddComponent<TransformComponent>(position);
+        object->AddComponent<MaterialComponent>(PrimitiveCache::GetDefaultMaterial(),
+                                                MaterialSharing::CopyOnWrite);
+        object->AddComponent<MeshComponent>(mesh.vertexBuffer, mesh.indexBuffer,
+                                            mesh.vertexCount, mesh.indexCount);
+        object->GetComponent<MeshComponent>()->SetLocalBounds(mesh.bounds);
+        object->GetComponent<MeshComponent>()->SetMeshData(mesh.meshData);
         object->Initialize();
+    }
 
+    GameObject* GameObject::CreatePlane(Math::Vector3D position, int width, int height) {
+        GameObject* object = new GameObject("Plane");
+        AddPrimitiveComponents(object, PrimitiveCache::GetPlane(width, height),
+                               Physics::ColliderType::AABB, position);
         return object;
     }
 
     GameObject* GameObject::CreateCube(Math::Vector3D position) {
         GameObject* object = new GameObject("Cube");
-
-        MeshData meshData = GetCubeMesh();
-        object->AddComponent<ColliderComponent>(meshData, Physics::ColliderType::AABB);
-        object->AddComponent<RigidbodyComponent>(BodyType::Static);
-        object->AddComponent<TransformComponent>(position);
-        object->AddComponent<MaterialComponent>(CreateDefaultMaterial());
-        object->AddComponent<MeshComponent>(std::move(meshData));
-        object->Initialize();
-
+        AddPrimitiveComponents(object, PrimitiveCache::GetCube(),
+                               Physics::ColliderType::AABB, position);
         return object;
     }
 
     GameObject* GameObject::CreateSphere(Math::Vector3D position, int stack, int slices) {
         GameObject* object = new GameObject("Sphere");
-
-        MeshData meshData = GetSphereMesh(stack, slices);
-        object->AddComponent<ColliderComponent>(meshData, Physics::ColliderType::Sphere);
-        object->AddComponent<RigidbodyComponent>(BodyType::Static);
-        object->AddComponent<TransformComponent>(position);
-        object->AddComponent<MaterialComponent>(CreateDefaultMaterial());
-        object->AddComponent<MeshComponent>(std::move(meshData));
-        object->Initialize();
-
+        AddPrimitiveComponents(object, PrimitiveCache::GetSphere(stack, slices),
+                               Physics::ColliderType::Sphere, position);
         return object;
     }
 
     GameObject* GameObject::CreateCapsule(Math::Vector3D position, int segments, int rings, float height, float radius) {
         GameObject* object = new GameObject("Capsule");
-
-        MeshData meshData = GetCapsuleMesh(segments, rings, height, radius);
-        object->AddComponent<ColliderComponent>(meshData, Physics::ColliderType::Capsule);
-        object->AddComponent<RigidbodyComponent>(BodyType::Static);
-        object->AddComponent<TransformComponent>(position);
-        object->AddComponent<MaterialComponent>(CreateDefaultMaterial());
-        object->AddComponent<MeshComponent>(std::move(meshData));
-        object->Initialize();
-
+        AddPrimitiveComponents(object, PrimitiveCache::GetCapsule(segments, rings, height, radius),
+                               Physics::ColliderType::Capsule, position);
         return object;
     }
 
     GameObject* GameObject::CreateCylinder(Math::Vector3D position, int segments, float height, float radius) {
         GameObject* object = new GameObject("Cylinder");
-
-        MeshData meshData = GetCylinderMesh(segments, height, radius);
-        object->AddComponent<ColliderComponent>(meshData, Physics::ColliderType::AABB);
-        object->AddComponent<RigidbodyComponent>(BodyType::Static);
-        object->AddComponent<MaterialComponent>(CreateDefaultMaterial());
-        object->AddComponent<MeshComponent>(std::move(meshData));
-        object->AddComponent<TransformComponent>(position);
-        object->Initialize();
-
+        AddPrimitiveComponents(object, PrimitiveCache::GetCylinder(segments, height, radius),
+                               Physics::ColliderType::AABB, position);
         return object;
     }
 }
@@ -0,0 +1,277 @@
+#include <Core/JobSystem.hpp>
+#include <Logger.hpp>
+#include <algorithm>
+
+namespace Sleak {
+
+    struct Job {
+        JobFunction function;
+        JobCounter* counter = nullptr;
+        JobAffinity affinity = JobAffinity::Any;
+    };
+
+    JobSystem* JobSystem::Instance = nullptr;
+
+    // Index of the deque owned by the calling thread, -1 for foreign threads
+    static thread_local int32_t t_workerIndex = -1;
+    static std::thread::id s_mainThreadId;
+
+    // --- Lifetime ---
+
+    void JobSystem::Initialize(uint32_t workerCount) {
+        if (Instance) {
+            SLEAK_WARN("JobSystem: already initialized");
+            return;
+        }
+
+        if (workerCount == 0) {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        Instance = new JobSystem(workerCount);
+        SLEAK_INFO("JobSystem: started {} worker threads", workerCount);
+    }
+
+    void JobSystem::Shutdown() {
+        delete Instance;
+        Instance = nullptr;
+    }
+
+    JobSystem::JobSystem(uint32_t workerCount) {
+        s_mainThreadId = std::this_thread::get_id();
+        t_workerIndex = 0;
+
+        m_queues.resize(workerCount + 1);
+        for (auto& queue : m_queues)
+            queue = new WorkerQueue();
+
+        for (uint32_t i = 1; i <= workerCount; ++i)
+            m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+
+    JobSystem::~JobSystem() {
+        // Finish what is already queued so nobody waits on a dead counter
+        while (Job* job = PopOrSteal(0))
+            Execute(job);
+        while (Job* job = PopMainThread())
+            Execute(job);
+
+        {
+            std::lock_guard<std::mutex> guard(m_sleepLock);
+            m_running = false;
+        }
+        m_wake.notify_all();
+
+        for (auto& worker : m_workers)
+            worker.join();
+
+        for (auto* queue : m_queues) {
+            for (Job* job : queue->jobs) delete job;
+            delete queue;
+        }
+
+        t_workerIndex = -1;
+    }
+
+    bool JobSystem::IsMainThread() {
+        return std::this_thread::get_id() == s_mainThreadId;
+    }
+
+    uint32_t JobSystem::GetWorkerCount() {
+        return Instance ? static_cast<uint32_t>(Instance->m_workers.size()) : 0;
+    }
+
+    // --- Scheduling ---
+
+    void JobSystem::Schedule(JobFunction function, JobCounter* counter,
+                             JobAffinity affinity) {
+        if (!Instance) {
+            function();
+            return;
+        }
+
+        if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        Instance->Push(new Job{std::move(function), counter, affinity});
+    }
+
+    void JobSystem::ScheduleAfter(JobCounter* dependency, JobFunction function,
+                                  JobCounter* counter, JobAffinity affinity) {
+        if (!dependency) {
+            Schedule(std::move(function), counter, affinity);
+            return;
+        }
+
+        if (!Instance) {
+            Wait(dependency);
+            function();
+            return;
+        }
+
+        if (counter) counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        Job* job = new Job{std::move(function), counter, affinity};
+
+        {
+            std::lock_guard<std::mutex> guard(dependency->m_lock);
+            if (!dependency->IsDone()) {
+                dependency->m_continuations.push_back(job);
+                return;
+            }
+        }
+
+        Instance->Push(job);
+    }
+
+    void JobSystem::Wait(JobCounter* counter) {
+        if (!counter) return;
+
+        if (Instance) {
+            bool mainThread = IsMainThread();
+            uint32_t index = t_workerIndex > 0 ? t_workerIndex : 0;
+
+            while (!counter->IsDone()) {
+                Job* job = mainThread ? Instance->PopMainThread() : nullptr;
+                if (!job) job = Instance->PopOrSteal(index);
+
+                if (job)
+                    Instance->Execute(job);
+                else
+                    std::this_thread::yield();
+            }
+        }
+
+        // Finish() may still hold the lock right after the count hit zero
+        std::lock_guard<std::mutex> guard(counter->m_lock);
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize,
+                                const std::function<void(uint32_t, uint32_t)>& fn) {
+        if (count == 0) return;
+        grainSize = std::max(grainSize, 1u);
+
+        if (!Instance || count <= grainSize) {
+            fn(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = 0; begin < count; begin += grainSize) {
+            uint32_t end = std::min(begin + grainSize, count);
+            Schedule([&fn, begin, end]() { fn(begin, end); }, &counter);
+        }
+        Wait(&counter);
+    }
+
+    void JobSystem::RunMainThreadJobs() {
+        if (!Instance || !IsMainThread()) return;
+
+        // Only run what is queued now; jobs may schedule more for next frame
+        std::deque<Job*> jobs;
+        {
+            std::lock_guard<std::mutex> guard(Instance->m_mainThreadLock);
+            jobs.swap(Instance->m_mainThreadJobs);
+        }
+
+        for (Job* job : jobs)
+            Instance->Execute(job);
+    }
+
+    // --- Internals ---
+
+    void JobSystem::WorkerLoop(uint32_t index) {
+        t_workerIndex = static_cast<int32_t>(index);
+
+        while (m_running.load(std::memory_order_acquire)) {
+            if (Job* job = PopOrSteal(index)) {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepLock);
+            m_wake.wait(lock, [this]() {
+                return m_queued.load(std::memory_order_acquire) > 0 ||
+                       !m_running.load(std::memory_order_acquire);
+            });
+        }
+    }
+
+    void JobSystem::Push(Job* job) {
+        if (job->affinity == JobAffinity::MainThread) {
+            std::lock_guard<std::mutex> guard(m_mainThreadLock);
+            m_mainThreadJobs.push_back(job);
+            return;
+        }
+
+        uint32_t index = t_workerIndex > 0 ? t_workerIndex : 0;
+        {
+            std::lock_guard<std::mutex> guard(m_queues[index]->lock);
+            m_queues[index]->jobs.push_back(job);
+        }
+
+        {
+            // Taking the lock orders this against a worker about to sleep
+            std::lock_guard<std::mutex> guard(m_sleepLock);
+            m_queued.fetch_add(1, std::memory_order_release);
+        }
+        m_wake.notify_one();
+    }
+
+    Job* JobSystem::PopOrSteal(uint32_t index) {
+        // Own deque: newest first, it is most likely still in cache
+        {
+            WorkerQueue* own = m_queues[index];
+            std::lock_guard<std::mutex> guard(own->lock);
+            if (!own->jobs.empty()) {
+                Job* job = own->jobs.back();
+                own->jobs.pop_back();
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        // Steal the oldest job from someone else
+        uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+        for (uint32_t i = 1; i < queueCount; ++i) {
+            WorkerQueue* victim = m_queues[(index + i) % queueCount];
+            std::lock_guard<std::mutex> guard(victim->lock);
+            if (!victim->jobs.empty()) {
+                Job* job = victim->jobs.front();
+                victim->jobs.pop_front();
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    Job* JobSystem::PopMainThread() {
+        std::lock_guard<std::mutex> guard(m_mainThreadLock);
+        if (m_mainThreadJobs.empty()) return nullptr;
+
+        Job* job = m_mainThreadJobs.front();
+        m_mainThreadJobs.pop_front();
+        return job;
+    }
+
+    void JobSystem::Execute(Job* job) {
+        job->function();
+        Finish(job->counter);
+        delete job;
+    }
+
+    void JobSystem::Finish(JobCounter* counter) {
+        if (!counter) return;
+
+        std::vector<Job*> ready;
+        {
+            std::lock_guard<std::mutex> guard(counter->m_lock);
+            if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ready.swap(counter->m_continuations);
+        }
+
+        for (Job* job : ready)
+            Push(job);
+    }
+
+}
@@ -5,6 +5,7 @@
 #include <Graphics/ResourceManager.hpp>
 #include <Graphics/BufferBase.hpp>
 #include <Graphics/Renderer.hpp>
+#include <Graphics/RenderCommandQueue.hpp>
 #include <Camera/Camera.hpp>
 #include <Core/Application.hpp>
 #include <Math/Matrix.hpp>
@@ -13,6 +14,53 @@
 
 namespace Sleak {
 
+// First enabled directional light that casts shadows
+static DirectionalLight* FindShadowLight(const List<Light*>& lights) {
+    for (size_t i = 0; i < lights.GetSize(); ++i) {
+        Light* light = lights[i];
+        if (!light || !light->IsEnabled() || !light->GetCastShadows()) continue;
+
+        if (auto* dirLight = dynamic_cast<DirectionalLight*>(light))
+            return dirLight;
+    }
+    return nullptr;
+}
+
+// Light view-projection from the light's shadow configuration
+static Math::Matrix4 ComputeLightViewProjection(const DirectionalLight& light) {
+    Math::Vector3D dir = light.GetDirection();
+    float frustumSize = light.GetShadowFrustumSize();
+    float shadowDist  = light.GetShadowDistance();
+    float nearP       = light.GetShadowNearPlane();
+    float farP        = light.GetShadowFarPlane();
+
+    // Light position: offset from scene center along negative light direction
+    Math::Vector3D lightPos = dir * (-shadowDist);
+
+    // Convert to Vector<float,3> for Matrix methods
+    Math::Vector<float, 3> lp({lightPos.GetX(), lightPos.GetY(), lightPos.GetZ()});
+    Math::Vector<float, 3> ld({dir.GetX(), dir.GetY(), dir.GetZ()});
+    Math::Vector<float, 3> up({0.0f, 1.0f, 0.0f});
+
+    Math::Matrix4 lightView = Math::Matrix4::LookTo(lp, ld, up);
+
+    // Build Vulkan-compatible orthographic projection (LH, [0,1] depth range)
+    // Engine stores row-major, GLSL reads column-major (transposed) —
+    // translations go in ROW 3 so they end up in GLSL column 3.
+    float left = -frustumSize, right = frustumSize;
+    float bottom = -frustumSize, top = frustumSize;
+    Math::Matrix4 lightProj = Math::Matrix4::Identity();
+    lightProj(0, 0) = 2.0f / (right - left);
+    lightProj(1, 1) = 2.0f / (top - bottom);
+    lightProj(2, 2) = 1.0f / (farP - nearP);
+    lightProj(3, 0) = -(right + left) / (right - left);
+    lightProj(3, 1) = -(top + bottom) / (top - bottom);
+    lightProj(3, 2) = -nearP / (farP - nearP);
+
+    // LightVP = View * Projection (row-major convention)
+    return lightView * lightProj;
+}
+
 LightManager::LightManager() = default;
 
 LightManager::~LightManager() = default;
@@ -51,6 +99,21 @@ void LightManager::UnregisterLight(Light* light) {
     }
 }
 
+void LightManager::UnregisterLights(const List<Light*>& lights) {
+    if (lights.empty()) return;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < m_lights.GetSize(); ++i) {
+        bool removed = false;
+        for (size_t j = 0; j < lights.GetSize() && !removed; ++j)
+            removed = lights[j] == m_lights[i];
+        if (!removed)
+            m_lights[kept++] = m_lights[i];
+    }
+    while (m_lights.GetSize() > kept)
+        m_lights.erase(m_lights.GetSize() - 1);
+}
+
 void LightManager::UpdateAndBind() {
     if (!m_lightBuffer) return;
 
@@ -81,32 +144,34 @@ void LightManager::UpdateAndBind() {
     }
     cbData.NumActiveLights = count;
 
-    // Update and bind at slot 2
-    m_lightBuffer->Update(&cbData, sizeof(cbData));
-    m_lightBuffer->Update();
+    // Update and bind at slot 2 when the queue executes, which may be on
+    // the render thread while the lights already change for the next frame
+    auto buffer = m_lightBuffer;
+    RenderEngine::RenderCommandQueue::GetInstance()->SubmitCustomCommand(
+        [buffer, cbData](RenderEngine::RenderContext*) mutable {
+            buffer->Update(&cbData, sizeof(cbData));
+            buffer->Update();
+        });
 
     // Update shadow data for Vulkan renderer
     UpdateShadowData();
 }
 
+bool LightManager::GetShadowViewProjection(Math::Matrix4& out) const {
+    const DirectionalLight* shadowLight = FindShadowLight(m_lights);
+    if (!shadowLight) return false;
+
+    out = ComputeLightViewProjection(*shadowLight);
+    return true;
+}
+
 void LightManager::UpdateShadowData() {
     auto* app = Application::GetInstance();
     if (!app) return;
     auto* renderer = app->GetRenderer();
     if (!renderer) return;
 
-    // Find first shadow-casting directional light
-    DirectionalLight* shadowLight = nullptr;
-    for (size_t i = 0; i < m_lights.GetSize(); ++i) {
-        Light* light = m_lights[i];
-        if (!light || !light->IsEnabled() || !light->GetCastShadows()) continue;
-
-        auto* dirLight = dynamic_cast<DirectionalLight*>(light);
-        if (dirLight) {
-            shadowLight = dirLight;
-            break;
-        }
-    }
+    DirectionalLight* shadowLight = FindShadowLight(m_lights);
 
     // Find first enabled directional light (regardless of shadow casting)
     // for populating light/ambient data in the UBO
@@ -136,44 +201,8 @@ void LightManager::UpdateShadowData() {
     auto color = activeLight->GetColor();
     float intensity = activeLight->GetIntensity();
 
-    Math::Matrix4 lightVP = Math::Matrix4::Identity();
-
-    if (shadowLight) {
-        // Compute light view-projection matrix from shadow configuration
-        float frustumSize = shadowLight->GetShadowFrustumSize();
-        float shadowDist  = shadowLight->GetShadowDistance();
-        float nearP       = shadowLight->GetShadowNearPlane();
-        float farP        = shadowLight->GetShadowFarPlane();
-
-        // Light position: offset from scene center along negative light direction
-        Math::Vector3D lightPos = dir * (-shadowDist);
-
-        // Convert to Vector<float,3> for Matrix methods
-        Math::Vector<float, 3> lp({lightPos.GetX(), lightPos.GetY(), lightPos.GetZ()});
-        Math::Vector<float, 3> ld({dir.GetX(), dir.GetY(), dir.GetZ()});
-        Math::Vector<float, 3> up({0.0f, 1.0f, 0.0f});
-
-        Math::Matrix4 lightView = Math::Matrix4::LookTo(lp, ld, up);
-
-        // Build Vulkan-compatible orthographic projection (LH, [0,1] depth range)
-        // Engine stores row-major, GLSL reads column-major (transposed) —
-        // translations go in ROW 3 so they end up in GLSL column 3.
-        float left = -frustumSize, right = frustumSize;
-        float bottom = -frustumSize, top = frustumSize;
-        Math::Matrix4 lightProj = Math::Matrix4::Identity();
-        lightProj(0, 0) = 2.0f / (right - left);
-        lightProj(1, 1) = 2.0f / (top - bottom);
-        lightProj(2, 2) = 1.0f / (farP - nearP);
-        lightProj(3, 0) = -(right + left) / (right - left);
-        lightProj(3, 1) = -(top + bottom) / (top - bottom);
-        lightProj(3, 2) = -nearP / (farP - nearP);
-
-        // LightVP = View * Projection (row-major convention)
-        lightVP = lightView * lightProj;
-    }
-
-    // Set the light VP matrix on the renderer
-    renderer->SetLightVP(&lightVP(0, 0));
+    Math::Matrix4 lightVP = shadowLight ? ComputeLightViewProjection(*shadowLight)
+                                        : Math::Matrix4::Identity();
 
     // Build shadow light UBO
     const auto& camPos = Camera::GetMainCameraPosition();
@@ -207,7 +236,12 @@ void LightManager::UpdateShadowData() {
     ubo.ShadowTexelSize = 1.0f / 4096.0f;  // Match SHADOW_MAP_SIZE
     ubo.LightSize = shadowLight ? shadowLight->GetLightSize() : 0.0f;
 
-    renderer->UpdateShadowLightUBO(&ubo, sizeof(ubo));
+    // Handed to the renderer in order with the frame's other commands
+    RenderEngine::RenderCommandQueue::GetInstance()->SubmitCustomCommand(
+        [renderer, lightVP, ubo](RenderEngine::RenderContext*) {
+            renderer->SetLightVP(&lightVP(0, 0));
+            renderer->UpdateShadowLightUBO(&ubo, sizeof(ubo));
+        });
 }
 
 void LightManager::SetAmbientColor(float r, float g, float b) {
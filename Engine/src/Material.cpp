@@ -9,6 +9,42 @@ namespace Sleak {
 
     Material::~Material() = default;
 
+    Material* Material::Clone() const {
+        auto* clone = new Material();
+        clone->m_shader = m_shader;
+
+        clone->m_diffuseTexture = m_diffuseTexture;
+        clone->m_normalTexture = m_normalTexture;
+        clone->m_specularTexture = m_specularTexture;
+        clone->m_roughnessTexture = m_roughnessTexture;
+        clone->m_metallicTexture = m_metallicTexture;
+        clone->m_aoTexture = m_aoTexture;
+        clone->m_emissiveTexture = m_emissiveTexture;
+
+        clone->m_diffuseColor = m_diffuseColor;
+        clone->m_specularColor = m_specularColor;
+        clone->m_emissiveColor = m_emissiveColor;
+
+        clone->m_shininess = m_shininess;
+        clone->m_metallic = m_metallic;
+        clone->m_roughness = m_roughness;
+        clone->m_ao = m_ao;
+        clone->m_normalIntensity = m_normalIntensity;
+        clone->m_emissiveIntensity = m_emissiveIntensity;
+        clone->m_opacity = m_opacity;
+        clone->m_alphaCutoff = m_alphaCutoff;
+
+        clone->m_tilingX = m_tilingX;
+        clone->m_tilingY = m_tilingY;
+        clone->m_offsetX = m_offsetX;
+        clone->m_offsetY = m_offsetY;
+
+        clone->m_renderMode = m_renderMode;
+        clone->m_twoSided = m_twoSided;
+        clone->m_instancing = m_instancing;
+        return clone;
+    }
+
     // --- Initialization & Binding ---
 
     void Material::Initialize() {
@@ -18,7 +54,7 @@ namespace Sleak {
                     RenderEngine::BufferType::Constant,
                     sizeof(RenderEngine::MaterialGPUData),
                     nullptr));
-            m_materialBuffer->SetSlot(1);
+            m_materialBuffer->SetSlot(CONSTANT_SLOT_MATERIAL);
         }
     }
 
@@ -107,14 +143,14 @@ namespace Sleak {
     // --- Shader ---
 
     void Material::SetShader(RenderEngine::Shader* shader) {
-        m_shader = ObjectPtr<RenderEngine::Shader>(shader);
+        m_shader = RefPtr<RenderEngine::Shader>(shader);
     }
 
     void Material::SetShader(const std::string& shaderPath) {
         auto* shader =
             RenderEngine::ResourceManager::CreateShader(shaderPath);
         if (shader)
-            m_shader = ObjectPtr<RenderEngine::Shader>(shader);
+            m_shader = RefPtr<RenderEngine::Shader>(shader);
     }
 
     RenderEngine::Shader* Material::GetShader() const {
@@ -124,11 +160,11 @@ namespace Sleak {
     // --- Diffuse Texture ---
 
     void Material::SetDiffuseTexture(Texture* texture) {
-        m_diffuseTexture = ObjectPtr<Texture>(texture);
+        m_diffuseTexture = RefPtr<Texture>(texture);
     }
 
     void Material::SetDiffuseTexture(const std::string& path) {
-        m_diffuseTexture = ObjectPtr<Texture>(
+        m_diffuseTexture = RefPtr<Texture>(
             RenderEngine::ResourceManager::CreateTexture(path));
     }
 
@@ -144,11 +180,11 @@ namespace Sleak {
     // --- Normal Texture ---
 
     void Material::SetNormalTexture(Texture* texture) {
-        m_normalTexture = ObjectPtr<Texture>(texture);
+        m_normalTexture = RefPtr<Texture>(texture);
     }
 
     void Material::SetNormalTexture(const std::string& path) {
-        m_normalTexture = ObjectPtr<Texture>(
+        m_normalTexture = RefPtr<Texture>(
             RenderEngine::ResourceManager::CreateTexture(path));
     }
 
@@ -164,11 +200,11 @@ namespace Sleak {
     // --- Specular Texture ---
 
     void Material::SetSpecularTexture(Texture* texture) {
-        m_specularTexture = ObjectPtr<Texture>(texture);
+        m_specularTexture = RefPtr<Texture>(texture);
     }
 
     void Material::SetSpecularTexture(const std::string& path) {
-        m_specularTexture = ObjectPtr<Texture>(
+        m_specularTexture = RefPtr<Texture>(
             RenderEngine::ResourceManager::CreateTexture(path));
     }
 
@@ -184,11 +220,11 @@ namespace Sleak {
     // --- Roughness Texture ---
 
     void Material::SetRoughnessTexture(Texture* texture) {
-        m_roughnessTexture = ObjectPtr<Texture>(texture);
+        m_roughnessTexture = RefPtr<Texture>(texture);
     }
 
     void Material::SetRoughnessTexture(const std::string& path) {
-        m_roughnessTexture = ObjectPtr<Texture>(
+        m_roughnessTexture = RefPtr<Texture>(
             RenderEngine::ResourceManager::CreateTexture(path));
     }
 
@@ -205,11 +241,11 @@ namespace Sleak {
     // --- Metallic Texture ---
 
     void Material::SetMetallicTexture(Texture* texture) {
-        m_metallicTexture = ObjectPtr<Texture>(texture);
+        m_metallicTexture = RefPtr<Texture>(texture);
     }
 
     void Material::SetMetallicTexture(const std::string& path) {
-        m_metallicTexture = ObjectPtr<Texture>(
+        m_metallicTexture = RefPtr<Texture>(
             RenderEngine::ResourceManager::CreateTexture(path));
     }
 
@@ -226,11 +262,11 @@ namespace Sleak {
     // --- AO Texture ---
 
     void Material::SetAOTexture(Texture* texture) {
-        m_aoTexture = ObjectPtr<Texture>(texture);
+        m_aoTexture = RefPtr<Texture>(texture);
     }
 
     void Material::SetAOTexture(const std::string& path) {
-        m_aoTexture = ObjectPtr<Texture>(
+        m_aoTexture = RefPtr<Texture>(
             RenderEngine::ResourceManager::CreateTexture(path));
     }
 
@@ -245,11 +281,11 @@ namespace Sleak {
     // --- Emissive Texture ---
 
     void Material::SetEmissiveTexture(Texture* texture) {
-        m_emissiveTexture = ObjectPtr<Texture>(texture);
+        m_emissiveTexture = RefPtr<Texture>(texture);
     }
 
     void Material::SetEmissiveTexture(const std::string& path) {
-        m_emissiveTexture = ObjectPtr<Texture>(
+        m_emissiveTexture = RefPtr<Texture>(
             RenderEngine::ResourceManager::CreateTexture(path));
     }
 
@@ -410,4 +446,10 @@ namespace Sleak {
 
     bool Material::IsTwoSided() const { return m_twoSided; }
 
+    void Material::SetInstancing(bool enabled) {
+        m_instancing = enabled;
+    }
+
+    bool Material::IsInstancingEnabled() const { return m_instancing; }
+
 }
@@ -1,12 +1,15 @@
 #include <ECS/Components/MaterialComponent.hpp>
 #include <Graphics/RenderCommandQueue.hpp>
+#include <Core/GameObject.hpp>
 
 namespace Sleak {
 
     // Shared material constructor (copies RefPtr, shares ownership)
     MaterialComponent::MaterialComponent(
-        GameObject* object, const RefPtr<Material>& material)
-        : Component(object), m_material(material) {}
+        GameObject* object, const RefPtr<Material>& material,
+        MaterialSharing sharing)
+        : Component(object), m_material(material),
+          m_copyOnWrite(sharing == MaterialSharing::CopyOnWrite) {}
 
     // Raw pointer constructor (takes sole ownership)
     MaterialComponent::MaterialComponent(GameObject* object,
@@ -46,7 +49,7 @@ namespace Sleak {
     }
 
     void MaterialComponent::Update(float DeltaTime) {
-        if (!m_enabled || !m_material)
+        if (!m_enabled || !m_material || owner->IsCulled())
             return;
 
         RenderEngine::RenderCommandQueue::GetInstance()->SubmitBindMaterial(m_material.get());
@@ -61,12 +64,14 @@ namespace Sleak {
     void MaterialComponent::SetMaterial(
         const RefPtr<Material>& material) {
         m_material = material;
+        m_copyOnWrite = false;
         if (bIsInitialized && m_material) {
             m_material->Initialize();
         }
     }
 
     void MaterialComponent::SetMaterial(Material* material) {
+        m_copyOnWrite = false;
         if (material)
             m_material = RefPtr<Material>(material);
         else
@@ -85,36 +90,51 @@ namespace Sleak {
         return m_material.IsValid() ? m_material.get() : nullptr;
     }
 
+    void MaterialComponent::MakeMaterialUnique() {
+        if (!m_copyOnWrite || !m_material) return;
+        m_copyOnWrite = false;
+
+        m_material = RefPtr<Material>(m_material->Clone());
+        if (bIsInitialized)
+            m_material->Initialize();
+    }
+
     // --- Convenience shortcuts ---
 
     void MaterialComponent::SetDiffuseColor(Math::Color color) {
+        MakeMaterialUnique();
         if (m_material)
             m_material->SetDiffuseColor(color);
     }
 
     void MaterialComponent::SetDiffuseTexture(
         const std::string& path) {
+        MakeMaterialUnique();
         if (m_material)
             m_material->SetDiffuseTexture(path);
     }
 
     void MaterialComponent::SetNormalTexture(
         const std::string& path) {
+        MakeMaterialUnique();
         if (m_material)
             m_material->SetNormalTexture(path);
     }
 
     void MaterialComponent::SetShininess(float shininess) {
+        MakeMaterialUnique();
         if (m_material)
             m_material->SetShininess(shininess);
     }
 
     void MaterialComponent::SetMetallic(float metallic) {
+        MakeMaterialUnique();
         if (m_material)
             m_material->SetMetallic(metallic);
     }
 
     void MaterialComponent::SetRoughness(float roughness) {
+        MakeMaterialUnique();
         if (m_material)
             m_material->SetRoughness(roughness);
     }
@@ -4,29 +4,73 @@
 #include "../../include/private/Graphics/ConstantBuffer.hpp"
 #include "../../include/private/Graphics/RenderCommandQueue.hpp"
 #include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/MaterialComponent.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <Runtime/Material.hpp>
+#include <Camera/Camera.hpp>
+#include <Core/SceneBase.hpp>
 
 namespace Sleak {
+    MeshComponent::MeshComponent(GameObject* object) : Component(object) {}
+
 MeshComponent::MeshComponent(GameObject* object, MeshData data) : Component(object) {
-        VertexBuffer = RefPtr(RenderEngine::ResourceManager::CreateBuffer(
-            RenderEngine::BufferType::Vertex,
-            data.vertices.GetSizeInBytes(),
-            data.vertices.GetRawData()));
+        if (data.layout == VertexLayout::Standard) {
+            VertexBuffer = RefPtr(RenderEngine::ResourceManager::CreateBuffer(
+                RenderEngine::BufferType::Vertex,
+                data.vertices.GetSizeInBytes(),
+                data.vertices.GetRawData()));
+        } else {
+            // Only the GPU copy is packed; colliders and bounds read the full vertices
+            auto packed = VertexFormat::EncodeVertices(data.vertices.GetData(),
+                                                       data.vertices.GetSize(), data.layout);
+            VertexBuffer = RefPtr(RenderEngine::ResourceManager::CreateBuffer(
+                RenderEngine::BufferType::Vertex, packed.size(), packed.data()));
+            if (VertexBuffer.IsValid())
+                VertexBuffer->SetVertexLayout(data.layout);
+        }
         
         IndexBuffer = RefPtr(RenderEngine::ResourceManager::CreateBuffer(
             RenderEngine::BufferType::Index,
             data.indices.GetByteSize(), 
-            data.indices.GetRawData()));
+            data.indices.GetRawData(),
+            data.indices.GetFormat()));
 
             VertexCount = data.vertices.GetSize();
             IndexCount = data.indices.GetSize();
+
+        if (VertexCount > 0) {
+            SetLocalBounds(Physics::AABB::FromVertices(
+                &data.vertices.GetData()[0].px, VertexCount, sizeof(Vertex)));
+        }
+
+        m_ownedMeshData = std::make_unique<MeshData>(std::move(data));
+        m_meshData = m_ownedMeshData.get();
     }
 
+    MeshComponent::MeshComponent(GameObject* object,
+                                 const RefPtr<RenderEngine::BufferBase>& vertexBuffer,
+                                 const RefPtr<RenderEngine::BufferBase>& indexBuffer,
+                                 uint32_t vertexCount, uint32_t indexCount)
+        : Component(object),
+          VertexBuffer(vertexBuffer),
+          IndexBuffer(indexBuffer),
+          VertexCount(vertexCount),
+          IndexCount(indexCount) {}
+
+    MeshComponent::~MeshComponent() = default;
+
     bool MeshComponent::Initialize() {
         if (!VertexBuffer.IsValid())
             return false;
         
         if (!IndexBuffer.IsValid())
             return false;
+
+        // Added after the scene batched its static meshes: nothing reads it
+        if (SceneBase* scene = owner->GetScene()) {
+            if (scene->GetStaticBatcher().IsBuilt())
+                ReleaseMeshData();
+        }
                 
         bIsInitialized = true;
 
@@ -34,10 +78,45 @@ MeshComponent::MeshComponent(GameObject* object, MeshData data) : Component(obje
     }
 
     void MeshComponent::Update(float deltaTime) {
-        if (!bIsInitialized) 
+        if (!bIsInitialized || m_batched || owner->IsCulled()) 
             return;
 
-        RenderEngine::RenderCommandQueue::GetInstance()->SubmitDrawIndexed(VertexBuffer,IndexBuffer,ConstantBuffers,IndexCount);
+        auto* queue = RenderEngine::RenderCommandQueue::GetInstance();
+        auto* command = queue->SubmitDrawIndexed(VertexBuffer,IndexBuffer,ConstantBuffers,IndexCount);
+        command->SetOwner(owner->GetHandle());
+        command->SetSortKey(BuildSortKey(queue));
+
+        if (auto* transform = owner->GetComponent<TransformComponent>())
+            static_cast<RenderEngine::DrawIndexedCommand*>(command)->SetWorldMatrix(transform->GetWorldMatrix());
+    }
+
+    uint64_t MeshComponent::BuildSortKey(RenderEngine::RenderCommandQueue* queue) const {
+        const Material* material = nullptr;
+        if (auto* materialComponent = owner->GetComponent<MaterialComponent>())
+            material = materialComponent->GetMaterial().get();
+
+        float depth = 0.0f;
+        if (auto* transform = owner->GetComponent<TransformComponent>())
+            depth = (transform->GetWorldPosition() - Camera::GetMainCameraPosition()).Magnitude();
+
+        uint8_t mode = material ? static_cast<uint8_t>(material->GetRenderMode()) : 0;
+
+        return RenderEngine::RenderSortKey::Make(
+            RenderEngine::SortPass::Main, mode,
+            queue->GetSortID(RenderEngine::SortResource::Shader, material ? material->GetShader() : nullptr),
+            queue->GetSortID(RenderEngine::SortResource::Material, material),
+            queue->GetSortID(RenderEngine::SortResource::Mesh, VertexBuffer.get()),
+            depth);
+    }
+
+    void MeshComponent::ReleaseMeshData() {
+        m_meshData = nullptr;
+        m_ownedMeshData.reset();
+    }
+
+    void MeshComponent::SetLocalBounds(const Physics::AABB& bounds) {
+        m_localBounds = bounds;
+        m_hasBounds = true;
     }
 
     void MeshComponent::SetVertexBuffer(RefPtr<RenderEngine::BufferBase>& buffer) {
@@ -444,7 +444,7 @@ MeshData ModelLoader::ProcessMesh(aiMesh* mesh, const ModelLoadOptions& options,
         }
     }
 
-    // Indices
+    // Indices, kept 16-bit while every index fits
     for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
         const aiFace& face = mesh->mFaces[i];
         if (options.flipWinding && face.mNumIndices == 3) {
@@ -458,9 +458,27 @@ MeshData ModelLoader::ProcessMesh(aiMesh* mesh, const ModelLoadOptions& options,
         }
     }
 
-    SLEAK_INFO("  Mesh '{}': {} vertices, {} indices{}",
+    if (options.compactVertices) {
+        bool skinned = false;
+        for (size_t i = 0; i < data.vertices.GetSize() && !skinned; ++i) {
+            const Vertex& v = data.vertices.GetData()[i];
+            skinned = v.boneIDs[0] >= 0 || v.boneIDs[1] >= 0 ||
+                      v.boneIDs[2] >= 0 || v.boneIDs[3] >= 0;
+        }
+
+        VertexLayout layout = skinned ? VertexLayout::SkinnedCompact : VertexLayout::StaticCompact;
+        if (VertexFormat::CanEncode(data.vertices.GetData(), data.vertices.GetSize(), layout)) {
+            data.layout = layout;
+        } else {
+            SLEAK_WARN("  Mesh '{}' uses bones past {} or UVs past +-{}, keeping the standard vertex layout",
+                       mesh->mName.C_Str(), VertexFormat::MAX_COMPACT_BONE, VertexFormat::MAX_COMPACT_UV);
+        }
+    }
+
+    SLEAK_INFO("  Mesh '{}': {} vertices ({} bytes each), {} {}-bit indices{}",
                mesh->mName.C_Str(), mesh->mNumVertices,
-               data.indices.GetSize(),
+               VertexFormat::GetStride(data.layout),
+               data.indices.GetSize(), GetIndexSize(data.indices.GetFormat()) * 8,
                mesh->HasBones() ? " (skinned)" : "");
 
     return data;
@@ -0,0 +1,266 @@
+#include "../../include/private/Graphics/Null/NullRenderer.hpp"
+#include "../../include/private/Graphics/Null/NullResources.hpp"
+#include "Graphics/ResourceManager.hpp"
+#include <Logger.hpp>
+#include <imgui.h>
+
+namespace Sleak {
+namespace RenderEngine {
+
+NullRenderStats& NullRenderStats::operator+=(const NullRenderStats& other) {
+    drawCalls += other.drawCalls;
+    instances += other.instances;
+    vertices += other.vertices;
+    triangles += other.triangles;
+    bufferBinds += other.bufferBinds;
+    textureBinds += other.textureBinds;
+    resourcesCreated += other.resourcesCreated;
+    return *this;
+}
+
+NullRenderer::NullRenderer(uint32_t width, uint32_t height)
+    : m_width(width), m_height(height) {
+    this->Type = RendererType::Null;
+    this->Mode = RenderMode::Fill;
+    this->Face = RenderFace::Back;
+
+    ResourceManager::RegisterCreateBuffer(
+        this, &NullRenderer::CreateBuffer);
+    ResourceManager::RegisterCreateShader(
+        this, &NullRenderer::CreateShader);
+    ResourceManager::RegisterCreateTexture(
+        this, &NullRenderer::CreateTexture);
+    ResourceManager::RegisterCreateCubemapTexture(
+        this, &NullRenderer::CreateCubemapTexture);
+    ResourceManager::RegisterCreateCubemapTextureFromPanorama(
+        this, &NullRenderer::CreateCubemapTextureFromPanorama);
+    ResourceManager::RegisterCreateTextureFromMemory(
+        [this](const void* data, uint32_t w, uint32_t h, TextureFormat fmt) -> Texture* {
+            auto* tex = new NullTexture();
+            tex->LoadFromMemory(data, w, h, fmt);
+            m_frame.resourcesCreated++;
+            return tex;
+        });
+}
+
+NullRenderer::~NullRenderer() {
+    Cleanup();
+}
+
+bool NullRenderer::Initialize() {
+    if (m_Initialized) {
+        return true;
+    }
+
+    m_Initialized = true;
+    SetPerformanceCounter(true);
+
+    SLEAK_INFO("Null renderer has been initialized, running headless");
+    return true;
+}
+
+void NullRenderer::BeginRender() {
+    if (bImInitialized) {
+        // Headless frames are not paced, give ImGui a nominal step
+        ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+    }
+}
+
+void NullRenderer::EndRender() {
+    if (bImInitialized)
+        ImGui::EndFrame();
+
+    m_lastFrame = m_frame;
+    m_total += m_frame;
+    m_framesRendered++;
+
+    // Resources created between frames count towards the next one
+    m_frame = NullRenderStats();
+
+    UpdateFrameMetrics();
+}
+
+void NullRenderer::Cleanup() {
+    if (!m_Initialized) return;
+    m_Initialized = false;
+
+    if (bImInitialized) {
+        ImGui::DestroyContext();
+        bImInitialized = false;
+    }
+
+    SLEAK_INFO("Null renderer: {} frames, {} draw calls, {} triangles",
+               m_framesRendered, m_total.drawCalls, m_total.triangles);
+}
+
+void NullRenderer::Resize(uint32_t width, uint32_t height) {
+    m_width = width;
+    m_height = height;
+
+    if (bImInitialized)
+        ImGui::GetIO().DisplaySize = ImVec2(float(width), float(height));
+}
+
+bool NullRenderer::CreateImGUI() {
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(float(m_width), float(m_height));
+    io.IniFilename = nullptr;
+
+    // NewFrame asserts on an unbuilt font atlas
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    bImInitialized = true;
+    return true;
+}
+
+// -----------------------------------------------------------------------
+// RenderContext Implementation
+// -----------------------------------------------------------------------
+
+void NullRenderer::CountDraw(uint32_t instanceCount, uint32_t verticesPerInstance) {
+    m_frame.drawCalls++;
+    m_frame.instances += instanceCount;
+    m_frame.vertices += uint64_t(verticesPerInstance) * instanceCount;
+    m_frame.triangles += uint64_t(verticesPerInstance / 3) * instanceCount;
+
+    DrawnVertices += verticesPerInstance * instanceCount;
+    DrawnTriangles += (verticesPerInstance / 3) * instanceCount;
+}
+
+void NullRenderer::Draw(uint32_t vertexCount) {
+    CountDraw(1, vertexCount);
+}
+
+void NullRenderer::DrawIndexed(uint32_t indexCount, uint32_t startIndex,
+                               int32_t baseVertex) {
+    (void)startIndex;
+    (void)baseVertex;
+    CountDraw(1, indexCount);
+}
+
+void NullRenderer::DrawInstance(uint32_t instanceCount,
+                                uint32_t vertexPerInstance) {
+    CountDraw(instanceCount, vertexPerInstance);
+}
+
+void NullRenderer::DrawIndexedInstance(uint32_t instanceCount,
+                                       uint32_t indexPerInstance,
+                                       uint32_t startIndex,
+                                       int32_t baseVertex) {
+    (void)startIndex;
+    (void)baseVertex;
+    CountDraw(instanceCount, indexPerInstance);
+}
+
+void NullRenderer::SetRenderFace(RenderFace face) {
+    Face = face;
+}
+
+void NullRenderer::SetRenderMode(RenderMode mode) {
+    Mode = mode;
+}
+
+void NullRenderer::SetViewport(float x, float y, float width, float height,
+                               float minDepth, float maxDepth) {
+    (void)x; (void)y; (void)width; (void)height;
+    (void)minDepth; (void)maxDepth;
+}
+
+void NullRenderer::ClearRenderTarget(float r, float g, float b, float a) {
+    (void)r; (void)g; (void)b; (void)a;
+}
+
+void NullRenderer::ClearDepthStencil(bool clearDepth, bool clearStencil,
+                                     float depth, uint8_t stencil) {
+    (void)clearDepth; (void)clearStencil; (void)depth; (void)stencil;
+}
+
+void NullRenderer::BindTexture(RefPtr<Sleak::Texture> texture, uint32_t slot) {
+    (void)texture; (void)slot;
+    m_frame.textureBinds++;
+}
+
+void NullRenderer::BindTextureRaw(Sleak::Texture* texture, uint32_t slot) {
+    (void)texture; (void)slot;
+    m_frame.textureBinds++;
+}
+
+void NullRenderer::BindVertexBuffer(RefPtr<BufferBase> buffer, uint32_t slot) {
+    (void)buffer; (void)slot;
+    m_frame.bufferBinds++;
+}
+
+void NullRenderer::BindIndexBuffer(RefPtr<BufferBase> buffer, uint32_t slot) {
+    (void)buffer; (void)slot;
+    m_frame.bufferBinds++;
+}
+
+void NullRenderer::BindConstantBuffer(RefPtr<BufferBase> buffer, uint32_t slot) {
+    (void)buffer; (void)slot;
+    m_frame.bufferBinds++;
+}
+
+void NullRenderer::BindBoneBuffer(RefPtr<BufferBase> buffer) {
+    (void)buffer;
+    m_frame.bufferBinds++;
+}
+
+bool NullRenderer::BeginInstancedDraw(RefPtr<BufferBase> instances, uint32_t firstInstance) {
+    (void)firstInstance;
+    if (!instances) return false;
+    m_frame.bufferBinds++;
+    return true;
+}
+
+// -----------------------------------------------------------------------
+// Resource creation
+// -----------------------------------------------------------------------
+
+BufferBase* NullRenderer::CreateBuffer(BufferType Type, uint32_t size, void* data) {
+    auto* buffer = new NullBuffer(size, Type);
+    buffer->Initialize(data);
+    m_frame.resourcesCreated++;
+    return buffer;
+}
+
+Shader* NullRenderer::CreateShader(const std::string& shaderSource) {
+    auto* shader = new NullShader();
+    shader->compile(shaderSource);
+    m_frame.resourcesCreated++;
+    return shader;
+}
+
+Texture* NullRenderer::CreateTexture(const std::string& TexturePath) {
+    auto* texture = new NullTexture();
+    texture->LoadFromFile(TexturePath);
+    m_frame.resourcesCreated++;
+    return texture;
+}
+
+Texture* NullRenderer::CreateTextureFromData(uint32_t width, uint32_t height, void* data) {
+    auto* texture = new NullTexture();
+    texture->LoadFromMemory(data, width, height, TextureFormat::RGBA8);
+    m_frame.resourcesCreated++;
+    return texture;
+}
+
+Texture* NullRenderer::CreateCubemapTexture(const std::array<std::string, 6>& facePaths) {
+    (void)facePaths;
+    m_frame.resourcesCreated++;
+    return new NullTexture(TextureType::TextureCube);
+}
+
+Texture* NullRenderer::CreateCubemapTextureFromPanorama(const std::string& panoramaPath) {
+    (void)panoramaPath;
+    m_frame.resourcesCreated++;
+    return new NullTexture(TextureType::TextureCube);
+}
+
+}  // namespace RenderEngine
+}  // namespace Sleak
@@ -0,0 +1,56 @@
+#include "../../include/private/Graphics/Null/NullResources.hpp"
+
+namespace Sleak {
+namespace RenderEngine {
+
+// --- NullBuffer ---
+
+NullBuffer::NullBuffer(uint32_t size, BufferType type) {
+    Size = size;
+    Type = type;
+}
+
+bool NullBuffer::Initialize(void* data) {
+    (void)data;
+    bIsInitialized = true;
+    return true;
+}
+
+void NullBuffer::Update(void* data, size_t size) {
+    (void)data;
+    if (size > Size) Size = size;
+}
+
+// --- NullShader ---
+
+bool NullShader::compile(const std::string& shaderPath) {
+    (void)shaderPath;
+    return true;
+}
+
+bool NullShader::compile(const std::string& vert, const std::string& frag) {
+    (void)vert;
+    (void)frag;
+    return true;
+}
+
+// --- NullTexture ---
+
+NullTexture::NullTexture(TextureType type) : m_type(type) {}
+
+bool NullTexture::LoadFromMemory(const void* data, uint32_t width, uint32_t height,
+                                 TextureFormat format) {
+    (void)data;
+    m_width = width;
+    m_height = height;
+    m_format = format;
+    return true;
+}
+
+bool NullTexture::LoadFromFile(const std::string& filePath) {
+    (void)filePath;
+    return true;
+}
+
+}  // namespace RenderEngine
+}  // namespace Sleak
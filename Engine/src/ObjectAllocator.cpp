@@ -0,0 +1,111 @@
+#include <Memory/ObjectAllocator.h>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Sleak {
+
+    static constexpr size_t SIZE_CLASS_COUNT =
+        ObjectAllocator::MAX_POOLED_SIZE / ObjectAllocator::GRANULARITY;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct AllocatorState {
+        std::mutex lock;
+        FreeBlock* freeLists[SIZE_CLASS_COUNT] = {};
+        std::vector<void*> chunks;
+        size_t liveCount = 0;
+    };
+
+    // Never destroyed: objects may still be freed during static destruction
+    static AllocatorState& GetState() {
+        static AllocatorState* state = new AllocatorState();
+        return *state;
+    }
+
+    static size_t SizeClassOf(size_t size) {
+        return (size + ObjectAllocator::GRANULARITY - 1) / ObjectAllocator::GRANULARITY - 1;
+    }
+
+    // Caller holds the lock
+    static void AddChunk(AllocatorState& state, size_t sizeClass) {
+        size_t blockSize = (sizeClass + 1) * ObjectAllocator::GRANULARITY;
+        auto* chunk = static_cast<unsigned char*>(
+            ::operator new(blockSize * ObjectAllocator::BLOCKS_PER_CHUNK,
+                           std::align_val_t(ObjectAllocator::GRANULARITY)));
+        state.chunks.push_back(chunk);
+
+        // Thread the blocks back to front so they are handed out in address order
+        for (size_t i = ObjectAllocator::BLOCKS_PER_CHUNK; i-- > 0;) {
+            auto* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+            block->next = state.freeLists[sizeClass];
+            state.freeLists[sizeClass] = block;
+        }
+    }
+
+    void* ObjectAllocator::Allocate(size_t size) {
+        if (size == 0) size = 1;
+        if (size > MAX_POOLED_SIZE) return ::operator new(size);
+
+        size_t sizeClass = SizeClassOf(size);
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+
+        if (!state.freeLists[sizeClass]) AddChunk(state, sizeClass);
+
+        FreeBlock* block = state.freeLists[sizeClass];
+        state.freeLists[sizeClass] = block->next;
+        ++state.liveCount;
+        return block;
+    }
+
+    void ObjectAllocator::Free(void* memory, size_t size) {
+        if (!memory) return;
+        if (size == 0) size = 1;
+        if (size > MAX_POOLED_SIZE) {
+            ::operator delete(memory);
+            return;
+        }
+
+        size_t sizeClass = SizeClassOf(size);
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+
+        auto* block = static_cast<FreeBlock*>(memory);
+        block->next = state.freeLists[sizeClass];
+        state.freeLists[sizeClass] = block;
+        --state.liveCount;
+    }
+
+    void ObjectAllocator::Reserve(size_t size, size_t count) {
+        if (size == 0 || size > MAX_POOLED_SIZE) return;
+
+        size_t sizeClass = SizeClassOf(size);
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+
+        size_t available = 0;
+        for (FreeBlock* block = state.freeLists[sizeClass]; block && available < count;
+             block = block->next) {
+            ++available;
+        }
+
+        for (; available < count; available += BLOCKS_PER_CHUNK)
+            AddChunk(state, sizeClass);
+    }
+
+    size_t ObjectAllocator::GetLiveCount() {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+        return state.liveCount;
+    }
+
+    size_t ObjectAllocator::GetChunkCount() {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+        return state.chunks.size();
+    }
+
+}
@@ -0,0 +1,56 @@
+#include <ECS/Components/OccluderComponent.hpp>
+#include <Runtime/MeshData.hpp>
+
+namespace Sleak {
+
+    OccluderComponent::OccluderComponent(GameObject* object,
+                                         std::vector<float> positions,
+                                         std::vector<uint32_t> indices)
+        : Component(object),
+          m_positions(std::move(positions)),
+          m_indices(std::move(indices)) {
+        m_localBounds = Physics::AABB::FromVertices(m_positions.data(), GetVertexCount(),
+                                                    3 * sizeof(float));
+    }
+
+    OccluderComponent::OccluderComponent(GameObject* object, const MeshData& data)
+        : Component(object) {
+        const size_t vertexCount = data.vertices.GetSize();
+        const Vertex* vertices = data.vertices.GetData();
+
+        m_positions.reserve(vertexCount * 3);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            m_positions.push_back(vertices[i].px);
+            m_positions.push_back(vertices[i].py);
+            m_positions.push_back(vertices[i].pz);
+        }
+
+        m_indices = data.indices.ToVector();
+        m_localBounds = Physics::AABB::FromVertices(m_positions.data(), vertexCount,
+                                                    3 * sizeof(float));
+    }
+
+    OccluderComponent::OccluderComponent(GameObject* object, const Physics::AABB& box)
+        : Component(object), m_localBounds(box) {
+        const Math::Vector3D& lo = box.min;
+        const Math::Vector3D& hi = box.max;
+
+        // Corner i takes max on x for bit 0, y for bit 1, z for bit 2
+        for (int i = 0; i < 8; ++i) {
+            m_positions.push_back((i & 1) ? hi.GetX() : lo.GetX());
+            m_positions.push_back((i & 2) ? hi.GetY() : lo.GetY());
+            m_positions.push_back((i & 4) ? hi.GetZ() : lo.GetZ());
+        }
+
+        // The rasterizer draws both windings, so faces need no consistent order
+        m_indices = {
+            0, 1, 3, 0, 3, 2,   // -z
+            4, 5, 7, 4, 7, 6,   // +z
+            0, 1, 5, 0, 5, 4,   // -y
+            2, 3, 7, 2, 7, 6,   // +y
+            0, 2, 6, 0, 6, 4,   // -x
+            1, 3, 7, 1, 7, 5    // +x
+        };
+    }
+
+}
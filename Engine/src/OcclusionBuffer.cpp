@@ -0,0 +1,315 @@
+#include <Camera/OcclusionBuffer.hpp>
+#include <Core/JobSystem.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace Sleak {
+
+    // Texels a box may span on each axis at the HiZ level it is tested on
+    static constexpr uint32_t TEST_FOOTPRINT = 8;
+
+    static uint32_t Log2(uint32_t value) {
+        uint32_t result = 0;
+        while (value > 1) {
+            value >>= 1;
+            ++result;
+        }
+        return result;
+    }
+
+    OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height) {
+        m_tilesX = std::max<uint32_t>(1, (width + TILE_WIDTH - 1) / TILE_WIDTH);
+        m_tilesY = std::max<uint32_t>(1, (height + TILE_HEIGHT - 1) / TILE_HEIGHT);
+        m_width = m_tilesX * TILE_WIDTH;
+        m_height = m_tilesY * TILE_HEIGHT;
+        m_tileLevels = Log2(std::min(TILE_WIDTH, TILE_HEIGHT));
+
+        // Inside the tiles every level halves evenly; past them, while it still does
+        uint32_t levelWidth = m_width;
+        uint32_t levelHeight = m_height;
+        uint32_t total = 0;
+        for (uint32_t level = 0;; ++level) {
+            m_levelOffsets.push_back(total);
+            total += levelWidth * levelHeight;
+
+            bool even = levelWidth % 2 == 0 && levelHeight % 2 == 0;
+            if (level >= m_tileLevels && !even) break;
+            levelWidth /= 2;
+            levelHeight /= 2;
+        }
+
+        m_depth.assign(total, 0.0f);
+        m_bins.resize(m_tilesX * m_tilesY);
+    }
+
+    void OcclusionBuffer::Begin(const Math::Matrix4& viewProjection) {
+        m_viewProjection = viewProjection;
+        std::fill(m_depth.begin(), m_depth.begin() + m_width * m_height, 0.0f);
+
+        m_triangles.clear();
+        for (auto& bin : m_bins)
+            bin.clear();
+    }
+
+    // --- Setup ---
+
+    void OcclusionBuffer::AddOccluder(const float* positions, uint32_t vertexCount,
+                                      const uint32_t* indices, uint32_t indexCount,
+                                      const Math::Matrix4& world) {
+        const Math::Matrix4 m = world * m_viewProjection;
+
+        m_clipVertices.resize(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            const float x = positions[i * 3 + 0];
+            const float y = positions[i * 3 + 1];
+            const float z = positions[i * 3 + 2];
+
+            ClipVertex& out = m_clipVertices[i];
+            out.x = x * m(0, 0) + y * m(1, 0) + z * m(2, 0) + m(3, 0);
+            out.y = x * m(0, 1) + y * m(1, 1) + z * m(2, 1) + m(3, 1);
+            out.z = x * m(0, 2) + y * m(1, 2) + z * m(2, 2) + m(3, 2);
+            out.w = x * m(0, 3) + y * m(1, 3) + z * m(2, 3) + m(3, 3);
+        }
+
+        for (uint32_t i = 0; i + 2 < indexCount; i += 3) {
+            const uint32_t i0 = indices[i], i1 = indices[i + 1], i2 = indices[i + 2];
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) continue;
+
+            AddTriangle(m_clipVertices[i0], m_clipVertices[i1], m_clipVertices[i2]);
+        }
+    }
+
+    void OcclusionBuffer::AddTriangle(const ClipVertex& v0, const ClipVertex& v1,
+                                      const ClipVertex& v2) {
+        // Near plane is clip.z >= 0, as in ViewFrustum
+        const ClipVertex input[3] = {v0, v1, v2};
+        const bool inside[3] = {v0.z >= 0.0f, v1.z >= 0.0f, v2.z >= 0.0f};
+
+        if (inside[0] && inside[1] && inside[2]) {
+            SetupTriangle(input);
+            return;
+        }
+        if (!inside[0] && !inside[1] && !inside[2]) return;
+
+        // One plane of Sutherland-Hodgman: 3 or 4 vertices out
+        ClipVertex polygon[4];
+        int count = 0;
+        for (int i = 0; i < 3; ++i) {
+            const ClipVertex& a = input[i];
+            const ClipVertex& b = input[(i + 1) % 3];
+
+            if (inside[i]) polygon[count++] = a;
+            if (inside[i] != inside[(i + 1) % 3]) {
+                const float t = a.z / (a.z - b.z);
+                polygon[count++] = {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                                    0.0f, a.w + (b.w - a.w) * t};
+            }
+        }
+
+        for (int i = 1; i + 1 < count; ++i) {
+            const ClipVertex fan[3] = {polygon[0], polygon[i], polygon[i + 1]};
+            SetupTriangle(fan);
+        }
+    }
+
+    void OcclusionBuffer::SetupTriangle(const ClipVertex* vertices) {
+        float x[3], y[3], depth[3];
+        for (int i = 0; i < 3; ++i) {
+            if (vertices[i].w <= 0.0f) return;
+
+            const float invW = 1.0f / vertices[i].w;
+            x[i] = (vertices[i].x * invW * 0.5f + 0.5f) * m_width;
+            y[i] = (0.5f - vertices[i].y * invW * 0.5f) * m_height;
+            depth[i] = invW;
+        }
+
+        const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (std::fabs(area) < 1e-6f) return;
+
+        const int minX = std::max(0, static_cast<int>(std::floor(std::min({x[0], x[1], x[2]}))));
+        const int minY = std::max(0, static_cast<int>(std::floor(std::min({y[0], y[1], y[2]}))));
+        const int maxX = std::min(static_cast<int>(m_width) - 1,
+                                  static_cast<int>(std::ceil(std::max({x[0], x[1], x[2]}))));
+        const int maxY = std::min(static_cast<int>(m_height) - 1,
+                                  static_cast<int>(std::ceil(std::max({y[0], y[1], y[2]}))));
+        if (minX > maxX || minY > maxY) return;
+
+        // Both windings are drawn: flip the edges so inside is positive
+        const float sign = area > 0.0f ? 1.0f : -1.0f;
+        const float invArea = 1.0f / std::fabs(area);
+
+        Triangle triangle;
+        triangle.depthA = triangle.depthB = triangle.depthC = 0.0f;
+        for (int edge = 0; edge < 3; ++edge) {
+            // Edge opposite vertex `edge`
+            const int i = (edge + 1) % 3;
+            const int j = (edge + 2) % 3;
+
+            // Symmetric in i and j: the neighbour sharing the edge gets the
+            // exact negation, so no pixel on it is missed by both
+            triangle.edgeA[edge] = sign * (y[i] - y[j]);
+            triangle.edgeB[edge] = sign * (x[j] - x[i]);
+            triangle.edgeC[edge] = sign * (x[i] * y[j] - x[j] * y[i]);
+
+            // Barycentric weight of the vertex is its edge over the area
+            triangle.depthA += triangle.edgeA[edge] * invArea * depth[edge];
+            triangle.depthB += triangle.edgeB[edge] * invArea * depth[edge];
+            triangle.depthC += triangle.edgeC[edge] * invArea * depth[edge];
+        }
+        triangle.minX = minX;
+        triangle.minY = minY;
+        triangle.maxX = maxX;
+        triangle.maxY = maxY;
+
+        const uint32_t index = static_cast<uint32_t>(m_triangles.size());
+        m_triangles.push_back(triangle);
+
+        for (int ty = minY / TILE_HEIGHT; ty <= maxY / static_cast<int>(TILE_HEIGHT); ++ty) {
+            for (int tx = minX / TILE_WIDTH; tx <= maxX / static_cast<int>(TILE_WIDTH); ++tx)
+                m_bins[ty * m_tilesX + tx].push_back(index);
+        }
+    }
+
+    // --- Rasterization ---
+
+    void OcclusionBuffer::Rasterize() {
+        // Tiles own disjoint pixels and HiZ texels: no synchronization needed
+        JobSystem::ParallelFor(m_tilesX * m_tilesY, 1, [this](uint32_t begin, uint32_t end) {
+            for (uint32_t tile = begin; tile < end; ++tile) {
+                RasterizeTile(tile);
+                BuildTileHiZ(tile);
+            }
+        });
+
+        BuildCoarseHiZ();
+    }
+
+    void OcclusionBuffer::RasterizeTile(uint32_t tile) {
+        const int tileX = static_cast<int>((tile % m_tilesX) * TILE_WIDTH);
+        const int tileY = static_cast<int>((tile / m_tilesX) * TILE_HEIGHT);
+
+        for (uint32_t index : m_bins[tile]) {
+            const Triangle& t = m_triangles[index];
+            const int x0 = std::max(t.minX, tileX);
+            const int x1 = std::min(t.maxX, tileX + static_cast<int>(TILE_WIDTH) - 1);
+            const int y0 = std::max(t.minY, tileY);
+            const int y1 = std::min(t.maxY, tileY + static_cast<int>(TILE_HEIGHT) - 1);
+
+            for (int y = y0; y <= y1; ++y) {
+                const float py = y + 0.5f;
+                const float row0 = t.edgeB[0] * py + t.edgeC[0];
+                const float row1 = t.edgeB[1] * py + t.edgeC[1];
+                const float row2 = t.edgeB[2] * py + t.edgeC[2];
+                const float rowDepth = t.depthB * py + t.depthC;
+                float* pixels = m_depth.data() + y * m_width;
+
+                // Branch-free so the compiler can run several pixels per instruction
+                for (int x = x0; x <= x1; ++x) {
+                    const float px = x + 0.5f;
+                    const float e0 = t.edgeA[0] * px + row0;
+                    const float e1 = t.edgeA[1] * px + row1;
+                    const float e2 = t.edgeA[2] * px + row2;
+                    const float depth = t.depthA * px + rowDepth;
+
+                    const bool covered = (e0 >= 0.0f) & (e1 >= 0.0f) & (e2 >= 0.0f);
+                    const float current = pixels[x];
+                    pixels[x] = covered && depth > current ? depth : current;
+                }
+            }
+        }
+    }
+
+    // dst(x, y) = min of the 2x2 source texels, for a rectangle of dst texels
+    static void Downsample(const float* source, uint32_t sourceWidth, float* target,
+                           uint32_t targetWidth, uint32_t x0, uint32_t y0,
+                           uint32_t width, uint32_t height) {
+        for (uint32_t y = y0; y < y0 + height; ++y) {
+            const float* top = source + (2 * y) * sourceWidth;
+            const float* bottom = top + sourceWidth;
+            float* out = target + y * targetWidth;
+
+            for (uint32_t x = x0; x < x0 + width; ++x) {
+                out[x] = std::min(std::min(top[2 * x], top[2 * x + 1]),
+                                  std::min(bottom[2 * x], bottom[2 * x + 1]));
+            }
+        }
+    }
+
+    void OcclusionBuffer::BuildTileHiZ(uint32_t tile) {
+        const uint32_t tileX = tile % m_tilesX;
+        const uint32_t tileY = tile / m_tilesX;
+
+        for (uint32_t level = 1; level <= m_tileLevels && level < m_levelOffsets.size(); ++level) {
+            const uint32_t width = TILE_WIDTH >> level;
+            const uint32_t height = TILE_HEIGHT >> level;
+            Downsample(Level(level - 1), m_width >> (level - 1), Level(level), m_width >> level,
+                       tileX * width, tileY * height, width, height);
+        }
+    }
+
+    void OcclusionBuffer::BuildCoarseHiZ() {
+        for (uint32_t level = m_tileLevels + 1; level < m_levelOffsets.size(); ++level) {
+            Downsample(Level(level - 1), m_width >> (level - 1), Level(level), m_width >> level,
+                       0, 0, m_width >> level, m_height >> level);
+        }
+    }
+
+    // --- Queries ---
+
+    bool OcclusionBuffer::IsVisible(const Physics::AABB& worldBounds) const {
+        const Math::Matrix4& m = m_viewProjection;
+        const Math::Vector3D& lo = worldBounds.min;
+        const Math::Vector3D& hi = worldBounds.max;
+
+        float minX = static_cast<float>(m_width), maxX = 0.0f;
+        float minY = static_cast<float>(m_height), maxY = 0.0f;
+        float nearest = 0.0f;
+
+        for (int i = 0; i < 8; ++i) {
+            const float x = (i & 1) ? hi.GetX() : lo.GetX();
+            const float y = (i & 2) ? hi.GetY() : lo.GetY();
+            const float z = (i & 4) ? hi.GetZ() : lo.GetZ();
+
+            const float clipZ = x * m(0, 2) + y * m(1, 2) + z * m(2, 2) + m(3, 2);
+            const float clipW = x * m(0, 3) + y * m(1, 3) + z * m(2, 3) + m(3, 3);
+            // Crosses the near plane: too close to judge
+            if (clipZ < 0.0f || clipW <= 0.0f) return true;
+
+            const float invW = 1.0f / clipW;
+            const float clipX = x * m(0, 0) + y * m(1, 0) + z * m(2, 0) + m(3, 0);
+            const float clipY = x * m(0, 1) + y * m(1, 1) + z * m(2, 1) + m(3, 1);
+            const float sx = (clipX * invW * 0.5f + 0.5f) * m_width;
+            const float sy = (0.5f - clipY * invW * 0.5f) * m_height;
+
+            minX = std::min(minX, sx);
+            maxX = std::max(maxX, sx);
+            minY = std::min(minY, sy);
+            maxY = std::max(maxY, sy);
+            nearest = std::max(nearest, invW);
+        }
+
+        const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+        const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+        const int x1 = std::min(static_cast<int>(m_width) - 1, static_cast<int>(std::floor(maxX)));
+        const int y1 = std::min(static_cast<int>(m_height) - 1, static_cast<int>(std::floor(maxY)));
+        // Off screen: left to the frustum test
+        if (x0 > x1 || y0 > y1) return true;
+
+        // Coarsest level is picked where the box still spans only a few texels
+        const uint32_t span = static_cast<uint32_t>(std::max(x1 - x0, y1 - y0)) + 1;
+        uint32_t level = 0;
+        while ((span >> level) > TEST_FOOTPRINT && level + 1 < m_levelOffsets.size())
+            ++level;
+
+        const float* texels = Level(level);
+        const uint32_t levelWidth = m_width >> level;
+        for (uint32_t y = y0 >> level; y <= (static_cast<uint32_t>(y1) >> level); ++y) {
+            for (uint32_t x = x0 >> level; x <= (static_cast<uint32_t>(x1) >> level); ++x) {
+                // Farthest occluder in the texel is not in front of the box
+                if (texels[y * levelWidth + x] <= nearest) return true;
+            }
+        }
+        return false;
+    }
+
+}
@@ -19,6 +19,9 @@ OpenGLBuffer::OpenGLBuffer(uint32_t size, BufferType type) {
         case BufferType::Constant:
             m_target = GL_UNIFORM_BUFFER;
             break;
+        case BufferType::ShaderResource:
+            m_target = GL_SHADER_STORAGE_BUFFER;
+            break;
         default:
             m_target = GL_ARRAY_BUFFER;
             break;
@@ -35,8 +38,9 @@ bool OpenGLBuffer::Initialize(void* data) {
     glGenBuffers(1, &m_buffer);
     glBindBuffer(m_target, m_buffer);
 
-    GLenum usage = (Type == BufferType::Constant) ? GL_DYNAMIC_DRAW
-                                                   : GL_STATIC_DRAW;
+    GLenum usage = (Type == BufferType::Constant || Type == BufferType::ShaderResource)
+                       ? GL_DYNAMIC_DRAW
+                       : GL_STATIC_DRAW;
     glBufferData(m_target, Size, data, usage);
     glBindBuffer(m_target, 0);
 
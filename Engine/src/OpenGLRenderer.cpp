@@ -178,9 +178,20 @@ void OpenGLRenderer::Draw(uint32_t vertexCount) {
     DrawnTriangles += vertexCount / 3;
 }
 
-void OpenGLRenderer::DrawIndexed(uint32_t indexCount) {
+static GLenum ToGLIndexType(IndexFormat format) {
+    return format == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+// Byte offset of an index in the bound element buffer
+static const void* IndexOffset(uint32_t startIndex, IndexFormat format) {
+    return reinterpret_cast<const void*>(static_cast<uintptr_t>(startIndex) * GetIndexSize(format));
+}
+
+void OpenGLRenderer::DrawIndexed(uint32_t indexCount, uint32_t startIndex,
+                                 int32_t baseVertex) {
     GLenum mode = m_debugLineMode ? GL_LINES : GL_TRIANGLES;
-    glDrawElements(mode, indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElementsBaseVertex(mode, indexCount, ToGLIndexType(m_indexFormat),
+                             IndexOffset(startIndex, m_indexFormat), baseVertex);
     DrawnVertices += indexCount;
     DrawnTriangles += indexCount / 3;
 }
@@ -195,14 +206,55 @@ void OpenGLRenderer::DrawInstance(uint32_t instanceCount,
 }
 
 void OpenGLRenderer::DrawIndexedInstance(uint32_t instanceCount,
-                                          uint32_t indexPerInstance) {
+                                          uint32_t indexPerInstance,
+                                          uint32_t startIndex,
+                                          int32_t baseVertex) {
     GLenum mode = m_debugLineMode ? GL_LINES : GL_TRIANGLES;
-    glDrawElementsInstanced(mode, indexPerInstance,
-                            GL_UNSIGNED_INT, 0, instanceCount);
+    glDrawElementsInstancedBaseVertex(mode, indexPerInstance, ToGLIndexType(m_indexFormat),
+                                      IndexOffset(startIndex, m_indexFormat), instanceCount,
+                                      baseVertex);
     DrawnVertices += indexPerInstance * instanceCount;
     DrawnTriangles += (indexPerInstance / 3) * instanceCount;
 }
 
+// Generic attribute the GL shaders read as inCompactVertex
+static constexpr GLuint COMPACT_VERTEX_LOCATION = 7;
+
+// Instance matrices, read by shaders that declare uInstanced
+static constexpr GLuint INSTANCE_BUFFER_BINDING = 4;
+
+bool OpenGLRenderer::BeginInstancedDraw(RefPtr<BufferBase> instances,
+                                        uint32_t firstInstance) {
+    auto* glBuf = dynamic_cast<OpenGLBuffer*>(instances.get());
+    if (!glBuf) return false;
+
+    GLint program = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    if (program == 0) return false;
+
+    GLint instanced = glGetUniformLocation(program, "uInstanced");
+    GLint base = glGetUniformLocation(program, "uInstanceBase");
+    if (instanced < 0 || base < 0) return false;
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, INSTANCE_BUFFER_BINDING,
+                     glBuf->GetGLBuffer());
+    glUniform1i(instanced, 1);
+    glUniform1ui(base, firstInstance);
+
+    m_instancedProgram = program;
+    m_instancedLocation = instanced;
+    return true;
+}
+
+void OpenGLRenderer::EndInstancedDraw() {
+    if (m_instancedProgram == 0) return;
+
+    // Uniforms belong to the program: later draws with it are not instanced
+    glUniform1i(m_instancedLocation, 0);
+    m_instancedProgram = 0;
+    m_instancedLocation = -1;
+}
+
 void OpenGLRenderer::BeginDebugLinePass() {
     m_debugLineMode = true;
 }
@@ -288,40 +340,49 @@ void OpenGLRenderer::BindVertexBuffer(RefPtr<BufferBase> buffer,
 
     glBindBuffer(GL_ARRAY_BUFFER, glBuf->GetGLBuffer());
 
-    // Position: 3 floats at offset 0
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, px));
-
-    // Normal: 3 floats at offset 12
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, nx));
-
-    // Tangent: 4 floats at offset 24
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, tx));
-
-    // Color: 4 floats at offset 40
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, r));
-
-    // UV: 2 floats at offset 56
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, u));
+    const VertexLayout layout = glBuf->GetVertexLayout();
+    const VertexLayoutDesc& desc = VertexFormat::GetLayoutDesc(layout);
+
+    bool present[VERTEX_BONE_WEIGHTS + 1] = {};
+    for (uint32_t i = 0; i < desc.attributeCount; ++i) {
+        const VertexAttribute& attribute = desc.attributes[i];
+        const GLint components = static_cast<GLint>(VertexFormat::GetComponentCount(attribute.format));
+        const void* offset = reinterpret_cast<const void*>(static_cast<uintptr_t>(attribute.offset));
+        present[attribute.location] = true;
+
+        glEnableVertexAttribArray(attribute.location);
+        switch (attribute.format) {
+            // Integer attributes must use IPointer
+            case VertexAttributeFormat::Int4:
+                glVertexAttribIPointer(attribute.location, components, GL_INT, desc.stride, offset);
+                break;
+            case VertexAttributeFormat::Uint8x4:
+                glVertexAttribIPointer(attribute.location, components, GL_UNSIGNED_BYTE, desc.stride, offset);
+                break;
+            case VertexAttributeFormat::Half2:
+            case VertexAttributeFormat::Half4:
+                glVertexAttribPointer(attribute.location, components, GL_HALF_FLOAT, GL_FALSE, desc.stride, offset);
+                break;
+            case VertexAttributeFormat::Snorm16x2:
+                glVertexAttribPointer(attribute.location, components, GL_SHORT, GL_TRUE, desc.stride, offset);
+                break;
+            case VertexAttributeFormat::Unorm8x4:
+                glVertexAttribPointer(attribute.location, components, GL_UNSIGNED_BYTE, GL_TRUE, desc.stride, offset);
+                break;
+            default:
+                glVertexAttribPointer(attribute.location, components, GL_FLOAT, GL_FALSE, desc.stride, offset);
+                break;
+        }
+    }
 
-    // BoneIDs: 4 ints (must use IPointer for integer attributes)
-    glEnableVertexAttribArray(5);
-    glVertexAttribIPointer(5, 4, GL_INT, sizeof(Vertex),
-                           (void*)offsetof(Vertex, boneIDs));
+    for (GLuint location = 0; location <= VERTEX_BONE_WEIGHTS; ++location) {
+        if (!present[location])
+            glDisableVertexAttribArray(location);
+    }
 
-    // BoneWeights: 4 floats
-    glEnableVertexAttribArray(6);
-    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex),
-                          (void*)offsetof(Vertex, boneWeights));
+    // Constant attribute telling the shaders the normal is octahedral packed;
+    // unlike a uniform it holds whichever program the draw ends up using
+    glVertexAttrib1f(COMPACT_VERTEX_LOCATION, layout == VertexLayout::Standard ? 0.0f : 1.0f);
 }
 
 void OpenGLRenderer::BindIndexBuffer(RefPtr<BufferBase> buffer,
@@ -330,6 +391,7 @@ void OpenGLRenderer::BindIndexBuffer(RefPtr<BufferBase> buffer,
     if (!glBuf) return;
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glBuf->GetGLBuffer());
+    m_indexFormat = glBuf->GetIndexFormat();
 }
 
 void OpenGLRenderer::BindConstantBuffer(RefPtr<BufferBase> buffer,
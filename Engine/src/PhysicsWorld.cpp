@@ -13,35 +13,97 @@ namespace Physics {
 void PhysicsWorld::RegisterCollider(ColliderComponent* collider) {
     if (!collider) return;
 
-    // Check not already registered
-    for (auto* c : m_colliders) {
-        if (c == collider) return;
+    // Registered colliders always own a broadphase proxy
+    if (collider->GetProxyId() >= 0) return;
+
+    auto* owner = collider->GetOwner();
+    Handle<ColliderComponent> handle =
+        owner ? owner->GetComponentHandle<ColliderComponent>() : Handle<ColliderComponent>();
+    if (!handle || ComponentStorage::Get().Resolve(handle) != collider) {
+        SLEAK_WARN("PhysicsWorld: collider is not attached to a game object, not registered");
+        return;
     }
 
     AABB worldAABB = collider->GetWorldAABB();
     int proxyId = m_tree.Insert(worldAABB, collider);
     collider->SetProxyId(proxyId);
-    m_colliders.push_back(collider);
+
+    if (static_cast<size_t>(proxyId) >= m_proxyHandles.size())
+        m_proxyHandles.resize(proxyId + 1);
+    m_proxyHandles[proxyId] = handle;
+    m_colliders.push_back({collider, handle, proxyId});
 }
 
 void PhysicsWorld::UnregisterCollider(ColliderComponent* collider) {
     if (!collider) return;
+    PruneStaleColliders();
 
     int proxyId = collider->GetProxyId();
     if (proxyId >= 0) {
         m_tree.Remove(proxyId);
+        m_proxyHandles[proxyId] = {};
         collider->SetProxyId(-1);
     }
 
     m_colliders.erase(
-        std::remove(m_colliders.begin(), m_colliders.end(), collider),
+        std::remove_if(m_colliders.begin(), m_colliders.end(),
+                       [&](const ColliderEntry& entry) { return entry.collider == collider; }),
+        m_colliders.end());
+}
+
+void PhysicsWorld::UnregisterColliders(const std::vector<ColliderComponent*>& colliders) {
+    if (colliders.empty()) return;
+    PruneStaleColliders();
+
+    // Proxy id -2 marks "remove in the sweep below"
+    for (auto* collider : colliders) {
+        if (!collider || collider->GetProxyId() < 0) continue;
+        m_tree.Remove(collider->GetProxyId());
+        m_proxyHandles[collider->GetProxyId()] = {};
+        collider->SetProxyId(-2);
+    }
+
+    m_colliders.erase(
+        std::remove_if(m_colliders.begin(), m_colliders.end(),
+                       [](const ColliderEntry& entry) {
+                           return entry.collider->GetProxyId() == -2;
+                       }),
+        m_colliders.end());
+
+    for (auto* collider : colliders) {
+        if (collider && collider->GetProxyId() == -2)
+            collider->SetProxyId(-1);
+    }
+}
+
+void PhysicsWorld::PruneStaleColliders() {
+    auto& storage = ComponentStorage::Get();
+
+    // Destroyed without UnregisterCollider: only the entry is left to clean
+    m_colliders.erase(
+        std::remove_if(m_colliders.begin(), m_colliders.end(),
+                       [&](const ColliderEntry& entry) {
+                           if (storage.Resolve(entry.handle) == entry.collider) return false;
+                           m_tree.Remove(entry.proxyId);
+                           m_proxyHandles[entry.proxyId] = {};
+                           return true;
+                       }),
         m_colliders.end());
 }
 
+ColliderComponent* PhysicsWorld::ResolveProxy(int proxyId) const {
+    if (proxyId < 0 || static_cast<size_t>(proxyId) >= m_proxyHandles.size()) return nullptr;
+    return ComponentStorage::Get().Resolve(m_proxyHandles[proxyId]);
+}
+
 void PhysicsWorld::Step(float dt) {
+    // Every collider used below is alive after this
+    PruneStaleColliders();
+
     // Phase 1: Save grounded state, then clear collision flags
     // We need wasGrounded BEFORE clearing, so gravity doesn't apply while standing
-    for (auto* collider : m_colliders) {
+    for (auto& entry : m_colliders) {
+        ColliderComponent* collider = entry.collider;
         if (auto* owner = collider->GetOwner()) {
             auto* rb = owner->GetComponent<RigidbodyComponent>();
             if (!rb) continue;
@@ -99,7 +161,8 @@ void PhysicsWorld::Step(float dt) {
 }
 
 void PhysicsWorld::UpdateBroadphase() {
-    for (auto* collider : m_colliders) {
+    for (auto& entry : m_colliders) {
+        ColliderComponent* collider = entry.collider;
         int proxyId = collider->GetProxyId();
         if (proxyId < 0) continue;
 
@@ -110,14 +173,14 @@ void PhysicsWorld::UpdateBroadphase() {
 
 void PhysicsWorld::FindPairsAndResolve() {
     for (size_t i = 0; i < m_colliders.size(); ++i) {
-        ColliderComponent* colliderA = m_colliders[i];
+        ColliderComponent* colliderA = m_colliders[i].collider;
         if (colliderA->GetProxyId() < 0) continue;
 
         AABB worldA = colliderA->GetWorldAABB();
 
         m_tree.Query(worldA, [&](int proxyId) -> bool {
-            auto* colliderB = static_cast<ColliderComponent*>(m_tree.GetUserData(proxyId));
-            if (colliderB == colliderA) return true;
+            auto* colliderB = ResolveProxy(proxyId);
+            if (!colliderB || colliderB == colliderA) return true;
 
             // Skip duplicate pairs: only process when A < B (pointer order)
             if (colliderA > colliderB) return true;
@@ -185,8 +248,8 @@ std::vector<CollisionPair> PhysicsWorld::OverlapSphere(const Vector3D& center, f
     AABB queryAABB = sphere.ToAABB();
 
     m_tree.Query(queryAABB, [&](int proxyId) -> bool {
-        auto* collider = static_cast<ColliderComponent*>(m_tree.GetUserData(proxyId));
-        if ((collider->GetLayer() & layerMask) == 0) return true;
+        auto* collider = ResolveProxy(proxyId);
+        if (!collider || (collider->GetLayer() & layerMask) == 0) return true;
 
         CollisionPair pair;
         pair.b = collider;
@@ -201,8 +264,8 @@ std::vector<CollisionPair> PhysicsWorld::OverlapAABB(const AABB& aabb, uint32_t
     std::vector<CollisionPair> results;
 
     m_tree.Query(aabb, [&](int proxyId) -> bool {
-        auto* collider = static_cast<ColliderComponent*>(m_tree.GetUserData(proxyId));
-        if ((collider->GetLayer() & layerMask) == 0) return true;
+        auto* collider = ResolveProxy(proxyId);
+        if (!collider || (collider->GetLayer() & layerMask) == 0) return true;
 
         CollisionPair pair;
         pair.b = collider;
@@ -231,8 +294,8 @@ SweepResult PhysicsWorld::SphereSweep(const Vector3D& start, const Vector3D& dir
     float closestDist = maxDist;
 
     m_tree.Query(sweepAABB, [&](int proxyId) -> bool {
-        auto* collider = static_cast<ColliderComponent*>(m_tree.GetUserData(proxyId));
-        if ((collider->GetLayer() & layerMask) == 0) return true;
+        auto* collider = ResolveProxy(proxyId);
+        if (!collider || (collider->GetLayer() & layerMask) == 0) return true;
 
         // Step along the sweep direction testing sphere collisions
         AABB targetAABB = collider->GetWorldAABB();
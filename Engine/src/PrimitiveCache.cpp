@@ -0,0 +1,151 @@
+#include <Runtime/PrimitiveCache.hpp>
+#include <Runtime/InternalGeometry.hpp>
+#include <Runtime/Material.hpp>
+#include <Graphics/BufferBase.hpp>
+#include <Graphics/ResourceManager.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Sleak {
+
+    enum class PrimitiveType : uint8_t {
+        Plane,
+        Cube,
+        Sphere,
+        Capsule,
+        Cylinder
+    };
+
+    // Generation parameters; unused fields stay zero
+    struct PrimitiveKey {
+        PrimitiveType type;
+        int32_t i0 = 0;
+        int32_t i1 = 0;
+        float f0 = 0.0f;
+        float f1 = 0.0f;
+
+        bool operator==(const PrimitiveKey& other) const {
+            return type == other.type && i0 == other.i0 && i1 == other.i1 &&
+                   f0 == other.f0 && f1 == other.f1;
+        }
+    };
+
+    struct PrimitiveKeyHash {
+        size_t operator()(const PrimitiveKey& key) const {
+            size_t hash = std::hash<uint8_t>{}(static_cast<uint8_t>(key.type));
+            auto combine = [&hash](size_t value) {
+                hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            };
+            combine(std::hash<int32_t>{}(key.i0));
+            combine(std::hash<int32_t>{}(key.i1));
+            combine(std::hash<float>{}(key.f0));
+            combine(std::hash<float>{}(key.f1));
+            return hash;
+        }
+    };
+
+    struct PrimitiveEntry {
+        MeshData data;
+        PrimitiveMesh mesh;
+    };
+
+    struct PrimitiveCacheState {
+        std::mutex lock;
+        std::unordered_map<PrimitiveKey, std::unique_ptr<PrimitiveEntry>, PrimitiveKeyHash> meshes;
+        RefPtr<Material> defaultMaterial;
+    };
+
+    static PrimitiveCacheState& GetState() {
+        static PrimitiveCacheState state;
+        return state;
+    }
+
+    template <typename Generate>
+    static const PrimitiveMesh& GetOrCreate(const PrimitiveKey& key, Generate&& generate) {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+
+        auto it = state.meshes.find(key);
+        if (it != state.meshes.end()) return it->second->mesh;
+
+        auto entry = std::make_unique<PrimitiveEntry>();
+        entry->data = generate();
+
+        PrimitiveMesh& mesh = entry->mesh;
+        mesh.vertexBuffer = RefPtr<RenderEngine::BufferBase>(
+            RenderEngine::ResourceManager::CreateBuffer(
+                RenderEngine::BufferType::Vertex,
+                entry->data.vertices.GetSizeInBytes(),
+                entry->data.vertices.GetRawData()));
+        mesh.indexBuffer = RefPtr<RenderEngine::BufferBase>(
+            RenderEngine::ResourceManager::CreateBuffer(
+                RenderEngine::BufferType::Index,
+                entry->data.indices.GetByteSize(),
+                entry->data.indices.GetRawData(),
+                entry->data.indices.GetFormat()));
+        mesh.vertexCount = static_cast<uint32_t>(entry->data.vertices.GetSize());
+        mesh.indexCount = static_cast<uint32_t>(entry->data.indices.GetSize());
+        mesh.meshData = &entry->data;
+        if (mesh.vertexCount > 0) {
+            mesh.bounds = Physics::AABB::FromVertices(&entry->data.vertices.GetData()[0].px,
+                                                      mesh.vertexCount, sizeof(Vertex));
+        }
+
+        return state.meshes.emplace(key, std::move(entry)).first->second->mesh;
+    }
+
+    const PrimitiveMesh& PrimitiveCache::GetPlane(int width, int height) {
+        return GetOrCreate({PrimitiveType::Plane, width, height},
+                           [&]() { return GetPlaneMesh(width, height); });
+    }
+
+    const PrimitiveMesh& PrimitiveCache::GetCube() {
+        return GetOrCreate({PrimitiveType::Cube}, []() { return GetCubeMesh(); });
+    }
+
+    const PrimitiveMesh& PrimitiveCache::GetSphere(int stacks, int slices) {
+        return GetOrCreate({PrimitiveType::Sphere, stacks, slices},
+                           [&]() { return GetSphereMesh(stacks, slices); });
+    }
+
+    const PrimitiveMesh& PrimitiveCache::GetCapsule(int segments, int rings,
+                                                    float height, float radius) {
+        return GetOrCreate({PrimitiveType::Capsule, segments, rings, height, radius},
+                           [&]() { return GetCapsuleMesh(segments, rings, height, radius); });
+    }
+
+    const PrimitiveMesh& PrimitiveCache::GetCylinder(int segments, float height, float radius) {
+        return GetOrCreate({PrimitiveType::Cylinder, segments, 0, height, radius},
+                           [&]() { return GetCylinderMesh(segments, height, radius); });
+    }
+
+    RefPtr<Material> PrimitiveCache::GetDefaultMaterial() {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+
+        if (!state.defaultMaterial) {
+            auto* material = new Material();
+            material->SetShader("assets/shaders/default_shader.hlsl");
+            state.defaultMaterial = RefPtr<Material>(material);
+        }
+        return state.defaultMaterial;
+    }
+
+    void PrimitiveCache::Clear() {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+
+        // Objects still using an entry keep its buffers alive through RefPtr
+        state.meshes.clear();
+        state.defaultMaterial = nullptr;
+    }
+
+    size_t PrimitiveCache::GetMeshCount() {
+        auto& state = GetState();
+        std::lock_guard<std::mutex> guard(state.lock);
+        return state.meshes.size();
+    }
+
+}
@@ -0,0 +1,461 @@
+#include "../../include/private/Graphics/RenderCapture.hpp"
+#include "../../include/private/Graphics/RenderCommandQueue.hpp"
+#include "../../include/private/Graphics/ResourceManager.hpp"
+#include <Runtime/Material.hpp>
+#include <Logger.hpp>
+#include <cstring>
+
+namespace Sleak {
+    namespace RenderEngine {
+        using namespace RenderCaptureFormat;
+
+        //----------------------------------------------------------------------
+        // Writer
+        //----------------------------------------------------------------------
+
+        RenderCaptureWriter::~RenderCaptureWriter() {
+            Close();
+        }
+
+        bool RenderCaptureWriter::Open(const std::string& path) {
+            Close();
+
+            m_file.open(path, std::ios::binary | std::ios::trunc);
+            if (!m_file.is_open()) {
+                SLEAK_ERROR("RenderCapture: cannot open {} for writing", path);
+                return false;
+            }
+
+            m_record.clear();
+            Put(MAGIC);
+            Put(VERSION);
+            Put(uint16_t(0));
+            m_file.write(reinterpret_cast<const char*>(m_record.data()), m_record.size());
+            m_record.clear();
+
+            m_buffers.clear();
+            m_materials.clear();
+            m_nextID = 1;
+            m_framesWritten = 0;
+            return true;
+        }
+
+        void RenderCaptureWriter::Close() {
+            if (m_file.is_open())
+                m_file.close();
+        }
+
+        uint32_t RenderCaptureWriter::BufferID(BufferBase* buffer) {
+            if (!buffer) return 0;
+
+            // A new buffer may reuse a freed one's address
+            auto it = m_buffers.find(buffer);
+            if (it != m_buffers.end() && it->second.type == buffer->GetType() &&
+                it->second.size == buffer->GetSize() && it->second.layout == buffer->GetVertexLayout() &&
+                it->second.format == buffer->GetIndexFormat())
+                return it->second.id;
+
+            BufferEntry entry{m_nextID++, buffer->GetType(), buffer->GetSize(),
+                              buffer->GetVertexLayout(), buffer->GetIndexFormat()};
+            m_buffers[buffer] = entry;
+
+            std::swap(m_record, m_defines);
+            Put(TAG_BUFFER);
+            Put(entry.id);
+            Put(static_cast<uint8_t>(entry.type));
+            Put(static_cast<uint32_t>(entry.size));
+            Put(static_cast<uint8_t>(entry.layout));
+            Put(static_cast<uint8_t>(entry.format));
+            std::swap(m_record, m_defines);
+            return entry.id;
+        }
+
+        uint32_t RenderCaptureWriter::MaterialID(::Sleak::Material* material) {
+            if (!material) return 0;
+
+            auto it = m_materials.find(material);
+            if (it != m_materials.end())
+                return it->second;
+
+            uint32_t id = m_nextID++;
+            m_materials[material] = id;
+
+            std::swap(m_record, m_defines);
+            Put(TAG_MATERIAL);
+            Put(id);
+            Put(static_cast<uint8_t>(material->GetRenderMode()));
+            Put(static_cast<uint8_t>(material->IsInstancingEnabled()));
+            std::swap(m_record, m_defines);
+            return id;
+        }
+
+        void RenderCaptureWriter::WriteFrame(uint64_t frame, const Queue<RenderCommandBase*>& commands) {
+            if (!m_file.is_open()) return;
+
+            m_record.clear();
+            m_defines.clear();
+            for (size_t i = 0; i < commands.size(); ++i)
+                WriteCommand(commands[i]);
+
+            // Definitions first: the commands refer to them
+            std::vector<uint8_t> header;
+            std::swap(m_record, header);
+            Put(TAG_FRAME);
+            Put(frame);
+            Put(static_cast<uint32_t>(commands.size()));
+            std::swap(m_record, header);
+
+            m_file.write(reinterpret_cast<const char*>(m_defines.data()), m_defines.size());
+            m_file.write(reinterpret_cast<const char*>(header.data()), header.size());
+            m_file.write(reinterpret_cast<const char*>(m_record.data()), m_record.size());
+            m_framesWritten++;
+        }
+
+        void RenderCaptureWriter::WriteBuffers(const BufferSpan& buffers) {
+            Put(buffers.GetSize());
+            for (const auto& buffer : buffers)
+                Put(BufferID(buffer.get()));
+        }
+
+        void RenderCaptureWriter::WriteDraw(RenderCommandBase* command, const Math::Matrix4* world) {
+            uint8_t flags = 0;
+            if (command->HasSortKey()) flags |= DRAW_SORT_KEY;
+            if (world) flags |= DRAW_WORLD;
+
+            Put(flags);
+            if (command->HasSortKey()) Put(command->GetSortKey());
+            if (world) Put(*world);
+        }
+
+        void RenderCaptureWriter::WriteCommand(RenderCommandBase* command) {
+            const CommandType type = command->GetType();
+            Put(static_cast<uint8_t>(type));
+
+            switch (type) {
+                case CommandType::Draw: {
+                    auto* draw = static_cast<DrawCommand*>(command);
+                    Put(BufferID(draw->GetVertexBuffer().get()));
+                    WriteBuffers(draw->GetConstantBuffers());
+                    Put(draw->GetVertexCount());
+                    Put(draw->GetStartVertexLocation());
+                    WriteDraw(command, nullptr);
+                    break;
+                }
+                case CommandType::DrawIndexed: {
+                    auto* draw = static_cast<DrawIndexedCommand*>(command);
+                    Put(BufferID(draw->GetVertexBuffer().get()));
+                    Put(BufferID(draw->GetIndexBuffer().get()));
+                    WriteBuffers(draw->GetConstantBuffers());
+                    Put(draw->GetIndexCount());
+                    Put(draw->GetStartIndexLocation());
+                    Put(draw->GetBaseVertexLocation());
+                    WriteDraw(command, draw->HasWorldMatrix() ? &draw->GetWorldMatrix() : nullptr);
+                    break;
+                }
+                case CommandType::UpdateConstantBuffer: {
+                    auto* update = static_cast<UpdateConstantBufferCommand*>(command);
+                    Put(BufferID(update->GetBuffer()));
+                    Put(update->GetSize());
+                    const auto* data = static_cast<const uint8_t*>(update->GetData());
+                    m_record.insert(m_record.end(), data, data + update->GetSize());
+                    break;
+                }
+                case CommandType::BindConstantBuffer: {
+                    auto* bind = static_cast<BindConstantBufferCommand*>(command);
+                    Put(BufferID(bind->GetBuffer().get()));
+                    Put(static_cast<uint8_t>(bind->GetSlot()));
+                    break;
+                }
+                case CommandType::BindMaterial:
+                    Put(MaterialID(static_cast<BindMaterialCommand*>(command)->GetMaterial()));
+                    break;
+                case CommandType::SetMode:
+                    Put(static_cast<uint8_t>(static_cast<SetRenderModeCommand*>(command)->GetMode()));
+                    break;
+                case CommandType::SetFace:
+                    Put(static_cast<uint8_t>(static_cast<SetRenderFaceCommand*>(command)->GetFace()));
+                    break;
+                default:
+                    // Custom commands and the rest are never replayed
+                    break;
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // Player
+        //----------------------------------------------------------------------
+
+        namespace {
+            // Bounds-checked reads over the loaded file
+            struct Reader {
+                const std::vector<uint8_t>& data;
+                size_t offset = 0;
+                bool failed = false;
+
+                template <typename T>
+                T Get() {
+                    T value{};
+                    if (offset + sizeof(T) > data.size()) {
+                        failed = true;
+                        return value;
+                    }
+                    std::memcpy(&value, data.data() + offset, sizeof(T));
+                    offset += sizeof(T);
+                    return value;
+                }
+
+                const uint8_t* Bytes(size_t size) {
+                    if (offset + size > data.size()) {
+                        failed = true;
+                        return nullptr;
+                    }
+                    const uint8_t* bytes = data.data() + offset;
+                    offset += size;
+                    return bytes;
+                }
+
+                bool AtEnd() const { return offset >= data.size(); }
+            };
+        }
+
+        RenderCapturePlayer::~RenderCapturePlayer() {
+            ReleaseResources();
+        }
+
+        bool RenderCapturePlayer::Load(const std::string& path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file.is_open()) {
+                SLEAK_ERROR("RenderCapture: cannot open {}", path);
+                return false;
+            }
+
+            std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(data.data()), data.size());
+
+            ReleaseResources();
+            m_frames.clear();
+            m_commands.clear();
+            m_bufferIDs.clear();
+            m_payload.clear();
+            m_bufferDefines.clear();
+            m_materialDefines.clear();
+            m_skipped = 0;
+
+            Reader reader{data};
+            if (reader.Get<uint32_t>() != MAGIC || reader.Get<uint16_t>() != VERSION) {
+                SLEAK_ERROR("RenderCapture: {} is not a version {} capture", path, VERSION);
+                return false;
+            }
+            reader.Get<uint16_t>();
+
+            uint32_t remaining = 0;     // Commands left in the current frame
+            while (!reader.AtEnd() && !reader.failed) {
+                const uint8_t tag = reader.Get<uint8_t>();
+
+                if (tag == TAG_FRAME) {
+                    Frame frame;
+                    frame.frame = reader.Get<uint64_t>();
+                    frame.count = reader.Get<uint32_t>();
+                    frame.first = static_cast<uint32_t>(m_commands.size());
+                    m_frames.push_back(frame);
+                    remaining = frame.count;
+                    continue;
+                }
+                if (tag == TAG_BUFFER) {
+                    BufferDefine define;
+                    define.id = reader.Get<uint32_t>();
+                    define.type = static_cast<BufferType>(reader.Get<uint8_t>());
+                    define.size = reader.Get<uint32_t>();
+                    define.layout = static_cast<VertexLayout>(reader.Get<uint8_t>());
+                    define.format = static_cast<IndexFormat>(reader.Get<uint8_t>());
+                    m_bufferDefines.push_back(define);
+                    continue;
+                }
+                if (tag == TAG_MATERIAL) {
+                    MaterialDefine define;
+                    define.id = reader.Get<uint32_t>();
+                    define.renderMode = reader.Get<uint8_t>();
+                    define.instancing = reader.Get<uint8_t>() != 0;
+                    m_materialDefines.push_back(define);
+                    continue;
+                }
+
+                if (remaining == 0) {
+                    reader.failed = true;
+                    break;
+                }
+                remaining--;
+
+                Command command;
+                command.type = static_cast<CommandType>(tag);
+
+                auto readBuffers = [&]() {
+                    command.firstBuffer = static_cast<uint32_t>(m_bufferIDs.size());
+                    command.bufferCount = reader.Get<uint32_t>();
+                    for (uint32_t i = 0; i < command.bufferCount && !reader.failed; ++i)
+                        m_bufferIDs.push_back(reader.Get<uint32_t>());
+                };
+                auto readDraw = [&]() {
+                    command.flags = reader.Get<uint8_t>();
+                    if (command.flags & DRAW_SORT_KEY) command.sortKey = reader.Get<uint64_t>();
+                    if (command.flags & DRAW_WORLD) command.world = reader.Get<Math::Matrix4>();
+                };
+
+                switch (command.type) {
+                    case CommandType::Draw:
+                        command.buffer = reader.Get<uint32_t>();
+                        readBuffers();
+                        command.count = reader.Get<uint32_t>();
+                        command.start = reader.Get<uint32_t>();
+                        readDraw();
+                        break;
+                    case CommandType::DrawIndexed:
+                        command.buffer = reader.Get<uint32_t>();
+                        command.indexBuffer = reader.Get<uint32_t>();
+                        readBuffers();
+                        command.count = reader.Get<uint32_t>();
+                        command.start = reader.Get<uint32_t>();
+                        command.baseVertex = reader.Get<int32_t>();
+                        readDraw();
+                        break;
+                    case CommandType::UpdateConstantBuffer: {
+                        command.buffer = reader.Get<uint32_t>();
+                        command.payloadSize = reader.Get<uint16_t>();
+                        command.payload = static_cast<uint32_t>(m_payload.size());
+                        const uint8_t* bytes = reader.Bytes(command.payloadSize);
+                        if (bytes) m_payload.insert(m_payload.end(), bytes, bytes + command.payloadSize);
+                        break;
+                    }
+                    case CommandType::BindConstantBuffer:
+                        command.buffer = reader.Get<uint32_t>();
+                        command.value = reader.Get<uint8_t>();
+                        break;
+                    case CommandType::BindMaterial:
+                        command.material = reader.Get<uint32_t>();
+                        break;
+                    case CommandType::SetMode:
+                    case CommandType::SetFace:
+                        command.value = reader.Get<uint8_t>();
+                        break;
+                    default:
+                        m_skipped++;
+                        break;
+                }
+
+                m_commands.push_back(command);
+            }
+
+            if (reader.failed || remaining != 0) {
+                SLEAK_ERROR("RenderCapture: {} is truncated or corrupt", path);
+                m_frames.clear();
+                return false;
+            }
+
+            SLEAK_INFO("RenderCapture: loaded {} frames, {} commands, {} buffers, {} materials from {}",
+                       m_frames.size(), m_commands.size(), m_bufferDefines.size(),
+                       m_materialDefines.size(), path);
+            return true;
+        }
+
+        bool RenderCapturePlayer::CreateResources() {
+            ReleaseResources();
+
+            uint32_t maxID = 0;
+            for (const auto& define : m_bufferDefines) maxID = std::max(maxID, define.id);
+            for (const auto& define : m_materialDefines) maxID = std::max(maxID, define.id);
+            m_buffers.resize(maxID + 1);
+            m_materials.resize(maxID + 1, nullptr);
+
+            std::vector<uint8_t> zeros;
+            for (const auto& define : m_bufferDefines) {
+                zeros.assign(define.size, 0);
+                auto* buffer = ResourceManager::CreateBuffer(define.type, define.size, zeros.data(),
+                                                             define.format);
+                if (!buffer) {
+                    SLEAK_ERROR("RenderCapture: the renderer could not create buffer {}", define.id);
+                    return false;
+                }
+                buffer->SetVertexLayout(define.layout);
+                m_buffers[define.id] = RefPtr<BufferBase>(buffer);
+            }
+
+            for (const auto& define : m_materialDefines) {
+                auto* material = new ::Sleak::Material();
+                material->SetRenderMode(static_cast<MaterialRenderMode>(define.renderMode));
+                material->SetInstancing(define.instancing);
+                m_materials[define.id] = material;
+            }
+            return true;
+        }
+
+        void RenderCapturePlayer::ReleaseResources() {
+            m_constantBuffers = List<RefPtr<BufferBase>>();
+            m_buffers.clear();
+            for (auto* material : m_materials)
+                delete material;
+            m_materials.clear();
+        }
+
+        RefPtr<BufferBase> RenderCapturePlayer::GetBuffer(uint32_t id) const {
+            return id < m_buffers.size() ? m_buffers[id] : RefPtr<BufferBase>();
+        }
+
+        void RenderCapturePlayer::SubmitFrame(uint32_t frame, RenderCommandQueue* queue) {
+            if (frame >= m_frames.size() || !queue) return;
+
+            const Frame& captured = m_frames[frame];
+            for (uint32_t i = captured.first; i < captured.first + captured.count; ++i) {
+                const Command& command = m_commands[i];
+
+                auto collectBuffers = [&]() {
+                    m_constantBuffers.clear();
+                    for (uint32_t b = 0; b < command.bufferCount; ++b)
+                        m_constantBuffers.add(GetBuffer(m_bufferIDs[command.firstBuffer + b]));
+                };
+                auto finishDraw = [&](RenderCommandBase* draw) {
+                    if (command.flags & DRAW_SORT_KEY) draw->SetSortKey(command.sortKey);
+                };
+
+                switch (command.type) {
+                    case CommandType::Draw: {
+                        collectBuffers();
+                        finishDraw(queue->SubmitDraw(GetBuffer(command.buffer), m_constantBuffers,
+                                                     command.count, command.start));
+                        break;
+                    }
+                    case CommandType::DrawIndexed: {
+                        collectBuffers();
+                        auto* draw = queue->SubmitDrawIndexed(GetBuffer(command.buffer), GetBuffer(command.indexBuffer),
+                                                              m_constantBuffers, command.count, command.start,
+                                                              command.baseVertex);
+                        if (command.flags & DRAW_WORLD)
+                            static_cast<DrawIndexedCommand*>(draw)->SetWorldMatrix(command.world);
+                        finishDraw(draw);
+                        break;
+                    }
+                    case CommandType::UpdateConstantBuffer:
+                        queue->SubmitUpdateConstantBuffer(GetBuffer(command.buffer),
+                                                          m_payload.data() + command.payload,
+                                                          command.payloadSize);
+                        break;
+                    case CommandType::BindConstantBuffer:
+                        queue->SubmitBindConstantBuffer(GetBuffer(command.buffer), command.value);
+                        break;
+                    case CommandType::BindMaterial:
+                        queue->SubmitBindMaterial(command.material < m_materials.size()
+                                                      ? m_materials[command.material] : nullptr);
+                        break;
+                    case CommandType::SetMode:
+                        queue->SubmitSetRenderMode(static_cast<RenderMode>(command.value));
+                        break;
+                    case CommandType::SetFace:
+                        queue->SubmitSetRenderFace(static_cast<RenderFace>(command.value));
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+    }
+}
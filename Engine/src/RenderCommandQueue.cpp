@@ -1,77 +1,152 @@
 #include "../../include/private/Graphics/RenderCommandQueue.hpp"
 #include "../../include/private/Graphics/BufferBase.hpp"
 #include "../../include/private/Graphics/RenderContext.hpp"
+#include "../../include/private/Graphics/RenderCapture.hpp"
+#include "../../include/private/Graphics/ResourceManager.hpp"
 #include <Memory/ObjectPtr.h>
+#include <Runtime/Material.hpp>
+#include <Camera/Camera.hpp>
 #include <Logger.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 
 namespace Sleak {
     namespace RenderEngine {
         RenderCommandQueue* RenderCommandQueue::Instance = nullptr; 
 
         
-        void RenderCommandQueue::SubmitDraw( RefPtr<BufferBase> vertexBuffer,
-                                            List<RefPtr<BufferBase>> constantBuffers, 
+        BufferSpan RenderCommandQueue::AllocateBuffers(const List<RefPtr<BufferBase>>& buffers) {
+            BufferSpan span;
+            span.count = static_cast<uint32_t>(buffers.GetSize());
+            if (span.count == 0) return span;
+
+            span.data = m_allocators[m_current].NewArray<RefPtr<BufferBase>>(span.count);
+            for (uint32_t i = 0; i < span.count; ++i)
+                new (&span.data[i]) RefPtr<BufferBase>(buffers[i]);
+            return span;
+        }
+
+        RenderCommandBase* RenderCommandQueue::SubmitDraw( RefPtr<BufferBase> vertexBuffer,
+                                            const List<RefPtr<BufferBase>>& constantBuffers, 
                                             uint32_t vertexCount, 
                                             uint32_t startVertexLocation) {
-            auto command = RefPtr<RenderCommandBase>(new DrawCommand(vertexBuffer,constantBuffers,vertexCount, startVertexLocation));
-            commands.push(std::move(command));
+            auto* command = Allocate<DrawCommand>(vertexBuffer, AllocateBuffers(constantBuffers),
+                                                  vertexCount, startVertexLocation);
+            commands.push(command);
+            return command;
         }
 
-        void RenderCommandQueue::SubmitDrawIndexed(
+        RenderCommandBase* RenderCommandQueue::SubmitDrawIndexed(
             RefPtr<BufferBase> vertexBuffer, RefPtr<BufferBase> indexBuffer,
-            List<RefPtr<BufferBase>> constantBuffers, uint32_t indexCount,
+            const List<RefPtr<BufferBase>>& constantBuffers, uint32_t indexCount,
             uint32_t startIndexLocation, int32_t baseVertexLocation) {
-            auto command = RefPtr<RenderCommandBase>(new DrawIndexedCommand(
-                vertexBuffer, indexBuffer, constantBuffers, indexCount,
-                startIndexLocation, baseVertexLocation));
-            commands.push(std::move(command));
+            auto* command = Allocate<DrawIndexedCommand>(
+                vertexBuffer, indexBuffer, AllocateBuffers(constantBuffers), indexCount,
+                startIndexLocation, baseVertexLocation);
+            commands.push(command);
+            return command;
         }
 
         void RenderCommandQueue::SubmitBindConstantBuffer(RefPtr<BufferBase> buffer, uint8_t slot) {
-            auto command = RefPtr<RenderCommandBase>(new BindConstantBufferCommand(buffer, slot));
-            commands.push(std::move(command));
+            commands.push(Allocate<BindConstantBufferCommand>(buffer, slot));
         }
 
-        void RenderCommandQueue::SubmitUpdateConstantBuffer(RefPtr<BufferBase> buffer, void* Data, uint16_t Size) {
-            auto command = RefPtr<RenderCommandBase>(new UpdateConstantBufferCommand(buffer, Data, Size));
-            commands.push(std::move(command));
+        void RenderCommandQueue::SubmitUpdateConstantBuffer(RefPtr<BufferBase> buffer, const void* Data, uint16_t Size) {
+            void* copy = m_allocators[m_current].Allocate(Size);
+            std::memcpy(copy, Data, Size);
+            commands.push(Allocate<UpdateConstantBufferCommand>(buffer, copy, Size));
         }
 
         void RenderCommandQueue::SubmitBindMaterial(::Sleak::Material* material) {
-            auto command = RefPtr<RenderCommandBase>(new BindMaterialCommand(material));
-            commands.push(std::move(command));
+            commands.push(Allocate<BindMaterialCommand>(material));
         }
 
         void RenderCommandQueue::SubmitSetRenderMode(RenderMode mode) {
-            auto command = RefPtr<RenderCommandBase>(new SetRenderModeCommand(mode));
-            commands.push(command);
+            commands.push(Allocate<SetRenderModeCommand>(mode));
         }
 
         void RenderCommandQueue::SubmitSetRenderFace(RenderFace face) {
-            auto command = RefPtr<RenderCommandBase>(new SetRenderFaceCommand(face));
-            commands.push(command);
+            commands.push(Allocate<SetRenderFaceCommand>(face));
         }
 
         void RenderCommandQueue::SubmitCustomCommand(CustomCommand::ExecuteFunction function) {
-            auto command =
-                RefPtr<RenderCommandBase>(new CustomCommand(function)); 
-            commands.push(std::move(command));
-
+            commands.push(Allocate<CustomCommand>(std::move(function)));
         }
 
         void RenderCommandQueue::ExecuteCommands(RenderContext* context) {
+            SubmitFrame();
+            ExecuteSubmitted(context);
+        }
+
+        void RenderCommandQueue::SubmitFrame() {
+            // The frame submitted last time has finished executing
+            CountFrameAllocations();
+
+            if (m_captureFramesLeft != 0) {
+                m_capture->WriteFrame(m_submittedFrames, commands);
+                if (--m_captureFramesLeft == 0)
+                    EndCapture();
+            }
+            m_submittedFrames++;
+
+            // m_submitted was drained: the next frame records into it
+            commands.swap(m_submitted);
+            m_submittedFrame = m_current;
+            m_submittedViewProjection = Camera::GetMainViewMatrix() * Camera::GetMainProjectionMatrix();
+            ReserveInstanceBuffer();
+
+            // IDs only have to be stable within one frame
+            static constexpr uint32_t SORT_ID_BITS[] = {RenderSortKey::SHADER_BITS,
+                                                        RenderSortKey::MATERIAL_BITS,
+                                                        RenderSortKey::MESH_BITS};
+            m_sortIDsFolded = 0;
+            for (size_t kind = 0; kind < std::size(m_sortIDs); ++kind) {
+                const uint32_t limit = (1u << SORT_ID_BITS[kind]) - 1;
+                if (m_sortIDs[kind].count > limit)
+                    m_sortIDsFolded += m_sortIDs[kind].count - limit;
+                m_sortIDs[kind].Clear();
+            }
+
+            // The next allocator holds the frame before the previous one.
+            // The submitted frame's shadow pass only replays the previous
+            // one, so it takes the next frame's commands.
+            m_current = (m_current + 1) % FRAME_ALLOCATORS;
+            ReleaseFrame(m_current);
+        }
+
+        bool RenderCommandQueue::BeginCapture(const std::string& path, uint32_t frameCount) {
+            EndCapture();
+            if (frameCount == 0) return false;
+
+            if (!m_capture) m_capture = new RenderCaptureWriter();
+            if (!m_capture->Open(path)) return false;
 
+            m_captureFramesLeft = frameCount;
+            SLEAK_INFO("RenderCommandQueue: capturing {} frames to {}", frameCount, path);
+            return true;
+        }
+
+        void RenderCommandQueue::EndCapture() {
+            if (!m_capture || !m_capture->IsOpen()) return;
+
+            SLEAK_INFO("RenderCommandQueue: captured {} frames", m_capture->GetFramesWritten());
+            m_capture->Close();
+            m_captureFramesLeft = 0;
+        }
+
+        void RenderCommandQueue::ExecuteSubmitted(RenderContext* context) {
             SortCommands();
-            OptimizeBatching();
 
             // Cache draw commands for shadow pass replay next frame,
-            // pairing each with the last-bound slot-0 (transform) buffer
+            // pairing each with the last-bound slot-0 (transform) buffer.
+            // Done before batching: the shadow pass draws objects one by one.
             cachedShadowDraws.clear();
             RefPtr<BufferBase> lastSlot0Buffer;
-            for (auto& cmd : commands) {
+            for (auto* cmd : m_submitted) {
                 auto type = cmd->GetType();
                 if (type == CommandType::BindConstantBuffer) {
-                    auto* bindCmd = static_cast<BindConstantBufferCommand*>(cmd.get());
+                    auto* bindCmd = static_cast<BindConstantBufferCommand*>(cmd);
                     if (bindCmd->GetSlot() == 0) {
                         lastSlot0Buffer = bindCmd->GetBuffer();
                     }
@@ -84,8 +159,77 @@ namespace Sleak {
                 }
             }
 
-            while (!commands.isEmpty())
-                commands.pop()->Execute(context);
+            OptimizeBatching(context);
+
+            // Nothing is known to be bound at the start of a frame
+            m_stateCache.Reset(context ? context->HasIndependentConstantBufferSlots() : true);
+            m_redundantStateFiltered = 0;
+
+            m_submitted.drain([this, context](RenderCommandBase* cmd) {
+                // A buffer bound on its own needs the data the ring draws skipped
+                if (!m_deferredUploads.empty()) {
+                    if (cmd->GetType() == CommandType::BindConstantBuffer)
+                        ApplyDeferredUpload(static_cast<BindConstantBufferCommand*>(cmd)->GetBuffer().get());
+                    else if (cmd->GetType() == CommandType::UpdateConstantBuffer)
+                        DropDeferredUpload(static_cast<UpdateConstantBufferCommand*>(cmd)->GetBuffer());
+                }
+
+                if (m_stateCache.Filter(cmd)) {
+                    ++m_redundantStateFiltered;
+                    return;
+                }
+                cmd->Execute(context);
+            });
+
+            if (m_deferredUploads.size() - m_freeDeferredSlots.size() > m_deferredPruneSize)
+                PruneDeferredUploads();
+        }
+
+        void RenderCommandQueue::AddFrameStats(Renderer* renderer) const {
+            renderer->AddStateChangesSaved(m_stateChangesSaved);
+            renderer->AddDrawsMerged(m_drawsMerged);
+            renderer->AddRedundantStateFiltered(m_redundantStateFiltered);
+            renderer->AddTransformUploadsDeferred(m_transformUploadsDeferred);
+            renderer->AddRenderAllocations(static_cast<int>(m_frameHeapAllocations));
+        }
+
+        void RenderCommandQueue::ReleaseFrame(uint32_t index) {
+            for (auto* command : m_allocated[index])
+                command->~RenderCommandBase();
+            m_allocated[index].clear();
+            m_allocators[index].Reset();
+        }
+
+        void RenderCommandQueue::CountFrameAllocations() {
+            m_frameMemoryUsed = m_allocators[m_submittedFrame].GetUsed();
+
+            uint64_t blocks = 0;
+            for (const auto& allocator : m_allocators)
+                blocks += allocator.GetBlockAllocations();
+            uint32_t allocations = static_cast<uint32_t>(blocks - m_lastBlockAllocations);
+            m_lastBlockAllocations = blocks;
+
+            // A capacity change means the array went back to the heap
+            const size_t capacities[] = {
+                // Pairs that swap (lists every frame, sort buffers per radix
+                // pass) only keep their sum stable
+                commands.capacity() + m_submitted.capacity(), cachedShadowDraws.GetCapacity(),
+                m_allocated[0].capacity(), m_allocated[1].capacity(), m_allocated[2].capacity(),
+                m_sortEntries.capacity() + m_sortScratch.capacity(),
+                m_groups.capacity(), m_sorted.capacity(),
+                m_sortIDs[0].keys.capacity(), m_sortIDs[1].keys.capacity(),
+                m_sortIDs[2].keys.capacity(), m_instanceRun.capacity(),
+                m_instanceData.capacity(), m_instancedDraws.capacity()
+            };
+
+            const size_t count = sizeof(capacities) / sizeof(capacities[0]);
+            m_lastCapacities.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                allocations += capacities[i] != m_lastCapacities[i];
+                m_lastCapacities[i] = capacities[i];
+            }
+
+            m_frameHeapAllocations = allocations;
         }
 
         void RenderCommandQueue::ExecuteShadowPass(RenderContext* context) {
@@ -96,31 +240,465 @@ namespace Sleak {
             }
             for (size_t i = 0; i < cachedShadowDraws.GetSize(); ++i) {
                 auto& entry = cachedShadowDraws[i];
+
+                // Merged into an instanced draw: its transforms are in the
+                // instance buffer, its own buffer never got them
+                if (m_shadowInstances && entry.command->GetType() == CommandType::DrawIndexed) {
+                    auto* draw = static_cast<DrawIndexedCommand*>(entry.command);
+                    if (draw->GetInstance() != DrawIndexedCommand::NO_INSTANCE &&
+                        context->BeginInstancedDraw(m_shadowInstances, draw->GetInstance())) {
+                        draw->ExecuteShadowInstance(context);
+                        context->EndInstancedDraw();
+                        continue;
+                    }
+                }
+
                 // Bind the transform buffer (slot 0) before drawing — shadow mode
                 // in VulkanRenderer::BindConstantBuffer computes LightVP * World
                 if (entry.transformBuffer) {
+                    ApplyDeferredUpload(entry.transformBuffer.get());
                     context->BindConstantBuffer(entry.transformBuffer, 0);
                 }
                 entry.command->ExecuteShadow(context);
             }
         }
 
+        uint32_t RenderCommandQueue::GetSortID(SortResource kind, const void* resource) {
+            if (!resource) return 0;
+            return m_sortIDs[static_cast<size_t>(kind)].Get(resource);
+        }
+
+        static size_t HashPointer(const void* pointer) {
+            // Fibonacci hashing; the low bits of a pointer are mostly alignment
+            return static_cast<size_t>((reinterpret_cast<uintptr_t>(pointer) >> 4) *
+                                       0x9E3779B97F4A7C15ull);
+        }
+
+        uint32_t RenderCommandQueue::SortIDTable::Get(const void* resource) {
+            if ((count + 1) * 2 > keys.size()) Grow();
+
+            const size_t mask = keys.size() - 1;
+            for (size_t slot = HashPointer(resource) & mask;; slot = (slot + 1) & mask) {
+                if (keys[slot] == resource) return ids[slot];
+                if (!keys[slot]) {
+                    keys[slot] = resource;
+                    ids[slot] = ++count;
+                    return count;
+                }
+            }
+        }
+
+        void RenderCommandQueue::SortIDTable::Grow() {
+            std::vector<const void*> oldKeys(std::max<size_t>(keys.size() * 2, 64), nullptr);
+            std::vector<uint32_t> oldIds(oldKeys.size(), 0);
+            oldKeys.swap(keys);
+            oldIds.swap(ids);
+
+            const size_t mask = keys.size() - 1;
+            for (size_t i = 0; i < oldKeys.size(); ++i) {
+                if (!oldKeys[i]) continue;
+                size_t slot = HashPointer(oldKeys[i]) & mask;
+                while (keys[slot]) slot = (slot + 1) & mask;
+                keys[slot] = oldKeys[i];
+                ids[slot] = oldIds[i];
+            }
+        }
+
+        void RenderCommandQueue::SortIDTable::Clear() {
+            if (count == 0) return;
+            std::fill(keys.begin(), keys.end(), nullptr);
+            count = 0;
+        }
+
+        void RenderCommandQueue::RadixSort(std::vector<SortEntry>& entries,
+                                           std::vector<SortEntry>& scratch) {
+            const size_t count = entries.size();
+            if (count < 2) return;
+            scratch.resize(count);
+
+            // LSD, one byte per pass; stable, so equal keys keep submission order
+            for (uint32_t shift = 0; shift < 64; shift += 8) {
+                uint32_t offsets[256] = {};
+                for (const auto& entry : entries)
+                    offsets[(entry.key >> shift) & 0xFF]++;
+
+                // Every key has the same byte here: nothing to move
+                if (offsets[(entries[0].key >> shift) & 0xFF] == count)
+                    continue;
+
+                uint32_t sum = 0;
+                for (auto& offset : offsets) {
+                    uint32_t bucket = offset;
+                    offset = sum;
+                    sum += bucket;
+                }
+
+                for (const auto& entry : entries)
+                    scratch[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+                entries.swap(scratch);
+            }
+        }
+
+        int32_t RenderCommandQueue::CountStateChanges(const std::vector<SortEntry>& entries) {
+            int32_t changes = 0;
+            for (size_t i = 1; i < entries.size(); ++i) {
+                uint64_t previous = entries[i - 1].key;
+                uint64_t current = entries[i].key;
+                changes += RenderSortKey::GetShader(previous) != RenderSortKey::GetShader(current);
+                changes += RenderSortKey::GetMaterial(previous) != RenderSortKey::GetMaterial(current);
+                changes += RenderSortKey::GetMesh(previous) != RenderSortKey::GetMesh(current);
+            }
+            return changes;
+        }
+
         void RenderCommandQueue::SortCommands() {
-            // Commands are submitted in the correct per-object order:
-            // UpdateCB → BindCB → BindMaterial → Draw for each object,
-            // with custom commands (skybox, debug lines) at their correct position.
-            // Preserve submission order to maintain correct state bindings.
-            // Future optimization: batch by material while preserving per-object groups.
+            m_stateChangesSaved = 0;
+
+            const uint32_t count = static_cast<uint32_t>(m_submitted.size());
+            if (count < 2) return;
+
+            auto& source = m_submitted;
+            m_sorted.clear();
+            m_sorted.reserve(count);
+            m_groups.clear();
+            m_sortEntries.clear();
+
+            // Emits the groups collected since the last barrier, sorted
+            auto flushSegment = [&]() {
+                if (m_sortEntries.empty()) return;
+
+                int32_t before = CountStateChanges(m_sortEntries);
+                RadixSort(m_sortEntries, m_sortScratch);
+                m_stateChangesSaved += before - CountStateChanges(m_sortEntries);
+
+                for (const auto& entry : m_sortEntries) {
+                    const CommandGroup& group = m_groups[entry.group];
+                    for (uint32_t i = group.first; i < group.first + group.count; ++i)
+                        m_sorted.push_back(source[i]);
+                }
+                m_sortEntries.clear();
+            };
+
+            uint32_t groupStart = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                RenderCommandBase* command = source[i];
+
+                switch (command->GetType()) {
+                    case CommandType::UpdateConstantBuffer:
+                    case CommandType::BindConstantBuffer:
+                    case CommandType::BindMaterial:
+                    case CommandType::SetShader:
+                    case CommandType::SetTexture:
+                        // Belongs to the group the next draw closes
+                        continue;
+
+                    case CommandType::Draw:
+                    case CommandType::DrawIndexed:
+                        if (command->HasSortKey()) {
+                            m_sortEntries.push_back({command->GetSortKey(),
+                                                     static_cast<uint32_t>(m_groups.size())});
+                            m_groups.push_back({groupStart, i + 1 - groupStart});
+                            groupStart = i + 1;
+                            continue;
+                        }
+                        [[fallthrough]];
+
+                    default:
+                        // Barrier: everything before it stays before it
+                        flushSegment();
+                        for (; groupStart <= i; ++groupStart)
+                            m_sorted.push_back(source[groupStart]);
+                        break;
+                }
+            }
+
+            flushSegment();
+            for (; groupStart < count; ++groupStart)
+                m_sorted.push_back(source[groupStart]);
+
+            m_submitted.clear();
+            for (auto* command : m_sorted)
+                m_submitted.push(command);
+            m_sorted.clear();
         }
 
-        void RenderCommandQueue::OptimizeBatching() {
-            // Batching is a technique to call render commands as single pass instead pf multiple draw calls. This significantly improves rendering efficiency
-            // TODO: Implement this method
+        bool RenderCommandQueue::GetInstanceGroup(uint32_t first, uint32_t draw,
+                                                  InstanceGroup& group) const {
+            const auto& source = m_submitted;
+
+            if (source[draw]->GetType() != CommandType::DrawIndexed) return false;
+            auto* drawCmd = static_cast<DrawIndexedCommand*>(source[draw]);
+            // Extra constant buffers (bones...) are per object
+            if (!drawCmd->HasWorldMatrix() || drawCmd->HasConstantBuffers()) return false;
+
+            group = {first, draw, draw, nullptr, RefPtr<BufferBase>()};
+            for (uint32_t i = first; i < draw; ++i) {
+                switch (source[i]->GetType()) {
+                    case CommandType::UpdateConstantBuffer:
+                        break;
+                    case CommandType::BindConstantBuffer: {
+                        auto* bind = static_cast<BindConstantBufferCommand*>(source[i]);
+                        if (bind->GetSlot() != 0) return false;
+                        group.transform = bind->GetBuffer();
+                        break;
+                    }
+                    case CommandType::BindMaterial:
+                        group.bindMaterial = i;
+                        group.material = static_cast<BindMaterialCommand*>(source[i])->GetMaterial();
+                        break;
+                    default:
+                        return false;
+                }
+            }
+
+            return group.transform && group.material && group.material->IsInstancingEnabled();
+        }
+
+        void RenderCommandQueue::FlushInstanceRun() {
+            auto& source = m_submitted;
+
+            if (m_instanceRun.empty()) return;
+
+            const Math::Matrix4& viewProjection = m_submittedViewProjection;
+            const uint32_t firstInstance = static_cast<uint32_t>(m_instanceData.size() / 2);
+
+            BufferSpan transforms;
+            transforms.data = m_allocators[m_submittedFrame].NewArray<RefPtr<BufferBase>>(m_instanceRun.size());
+
+            // The instance data replaces the transform uploads. They are kept
+            // aside for a later frame that binds the buffer on its own.
+            for (const auto& group : m_instanceRun) {
+                for (uint32_t i = group.first; i < group.draw; ++i) {
+                    if (source[i]->GetType() != CommandType::UpdateConstantBuffer) continue;
+                    auto* update = static_cast<UpdateConstantBufferCommand*>(source[i]);
+                    if (!DeferUpload(group.transform, update))
+                        m_sorted.push_back(update);
+                }
+
+                // Same layout as TransformBuffer
+                auto* draw = static_cast<DrawIndexedCommand*>(source[group.draw]);
+                draw->SetInstance(static_cast<uint32_t>(m_instanceData.size() / 2));
+                const auto& world = draw->GetWorldMatrix();
+                m_instanceData.push_back(world * viewProjection);
+                m_instanceData.push_back(world);
+                new (&transforms.data[transforms.count++]) RefPtr<BufferBase>(group.transform);
+            }
+
+            m_sorted.push_back(source[m_instanceRun[0].bindMaterial]);
+
+            auto* first = static_cast<DrawIndexedCommand*>(source[m_instanceRun[0].draw]);
+            auto* instanced = AllocateIn<DrawIndexedInstancedCommand>(
+                m_submittedFrame, first->GetVertexBuffer(), first->GetIndexBuffer(), first->GetIndexCount(),
+                first->GetStartIndexLocation(), first->GetBaseVertexLocation(), firstInstance, transforms);
+            m_instancedDraws.push_back(instanced);
+            m_sorted.push_back(instanced);
+
+            m_drawsMerged += static_cast<int32_t>(m_instanceRun.size()) - 1;
+            m_instanceRun.clear();
+        }
+
+        void RenderCommandQueue::OptimizeBatching(RenderContext* context) {
+            m_drawsMerged = 0;
+            m_transformUploadsDeferred = 0;
+            m_shadowInstances = nullptr;
+            m_instancingSupported = context && context->SupportsInstancing();
+            if (!m_instancingSupported) return;
+
+            const uint32_t count = static_cast<uint32_t>(m_submitted.size());
+            if (count == 0) return;
+
+            auto& source = m_submitted;
+            m_sorted.clear();
+            m_sorted.reserve(count);
+            m_instanceData.clear();
+            m_instancedDraws.clear();
+            m_instanceRun.clear();
+
+            auto sameBatch = [&](const InstanceGroup& a, const InstanceGroup& b) {
+                auto* drawA = static_cast<DrawIndexedCommand*>(source[a.draw]);
+                auto* drawB = static_cast<DrawIndexedCommand*>(source[b.draw]);
+                return a.material == b.material &&
+                       drawA->GetVertexBuffer().get() == drawB->GetVertexBuffer().get() &&
+                       drawA->GetIndexBuffer().get() == drawB->GetIndexBuffer().get() &&
+                       drawA->GetIndexCount() == drawB->GetIndexCount() &&
+                       drawA->GetStartIndexLocation() == drawB->GetStartIndexLocation() &&
+                       drawA->GetBaseVertexLocation() == drawB->GetBaseVertexLocation();
+            };
+
+            uint32_t groupStart = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                switch (source[i]->GetType()) {
+                    case CommandType::UpdateConstantBuffer:
+                    case CommandType::BindConstantBuffer:
+                    case CommandType::BindMaterial:
+                    case CommandType::SetShader:
+                    case CommandType::SetTexture:
+                        continue;
+
+                    case CommandType::Draw:
+                    case CommandType::DrawIndexed: {
+                        InstanceGroup group;
+                        if (GetInstanceGroup(groupStart, i, group)) {
+                            if (!m_instanceRun.empty() && !sameBatch(m_instanceRun[0], group))
+                                FlushInstanceRun();
+                            m_instanceRun.push_back(group);
+                            groupStart = i + 1;
+                            continue;
+                        }
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+
+                // Anything that cannot be an instance ends the run
+                FlushInstanceRun();
+                for (; groupStart <= i; ++groupStart)
+                    m_sorted.push_back(source[groupStart]);
+            }
+
+            FlushInstanceRun();
+            for (; groupStart < count; ++groupStart)
+                m_sorted.push_back(source[groupStart]);
+
+            m_submitted.clear();
+            for (auto* command : m_sorted)
+                m_submitted.push(command);
+            m_sorted.clear();
+
+            UploadInstanceData();
+        }
+
+        void RenderCommandQueue::ReserveInstanceBuffer() {
+            if (!m_instancingSupported) return;
+
+            // Every draw that could become an instance, whether it merges or not
+            uint32_t draws = 0;
+            for (auto* cmd : m_submitted) {
+                if (cmd->GetType() == CommandType::DrawIndexed &&
+                    static_cast<DrawIndexedCommand*>(cmd)->HasWorldMatrix())
+                    ++draws;
+            }
+            if (draws == 0) return;
+
+            // The slot UploadInstanceData writes next
+            auto& buffer = m_instanceBuffers[(m_instanceFrame + 1) % FRAMES_IN_FLIGHT];
+            const uint32_t bytes = draws * 2 * static_cast<uint32_t>(sizeof(Math::Matrix4));
+            if (buffer && buffer->GetSize() >= bytes) return;
+
+            uint32_t capacity = buffer ? static_cast<uint32_t>(buffer->GetSize()) : 0;
+            capacity = std::max(bytes, capacity * 2);
+            buffer = RefPtr<BufferBase>(
+                ResourceManager::CreateBuffer(BufferType::ShaderResource, capacity, nullptr));
+        }
+
+        void RenderCommandQueue::UploadInstanceData() {
+            if (m_instancedDraws.empty()) return;
+
+            // One upload for every instanced draw of the frame, into the
+            // ring slot the GPU finished reading FRAMES_IN_FLIGHT frames ago.
+            // SubmitFrame sized it, so nothing is allocated here.
+            m_instanceFrame = (m_instanceFrame + 1) % FRAMES_IN_FLIGHT;
+            RefPtr<BufferBase> buffer = m_instanceBuffers[m_instanceFrame];
+
+            const uint32_t bytes = static_cast<uint32_t>(m_instanceData.size() * sizeof(Math::Matrix4));
+            if (buffer && buffer->GetSize() < bytes) buffer = nullptr;
+
+            // Without a buffer the instanced draws fall back to one draw each
+            if (buffer) buffer->Update(m_instanceData.data(), bytes);
+            m_shadowInstances = buffer;
+
+            for (auto* instanced : m_instancedDraws)
+                instanced->SetInstanceBuffer(buffer, m_instanceData.data());
+            m_instancedDraws.clear();
+        }
+
+        bool RenderCommandQueue::DeferUpload(const RefPtr<BufferBase>& buffer,
+                                             const UpdateConstantBufferCommand* update) {
+            // Only the transform itself, other constant buffers still upload
+            if (update->GetBuffer() != buffer.get()) return false;
+            if (update->GetSize() > sizeof(DeferredUpload::data)) return false;
+
+            uint32_t slot = buffer->GetDeferredSlot();
+            if (slot == BufferBase::NO_DEFERRED_SLOT) {
+                if (!m_freeDeferredSlots.empty()) {
+                    slot = m_freeDeferredSlots.back();
+                    m_freeDeferredSlots.pop_back();
+                } else {
+                    slot = static_cast<uint32_t>(m_deferredUploads.size());
+                    m_deferredUploads.emplace_back();
+                }
+                m_deferredUploads[slot].buffer = buffer;
+                buffer->SetDeferredSlot(slot);
+            }
+
+            auto& deferred = m_deferredUploads[slot];
+            std::memcpy(deferred.data, update->GetData(), update->GetSize());
+            deferred.size = update->GetSize();
+            deferred.pending = true;
+
+            ++m_transformUploadsDeferred;
+            return true;
+        }
+
+        void RenderCommandQueue::ApplyDeferredUpload(BufferBase* buffer) {
+            const uint32_t slot = buffer ? buffer->GetDeferredSlot() : BufferBase::NO_DEFERRED_SLOT;
+            if (slot == BufferBase::NO_DEFERRED_SLOT) return;
+
+            auto& deferred = m_deferredUploads[slot];
+            if (!deferred.pending) return;
+            deferred.pending = false;
+            buffer->Update(deferred.data, deferred.size);
+        }
+
+        void RenderCommandQueue::DropDeferredUpload(BufferBase* buffer) {
+            const uint32_t slot = buffer ? buffer->GetDeferredSlot() : BufferBase::NO_DEFERRED_SLOT;
+            if (slot != BufferBase::NO_DEFERRED_SLOT)
+                m_deferredUploads[slot].pending = false;
+        }
+
+        void RenderCommandQueue::ReleaseDeferredSlot(uint32_t slot) {
+            auto& deferred = m_deferredUploads[slot];
+            deferred.buffer->SetDeferredSlot(BufferBase::NO_DEFERRED_SLOT);
+            deferred.buffer = nullptr;
+            deferred.pending = false;
+            m_freeDeferredSlots.push_back(slot);
+        }
+
+        void RenderCommandQueue::PruneDeferredUploads() {
+            // An entry holding the last reference belongs to a destroyed object
+            for (uint32_t slot = 0; slot < m_deferredUploads.size(); ++slot) {
+                if (m_deferredUploads[slot].buffer && m_deferredUploads[slot].buffer.use_count() == 1)
+                    ReleaseDeferredSlot(slot);
+            }
+            const size_t live = m_deferredUploads.size() - m_freeDeferredSlots.size();
+            m_deferredPruneSize = std::max<size_t>(64, live * 2);
         }
 
         void RenderCommandQueue::Clear() {
-            while (!commands.isEmpty()) 
-                commands.pop();
+            commands.clear();
+            m_submitted.clear();
+            // clear() keeps the entries' buffer references alive
+            cachedShadowDraws = List<ShadowDrawEntry>();
+            for (uint32_t i = 0; i < FRAME_ALLOCATORS; ++i)
+                ReleaseFrame(i);
+
+            for (auto& ids : m_sortIDs)
+                ids.Clear();
+
+            // Hold GPU buffers: must go before the renderer
+            for (auto& buffer : m_instanceBuffers)
+                buffer = nullptr;
+            m_shadowInstances = nullptr;
+
+            // Buffers outliving the queue must not keep their slots
+            for (uint32_t slot = 0; slot < m_deferredUploads.size(); ++slot) {
+                if (m_deferredUploads[slot].buffer) ReleaseDeferredSlot(slot);
+            }
+            m_deferredUploads.clear();
+            m_freeDeferredSlots.clear();
+            m_deferredPruneSize = 64;
         }
     }
 }
@@ -6,16 +6,56 @@
 #include "../../include/private/Graphics/Shader.hpp"
 #include "../../include/public/Runtime/Texture.hpp"
 #include <Runtime/Material.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace Sleak {
 namespace RenderEngine {
 
+//------------------------------------------------------------------------------
+// Sort Key
+//------------------------------------------------------------------------------
+
+uint32_t RenderSortKey::QuantizeDepth(float depth, uint32_t bits) {
+    // The bit pattern of a non-negative float grows with its value, so its
+    // top bits are a log-scale depth: fine near the camera, coarse far away
+    depth = std::max(depth, 0.0f);
+    uint32_t raw;
+    std::memcpy(&raw, &depth, sizeof(raw));
+    return raw >> (31 - bits);
+}
+
+uint64_t RenderSortKey::Make(SortPass pass, uint8_t mode, uint32_t shader,
+                             uint32_t material, uint32_t mesh, float depth) {
+    // IDs past the field wrap onto 1.. (0 stays null), so they still sort
+    // apart from their neighbours; a clamp would merge them all into one
+    auto fold = [](uint32_t value, uint32_t bits) {
+        const uint32_t limit = (1u << bits) - 1;
+        return static_cast<uint64_t>(value <= limit ? value : 1 + (value - 1) % limit);
+    };
+
+    uint64_t key = (static_cast<uint64_t>(pass) & 0x3) << PASS_SHIFT;
+    key |= (static_cast<uint64_t>(mode) & 0x3) << MODE_SHIFT;
+    key |= fold(shader, SHADER_BITS) << SHADER_SHIFT;
+    key |= fold(material, MATERIAL_BITS) << MATERIAL_SHIFT;
+    key |= fold(mesh, MESH_BITS) << MESH_SHIFT;
+
+    if (mode == TRANSPARENT_MODE) {
+        uint32_t far = QuantizeDepth(depth, FAR_DEPTH_BITS);
+        key |= static_cast<uint64_t>(~far & ((1u << FAR_DEPTH_BITS) - 1)) << FAR_DEPTH_SHIFT;
+    } else {
+        key |= QuantizeDepth(depth, NEAR_DEPTH_BITS);
+    }
+
+    return key;
+}
+
 //------------------------------------------------------------------------------
 // Drawing
 //------------------------------------------------------------------------------
 
 DrawCommand::DrawCommand(RefPtr<BufferBase> buffer,
-                         List<RefPtr<BufferBase>> constantBuffers,
+                         BufferSpan constantBuffers,
                          uint32_t vertexCount, uint32_t vertexLocation)
     : m_vertexBuffer(buffer),
       m_constantBuffers(constantBuffers),
@@ -43,7 +83,7 @@ void DrawCommand::ExecuteShadow(RenderContext* context) {
 
 DrawIndexedCommand::DrawIndexedCommand(RefPtr<BufferBase> vertexBuffer,
                                        RefPtr<BufferBase> indexBuffer,
-                                       List<RefPtr<BufferBase>> constantBuffers,
+                                       BufferSpan constantBuffers,
                                        uint32_t indexCount,
                                        uint32_t startIndexLocation,
                                        int32_t baseVertexLocation)
@@ -55,8 +95,8 @@ DrawIndexedCommand::DrawIndexedCommand(RefPtr<BufferBase> vertexBuffer,
       m_baseVertexLocation(baseVertexLocation) {}
 
 void DrawIndexedCommand::Execute(RenderContext* context) {
-    context->BindVertexBuffer(m_vertexBuffer, m_startIndexLocation);
-    context->BindIndexBuffer(m_indexBuffer, m_startIndexLocation);
+    context->BindVertexBuffer(m_vertexBuffer);
+    context->BindIndexBuffer(m_indexBuffer);
 
     // Detect if this is a skinned mesh (has bone buffer at slot 3)
     bool hasBones = false;
@@ -77,17 +117,67 @@ void DrawIndexedCommand::Execute(RenderContext* context) {
         }
     }
 
-    context->DrawIndexed(m_indexCount);
+    context->DrawIndexed(m_indexCount, m_startIndexLocation, m_baseVertexLocation);
 
     // Switch back to default pipeline for subsequent non-skinned draws
     if (hasBones) context->EndSkinnedPass();
 }
 
 void DrawIndexedCommand::ExecuteShadow(RenderContext* context) {
-    context->BindVertexBuffer(m_vertexBuffer, m_startIndexLocation);
-    context->BindIndexBuffer(m_indexBuffer, m_startIndexLocation);
+    context->BindVertexBuffer(m_vertexBuffer);
+    context->BindIndexBuffer(m_indexBuffer);
     // Transform buffer (slot 0) is bound by ExecuteShadowPass before this call
-    context->DrawIndexed(m_indexCount);
+    context->DrawIndexed(m_indexCount, m_startIndexLocation, m_baseVertexLocation);
+}
+
+void DrawIndexedCommand::ExecuteShadowInstance(RenderContext* context) {
+    context->BindVertexBuffer(m_vertexBuffer);
+    context->BindIndexBuffer(m_indexBuffer);
+    context->DrawIndexedInstance(1, m_indexCount, m_startIndexLocation, m_baseVertexLocation);
+}
+
+//------------------------------------------------------------------------------
+// Instanced Indexed Drawing
+//------------------------------------------------------------------------------
+
+DrawIndexedInstancedCommand::DrawIndexedInstancedCommand(RefPtr<BufferBase> vertexBuffer,
+                                                         RefPtr<BufferBase> indexBuffer,
+                                                         uint32_t indexCount,
+                                                         uint32_t startIndexLocation,
+                                                         int32_t baseVertexLocation,
+                                                         uint32_t firstInstance,
+                                                         BufferSpan transformBuffers)
+    : m_vertexBuffer(vertexBuffer),
+      m_indexBuffer(indexBuffer),
+      m_indexCount(indexCount),
+      m_startIndexLocation(startIndexLocation),
+      m_baseVertexLocation(baseVertexLocation),
+      m_firstInstance(firstInstance),
+      m_transformBuffers(transformBuffers) {}
+
+void DrawIndexedInstancedCommand::Execute(RenderContext* context) {
+    context->BindVertexBuffer(m_vertexBuffer, 0);
+    context->BindIndexBuffer(m_indexBuffer, 0);
+
+    if (context->BeginInstancedDraw(m_instanceBuffer, m_firstInstance)) {
+        context->DrawIndexedInstance(GetInstanceCount(), m_indexCount,
+                                     m_startIndexLocation, m_baseVertexLocation);
+        context->EndInstancedDraw();
+        return;
+    }
+
+    // Shader without an instancing path: one draw per object
+    for (uint32_t i = 0; i < m_transformBuffers.GetSize(); ++i) {
+        const auto& transform = m_transformBuffers.data[i];
+        if (m_instanceData) {
+            // Update takes a mutable pointer; the recorded data stays as is
+            Math::Matrix4 matrices[2];
+            std::memcpy(matrices, m_instanceData + (m_firstInstance + i) * 2, sizeof(matrices));
+            transform->Update(matrices, sizeof(matrices));
+        }
+        context->BindConstantBuffer(transform, 0);
+        context->DrawIndexed(m_indexCount, m_startIndexLocation, m_baseVertexLocation);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -98,16 +188,8 @@ UpdateConstantBufferCommand::UpdateConstantBufferCommand(RefPtr<BufferBase> buff
     void* Data,
     uint16_t Size) : 
       constantBuffer(buffer), 
-      Data(nullptr),
-      Size(Size) {
-    this->Data = malloc(Size);
-
-    if (this->Data) {
-        memcpy(this->Data,Data,Size);
-    } else {
-        SLEAK_ERROR("Failed to allocate memory at UpdateConstantBufferCommand!");
-    }
-}
+      Data(Data),
+      Size(Size) {}
 
 void UpdateConstantBufferCommand::Execute(RenderContext* context) {
     constantBuffer->Update(Data,Size);
@@ -144,6 +226,22 @@ void SetRenderFaceCommand::Execute(RenderContext* context) {
     context->SetRenderFace(face);
 }
 
+//------------------------------------------------------------------------------
+// Bind Texture / Shader
+//------------------------------------------------------------------------------
+
+BindTextureCommand::BindTextureCommand(RefPtr<Texture> texture) : texture(texture) {}
+
+void BindTextureCommand::Execute(RenderContext* context) {
+    context->BindTexture(texture, 0);
+}
+
+BindShaderCommand::BindShaderCommand(RefPtr<Shader> shader) : shader(shader) {}
+
+void BindShaderCommand::Execute(RenderContext* context) {
+    if (shader) shader->bind();
+}
+
 //------------------------------------------------------------------------------
 // Bind Material
 //------------------------------------------------------------------------------
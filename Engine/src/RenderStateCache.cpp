@@ -0,0 +1,123 @@
+#include "../../include/private/Graphics/RenderStateCache.hpp"
+#include "../../include/private/Graphics/RenderCommands.hpp"
+#include "../../include/private/Graphics/BufferBase.hpp"
+#include <Runtime/Material.hpp>
+
+namespace Sleak {
+    namespace RenderEngine {
+
+        void RenderStateCache::Reset(bool independentSlots) {
+            m_independentSlots = independentSlots;
+            m_shader = nullptr;
+            m_material = nullptr;
+            m_mode = -1;
+            m_face = -1;
+            ForgetTextures();
+            ForgetConstantBuffers();
+        }
+
+        void RenderStateCache::ForgetConstantBuffers() {
+            for (auto& buffer : m_constantBuffers)
+                buffer = nullptr;
+        }
+
+        void RenderStateCache::ForgetTextures() {
+            for (auto& texture : m_textures)
+                texture = nullptr;
+        }
+
+        void RenderStateCache::BindConstantBuffer(uint32_t slot, const BufferBase* buffer) {
+            if (!m_independentSlots) ForgetConstantBuffers();
+            if (slot < MAX_SLOTS) m_constantBuffers[slot] = buffer;
+        }
+
+        bool RenderStateCache::Filter(const RenderCommandBase* command) {
+            switch (command->GetType()) {
+                case CommandType::BindConstantBuffer: {
+                    auto* bind = static_cast<const BindConstantBufferCommand*>(command);
+                    const BufferBase* buffer = bind->GetBuffer().get();
+                    const uint32_t slot = static_cast<uint32_t>(bind->GetSlot());
+
+                    if (buffer && slot < MAX_SLOTS && m_constantBuffers[slot] == buffer)
+                        return true;
+                    BindConstantBuffer(slot, buffer);
+                    return false;
+                }
+
+                case CommandType::UpdateConstantBuffer: {
+                    // New contents must be bound again (push constants copy on bind)
+                    const BufferBase* buffer =
+                        static_cast<const UpdateConstantBufferCommand*>(command)->GetBuffer();
+                    for (auto& bound : m_constantBuffers) {
+                        if (bound == buffer) bound = nullptr;
+                    }
+                    return false;
+                }
+
+                case CommandType::BindMaterial: {
+                    const void* material = static_cast<const BindMaterialCommand*>(command)->GetMaterial();
+                    if (material && material == m_material) return true;
+
+                    // Binds its own shader, textures and constant buffer
+                    m_material = material;
+                    m_shader = nullptr;
+                    ForgetTextures();
+                    BindConstantBuffer(CONSTANT_SLOT_MATERIAL, nullptr);
+                    return false;
+                }
+
+                case CommandType::SetShader: {
+                    const void* shader = static_cast<const BindShaderCommand*>(command)->GetShader().get();
+                    if (shader && shader == m_shader) return true;
+
+                    m_shader = shader;
+                    m_material = nullptr;
+                    return false;
+                }
+
+                case CommandType::SetTexture: {
+                    const void* texture = static_cast<const BindTextureCommand*>(command)->GetTexture().get();
+                    if (texture && texture == m_textures[0]) return true;
+
+                    m_textures[0] = texture;
+                    m_material = nullptr;
+                    return false;
+                }
+
+                case CommandType::SetMode: {
+                    const int32_t mode = static_cast<int32_t>(
+                        static_cast<const SetRenderModeCommand*>(command)->GetMode());
+                    if (mode == m_mode) return true;
+                    m_mode = mode;
+                    return false;
+                }
+
+                case CommandType::SetFace: {
+                    const int32_t face = static_cast<int32_t>(
+                        static_cast<const SetRenderFaceCommand*>(command)->GetFace());
+                    if (face == m_face) return true;
+                    m_face = face;
+                    return false;
+                }
+
+                case CommandType::Draw:
+                    // Binds its extra constant buffers itself
+                    if (static_cast<const DrawCommand*>(command)->HasConstantBuffers())
+                        ForgetConstantBuffers();
+                    return false;
+
+                case CommandType::DrawIndexed:
+                    // Extra buffers may switch to the skinned pipeline and back
+                    if (static_cast<const DrawIndexedCommand*>(command)->HasConstantBuffers())
+                        Reset(m_independentSlots);
+                    return false;
+
+                default:
+                    // Instanced draws switch pipelines, custom commands do anything
+                    Reset(m_independentSlots);
+                    return false;
+            }
+        }
+
+    }
+}
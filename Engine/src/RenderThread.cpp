@@ -0,0 +1,102 @@
+#include "../../include/private/Graphics/RenderThread.hpp"
+#include "../../include/private/Graphics/RenderCommandQueue.hpp"
+#include "../../include/private/Graphics/Renderer.hpp"
+#include <Logger.hpp>
+
+namespace Sleak {
+    namespace RenderEngine {
+        std::atomic<RenderThread*> RenderThread::s_active = nullptr;
+
+        RenderThread::~RenderThread() {
+            Stop();
+        }
+
+        bool RenderThread::Start(Renderer* renderer) {
+            if (IsRunning()) return true;
+
+            if (!renderer || !renderer->SupportsRenderThread()) {
+                SLEAK_WARN("RenderThread: the {} renderer must run on the main thread",
+                           renderer ? renderer->GetTypeStr() : "missing");
+                return false;
+            }
+
+            m_renderer = renderer;
+            m_queue = RenderCommandQueue::GetInstance();
+            m_pending = false;
+            m_stop = false;
+
+            m_thread = std::thread(&RenderThread::Run, this);
+            s_active = this;
+
+            SLEAK_INFO("RenderThread: started, frames execute one behind the main thread");
+            return true;
+        }
+
+        void RenderThread::Stop() {
+            if (!IsRunning()) return;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_one();
+            m_thread.join();
+
+            s_active = nullptr;
+        }
+
+        void RenderThread::Submit() {
+            WaitIdle();
+
+            // Nothing executes now: the queue can swap its lists safely
+            m_queue->SubmitFrame();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending = true;
+            }
+            m_wake.notify_one();
+        }
+
+        void RenderThread::Sync() {
+            RenderThread* active = s_active;
+            if (!active || std::this_thread::get_id() == active->m_thread.get_id())
+                return;
+
+            active->WaitIdle();
+        }
+
+        void RenderThread::WaitIdle() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this]() { return !m_pending; });
+        }
+
+        void RenderThread::Run() {
+            RenderContext* context = m_renderer->GetContext();
+
+            for (;;) {
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [this]() { return m_pending || m_stop; });
+
+                    // A submitted frame still runs before stopping
+                    if (!m_pending) break;
+                }
+
+                m_renderer->BeginRender();
+                if (context) {
+                    m_queue->ExecuteSubmitted(context);
+                    m_queue->AddFrameStats(m_renderer);
+                }
+                m_renderer->EndRender();
+                ++m_framesRendered;
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_pending = false;
+                }
+                m_idle.notify_all();
+            }
+        }
+    }
+}
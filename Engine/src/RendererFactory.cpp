@@ -22,6 +22,9 @@ Renderer* RendererFactory::CreateRenderer(RendererType type, Window* window) {
             SLEAK_INFO("Used graphic API is OpenGL");
             #define API_OPENGL
             return new OpenGLRenderer(window);
+        case RendererType::Null:
+            SLEAK_INFO("Running headless with the Null renderer");
+            return new NullRenderer(Window::GetWidth(), Window::GetHeight());
         #ifdef PLATFORM_WIN
         case RendererType::DirectX11:
             SLEAK_INFO("Used graphic API is DirectX 11");
@@ -56,6 +59,8 @@ Renderer* RendererFactory::ParseArg(std::string arg, Window* window) {
         return CreateRenderer(RendererType::DirectX11, window);
         else if(arg == "d12" || arg == "d3d12" || arg == "directx12")
         return CreateRenderer(RendererType::DirectX12, window);
+    else if(arg == "n" || arg == "null" || arg == "headless")
+        return CreateRenderer(RendererType::Null, window);
     else
         throw std::runtime_error("Unsupported API has been requested!");
 }
@@ -1,4 +1,5 @@
 #include "../../include/private/Graphics/ResourceManager.hpp"
+#include "../../include/private/Graphics/RenderThread.hpp"
 #include <Logger.hpp>
 
 namespace Sleak {
@@ -6,13 +7,18 @@ namespace Sleak {
 
         IMPLEMENT_RESOURCE_MANAGER
 
-        BufferBase* ResourceManager::CreateBuffer(BufferType Type, uint32_t Size, void* Data) {
+        BufferBase* ResourceManager::CreateBuffer(BufferType Type, uint32_t Size, void* Data,
+                                                  IndexFormat Format) {
+            // Backends only create resources while no frame is in flight
+            RenderThread::Sync();
             std::lock_guard<std::mutex> lock(threadManager);
             if (BufferCreationFunc) {
                 std::any result = BufferCreationFunc(Type, Size, Data);
                 try {
                     if (result.has_value()) {
                         BufferBase* buffer = std::any_cast<BufferBase*>(result);
+                        if (buffer && Type == BufferType::Index)
+                            buffer->SetIndexFormat(Format);
                         return buffer;
                     }
                 } catch (const std::exception& e) {
@@ -25,6 +31,7 @@ namespace Sleak {
         }
 
         Shader* ResourceManager::CreateShader(const std::string& ShaderPath) {
+            RenderThread::Sync();
             std::lock_guard<std::mutex> lock(threadManager);
             if (ShaderCreateFunc) {
                 std::any result = ShaderCreateFunc(ShaderPath);
@@ -43,6 +50,7 @@ namespace Sleak {
         }
 
         Sleak::Texture* ResourceManager::CreateTexture(const std::string& TexturePath) {
+            RenderThread::Sync();
             std::lock_guard<std::mutex> lock(threadManager);
             if (TextureCreateFunc) {
                 std::any result = TextureCreateFunc(TexturePath);
@@ -62,6 +70,7 @@ namespace Sleak {
         }
 
         Sleak::Texture* ResourceManager::CreateTextureFromMemory(const void* data, uint32_t width, uint32_t height, TextureFormat format) {
+            RenderThread::Sync();
             std::lock_guard<std::mutex> lock(threadManager);
             if (TextureFromMemoryCreateFunc) {
                 std::any result = TextureFromMemoryCreateFunc(data, width, height, format);
@@ -81,6 +90,7 @@ namespace Sleak {
         }
 
         Sleak::Texture* ResourceManager::CreateCubemapTexture(const std::array<std::string, 6>& FacePaths) {
+            RenderThread::Sync();
             std::lock_guard<std::mutex> lock(threadManager);
             if (CubemapTextureCreateFunc) {
                 std::any result = CubemapTextureCreateFunc(FacePaths);
@@ -100,6 +110,7 @@ namespace Sleak {
         }
 
         Sleak::Texture* ResourceManager::CreateCubemapTextureFromPanorama(const std::string& PanoramaPath) {
+            RenderThread::Sync();
             std::lock_guard<std::mutex> lock(threadManager);
             if (CubemapPanoramaCreateFunc) {
                 std::any result = CubemapPanoramaCreateFunc(PanoramaPath);
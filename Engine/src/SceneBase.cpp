@@ -1,10 +1,13 @@
 #include "../../include/public/Core/SceneBase.hpp"
+#include "../../include/private/Graphics/RenderThread.hpp"
 #include <Core/GameObject.hpp>
 #include <Logger.hpp>
 #include <Camera/Camera.hpp>
 #include <ECS/Components/FreeLookCameraController.hpp>
 #include <ECS/Components/FirstPersonController.hpp>
 #include <ECS/Components/TransformComponent.hpp>
+#include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/OccluderComponent.hpp>
 #include <Lighting/Light.hpp>
 #include <Lighting/LightManager.hpp>
 #include <Runtime/Skybox.hpp>
@@ -12,6 +15,10 @@
 #include <Physics/ColliderComponent.hpp>
 #include <Physics/RigidbodyComponent.hpp>
 #include <Debug/DebugLineRenderer.hpp>
+#include <ECS/Components/AnimatorComponent.hpp>
+#include <Core/JobSystem.hpp>
+#include <algorithm>
+#include <unordered_set>
 
 namespace Sleak {
 
@@ -28,18 +35,24 @@ static void RegisterCollidersRecursive(GameObject* obj, Physics::PhysicsWorld* w
     }
 }
 
-static void UnregisterCollidersRecursive(GameObject* obj, Physics::PhysicsWorld* world) {
-    if (!obj || !world) return;
+static void CollectCollidersRecursive(GameObject* obj, std::vector<ColliderComponent*>& out) {
+    if (!obj) return;
     auto* collider = obj->GetComponent<ColliderComponent>();
     if (collider) {
-        world->UnregisterCollider(collider);
+        out.push_back(collider);
     }
     for (size_t i = 0; i < obj->GetChildren().GetSize(); ++i) {
-        UnregisterCollidersRecursive(obj->GetChildren()[i], world);
+        CollectCollidersRecursive(obj->GetChildren()[i], out);
     }
 }
 
-// --- Destructor ---
+// --- Construction ---
+
+SceneBase::SceneBase(const std::string& name)
+    : name(name), state(SceneState::Unloaded),
+      bInitialized(false), bActive(false) {
+    RegisterDefaultSystems();
+}
 
 SceneBase::~SceneBase() {
     DestroyAllObjects();
@@ -69,6 +82,7 @@ void SceneBase::Unload() {
     OnUnload();
 
     DestroyAllObjects();
+    m_staticBatcher.Clear();
     bInitialized = false;
     state = SceneState::Unloaded;
 }
@@ -84,6 +98,10 @@ void SceneBase::Activate() {
     OnActivate();
 
     Begin();
+
+    // Objects are active now; the batches stay for later activations
+    if (!m_staticBatcher.IsBuilt())
+        m_staticBatcher.Build(Objects);
 }
 
 void SceneBase::Deactivate() {
@@ -151,111 +169,299 @@ void SceneBase::Begin() {
 void SceneBase::Update(float deltaTime) {
     if (!bActive) return;
 
-    // Update lighting constant buffer before rendering
-    if (m_lightManager)
-        m_lightManager->UpdateAndBind();
+    PrepareAnimationSystems();
 
-    // Only update root objects — children update recursively
-    for (size_t i = 0; i < Objects.GetSize(); ++i) {
-        if (Objects[i] && Objects[i]->IsActive() && !Objects[i]->HasParent()) {
-            Objects[i]->Update(deltaTime);
-        }
-    }
+    m_inUpdate = true;
+    m_scheduler.Run(SystemPhase::Update, deltaTime);
+    m_inUpdate = false;
 
-    // Render skybox after scene objects (depth testing ensures it appears behind)
-    if (m_skybox)
-        m_skybox->Render();
+    // Apply the adds and deferred destruction recorded this frame
+    FlushPendingAdds();
+    ProcessPendingDestroy();
+}
 
-    if (DebugCamera)
-        DebugCamera->Update(deltaTime);
+void SceneBase::FixedUpdate(float fixedDeltaTime) {
+    if (!bActive) return;
 
-    // Resolve collisions after all movement is done
-    if (m_physicsWorld)
-        m_physicsWorld->Step(deltaTime);
-
-    // Debug line rendering for colliders
-    if (DebugLineRenderer::IsEnabled()) {
-        auto drawColliderShape = [](ColliderComponent* collider, const Math::Vector3D& worldPos, const Math::Vector3D& worldScale) {
-            const auto& shape = collider->GetShape();
-
-            if (auto* aabb = std::get_if<Physics::AABB>(&shape)) {
-                Physics::AABB worldAABB(
-                    aabb->min * worldScale + worldPos,
-                    aabb->max * worldScale + worldPos);
-                DebugLineRenderer::DrawAABB(worldAABB, 0.0f, 1.0f, 0.0f);
-            } else if (auto* sphere = std::get_if<Physics::BoundingSphere>(&shape)) {
-                Math::Vector3D center = sphere->center * worldScale + worldPos;
-                float maxScale = std::max({worldScale.GetX(), worldScale.GetY(), worldScale.GetZ()});
-                DebugLineRenderer::DrawSphere(center, sphere->radius * maxScale, 0.0f, 1.0f, 0.0f);
-            } else if (auto* capsule = std::get_if<Physics::BoundingCapsule>(&shape)) {
-                Physics::BoundingCapsule worldCapsule = *capsule;
-                worldCapsule.center = capsule->center * worldScale + worldPos;
-                float maxScale = std::max({worldScale.GetX(), worldScale.GetY(), worldScale.GetZ()});
-                worldCapsule.radius = capsule->radius * maxScale;
-                worldCapsule.halfHeight = capsule->halfHeight * maxScale;
-                DebugLineRenderer::DrawCapsule(worldCapsule, 0.0f, 1.0f, 0.0f);
+    m_inUpdate = true;
+    m_scheduler.Run(SystemPhase::FixedUpdate, fixedDeltaTime);
+    m_inUpdate = false;
+
+    FlushPendingAdds();
+}
+
+void SceneBase::LateUpdate(float deltaTime) {
+    if (!bActive) return;
+
+    m_inUpdate = true;
+    m_scheduler.Run(SystemPhase::LateUpdate, deltaTime);
+    m_inUpdate = false;
+
+    FlushPendingAdds();
+}
+
+// --- Systems ---
+
+// Same walk as GameObject::Update, so exactly the animators it would reach
+static void CollectAnimators(GameObject* obj, std::vector<AnimatorComponent*>& out) {
+    if (!obj->IsActive() || obj->IsPendingDestroy()) return;
+
+    if (auto* animator = obj->GetComponent<AnimatorComponent>())
+        out.push_back(animator);
+
+    const auto& children = obj->GetChildren();
+    for (size_t i = 0; i < children.GetSize(); ++i) {
+        if (children[i] && children[i]->IsActive())
+            CollectAnimators(children[i], out);
+    }
+}
+
+void SceneBase::RegisterDefaultSystems() {
+    // Registration order is the serial order. Systems that touch disjoint
+    // components and resources may overlap (see SystemScheduler).
+
+    // World matrices first: everything after reads them
+    m_scheduler.AddSystem({"TransformHierarchy", SystemPhase::Update,
+        SystemAccess().Write<TransformComponent>(),
+        [this](float) {
+            m_transformHierarchy.Update(Objects);
+        }});
+
+    // Before any object submits: culled ones skip their render commands.
+    // Writes the objects' culled flags, hence the Scene resource.
+    m_scheduler.AddSystem({"Culling", SystemPhase::Update,
+        SystemAccess()
+            .Read<TransformComponent>()
+            .Read<MeshComponent>()
+            .Read<OccluderComponent>()
+            .Use(SystemResource::Camera | SystemResource::Scene),
+        [this](float) {
+            // Keeps what the shadow map sees as casters
+            ViewFrustum shadowFrustum;
+            Math::Matrix4 shadowViewProjection;
+            const bool shadows = m_lightManager &&
+                                 m_lightManager->GetShadowViewProjection(shadowViewProjection);
+            if (shadows) shadowFrustum.ExtractFromVP(shadowViewProjection);
+
+            m_culling.Update(m_transformHierarchy, Camera::GetMainViewFrustum(),
+                             Camera::GetMainViewMatrix() * Camera::GetMainProjectionMatrix(),
+                             shadows ? &shadowFrustum : nullptr);
+        }});
+
+    m_scheduler.AddSystem({"Lighting", SystemPhase::Update,
+        SystemAccess()
+            .Use(SystemResource::GPU | SystemResource::RenderQueue |
+                 SystemResource::Camera | SystemResource::Scene)
+            .OnMainThread(),
+        [this](float) {
+            // Update lighting constant buffer before rendering
+            if (m_lightManager)
+                m_lightManager->UpdateAndBind();
+        }});
+
+    m_scheduler.AddSystem({"Animation", SystemPhase::Update,
+        SystemAccess().Write<AnimatorComponent>(),
+        [this](float deltaTime) {
+            JobSystem::ParallelFor(static_cast<uint32_t>(m_animators.size()), 4,
+                [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t i = begin; i < end; ++i)
+                        m_animators[i]->Evaluate(deltaTime);
+                });
+        }});
+
+    // Only update root objects — children update recursively
+    auto objectAccess = [this]() {
+        ComponentMask types = ComponentStorage::Get().GetLiveComponentMask() &
+                              ~m_scheduler.GetSystemUpdatedComponents();
+        SystemAccess access = SystemScheduler::GetAccessForComponents(types);
+        access.Use(SystemResource::Scene | SystemResource::Camera).OnMainThread();
+        return access;
+    };
+
+    m_scheduler.AddSystem({"ObjectUpdate", SystemPhase::Update, {},
+        [this](float deltaTime) {
+            for (size_t i = 0; i < Objects.GetSize(); ++i) {
+                if (Objects[i] && Objects[i]->IsActive() && !Objects[i]->HasParent())
+                    Objects[i]->Update(deltaTime);
             }
-        };
+        }, objectAccess});
+
+    // Reads the culling pass's occlusion buffer, hence the Scene resource
+    m_scheduler.AddSystem({"StaticBatches", SystemPhase::Update,
+        SystemAccess()
+            .Use(SystemResource::RenderQueue | SystemResource::Camera | SystemResource::Scene)
+            .OnMainThread(),
+        [this](float) {
+            m_staticBatcher.Submit(Camera::GetMainViewFrustum(), m_culling);
+        }});
+
+    m_scheduler.AddSystem({"AnimationUpload", SystemPhase::Update,
+        SystemAccess().Read<AnimatorComponent>().Use(SystemResource::GPU).OnMainThread(),
+        [this](float) {
+            for (auto* animator : m_animators)
+                animator->UploadBones();
+        }});
 
-        for (size_t i = 0; i < Objects.GetSize(); ++i) {
-            if (!Objects[i]) continue;
-            auto* collider = Objects[i]->GetComponent<ColliderComponent>();
-            if (!collider) continue;
+    // Render skybox after scene objects (depth testing ensures it appears behind)
+    m_scheduler.AddSystem({"Skybox", SystemPhase::Update,
+        SystemAccess().Use(SystemResource::RenderQueue).OnMainThread(),
+        [this](float) {
+            if (m_skybox)
+                m_skybox->Render();
+        }});
+
+    m_scheduler.AddSystem({"DebugCamera", SystemPhase::Update, {},
+        [this](float deltaTime) {
+            if (DebugCamera)
+                DebugCamera->Update(deltaTime);
+        },
+        [this]() {
+            SystemAccess access;
+            if (DebugCamera.IsValid())
+                access = SystemScheduler::GetAccessForComponents(DebugCamera->GetComponentMask());
+            access.Use(SystemResource::Camera | SystemResource::RenderQueue).OnMainThread();
+            return access;
+        }});
 
-            Math::Vector3D pos(0, 0, 0), scale(1, 1, 1);
-            auto* transform = Objects[i]->GetComponent<TransformComponent>();
-            if (transform) {
-                pos = transform->GetWorldPosition() + collider->GetOffset();
-                scale = transform->GetWorldScale();
-            } else if (auto* cam = dynamic_cast<Camera*>(Objects[i])) {
-                pos = cam->GetPosition() + collider->GetOffset();
+    // Resolve collisions after all movement is done
+    m_scheduler.AddSystem({"Physics", SystemPhase::Update,
+        SystemAccess()
+            .Read<ColliderComponent>()
+            .Write<TransformComponent>()
+            .Write<RigidbodyComponent>()
+            .Use(SystemResource::Physics | SystemResource::Camera),
+        [this](float deltaTime) {
+            if (m_physicsWorld)
+                m_physicsWorld->Step(deltaTime);
+        }});
+
+    m_scheduler.AddSystem({"DebugColliders", SystemPhase::Update,
+        SystemAccess()
+            .Read<ColliderComponent>()
+            .Read<TransformComponent>()
+            .Use(SystemResource::RenderQueue | SystemResource::Camera)
+            .OnMainThread(),
+        [this](float) {
+            if (DebugLineRenderer::IsEnabled())
+                DrawDebugColliders();
+        }});
+
+    m_scheduler.AddSystem({"ObjectFixedUpdate", SystemPhase::FixedUpdate, {},
+        [this](float fixedDeltaTime) {
+            for (size_t i = 0; i < Objects.GetSize(); ++i) {
+                if (Objects[i] && Objects[i]->IsActive() && !Objects[i]->HasParent())
+                    Objects[i]->FixedUpdate(fixedDeltaTime);
             }
-            drawColliderShape(collider, pos, scale);
-        }
+        }, objectAccess});
 
-        // Also draw debug camera collider
-        if (DebugCamera.IsValid()) {
-            auto* collider = DebugCamera->GetComponent<ColliderComponent>();
-            if (collider) {
-                Math::Vector3D pos = DebugCamera->GetPosition() + collider->GetOffset();
-                drawColliderShape(collider, pos, Math::Vector3D(1, 1, 1));
+    m_scheduler.AddSystem({"ObjectLateUpdate", SystemPhase::LateUpdate, {},
+        [this](float deltaTime) {
+            for (size_t i = 0; i < Objects.GetSize(); ++i) {
+                if (Objects[i] && Objects[i]->IsActive() && !Objects[i]->HasParent())
+                    Objects[i]->LateUpdate(deltaTime);
             }
-        }
+        }, objectAccess});
+}
 
-        DebugLineRenderer::Flush(DebugCamera.IsValid() ? DebugCamera.get() : nullptr);
-    }
+void SceneBase::PrepareAnimationSystems() {
+    m_animators.clear();
 
-    // Process deferred destruction at end of frame
-    ProcessPendingDestroy();
-}
+    // Animators leave the per-object pass only when nothing else updated
+    // there touches them; otherwise they keep their original interleaving
+    ComponentTypeID animatorType = ComponentTypeRegistry::Get<AnimatorComponent>();
+    ComponentMask others = ComponentStorage::Get().GetLiveComponentMask() &
+                           ~ComponentTypeRegistry::MaskOf(animatorType);
+    SystemAccess access = SystemScheduler::GetAccessForComponents(others);
 
-void SceneBase::FixedUpdate(float fixedDeltaTime) {
-    if (!bActive) return;
+    if ((access.reads | access.writes) & ComponentTypeRegistry::MaskOf(animatorType)) {
+        m_scheduler.ClearUpdatedBySystem<AnimatorComponent>();
+        return;
+    }
 
+    m_scheduler.SetUpdatedBySystem<AnimatorComponent>();
     for (size_t i = 0; i < Objects.GetSize(); ++i) {
-        if (Objects[i] && Objects[i]->IsActive() && !Objects[i]->HasParent()) {
-            Objects[i]->FixedUpdate(fixedDeltaTime);
-        }
+        if (Objects[i] && Objects[i]->IsActive() && !Objects[i]->HasParent())
+            CollectAnimators(Objects[i], m_animators);
     }
 }
 
-void SceneBase::LateUpdate(float deltaTime) {
-    if (!bActive) return;
+void SceneBase::DrawDebugColliders() {
+    auto drawColliderShape = [](ColliderComponent* collider, const Math::Vector3D& worldPos, const Math::Vector3D& worldScale) {
+        const auto& shape = collider->GetShape();
+
+        if (auto* aabb = std::get_if<Physics::AABB>(&shape)) {
+            Physics::AABB worldAABB(
+                aabb->min * worldScale + worldPos,
+                aabb->max * worldScale + worldPos);
+            DebugLineRenderer::DrawAABB(worldAABB, 0.0f, 1.0f, 0.0f);
+        } else if (auto* sphere = std::get_if<Physics::BoundingSphere>(&shape)) {
+            Math::Vector3D center = sphere->center * worldScale + worldPos;
+            float maxScale = std::max({worldScale.GetX(), worldScale.GetY(), worldScale.GetZ()});
+            DebugLineRenderer::DrawSphere(center, sphere->radius * maxScale, 0.0f, 1.0f, 0.0f);
+        } else if (auto* capsule = std::get_if<Physics::BoundingCapsule>(&shape)) {
+            Physics::BoundingCapsule worldCapsule = *capsule;
+            worldCapsule.center = capsule->center * worldScale + worldPos;
+            float maxScale = std::max({worldScale.GetX(), worldScale.GetY(), worldScale.GetZ()});
+            worldCapsule.radius = capsule->radius * maxScale;
+            worldCapsule.halfHeight = capsule->halfHeight * maxScale;
+            DebugLineRenderer::DrawCapsule(worldCapsule, 0.0f, 1.0f, 0.0f);
+        }
+    };
 
-    for (size_t i = 0; i < Objects.GetSize(); ++i) {
-        if (Objects[i] && Objects[i]->IsActive() && !Objects[i]->HasParent()) {
-            Objects[i]->LateUpdate(deltaTime);
+    // Linear pass over the collider archetype columns instead of a
+    // per-object component search
+    ComponentStorage::Get().ForEach<ColliderComponent>(
+        [&](GameObject* object, ColliderComponent* collider) {
+            if (object->GetScene() != this) return;
+
+            Math::Vector3D pos(0, 0, 0), scale(1, 1, 1);
+            auto* transform = object->GetComponent<TransformComponent>();
+            if (transform) {
+                pos = transform->GetWorldPosition() + collider->GetOffset();
+                scale = transform->GetWorldScale();
+            } else if (auto* cam = dynamic_cast<Camera*>(object)) {
+                pos = cam->GetPosition() + collider->GetOffset();
+            }
+            drawColliderShape(collider, pos, scale);
+        });
+
+    // Also draw debug camera collider
+    if (DebugCamera.IsValid()) {
+        auto* collider = DebugCamera->GetComponent<ColliderComponent>();
+        if (collider) {
+            Math::Vector3D pos = DebugCamera->GetPosition() + collider->GetOffset();
+            drawColliderShape(collider, pos, Math::Vector3D(1, 1, 1));
         }
     }
+
+    DebugLineRenderer::Flush(DebugCamera.IsValid() ? DebugCamera.get() : nullptr);
 }
 
 // --- Object management ---
 
 void SceneBase::AddObject(GameObject* object) {
     if (!object) return;
-    if (Objects.indexOf(object) != -1) return; // already in scene
+    if (IsIndexed(object)) return; // already in scene
+
+    // Mid-update adds are recorded and applied in one batch afterwards
+    if (m_inUpdate) {
+        if (!object->m_pendingAdd) {
+            object->m_pendingAdd = true;
+            object->SetSceneRecursive(this);
+            m_pendingAdd.add(object);
+        }
+        return;
+    }
+
+    InsertObject(object);
+}
 
+void SceneBase::InsertObject(GameObject* object) {
+    object->m_sceneSlot = static_cast<uint32_t>(Objects.GetSize());
     Objects.add(object);
+    object->SetSceneRecursive(this);
+    IndexObject(object);
+    m_transformHierarchy.Invalidate();
 
     // Auto-register lights with the LightManager
     if (m_lightManager && object->IsLight()) {
@@ -277,18 +483,41 @@ void SceneBase::AddObject(GameObject* object) {
 
 void SceneBase::RemoveObject(GameObject* object) {
     if (!object) return;
-    int index = Objects.indexOf(object);
-    if (index != -1) {
-        if (m_lightManager && object->IsLight()) {
-            m_lightManager->UnregisterLight(
-                static_cast<Light*>(object));
-        }
-        if (m_physicsWorld) {
-            UnregisterCollidersRecursive(object, m_physicsWorld);
+
+    // Never delete under a running update; the batch pass does it
+    if (m_inUpdate) {
+        if (!object->IsPendingDestroy() &&
+            (IsIndexed(object) || object->m_pendingAdd)) {
+            object->MarkForDestroy();
+            m_pendingDestroy.add(object);
         }
-        Objects.erase(index);
-        delete object;
+        return;
+    }
+
+    if (!IsIndexed(object)) return;
+
+    if (m_lightManager && object->IsLight()) {
+        m_lightManager->UnregisterLight(
+            static_cast<Light*>(object));
     }
+    if (m_physicsWorld) {
+        std::vector<ColliderComponent*> colliders;
+        CollectCollidersRecursive(object, colliders);
+        m_physicsWorld->UnregisterColliders(colliders);
+    }
+    UnindexObject(object);
+    SwapRemoveObject(object);
+    delete object;
+}
+
+void SceneBase::SwapRemoveObject(GameObject* object) {
+    // O(1): the last object takes the freed slot
+    uint32_t slot = object->m_sceneSlot;
+    GameObject* last = Objects[Objects.GetSize() - 1];
+    Objects[slot] = last;
+    last->m_sceneSlot = slot;
+    Objects.erase(Objects.GetSize() - 1);
+    m_transformHierarchy.Invalidate();
 }
 
 void SceneBase::DestroyObject(GameObject* object) {
@@ -310,72 +539,184 @@ void SceneBase::DestroyObject(GameObject* object) {
 // --- Object queries ---
 
 GameObject* SceneBase::FindObjectByName(const std::string& objectName) {
-    for (size_t i = 0; i < Objects.GetSize(); ++i) {
-        if (Objects[i] && Objects[i]->GetName() == objectName) {
-            return Objects[i];
-        }
-    }
-    return nullptr;
+    auto it = m_nameIndex.find(objectName);
+    return it != m_nameIndex.end() ? it->second.front() : nullptr;
 }
 
 GameObject* SceneBase::FindObjectByID(uint64_t id) {
-    for (size_t i = 0; i < Objects.GetSize(); ++i) {
-        if (Objects[i] && Objects[i]->GetUniqueID() == id) {
-            return Objects[i];
-        }
-    }
-    return nullptr;
+    auto it = m_idIndex.find(id);
+    return it != m_idIndex.end() ? it->second : nullptr;
 }
 
 List<GameObject*> SceneBase::FindObjectsByTag(const std::string& tag) {
     List<GameObject*> result;
-    for (size_t i = 0; i < Objects.GetSize(); ++i) {
-        if (Objects[i] && Objects[i]->GetTag() == tag) {
-            result.add(Objects[i]);
-        }
-    }
+    for (GameObject* object : GetObjectsWithTag(tag))
+        result.add(object);
+
+    // Same order as Objects, like the old linear scan
+    result.sort([](GameObject* const& a, GameObject* const& b) {
+        return a->m_sceneOrder < b->m_sceneOrder;
+    });
     return result;
 }
 
+std::span<GameObject* const> SceneBase::GetObjectsWithTag(std::string_view tag) const {
+    auto it = m_tagIndex.find(tag);
+    if (it == m_tagIndex.end()) return {};
+    return {it->second.data(), it->second.size()};
+}
+
+// --- Object indices ---
+
+bool SceneBase::IsIndexed(const GameObject* object) const {
+    auto it = m_idIndex.find(object->GetUniqueID());
+    return it != m_idIndex.end() && it->second == object;
+}
+
+void SceneBase::IndexObject(GameObject* object) {
+    object->m_sceneOrder = m_nextSceneOrder++;
+    m_idIndex[object->GetUniqueID()] = object;
+
+    // New objects always have the highest order: append
+    m_nameIndex[object->GetName()].push_back(object);
+
+    auto& tagged = m_tagIndex[object->GetTag()];
+    object->m_tagSlot = static_cast<uint32_t>(tagged.size());
+    tagged.push_back(object);
+}
+
+void SceneBase::UnindexObject(GameObject* object) {
+    m_idIndex.erase(object->GetUniqueID());
+
+    auto name = m_nameIndex.find(object->GetName());
+    if (name != m_nameIndex.end()) {
+        auto& bucket = name->second;
+        bucket.erase(std::find(bucket.begin(), bucket.end(), object));
+        if (bucket.empty()) m_nameIndex.erase(name);
+    }
+
+    auto tag = m_tagIndex.find(object->GetTag());
+    if (tag != m_tagIndex.end()) {
+        auto& tagged = tag->second;
+        GameObject* last = tagged.back();
+        tagged[object->m_tagSlot] = last;
+        last->m_tagSlot = object->m_tagSlot;
+        tagged.pop_back();
+        if (tagged.empty()) m_tagIndex.erase(tag);
+    }
+}
+
+void SceneBase::OnObjectRenamed(GameObject* object, const std::string& oldName) {
+    if (!object || !IsIndexed(object)) return;
+
+    auto old = m_nameIndex.find(oldName);
+    if (old != m_nameIndex.end()) {
+        auto& bucket = old->second;
+        bucket.erase(std::find(bucket.begin(), bucket.end(), object));
+        if (bucket.empty()) m_nameIndex.erase(old);
+    }
+
+    // Keep the bucket in insertion order so the first entry is what a scan
+    // over Objects would have found
+    auto& bucket = m_nameIndex[object->GetName()];
+    auto pos = std::upper_bound(bucket.begin(), bucket.end(), object,
+        [](const GameObject* a, const GameObject* b) {
+            return a->m_sceneOrder < b->m_sceneOrder;
+        });
+    bucket.insert(pos, object);
+}
+
+void SceneBase::OnObjectRetagged(GameObject* object, const std::string& oldTag) {
+    if (!object || !IsIndexed(object)) return;
+
+    auto old = m_tagIndex.find(oldTag);
+    if (old != m_tagIndex.end()) {
+        auto& tagged = old->second;
+        GameObject* last = tagged.back();
+        tagged[object->m_tagSlot] = last;
+        last->m_tagSlot = object->m_tagSlot;
+        tagged.pop_back();
+        if (tagged.empty()) m_tagIndex.erase(old);
+    }
+
+    auto& tagged = m_tagIndex[object->GetTag()];
+    object->m_tagSlot = static_cast<uint32_t>(tagged.size());
+    tagged.push_back(object);
+}
+
 // --- Internal ---
 
+void SceneBase::FlushPendingAdds() {
+    if (m_pendingAdd.empty()) return;
+
+    // Swap out first: initializing an object may add more
+    List<GameObject*> adds = std::move(m_pendingAdd);
+
+    for (size_t i = 0; i < adds.GetSize(); ++i) {
+        adds[i]->m_pendingAdd = false;
+
+        // Destroyed before it ever joined; ProcessPendingDestroy deletes it
+        if (adds[i]->IsPendingDestroy()) continue;
+        InsertObject(adds[i]);
+    }
+}
+
 void SceneBase::ProcessPendingDestroy() {
     if (m_pendingDestroy.empty()) return;
 
+    // Batch the light and collider unregistration
+    List<Light*> lights;
+    std::vector<ColliderComponent*> colliders;
     for (size_t i = 0; i < m_pendingDestroy.GetSize(); ++i) {
         GameObject* obj = m_pendingDestroy[i];
         if (!obj) continue;
 
-        // Unregister lights
-        if (m_lightManager && obj->IsLight()) {
-            m_lightManager->UnregisterLight(
-                static_cast<Light*>(obj));
-        }
+        if (obj->IsLight())
+            lights.add(static_cast<Light*>(obj));
+        CollectCollidersRecursive(obj, colliders);
+    }
 
-        // Unregister colliders
-        if (m_physicsWorld) {
-            UnregisterCollidersRecursive(obj, m_physicsWorld);
-        }
+    if (m_lightManager)
+        m_lightManager->UnregisterLights(lights);
+    if (m_physicsWorld)
+        m_physicsWorld->UnregisterColliders(colliders);
 
-        // Remove from the main objects list
-        int index = Objects.indexOf(obj);
-        if (index != -1) {
-            Objects.erase(index);
+    for (size_t i = 0; i < m_pendingDestroy.GetSize(); ++i) {
+        GameObject* obj = m_pendingDestroy[i];
+        if (obj && IsIndexed(obj)) {
+            UnindexObject(obj);
+            SwapRemoveObject(obj);
         }
-
-        delete obj;
     }
+
+    // The frame in flight may still bind their materials and buffers
+    RenderEngine::RenderThread::Sync();
+    for (size_t i = 0; i < m_pendingDestroy.GetSize(); ++i)
+        delete m_pendingDestroy[i];
     m_pendingDestroy.clear();
 }
 
 void SceneBase::DestroyAllObjects() {
+    RenderEngine::RenderThread::Sync();
+
     // Clear pending list first (those are also in Objects)
     m_pendingDestroy.clear();
 
+    // Recorded adds are owned by the scene too
+    for (size_t i = 0; i < m_pendingAdd.GetSize(); ++i) {
+        delete m_pendingAdd[i];
+    }
+    m_pendingAdd.clear();
+
     for (size_t i = 0; i < Objects.GetSize(); ++i) {
         delete Objects[i];
     }
     Objects.clear();
+
+    m_idIndex.clear();
+    m_nameIndex.clear();
+    m_tagIndex.clear();
+    m_transformHierarchy.Invalidate();
 }
 
 void SceneBase::SetSkybox(Skybox* skybox) {
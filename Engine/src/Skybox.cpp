@@ -68,7 +68,8 @@ void Skybox::Initialize() {
     m_indexBuffer = RefPtr(RenderEngine::ResourceManager::CreateBuffer(
         RenderEngine::BufferType::Index,
         cube.indices.GetByteSize(),
-        cube.indices.GetRawData()));
+        cube.indices.GetRawData(),
+        cube.indices.GetFormat()));
 
     // Constant buffer for ViewProjection matrix
     SkyboxCBData cbData;
@@ -132,10 +133,9 @@ void Skybox::Render() {
     Math::Matrix4 proj = Camera::GetMainProjectionMatrix();
     Math::Matrix4 viewProj = view * proj;
 
-    // Update constant buffer data
+    // Constant buffer data, uploaded when the command executes
     SkyboxCBData cbData;
     cbData.ViewProjection = viewProj;
-    m_constantBuffer->Update(&cbData, sizeof(SkyboxCBData));
 
     // Capture resources for the lambda
     auto shader = m_shader;
@@ -145,7 +145,9 @@ void Skybox::Render() {
     auto cubemap = m_cubemapTexture;
 
     RenderEngine::RenderCommandQueue::GetInstance()->SubmitCustomCommand(
-        [shader, vb, ib, cb, cubemap](RenderEngine::RenderContext* ctx) {
+        [shader, vb, ib, cb, cubemap, cbData](RenderEngine::RenderContext* ctx) mutable {
+            cb->Update(&cbData, sizeof(SkyboxCBData));
+
             // Switch to skybox pipeline/state (handles Vulkan pipeline swap)
             ctx->BeginSkyboxPass();
 
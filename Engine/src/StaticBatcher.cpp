@@ -0,0 +1,277 @@
+#include "../../include/private/Graphics/ResourceManager.hpp"
+#include "../../include/private/Graphics/BufferBase.hpp"
+#include "../../include/private/Graphics/ConstantBuffer.hpp"
+#include "../../include/private/Graphics/RenderCommandQueue.hpp"
+#include <ECS/StaticBatcher.hpp>
+#include <ECS/CullingSystem.hpp>
+#include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/MaterialComponent.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <ECS/Components/OccluderComponent.hpp>
+#include <Runtime/Material.hpp>
+#include <Runtime/MeshData.hpp>
+#include <Camera/Camera.hpp>
+#include <Camera/ViewFrustum.hpp>
+#include <Core/GameObject.hpp>
+#include <Logger.hpp>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace Sleak {
+
+    namespace {
+        struct Candidate {
+            GameObject* object;
+            MeshComponent* mesh;
+            Material* material;
+            Math::Matrix4 world;
+            int cell[3];
+        };
+
+        void CollectCandidates(GameObject* object, std::vector<Candidate>& out) {
+            if (!object || !object->IsActive() || object->IsPendingDestroy()) return;
+
+            auto* mesh = object->GetComponent<MeshComponent>();
+            auto* transform = object->GetComponent<TransformComponent>();
+            auto* material = object->GetComponent<MaterialComponent>();
+
+            const MeshData* data = mesh ? mesh->GetMeshData() : nullptr;
+            if (object->IsStatic() && data && transform && material && material->GetMaterial() &&
+                mesh->IsCullable() && !mesh->IsBatched() &&
+                data->vertices.GetSize() > 0 && data->indices.GetSize() > 0 &&
+                data->vertices.GetSize() <= StaticBatcher::MAX_BATCH_VERTICES) {
+                Candidate candidate;
+                candidate.object = object;
+                candidate.mesh = mesh;
+                candidate.material = material->GetMaterial().get();
+                candidate.world = transform->GetWorldMatrix();
+
+                const Math::Vector3D position = transform->GetWorldPosition();
+                candidate.cell[0] = static_cast<int>(std::floor(position.GetX() / StaticBatcher::CELL_SIZE));
+                candidate.cell[1] = static_cast<int>(std::floor(position.GetY() / StaticBatcher::CELL_SIZE));
+                candidate.cell[2] = static_cast<int>(std::floor(position.GetZ() / StaticBatcher::CELL_SIZE));
+                out.push_back(candidate);
+            }
+
+            const auto& children = object->GetChildren();
+            for (size_t i = 0; i < children.GetSize(); ++i)
+                CollectCandidates(children[i], out);
+        }
+
+        void ReleaseMeshData(GameObject* object) {
+            if (!object) return;
+
+            if (auto* mesh = object->GetComponent<MeshComponent>())
+                mesh->ReleaseMeshData();
+
+            const auto& children = object->GetChildren();
+            for (size_t i = 0; i < children.GetSize(); ++i)
+                ReleaseMeshData(children[i]);
+        }
+
+        void Normalize(float& x, float& y, float& z) {
+            const float length = std::sqrt(x * x + y * y + z * z);
+            if (length > 0.0f) {
+                x /= length;
+                y /= length;
+                z /= length;
+            }
+        }
+
+        // Appends the mesh in world space (row vectors: p' = p * world)
+        void AppendMesh(const MeshData& data, const Math::Matrix4& world,
+                        std::vector<Vertex>& vertices, IndexGroup& indices,
+                        uint32_t firstVertex) {
+            // Normals take the inverse transpose, so non-uniform scale keeps them perpendicular
+            const Math::Matrix4 normalMatrix = world.Inverse().Transpose();
+
+            const float det =
+                world(0, 0) * (world(1, 1) * world(2, 2) - world(1, 2) * world(2, 1)) -
+                world(0, 1) * (world(1, 0) * world(2, 2) - world(1, 2) * world(2, 0)) +
+                world(0, 2) * (world(1, 0) * world(2, 1) - world(1, 1) * world(2, 0));
+            const bool mirrored = det < 0.0f;
+
+            const Vertex* source = data.vertices.GetData();
+            for (size_t i = 0; i < data.vertices.GetSize(); ++i) {
+                Vertex vertex = source[i];
+
+                for (int column = 0; column < 3; ++column) {
+                    (&vertex.px)[column] = source[i].px * world(0, column) + source[i].py * world(1, column) +
+                                           source[i].pz * world(2, column) + world(3, column);
+                    (&vertex.nx)[column] = source[i].nx * normalMatrix(0, column) +
+                                           source[i].ny * normalMatrix(1, column) +
+                                           source[i].nz * normalMatrix(2, column);
+                    (&vertex.tx)[column] = source[i].tx * world(0, column) + source[i].ty * world(1, column) +
+                                           source[i].tz * world(2, column);
+                }
+                Normalize(vertex.nx, vertex.ny, vertex.nz);
+                Normalize(vertex.tx, vertex.ty, vertex.tz);
+                if (mirrored) vertex.tw = -vertex.tw;
+
+                vertices.push_back(vertex);
+            }
+
+            // A mirroring transform flips the winding: swap two corners back
+            const IndexGroup& sourceIndices = data.indices;
+            const size_t count = sourceIndices.GetSize();
+            for (size_t i = 0; i + 2 < count; i += 3) {
+                const IndexType a = sourceIndices[i] + firstVertex;
+                const IndexType b = sourceIndices[i + 1] + firstVertex;
+                const IndexType c = sourceIndices[i + 2] + firstVertex;
+                indices.add(a);
+                indices.add(mirrored ? c : b);
+                indices.add(mirrored ? b : c);
+            }
+        }
+    }
+
+    StaticBatcher::~StaticBatcher() = default;
+
+    void StaticBatcher::Build(const List<GameObject*>& objects) {
+        if (m_built) return;
+        m_built = true;
+
+        std::vector<Candidate> candidates;
+        for (size_t i = 0; i < objects.GetSize(); ++i) {
+            // Children are reached through their parent
+            if (objects[i] && !objects[i]->HasParent())
+                CollectCandidates(objects[i], candidates);
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            return std::tie(a.material, a.cell[0], a.cell[1], a.cell[2]) <
+                   std::tie(b.material, b.cell[0], b.cell[1], b.cell[2]);
+        });
+
+        std::vector<Vertex> vertices;
+        IndexGroup indices;     // Batch-local: MAX_BATCH_VERTICES keeps them 16-bit
+        bool allCompact = true;
+
+        // A batch collects consecutive candidates with the same material and cell
+        size_t first = 0;
+        while (first < candidates.size()) {
+            const Candidate& head = candidates[first];
+
+            Batch batch;
+            batch.material = head.object->GetComponent<MaterialComponent>()->GetMaterial();
+            batch.startIndex = static_cast<uint32_t>(indices.GetSize());
+            batch.baseVertex = static_cast<int32_t>(vertices.size());
+
+            size_t end = first;
+            uint32_t batchVertices = 0;
+            for (; end < candidates.size(); ++end) {
+                const Candidate& candidate = candidates[end];
+                if (candidate.material != head.material ||
+                    !std::equal(candidate.cell, candidate.cell + 3, head.cell))
+                    break;
+
+                const MeshData& data = *candidate.mesh->GetMeshData();
+                const uint32_t count = static_cast<uint32_t>(data.vertices.GetSize());
+                if (batchVertices + count > MAX_BATCH_VERTICES) break;
+
+                // Indices stay local to the batch; baseVertex offsets them
+                AppendMesh(data, candidate.world, vertices, indices, batchVertices);
+                batchVertices += count;
+                allCompact &= data.layout != VertexLayout::Standard;
+
+                batch.hasOccluder |= candidate.object->HasComponent<OccluderComponent>();
+                candidate.mesh->SetBatched(true);
+                candidate.object->SetCulled(true);
+            }
+
+            batch.indexCount = static_cast<uint32_t>(indices.GetSize()) - batch.startIndex;
+            batch.bounds = Physics::AABB::FromVertices(&vertices[batch.baseVertex].px,
+                                                       batchVertices, sizeof(Vertex));
+            m_batches.push_back(std::move(batch));
+
+            m_batchedObjects += static_cast<uint32_t>(end - first);
+            first = end;
+        }
+
+        for (size_t i = 0; i < objects.GetSize(); ++i)
+            ReleaseMeshData(objects[i]);
+
+        if (m_batches.empty()) return;
+
+        // The merged buffer stays compact when every mesh in it was
+        if (allCompact && VertexFormat::CanEncode(vertices.data(), vertices.size(), VertexLayout::StaticCompact)) {
+            auto packed = VertexFormat::EncodeVertices(vertices.data(), vertices.size(), VertexLayout::StaticCompact);
+            m_vertexBuffer = RefPtr<RenderEngine::BufferBase>(RenderEngine::ResourceManager::CreateBuffer(
+                RenderEngine::BufferType::Vertex, packed.size(), packed.data()));
+            if (m_vertexBuffer.IsValid())
+                m_vertexBuffer->SetVertexLayout(VertexLayout::StaticCompact);
+        } else {
+            m_vertexBuffer = RefPtr<RenderEngine::BufferBase>(RenderEngine::ResourceManager::CreateBuffer(
+                RenderEngine::BufferType::Vertex, vertices.size() * sizeof(Vertex), vertices.data()));
+        }
+        m_indexBuffer = RefPtr<RenderEngine::BufferBase>(RenderEngine::ResourceManager::CreateBuffer(
+            RenderEngine::BufferType::Index, indices.GetByteSize(), indices.GetRawData(),
+            indices.GetFormat()));
+
+        RenderEngine::TransformBuffer tb(Math::Matrix4::Identity(),
+                                         Camera::GetMainViewMatrix(),
+                                         Camera::GetMainProjectionMatrix());
+        for (auto& batch : m_batches) {
+            batch.transform = RefPtr<RenderEngine::BufferBase>(RenderEngine::ResourceManager::CreateBuffer(
+                RenderEngine::BufferType::Constant, tb.GetSize(), tb.GetData()));
+            batch.uploadedCameraVersion = Camera::GetMainVersion();
+        }
+
+        SLEAK_INFO("StaticBatcher: {} objects merged into {} batches ({} vertices)",
+                   m_batchedObjects, m_batches.size(), vertices.size());
+    }
+
+    void StaticBatcher::Submit(const ViewFrustum& frustum, const CullingSystem& culling) {
+        m_submitted = 0;
+        if (m_batches.empty() || !m_vertexBuffer || !m_indexBuffer) return;
+
+        auto* queue = RenderEngine::RenderCommandQueue::GetInstance();
+        const uint64_t cameraVersion = Camera::GetMainVersion();
+        const List<RefPtr<RenderEngine::BufferBase>> noBuffers;
+
+        for (auto& batch : m_batches) {
+            if (culling.IsEnabled()) {
+                if (!frustum.IsAABBVisible(batch.bounds.min, batch.bounds.max)) continue;
+                if (!batch.hasOccluder && culling.IsOccluded(batch.bounds)) continue;
+            }
+
+            // Each batch has its own buffer: sorting may draw any of them first
+            if (batch.uploadedCameraVersion != cameraVersion) {
+                RenderEngine::TransformBuffer tb(Math::Matrix4::Identity(),
+                                                 Camera::GetMainViewMatrix(),
+                                                 Camera::GetMainProjectionMatrix());
+                queue->SubmitUpdateConstantBuffer(batch.transform, tb.GetData(), tb.GetSize());
+                batch.uploadedCameraVersion = cameraVersion;
+            }
+
+            queue->SubmitBindConstantBuffer(batch.transform, 0);
+            queue->SubmitBindMaterial(batch.material.get());
+
+            auto* command = static_cast<RenderEngine::DrawIndexedCommand*>(queue->SubmitDrawIndexed(
+                m_vertexBuffer, m_indexBuffer, noBuffers, batch.indexCount, batch.startIndex, batch.baseVertex));
+            command->SetWorldMatrix(Math::Matrix4::Identity());
+
+            const Material* material = batch.material.get();
+            const float depth = (batch.bounds.GetCenter() - Camera::GetMainCameraPosition()).Magnitude();
+            command->SetSortKey(RenderEngine::RenderSortKey::Make(
+                RenderEngine::SortPass::Main, static_cast<uint8_t>(material->GetRenderMode()),
+                queue->GetSortID(RenderEngine::SortResource::Shader, material->GetShader()),
+                queue->GetSortID(RenderEngine::SortResource::Material, material),
+                queue->GetSortID(RenderEngine::SortResource::Mesh, m_vertexBuffer.get()),
+                depth));
+
+            ++m_submitted;
+        }
+    }
+
+    void StaticBatcher::Clear() {
+        m_batches.clear();
+        m_vertexBuffer = nullptr;
+        m_indexBuffer = nullptr;
+        m_batchedObjects = 0;
+        m_submitted = 0;
+        m_built = false;
+    }
+
+}
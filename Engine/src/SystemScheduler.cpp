@@ -0,0 +1,211 @@
+#include <ECS/SystemScheduler.hpp>
+#include <Core/JobSystem.hpp>
+#include <Logger.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace Sleak {
+
+    // --- Component access table ---
+
+    struct ComponentAccessTable {
+        SystemAccess access[MAX_COMPONENT_TYPES];
+        bool declared[MAX_COMPONENT_TYPES] = {};
+    };
+
+    static ComponentAccessTable& GetAccessTable() {
+        static ComponentAccessTable table;
+        static std::once_flag builtins;
+
+        // What the engine components do in their per-object updates
+        std::call_once(builtins, []() {
+            auto declare = [](ComponentTypeID type, const SystemAccess& access) {
+                table.access[type] = access;
+                table.declared[type] = true;
+            };
+
+            declare(ComponentTypeRegistry::Get<TransformComponent>(),
+                    SystemAccess().Write<TransformComponent>()
+                        .Use(SystemResource::RenderQueue | SystemResource::Camera)
+                        .OnMainThread());
+            declare(ComponentTypeRegistry::Get<MeshComponent>(),
+                    SystemAccess().Read<MeshComponent>()
+                        .Use(SystemResource::RenderQueue).OnMainThread());
+            declare(ComponentTypeRegistry::Get<MaterialComponent>(),
+                    SystemAccess().Read<MaterialComponent>()
+                        .Use(SystemResource::RenderQueue).OnMainThread());
+            declare(ComponentTypeRegistry::Get<AnimatorComponent>(),
+                    SystemAccess().Write<AnimatorComponent>()
+                        .Use(SystemResource::GPU).OnMainThread());
+            declare(ComponentTypeRegistry::Get<ColliderComponent>(),
+                    SystemAccess().Read<ColliderComponent>());
+            declare(ComponentTypeRegistry::Get<RigidbodyComponent>(),
+                    SystemAccess().Read<RigidbodyComponent>());
+
+            SystemAccess controller = SystemAccess()
+                .Write<RigidbodyComponent>()
+                .Use(SystemResource::Input | SystemResource::Camera)
+                .OnMainThread();
+            declare(ComponentTypeRegistry::Get<CameraController>(), controller);
+            declare(ComponentTypeRegistry::Get<FirstPersonController>(), controller);
+            declare(ComponentTypeRegistry::Get<FreeLookCameraController>(), controller);
+        });
+
+        return table;
+    }
+
+    void SystemScheduler::DeclareComponentAccess(ComponentTypeID type,
+                                                 const SystemAccess& access) {
+        if (type >= MAX_COMPONENT_TYPES) return;
+
+        auto& table = GetAccessTable();
+        table.access[type] = access;
+        table.declared[type] = true;
+    }
+
+    SystemAccess SystemScheduler::GetComponentAccess(ComponentTypeID type) {
+        auto& table = GetAccessTable();
+        if (type >= MAX_COMPONENT_TYPES || !table.declared[type])
+            return SystemAccess::Everything();
+        return table.access[type];
+    }
+
+    SystemAccess SystemScheduler::GetAccessForComponents(ComponentMask types) {
+        SystemAccess result;
+        for (ComponentTypeID type = 0; types; ++type, types >>= 1) {
+            if (types & 1) result |= GetComponentAccess(type);
+        }
+        return result;
+    }
+
+    // --- Systems ---
+
+    void SystemScheduler::AddSystem(System system) {
+        if (!system.run) {
+            SLEAK_WARN("SystemScheduler: system '{}' has nothing to run", system.name);
+            return;
+        }
+        m_systems.push_back(std::move(system));
+    }
+
+    void SystemScheduler::RemoveSystem(const std::string& name) {
+        m_systems.erase(std::remove_if(m_systems.begin(), m_systems.end(),
+                                       [&](const System& system) {
+                                           return system.name == name;
+                                       }),
+                        m_systems.end());
+    }
+
+    void SystemScheduler::RunSerial(const std::vector<System*>& systems, float deltaTime) {
+        for (System* system : systems)
+            system->run(deltaTime);
+    }
+
+    void SystemScheduler::Run(SystemPhase phase, float deltaTime) {
+        std::vector<System*> systems;
+        for (auto& system : m_systems) {
+            if (system.phase == phase) systems.push_back(&system);
+        }
+
+        if (systems.empty()) return;
+        if (!m_reverseOrder &&
+            (!m_parallel || systems.size() == 1 || !JobSystem::IsInitialized())) {
+            RunSerial(systems, deltaTime);
+            return;
+        }
+
+        // Build this frame's graph: an edge from every earlier system that
+        // conflicts, so conflicting pairs keep their registration order
+        struct Node {
+            SystemAccess access;
+            std::vector<uint32_t> successors;
+            std::atomic<uint32_t> remaining{0};
+        };
+
+        const uint32_t count = static_cast<uint32_t>(systems.size());
+        std::unique_ptr<Node[]> nodes(new Node[count]);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            nodes[i].access = systems[i]->resolveAccess ? systems[i]->resolveAccess()
+                                                        : systems[i]->access;
+        }
+
+        bool anyOverlap = false;
+        for (uint32_t j = 1; j < count; ++j) {
+            for (uint32_t i = 0; i < j; ++i) {
+                if (nodes[i].access.ConflictsWith(nodes[j].access)) {
+                    nodes[i].successors.push_back(j);
+                    nodes[j].remaining.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            anyOverlap |= !nodes[j - 1].access.ConflictsWith(nodes[j].access);
+        }
+
+        // Debug order, built back to front: the earliest registered system
+        // whose conflicting successors are all placed goes last
+        if (m_reverseOrder) {
+            std::vector<uint32_t> unplaced(count);
+            std::vector<std::vector<uint32_t>> predecessors(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                unplaced[i] = static_cast<uint32_t>(nodes[i].successors.size());
+                for (uint32_t next : nodes[i].successors)
+                    predecessors[next].push_back(i);
+            }
+
+            std::vector<uint32_t> ready;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (unplaced[i] == 0) ready.push_back(i);
+            }
+
+            std::vector<uint32_t> order(count);
+            for (uint32_t slot = count; slot-- > 0;) {
+                auto earliest = std::min_element(ready.begin(), ready.end());
+                order[slot] = *earliest;
+                ready.erase(earliest);
+
+                for (uint32_t previous : predecessors[order[slot]]) {
+                    if (--unplaced[previous] == 0) ready.push_back(previous);
+                }
+            }
+
+            for (uint32_t index : order)
+                systems[index]->run(deltaTime);
+            return;
+        }
+
+        // Every system waits on the previous one: skip the job overhead
+        if (!anyOverlap) {
+            RunSerial(systems, deltaTime);
+            return;
+        }
+
+        JobCounter frame;
+        std::function<void(uint32_t)> launch = [&](uint32_t index) {
+            JobAffinity affinity = nodes[index].access.mainThread ? JobAffinity::MainThread
+                                                                  : JobAffinity::Any;
+            JobSystem::Schedule([&, index]() {
+                systems[index]->run(deltaTime);
+
+                // Schedule before this job finishes so 'frame' cannot hit zero early
+                for (uint32_t next : nodes[index].successors) {
+                    if (nodes[next].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        launch(next);
+                }
+            }, &frame, affinity);
+        };
+
+        // Collect roots first: once launched, jobs drive 'remaining' to zero
+        std::vector<uint32_t> roots;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (nodes[i].remaining.load(std::memory_order_relaxed) == 0)
+                roots.push_back(i);
+        }
+        for (uint32_t root : roots)
+            launch(root);
+
+        JobSystem::Wait(&frame);
+    }
+
+}
@@ -1,4 +1,7 @@
 #include <ECS/Components/TransformComponent.hpp>
+#include <ECS/TransformHierarchy.hpp>
+#include <Core/GameObject.hpp>
+#include <Core/SceneBase.hpp>
 #include <Graphics/BufferBase.hpp>
 #include <Graphics/ConstantBuffer.hpp>
 #include <Graphics/ResourceManager.hpp>
@@ -8,6 +11,36 @@
 
 namespace Sleak {
 
+    // Same result as Scale * Rotate * Translate without the two full products
+    static Matrix4 ComposeLocalMatrix(const Vector3D& position, const Quaternion& rotation,
+                                      const Vector3D& scale) {
+        Matrix4 matrix = rotation.toRotationMatrix();
+        const float factors[3] = {scale.GetX(), scale.GetY(), scale.GetZ()};
+
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t col = 0; col < 3; ++col)
+                matrix(row, col) *= factors[row];
+        }
+
+        matrix(3, 0) = position.GetX();
+        matrix(3, 1) = position.GetY();
+        matrix(3, 2) = position.GetZ();
+        return matrix;
+    }
+
+    // Stops at children with their own transform: MarkDirty continues from there
+    static void MarkDescendantsDirty(GameObject* object) {
+        const auto& children = object->GetChildren();
+        for (size_t i = 0; i < children.GetSize(); ++i) {
+            if (!children[i]) continue;
+
+            if (auto* transform = children[i]->GetComponent<TransformComponent>())
+                transform->MarkDirty();
+            else
+                MarkDescendantsDirty(children[i]);
+        }
+    }
+
     // Constructors
     TransformComponent::TransformComponent(GameObject* object, const Vector3D& position) : Component(object), position(position) {}
 
@@ -27,16 +60,23 @@ namespace Sleak {
             {}
 
     TransformComponent::~TransformComponent() {
-        delete Transform;
-        Transform = nullptr;
+        if (!owner) return;
+
+        // Children now resolve against the next transform up
+        MarkDescendantsDirty(owner);
+        if (SceneBase* scene = owner->GetScene())
+            scene->GetTransformHierarchy().Invalidate();
     }
 
     bool TransformComponent::Initialize() {
+        if (owner) {
+            MarkDescendantsDirty(owner);
+            if (SceneBase* scene = owner->GetScene())
+                scene->GetTransformHierarchy().Invalidate();
+        }
 
-        Transform = new TransformMatrix();
         UpdateTransform();
-        auto world = GetTransformMatrix();
-        RenderEngine::TransformBuffer tb(world,
+        RenderEngine::TransformBuffer tb(m_worldMatrix,
                                          Camera::GetMainViewMatrix(),
                                          Camera::GetMainProjectionMatrix());
         ConstantBuffer = RefPtr<RenderEngine::BufferBase>(
@@ -44,10 +84,15 @@ namespace Sleak {
                 RenderEngine::BufferType::Constant,
                 tb.GetSize(), tb.GetData()));
 
+        m_uploadedWorldVersion = m_worldVersion;
+        m_uploadedCameraVersion = Camera::GetMainVersion();
         return true;
     }
 
     void TransformComponent::Update(float DeltaTime) {
+        // Uploads resume with the current matrices once it is visible again
+        if (owner->IsCulled()) return;
+
         UpdateConstantBuffer();
 
         RenderEngine::RenderCommandQueue::GetInstance()->SubmitBindConstantBuffer(ConstantBuffer, 0);
@@ -55,14 +100,27 @@ namespace Sleak {
 
     // Transformation matrix calculation
     Matrix4 TransformComponent::GetTransformMatrix() {
-        return Transform->CalculateTransformMatrix();
+        UpdateTransform();
+        return m_worldMatrix;
+    }
+
+    // Computes without caching while dirty, so concurrent readers never write
+    Matrix4 TransformComponent::GetWorldMatrix() const {
+        if (!m_dirty) return m_worldMatrix;
+
+        Matrix4 local = ComposeLocalMatrix(position, rotation, scale);
+        const TransformComponent* parent = GetParentTransform();
+        return parent ? local * parent->GetWorldMatrix() : local;
+    }
+
+    Matrix4 TransformComponent::GetLocalMatrix() const {
+        return m_dirty ? ComposeLocalMatrix(position, rotation, scale) : m_localMatrix;
     }
 
     // Transformations
     void TransformComponent::Translate(const Vector3D& translation) {
         position += translation;
-        Transform->Translation = Matrix4::Translate(position);
-        UpdateTransform();
+        MarkDirty();
     }
 
 
@@ -72,7 +130,7 @@ namespace Sleak {
 
     void TransformComponent::Rotate(const Quaternion& rotation) {
         this->rotation *= rotation;
-        UpdateTransform();
+        MarkDirty();
     }
 
     void TransformComponent::Scale(float amount) {
@@ -81,33 +139,36 @@ namespace Sleak {
 
     void TransformComponent::Scale(const Vector3D& scale) {
         this->scale = scale * this->scale;
-        UpdateTransform();
+        MarkDirty();
     }
 
     // Setters
     void TransformComponent::SetPosition(const Vector3D& position) {
         this->position = position;
+        MarkDirty();
     }
 
     void TransformComponent::SetRotation(const Quaternion& rotation) {
         this->rotation = rotation;
+        MarkDirty();
     }
 
     void TransformComponent::SetScale(const Vector3D& scale) {
         this->scale = scale;
+        MarkDirty();
     }
 
     // Direction vectors
     Vector3D TransformComponent::Forward() const {
-        return rotation * Vector3D(0.0f, 0.0f, 1.0f);
+        return GetWorldRotation() * Vector3D(0.0f, 0.0f, 1.0f);
     }
 
     Vector3D TransformComponent::Right() const {
-        return rotation * Vector3D(1.0f, 0.0f, 0.0f);
+        return GetWorldRotation() * Vector3D(1.0f, 0.0f, 0.0f);
     }
 
     Vector3D TransformComponent::Up() const {
-        return rotation * Vector3D(0.0f, 1.0f, 0.0f);
+        return GetWorldRotation() * Vector3D(0.0f, 1.0f, 0.0f);
     }
 
     // Rotation utilities
@@ -123,27 +184,74 @@ namespace Sleak {
         Vector3D direction = (target - position).Normalize();
         Vector3D Up = VECTOR_Up;
         rotation = Quaternion::LookRotation(direction, Up);
+        MarkDirty();
     }
 
     // Getters
     Vector3D TransformComponent::GetWorldPosition() const {
-        return position;
+        Matrix4 world = GetWorldMatrix();
+        return Vector3D(world(3, 0), world(3, 1), world(3, 2));
     }
 
     Quaternion TransformComponent::GetWorldRotation() const {
-        return rotation;
+        if (!m_dirty) return m_worldRotation;
+
+        const TransformComponent* parent = GetParentTransform();
+        return parent ? parent->GetWorldRotation() * rotation : rotation;
     }
 
     Vector3D TransformComponent::GetWorldScale() const {
-        return scale;
+        if (!m_dirty) return m_worldScale;
+
+        const TransformComponent* parent = GetParentTransform();
+        return parent ? parent->GetWorldScale() * scale : scale;
+    }
+
+    TransformComponent* TransformComponent::GetParentTransform() const {
+        if (!owner) return nullptr;
+
+        for (GameObject* parent = owner->GetParent(); parent; parent = parent->GetParent()) {
+            if (auto* transform = parent->GetComponent<TransformComponent>())
+                return transform;
+        }
+        return nullptr;
+    }
+
+    void TransformComponent::MarkDirty() {
+        // A dirty transform always has dirty descendants: nothing to add
+        if (m_dirty) return;
+        m_dirty = true;
+
+        if (!owner) return;
+        if (SceneBase* scene = owner->GetScene()) {
+            scene->GetTransformHierarchy().MarkChanged();
+            scene->GetTransformHierarchy().RecordMoved(owner->GetHandle());
+        }
+
+        MarkDescendantsDirty(owner);
     }
 
     void TransformComponent::UpdateTransform() {
-        Transform->Translation = Matrix4::Translate(position);
-        Transform->Rotation = Matrix4::Rotate(rotation);
-        Transform->Scaling = Matrix4::Scale(scale);
+        if (!m_dirty) return;
+
+        // Normally already done by the hierarchy pass; covers objects
+        // outside a scene and changes made after the pass this frame
+        TransformComponent* parent = GetParentTransform();
+        if (parent) parent->UpdateTransform();
+
+        m_localMatrix = ComposeLocalMatrix(position, rotation, scale);
+        if (parent) {
+            m_worldMatrix = m_localMatrix * parent->m_worldMatrix;
+            m_worldRotation = parent->m_worldRotation * rotation;
+            m_worldScale = parent->m_worldScale * scale;
+        } else {
+            m_worldMatrix = m_localMatrix;
+            m_worldRotation = rotation;
+            m_worldScale = scale;
+        }
 
-        Transform->CalculateTransformMatrix();
+        m_dirty = false;
+        ++m_worldVersion;
     }
 
 
@@ -155,12 +263,19 @@ namespace Sleak {
 
         UpdateTransform();
 
-        auto world = GetTransformMatrix();
-        RenderEngine::TransformBuffer tb(world,
+        // Nothing moved and the camera did not change: the buffer is current
+        uint64_t cameraVersion = Camera::GetMainVersion();
+        if (m_uploadedWorldVersion == m_worldVersion && m_uploadedCameraVersion == cameraVersion)
+            return;
+
+        RenderEngine::TransformBuffer tb(m_worldMatrix,
                                          Camera::GetMainViewMatrix(),
                                          Camera::GetMainProjectionMatrix());
 
         RenderEngine::RenderCommandQueue::GetInstance()->SubmitUpdateConstantBuffer(ConstantBuffer, tb.GetData(), tb.GetSize());
+
+        m_uploadedWorldVersion = m_worldVersion;
+        m_uploadedCameraVersion = cameraVersion;
     }
 
 
@@ -172,4 +287,4 @@ namespace Sleak {
         return mat;
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,54 @@
+#include <ECS/TransformHierarchy.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <Core/GameObject.hpp>
+
+namespace Sleak {
+
+    void TransformHierarchy::Update(const List<GameObject*>& objects) {
+        if (m_structureDirty) Rebuild(objects);
+
+        m_lastUpdated = 0;
+        if (!m_changed) return;
+        m_changed = false;
+
+        for (TransformComponent* transform : m_transforms) {
+            if (!transform->m_dirty) continue;
+
+            // The parent came earlier in the array, so it is already clean
+            transform->UpdateTransform();
+            ++m_lastUpdated;
+        }
+    }
+
+    void TransformHierarchy::Rebuild(const List<GameObject*>& objects) {
+        m_transforms.clear();
+        m_level.clear();
+
+        // Children are reached through their parent, not the scene list
+        for (size_t i = 0; i < objects.GetSize(); ++i) {
+            if (objects[i] && !objects[i]->HasParent())
+                m_level.push_back(objects[i]);
+        }
+
+        // Breadth first: every level lands after the one above it
+        while (!m_level.empty()) {
+            m_nextLevel.clear();
+
+            for (GameObject* object : m_level) {
+                if (auto* transform = object->GetComponent<TransformComponent>())
+                    m_transforms.push_back(transform);
+
+                const auto& children = object->GetChildren();
+                for (size_t i = 0; i < children.GetSize(); ++i) {
+                    if (children[i]) m_nextLevel.push_back(children[i]);
+                }
+            }
+
+            m_level.swap(m_nextLevel);
+        }
+
+        m_structureDirty = false;
+        ++m_structureVersion;
+    }
+
+}
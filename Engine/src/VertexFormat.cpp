@@ -0,0 +1,338 @@
+#include <Runtime/VertexFormat.hpp>
+#include <Runtime/MeshData.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Sleak {
+    namespace VertexFormat {
+
+        namespace {
+            const VertexAttribute STANDARD_ATTRIBUTES[] = {
+                {VERTEX_POSITION,     VertexAttributeFormat::Float3, offsetof(Vertex, px)},
+                {VERTEX_NORMAL,       VertexAttributeFormat::Float3, offsetof(Vertex, nx)},
+                {VERTEX_TANGENT,      VertexAttributeFormat::Float4, offsetof(Vertex, tx)},
+                {VERTEX_COLOR,        VertexAttributeFormat::Float4, offsetof(Vertex, r)},
+                {VERTEX_TEXCOORD,     VertexAttributeFormat::Float2, offsetof(Vertex, u)},
+                {VERTEX_BONE_IDS,     VertexAttributeFormat::Int4,   offsetof(Vertex, boneIDs)},
+                {VERTEX_BONE_WEIGHTS, VertexAttributeFormat::Float4, offsetof(Vertex, boneWeights)},
+            };
+
+            const VertexAttribute STATIC_COMPACT_ATTRIBUTES[] = {
+                {VERTEX_POSITION, VertexAttributeFormat::Float3,    offsetof(StaticCompactVertex, px)},
+                {VERTEX_NORMAL,   VertexAttributeFormat::Snorm16x2, offsetof(StaticCompactVertex, normal)},
+                {VERTEX_TANGENT,  VertexAttributeFormat::Half4,     offsetof(StaticCompactVertex, tangent)},
+                {VERTEX_COLOR,    VertexAttributeFormat::Unorm8x4,  offsetof(StaticCompactVertex, color)},
+                {VERTEX_TEXCOORD, VertexAttributeFormat::Half2,     offsetof(StaticCompactVertex, uv)},
+            };
+
+            const VertexAttribute SKINNED_COMPACT_ATTRIBUTES[] = {
+                {VERTEX_POSITION,     VertexAttributeFormat::Float3,    offsetof(SkinnedCompactVertex, px)},
+                {VERTEX_NORMAL,       VertexAttributeFormat::Snorm16x2, offsetof(SkinnedCompactVertex, normal)},
+                {VERTEX_TANGENT,      VertexAttributeFormat::Half4,     offsetof(SkinnedCompactVertex, tangent)},
+                {VERTEX_COLOR,        VertexAttributeFormat::Unorm8x4,  offsetof(SkinnedCompactVertex, color)},
+                {VERTEX_TEXCOORD,     VertexAttributeFormat::Half2,     offsetof(SkinnedCompactVertex, uv)},
+                {VERTEX_BONE_IDS,     VertexAttributeFormat::Uint8x4,   offsetof(SkinnedCompactVertex, boneIDs)},
+                {VERTEX_BONE_WEIGHTS, VertexAttributeFormat::Unorm8x4,  offsetof(SkinnedCompactVertex, boneWeights)},
+            };
+
+            template <size_t N>
+            constexpr VertexLayoutDesc MakeDesc(uint32_t stride, const VertexAttribute (&attributes)[N]) {
+                return {stride, attributes, static_cast<uint32_t>(N)};
+            }
+
+            const VertexLayoutDesc LAYOUTS[] = {
+                MakeDesc(sizeof(Vertex), STANDARD_ATTRIBUTES),
+                MakeDesc(sizeof(StaticCompactVertex), STATIC_COMPACT_ATTRIBUTES),
+                MakeDesc(sizeof(SkinnedCompactVertex), SKINNED_COMPACT_ATTRIBUTES),
+            };
+
+            int16_t ToSnorm16(float value) {
+                return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+            }
+
+            float FromSnorm16(int16_t value) {
+                return std::max(value / 32767.0f, -1.0f);
+            }
+
+            uint8_t ToUnorm8(float value) {
+                return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+            }
+
+            float FromUnorm8(uint8_t value) {
+                return value / 255.0f;
+            }
+
+            bool HasBones(const Vertex& vertex) {
+                for (int i = 0; i < 4; ++i) {
+                    if (vertex.boneIDs[i] >= 0 && vertex.boneWeights[i] > 0.0f)
+                        return true;
+                }
+                return false;
+            }
+
+            // Fields both compact layouts share
+            template <typename T>
+            void EncodeCommon(const Vertex& vertex, T& out) {
+                out.px = vertex.px;
+                out.py = vertex.py;
+                out.pz = vertex.pz;
+
+                EncodeOctahedral(vertex.nx, vertex.ny, vertex.nz, out.normal);
+
+                out.tangent[0] = FloatToHalf(vertex.tx);
+                out.tangent[1] = FloatToHalf(vertex.ty);
+                out.tangent[2] = FloatToHalf(vertex.tz);
+                out.tangent[3] = FloatToHalf(vertex.tw);
+
+                out.color[0] = ToUnorm8(vertex.r);
+                out.color[1] = ToUnorm8(vertex.g);
+                out.color[2] = ToUnorm8(vertex.b);
+                out.color[3] = ToUnorm8(vertex.a);
+
+                out.uv[0] = FloatToHalf(vertex.u);
+                out.uv[1] = FloatToHalf(vertex.v);
+            }
+
+            template <typename T>
+            void DecodeCommon(const T& vertex, Vertex& out) {
+                out.px = vertex.px;
+                out.py = vertex.py;
+                out.pz = vertex.pz;
+
+                DecodeOctahedral(vertex.normal, out.nx, out.ny, out.nz);
+
+                out.tx = HalfToFloat(vertex.tangent[0]);
+                out.ty = HalfToFloat(vertex.tangent[1]);
+                out.tz = HalfToFloat(vertex.tangent[2]);
+                out.tw = HalfToFloat(vertex.tangent[3]);
+
+                out.r = FromUnorm8(vertex.color[0]);
+                out.g = FromUnorm8(vertex.color[1]);
+                out.b = FromUnorm8(vertex.color[2]);
+                out.a = FromUnorm8(vertex.color[3]);
+
+                out.u = HalfToFloat(vertex.uv[0]);
+                out.v = HalfToFloat(vertex.uv[1]);
+            }
+
+            template <typename T>
+            std::vector<uint8_t> EncodeAll(const Vertex* vertices, size_t count) {
+                std::vector<uint8_t> data(count * sizeof(T));
+                T* out = reinterpret_cast<T*>(data.data());
+                for (size_t i = 0; i < count; ++i)
+                    Encode(vertices[i], out[i]);
+                return data;
+            }
+        }
+
+        const VertexLayoutDesc& GetLayoutDesc(VertexLayout layout) {
+            size_t index = static_cast<size_t>(layout);
+            return LAYOUTS[index < static_cast<size_t>(VertexLayout::Count) ? index : 0];
+        }
+
+        uint32_t GetStride(VertexLayout layout) {
+            return GetLayoutDesc(layout).stride;
+        }
+
+        uint32_t GetComponentCount(VertexAttributeFormat format) {
+            switch (format) {
+                case VertexAttributeFormat::Float2:
+                case VertexAttributeFormat::Half2:
+                case VertexAttributeFormat::Snorm16x2:
+                    return 2;
+                case VertexAttributeFormat::Float3:
+                    return 3;
+                default:
+                    return 4;
+            }
+        }
+
+        bool CanEncode(const Vertex* vertices, size_t count, VertexLayout layout) {
+            if (layout == VertexLayout::Standard) return true;
+
+            for (size_t i = 0; i < count; ++i) {
+                const Vertex& vertex = vertices[i];
+
+                // Written so NaN fails too
+                if (!(std::abs(vertex.u) <= MAX_COMPACT_UV && std::abs(vertex.v) <= MAX_COMPACT_UV))
+                    return false;
+
+                if (layout == VertexLayout::StaticCompact && HasBones(vertex))
+                    return false;
+
+                if (layout == VertexLayout::SkinnedCompact) {
+                    for (int b = 0; b < 4; ++b) {
+                        if (vertex.boneWeights[b] > 0.0f && vertex.boneIDs[b] > MAX_COMPACT_BONE)
+                            return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        uint16_t FloatToHalf(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            const uint32_t sign = (bits >> 16) & 0x8000;
+            const uint32_t exponent = (bits >> 23) & 0xFF;
+            uint32_t mantissa = bits & 0x7FFFFF;
+
+            // Infinity and NaN, NaN staying a NaN
+            if (exponent == 0xFF)
+                return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+            const int32_t halfExponent = static_cast<int32_t>(exponent) - 127 + 15;
+            if (halfExponent >= 31)
+                return static_cast<uint16_t>(sign | 0x7C00);
+
+            // Rounds to nearest, ties to even
+            auto round = [](uint32_t value, uint32_t shift) {
+                uint32_t result = value >> shift;
+                uint32_t rest = value & ((1u << shift) - 1);
+                uint32_t halfway = 1u << (shift - 1);
+                if (rest > halfway || (rest == halfway && (result & 1)))
+                    result++;
+                return result;
+            };
+
+            if (halfExponent <= 0) {
+                // Subnormal half, or too small for one
+                if (halfExponent < -10)
+                    return static_cast<uint16_t>(sign);
+                mantissa |= 0x800000;
+                return static_cast<uint16_t>(sign | round(mantissa, static_cast<uint32_t>(14 - halfExponent)));
+            }
+
+            // A carry out of the mantissa correctly bumps the exponent
+            uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+            uint32_t rest = mantissa & 0x1FFF;
+            if (rest > 0x1000 || (rest == 0x1000 && (half & 1)))
+                half++;
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        float HalfToFloat(uint16_t value) {
+            const uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+            const uint32_t exponent = (value >> 10) & 0x1F;
+            const uint32_t mantissa = value & 0x3FF;
+
+            uint32_t bits;
+            if (exponent == 0) {
+                if (mantissa == 0) {
+                    bits = sign;
+                } else {
+                    float result = std::ldexp(static_cast<float>(mantissa), -24);
+                    return sign ? -result : result;
+                }
+            } else if (exponent == 31) {
+                bits = sign | 0x7F800000 | (mantissa << 13);
+            } else {
+                bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+            }
+
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        void EncodeOctahedral(float x, float y, float z, int16_t out[2]) {
+            float sum = std::fabs(x) + std::fabs(y) + std::fabs(z);
+            if (sum <= 0.0f) {
+                // No normal: decodes to +Z
+                out[0] = 0;
+                out[1] = 0;
+                return;
+            }
+
+            float ox = x / sum;
+            float oy = y / sum;
+
+            // Lower hemisphere folds over the diagonals
+            if (z < 0.0f) {
+                float fx = (1.0f - std::fabs(oy)) * (ox >= 0.0f ? 1.0f : -1.0f);
+                float fy = (1.0f - std::fabs(ox)) * (oy >= 0.0f ? 1.0f : -1.0f);
+                ox = fx;
+                oy = fy;
+            }
+
+            out[0] = ToSnorm16(ox);
+            out[1] = ToSnorm16(oy);
+        }
+
+        void DecodeOctahedral(const int16_t in[2], float& x, float& y, float& z) {
+            x = FromSnorm16(in[0]);
+            y = FromSnorm16(in[1]);
+            z = 1.0f - std::fabs(x) - std::fabs(y);
+
+            float t = std::max(-z, 0.0f);
+            x += x >= 0.0f ? -t : t;
+            y += y >= 0.0f ? -t : t;
+
+            float length = std::sqrt(x * x + y * y + z * z);
+            x /= length;
+            y /= length;
+            z /= length;
+        }
+
+        void Encode(const Vertex& vertex, StaticCompactVertex& out) {
+            EncodeCommon(vertex, out);
+        }
+
+        void Encode(const Vertex& vertex, SkinnedCompactVertex& out) {
+            EncodeCommon(vertex, out);
+
+            float total = 0.0f;
+            for (int i = 0; i < 4; ++i) {
+                if (vertex.boneIDs[i] >= 0)
+                    total += std::max(vertex.boneWeights[i], 0.0f);
+            }
+
+            int sum = 0;
+            int largest = 0;
+            for (int i = 0; i < 4; ++i) {
+                const bool used = vertex.boneIDs[i] >= 0 && total > 0.0f;
+                out.boneIDs[i] = used ? static_cast<uint8_t>(std::min(vertex.boneIDs[i], MAX_COMPACT_BONE)) : 0;
+                out.boneWeights[i] = used ? ToUnorm8(std::max(vertex.boneWeights[i], 0.0f) / total) : 0;
+
+                sum += out.boneWeights[i];
+                if (out.boneWeights[i] > out.boneWeights[largest])
+                    largest = i;
+            }
+
+            // Rounding can leave the weights off 255: the largest absorbs it
+            if (sum != 0)
+                out.boneWeights[largest] = static_cast<uint8_t>(out.boneWeights[largest] + (255 - sum));
+        }
+
+        void Decode(const StaticCompactVertex& vertex, Vertex& out) {
+            DecodeCommon(vertex, out);
+            for (int i = 0; i < 4; ++i) {
+                out.boneIDs[i] = -1;
+                out.boneWeights[i] = 0.0f;
+            }
+        }
+
+        void Decode(const SkinnedCompactVertex& vertex, Vertex& out) {
+            DecodeCommon(vertex, out);
+            for (int i = 0; i < 4; ++i) {
+                out.boneIDs[i] = vertex.boneWeights[i] ? vertex.boneIDs[i] : -1;
+                out.boneWeights[i] = FromUnorm8(vertex.boneWeights[i]);
+            }
+        }
+
+        std::vector<uint8_t> EncodeVertices(const Vertex* vertices, size_t count, VertexLayout layout) {
+            switch (layout) {
+                case VertexLayout::StaticCompact:
+                    return EncodeAll<StaticCompactVertex>(vertices, count);
+                case VertexLayout::SkinnedCompact:
+                    return EncodeAll<SkinnedCompactVertex>(vertices, count);
+                default: {
+                    const auto* bytes = reinterpret_cast<const uint8_t*>(vertices);
+                    return std::vector<uint8_t>(bytes, bytes + count * sizeof(Vertex));
+                }
+            }
+        }
+    }
+}
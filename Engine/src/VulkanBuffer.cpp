@@ -1,5 +1,6 @@
 #include "../../include/private/Graphics/Vulkan/VulkanBuffer.hpp"
 #include <Logger.hpp>
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
@@ -112,7 +113,8 @@ bool VulkanBuffer::Initialize(void* data) {
             break;
         }
         default: {
-            // Generic buffer
+            // Generic storage buffer, persistently mapped like constant
+            // buffers: instance data is rewritten every frame
             CreateBuffer(
                 Size,
                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
@@ -120,11 +122,10 @@ bool VulkanBuffer::Initialize(void* data) {
                     VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                 m_buffer, m_memory);
 
+            vkMapMemory(m_device, m_memory, 0, Size, 0, &m_mappedData);
+
             if (data) {
-                void* mapped;
-                vkMapMemory(m_device, m_memory, 0, Size, 0, &mapped);
-                memcpy(mapped, data, Size);
-                vkUnmapMemory(m_device, m_memory);
+                memcpy(m_mappedData, data, Size);
             }
             break;
         }
@@ -142,9 +143,9 @@ void VulkanBuffer::Update() {
 void VulkanBuffer::Update(void* data, size_t size) {
     if (!data || size == 0) return;
 
-    if (Type == BufferType::Constant && m_mappedData) {
-        // Constant buffer is persistently mapped
-        memcpy(m_mappedData, data, size);
+    if (m_mappedData) {
+        // Constant and storage buffers are persistently mapped
+        memcpy(m_mappedData, data, std::min<size_t>(size, Size));
     } else if (Type == BufferType::Vertex || Type == BufferType::Index) {
         // Need staging buffer for device-local buffers
         VkBuffer staging;
@@ -171,7 +172,7 @@ void VulkanBuffer::Update(void* data, size_t size) {
 void VulkanBuffer::Cleanup() {
     if (m_device == VK_NULL_HANDLE) return;
 
-    if (Type == BufferType::Constant && m_mappedData) {
+    if (m_mappedData) {
         vkUnmapMemory(m_device, m_memory);
         m_mappedData = nullptr;
     }
@@ -198,7 +199,7 @@ void VulkanBuffer::Cleanup() {
 
 bool VulkanBuffer::Map() {
     if (bIsMapped) return true;
-    if (Type == BufferType::Constant && m_mappedData) {
+    if (m_mappedData) {
         Data = m_mappedData;
         bIsMapped = true;
         return true;
@@ -211,8 +212,8 @@ bool VulkanBuffer::Map() {
 
 void VulkanBuffer::Unmap() {
     if (!bIsMapped) return;
-    // Don't unmap persistent constant buffer mappings
-    if (Type == BufferType::Constant && m_mappedData) {
+    // Don't unmap persistent mappings
+    if (m_mappedData) {
         bIsMapped = false;
         return;
     }
@@ -33,6 +33,38 @@
 namespace Sleak {
     namespace RenderEngine {
 
+static VkFormat ToVkFormat(VertexAttributeFormat format) {
+    switch (format) {
+        case VertexAttributeFormat::Float2:    return VK_FORMAT_R32G32_SFLOAT;
+        case VertexAttributeFormat::Float3:    return VK_FORMAT_R32G32B32_SFLOAT;
+        case VertexAttributeFormat::Float4:    return VK_FORMAT_R32G32B32A32_SFLOAT;
+        case VertexAttributeFormat::Int4:      return VK_FORMAT_R32G32B32A32_SINT;
+        case VertexAttributeFormat::Half2:     return VK_FORMAT_R16G16_SFLOAT;
+        case VertexAttributeFormat::Half4:     return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case VertexAttributeFormat::Snorm16x2: return VK_FORMAT_R16G16_SNORM;
+        case VertexAttributeFormat::Unorm8x4:  return VK_FORMAT_R8G8B8A8_UNORM;
+        case VertexAttributeFormat::Uint8x4:   return VK_FORMAT_R8G8B8A8_UINT;
+    }
+    return VK_FORMAT_UNDEFINED;
+}
+
+// Whether the vertex stage of a binary can read the layout: every attribute
+// it reads is provided, and a compact normal is decoded (COMPACT_VERTEX,
+// constant_id 0). Binaries built before a source gained those fail here.
+static bool CanReadLayout(const VulkanShader& shader, VertexLayout layout) {
+    const VertexLayoutDesc& desc = VertexFormat::GetLayoutDesc(layout);
+    for (uint32_t location : shader.GetVertexInputs()) {
+        bool provided = false;
+        for (uint32_t i = 0; i < desc.attributeCount && !provided; ++i)
+            provided = desc.attributes[i].location == location;
+        if (!provided) return false;
+
+        if (location == 1 && layout != VertexLayout::Standard && !shader.HasVertexSpecConstant(0))
+            return false;
+    }
+    return true;
+}
+
 VulkanRenderer::VulkanRenderer(Window* window)
     : sdlWindow(window) {
     this->Type = RendererType::Vulkan;
@@ -121,6 +153,9 @@ bool VulkanRenderer::Initialize() {
     if (!CreateShadowResources())
         SLEAK_WARN("Failed to create shadow mapping resources — shadows disabled");
 
+    if (!BuildFrameGraph())
+        SLEAK_RETURN_ERR("Failed to build the frame graph!");
+
     if (!CreateFrameBuffer())
         SLEAK_RETURN_ERR("Failed to create framebuffer of renderer!");
 
@@ -176,6 +211,9 @@ void VulkanRenderer::BeginRender() {
     // Reset the fence only after all waits are done
     vkResetFences(device, 1, &inFlightFences[currentFrame]);
 
+    // The GPU is done with this frame's instance descriptor set
+    m_instanceSetBound[currentFrame] = false;
+
     // Select the command buffer for this frame-in-flight
     command = commandBuffers[currentFrame];
 
@@ -191,54 +229,75 @@ void VulkanRenderer::BeginRender() {
         return;
     }
 
-    // --- Shadow pass (before main render pass) ---
-    if (m_shadowResourcesCreated) {
-        VkClearValue shadowClear{};
-        shadowClear.depthStencil = {1.0f, 0};
-
-        VkRenderPassBeginInfo shadowPassInfo{};
-        shadowPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        shadowPassInfo.renderPass = m_shadowRenderPass;
-        shadowPassInfo.framebuffer = m_shadowFramebuffer;
-        shadowPassInfo.renderArea.offset = {0, 0};
-        shadowPassInfo.renderArea.extent = {SHADOW_MAP_SIZE, SHADOW_MAP_SIZE};
-        shadowPassInfo.clearValueCount = 1;
-        shadowPassInfo.pClearValues = &shadowClear;
-
-        vkCmdBeginRenderPass(command, &shadowPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-        vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS, m_shadowPipeline);
-
-        VkViewport shadowViewport{};
-        shadowViewport.x = 0.0f;
-        shadowViewport.y = 0.0f;
-        shadowViewport.width = static_cast<float>(SHADOW_MAP_SIZE);
-        shadowViewport.height = static_cast<float>(SHADOW_MAP_SIZE);
-        shadowViewport.minDepth = 0.0f;
-        shadowViewport.maxDepth = 1.0f;
-        vkCmdSetViewport(command, 0, 1, &shadowViewport);
-
-        VkRect2D shadowScissor{};
-        shadowScissor.offset = {0, 0};
-        shadowScissor.extent = {SHADOW_MAP_SIZE, SHADOW_MAP_SIZE};
-        vkCmdSetScissor(command, 0, 1, &shadowScissor);
-
-        m_shadowPassActive = true;
-        auto* queue = RenderCommandQueue::GetInstance();
-        if (queue) {
-            static int shadowDbgFrame = 0;
-            if (shadowDbgFrame < 5) {
-                SLEAK_INFO("Shadow pass frame {}: lightVP[0]={:.4f}, [5]={:.4f}, [10]={:.4f}, [15]={:.4f}",
-                    shadowDbgFrame, m_lightVP[0], m_lightVP[5], m_lightVP[10], m_lightVP[15]);
-            }
-            queue->ExecuteShadowPass(this);
-            ++shadowDbgFrame;
-        }
-        m_shadowPassActive = false;
+    // Shadow pass, then the main render pass, which stays open for the
+    // queue's commands until EndRender
+    m_frameGraph.Execute(this, [this](const std::vector<FrameGraphBarrier>& barriers) {
+        RecordBarriers(barriers);
+    });
+
+    // RenderCommandQueue will now call Draw/DrawIndexed/Bind* methods
+    // via the RenderContext interface on this object
+
+    if (bImInitialized) {
+        ImGui_ImplVulkan_NewFrame();
+        ImGui_ImplSDL3_NewFrame();
+        ImGui::NewFrame();
+    }
 
-        vkCmdEndRenderPass(command);
+    bFrameStarted = true;
+}
+
+// Records the shadow map pass: replays last frame's draws from the light
+void VulkanRenderer::RecordShadowPass() {
+    VkClearValue shadowClear{};
+    shadowClear.depthStencil = {1.0f, 0};
+
+    VkRenderPassBeginInfo shadowPassInfo{};
+    shadowPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    shadowPassInfo.renderPass = m_shadowRenderPass;
+    shadowPassInfo.framebuffer = m_shadowFramebuffer;
+    shadowPassInfo.renderArea.offset = {0, 0};
+    shadowPassInfo.renderArea.extent = {SHADOW_MAP_SIZE, SHADOW_MAP_SIZE};
+    shadowPassInfo.clearValueCount = 1;
+    shadowPassInfo.pClearValues = &shadowClear;
+
+    vkCmdBeginRenderPass(command, &shadowPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS, m_shadowPipeline);
+    m_vertexLayout = VertexLayout::Standard;
+
+    VkViewport shadowViewport{};
+    shadowViewport.x = 0.0f;
+    shadowViewport.y = 0.0f;
+    shadowViewport.width = static_cast<float>(SHADOW_MAP_SIZE);
+    shadowViewport.height = static_cast<float>(SHADOW_MAP_SIZE);
+    shadowViewport.minDepth = 0.0f;
+    shadowViewport.maxDepth = 1.0f;
+    vkCmdSetViewport(command, 0, 1, &shadowViewport);
+
+    VkRect2D shadowScissor{};
+    shadowScissor.offset = {0, 0};
+    shadowScissor.extent = {SHADOW_MAP_SIZE, SHADOW_MAP_SIZE};
+    vkCmdSetScissor(command, 0, 1, &shadowScissor);
+
+    m_shadowPassActive = true;
+    auto* queue = RenderCommandQueue::GetInstance();
+    if (queue) {
+        static int shadowDbgFrame = 0;
+        if (shadowDbgFrame < 5) {
+            SLEAK_INFO("Shadow pass frame {}: lightVP[0]={:.4f}, [5]={:.4f}, [10]={:.4f}, [15]={:.4f}",
+                shadowDbgFrame, m_lightVP[0], m_lightVP[5], m_lightVP[10], m_lightVP[15]);
+        }
+        queue->ExecuteShadowPass(this);
+        ++shadowDbgFrame;
     }
+    m_shadowPassActive = false;
 
-    // Begin render pass
+    vkCmdEndRenderPass(command);
+}
+
+// Begins the main render pass. Skybox, skinned and debug line draws
+// switch pipelines inside it; EndRender ends it after ImGui.
+void VulkanRenderer::BeginMainPass() {
     // When MSAA: 3 attachments (color, depth, resolve); otherwise 2
     std::vector<VkClearValue> clearValues(2);
     clearValues[0] = clearColor;
@@ -262,6 +321,7 @@ void VulkanRenderer::BeginRender() {
     vkCmdBeginRenderPass(command, &passInfo, VK_SUBPASS_CONTENTS_INLINE);
 
     vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    m_vertexLayout = VertexLayout::Standard;
 
     // Bind texture descriptor set if available
     if (m_textureDescriptorsWritten &&
@@ -295,17 +355,6 @@ void VulkanRenderer::BeginRender() {
             command, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLay, 3, 1,
             &m_shadowSamplerDescriptorSets[currentFrame], 0, nullptr);
     }
-
-    // RenderCommandQueue will now call Draw/DrawIndexed/Bind* methods
-    // via the RenderContext interface on this object
-
-    if (bImInitialized) {
-        ImGui_ImplVulkan_NewFrame();
-        ImGui_ImplSDL3_NewFrame();
-        ImGui::NewFrame();
-    }
-
-    bFrameStarted = true;
 }
 
 // EndRender: end render pass, end command buffer, submit, present.
@@ -378,29 +427,36 @@ void VulkanRenderer::EndRender() {
 // -----------------------------------------------------------------------
 
 void VulkanRenderer::Draw(uint32_t vertexCount) {
-    if (!bFrameStarted) return;
+    if (!bFrameStarted || !HasLayoutPipeline()) return;
     vkCmdDraw(command, vertexCount, 1, 0, 0);
     DrawnVertices += vertexCount;
     DrawnTriangles += vertexCount / 3;
 }
 
-void VulkanRenderer::DrawIndexed(uint32_t indexCount) {
-    if (!bFrameStarted) return;
-    vkCmdDrawIndexed(command, indexCount, 1, 0, 0, 0);
+void VulkanRenderer::DrawIndexed(uint32_t indexCount, uint32_t startIndex,
+                                 int32_t baseVertex) {
+    if (!bFrameStarted || !HasLayoutPipeline()) return;
+    vkCmdDrawIndexed(command, indexCount, 1, startIndex, baseVertex, 0);
     DrawnVertices += indexCount;
     DrawnTriangles += indexCount / 3;
 }
 
 void VulkanRenderer::DrawInstance(uint32_t instanceCount,
                                    uint32_t vertexPerInstance) {
-    if (!bFrameStarted) return;
+    if (!bFrameStarted || !HasLayoutPipeline()) return;
     vkCmdDraw(command, vertexPerInstance, instanceCount, 0, 0);
 }
 
 void VulkanRenderer::DrawIndexedInstance(uint32_t instanceCount,
-                                          uint32_t indexPerInstance) {
-    if (!bFrameStarted) return;
-    vkCmdDrawIndexed(command, indexPerInstance, instanceCount, 0, 0, 0);
+                                          uint32_t indexPerInstance,
+                                          uint32_t startIndex,
+                                          int32_t baseVertex) {
+    if (!bFrameStarted || !HasLayoutPipeline()) return;
+    const uint32_t firstInstance = m_instancedDrawActive ? m_firstInstance : 0;
+    vkCmdDrawIndexed(command, indexPerInstance, instanceCount, startIndex, baseVertex,
+                     firstInstance);
+    DrawnVertices += indexPerInstance * instanceCount;
+    DrawnTriangles += (indexPerInstance / 3) * instanceCount;
 }
 
 void VulkanRenderer::SetRenderFace(RenderFace face) {
@@ -443,18 +499,143 @@ void VulkanRenderer::BindVertexBuffer(RefPtr<BufferBase> buffer,
     if (!bFrameStarted) return;
     auto* vkBuf = dynamic_cast<VulkanBuffer*>(buffer.get());
     if (!vkBuf) return;
+    if (slot == 0)
+        SetVertexLayout(vkBuf->GetVertexLayout());
     VkBuffer buffers[] = {vkBuf->GetVkBuffer()};
     VkDeviceSize offsets[] = {0};
     vkCmdBindVertexBuffers(command, slot, 1, buffers, offsets);
 }
 
+VkPipeline VulkanRenderer::GetLayoutPipeline(VkPipeline base,
+                                             const PipelineVariants& variants) const {
+    VkPipeline variant = variants[static_cast<size_t>(m_vertexLayout)];
+    return variant != VK_NULL_HANDLE ? variant : base;
+}
+
+// False while a buffer is bound whose layout the current pass has no
+// pipeline for: the base pipeline would read it with the wrong stride
+bool VulkanRenderer::HasLayoutPipeline() const {
+    if (m_vertexLayout == VertexLayout::Standard && !m_instancedDrawActive) return true;
+
+    const PipelineVariants& variants = m_shadowPassActive    ? m_shadowVariants
+                                     : m_skinnedPassActive   ? m_skinnedVariants
+                                     : m_instancedDrawActive ? m_instancedVariants
+                                                             : m_mainVariants;
+    return variants[static_cast<size_t>(m_vertexLayout)] != VK_NULL_HANDLE;
+}
+
+// Switches the pipeline of the current pass to the variant reading the
+// layout. Skybox and debug line passes bind standard buffers only.
+void VulkanRenderer::SetVertexLayout(VertexLayout layout) {
+    if (layout == m_vertexLayout) return;
+    m_vertexLayout = layout;
+
+    VkPipeline bound;
+    if (m_shadowPassActive)
+        bound = GetLayoutPipeline(m_shadowPipeline, m_shadowVariants);
+    else if (m_skinnedPassActive)
+        bound = GetLayoutPipeline(skinnedPipeline, m_skinnedVariants);
+    else if (m_instancedDrawActive)
+        bound = GetLayoutPipeline(VK_NULL_HANDLE, m_instancedVariants);
+    else
+        bound = GetLayoutPipeline(pipeline, m_mainVariants);
+
+    if (bound != VK_NULL_HANDLE)
+        vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS, bound);
+}
+
+// Creates copies of a pipeline reading the given layouts; the vertex stage
+// gets COMPACT_VERTEX (constant_id 0) set for the compact ones and
+// INSTANCED (constant_id 1) when asked. Shaders without a constant ignore
+// its entry. The Standard layout keeps the base vertex input. Layouts the
+// shader binary cannot read get no variant, and their draws are skipped.
+void VulkanRenderer::CreateLayoutVariants(const VkGraphicsPipelineCreateInfo& baseInfo,
+                                          const VulkanShader& shader,
+                                          PipelineVariants& variants,
+                                          std::initializer_list<VertexLayout> layouts,
+                                          bool instanced) {
+    struct SpecConstants {
+        VkBool32 compact;
+        VkBool32 instanced;
+    };
+    const VkSpecializationMapEntry entries[] = {
+        {0, offsetof(SpecConstants, compact), sizeof(VkBool32)},
+        {1, offsetof(SpecConstants, instanced), sizeof(VkBool32)},
+    };
+
+    for (VertexLayout layout : layouts) {
+        if (!CanReadLayout(shader, layout)) {
+            SLEAK_WARN("VulkanRenderer: a shader binary predates vertex layout {}, "
+                       "rebuild the shaders with glslc (CompileShaders)",
+                       static_cast<int>(layout));
+            continue;
+        }
+
+        const SpecConstants constants{layout != VertexLayout::Standard ? VK_TRUE : VK_FALSE,
+                                      instanced ? VK_TRUE : VK_FALSE};
+        VkSpecializationInfo specialization{2, entries, sizeof(SpecConstants), &constants};
+
+        std::vector<VkPipelineShaderStageCreateInfo> stages(
+            baseInfo.pStages, baseInfo.pStages + baseInfo.stageCount);
+        for (auto& stage : stages) {
+            if (stage.stage == VK_SHADER_STAGE_VERTEX_BIT)
+                stage.pSpecializationInfo = &specialization;
+        }
+
+        const VertexLayoutDesc& desc = VertexFormat::GetLayoutDesc(layout);
+
+        VkVertexInputBindingDescription binding{};
+        binding.binding = 0;
+        binding.stride = desc.stride;
+        binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+        std::vector<VkVertexInputAttributeDescription> attributes(desc.attributeCount);
+        for (uint32_t i = 0; i < desc.attributeCount; ++i) {
+            attributes[i].binding = 0;
+            attributes[i].location = desc.attributes[i].location;
+            attributes[i].format = ToVkFormat(desc.attributes[i].format);
+            attributes[i].offset = desc.attributes[i].offset;
+        }
+
+        VkPipelineVertexInputStateCreateInfo vertexInput{};
+        vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount = 1;
+        vertexInput.pVertexBindingDescriptions = &binding;
+        vertexInput.vertexAttributeDescriptionCount = desc.attributeCount;
+        vertexInput.pVertexAttributeDescriptions = attributes.data();
+
+        VkGraphicsPipelineCreateInfo info = baseInfo;
+        info.pStages = stages.data();
+        if (layout != VertexLayout::Standard)
+            info.pVertexInputState = &vertexInput;
+
+        VkPipeline& variant = variants[static_cast<size_t>(layout)];
+        if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &info, nullptr,
+                                      &variant) != VK_SUCCESS) {
+            SLEAK_ERROR("VulkanRenderer: Failed to create a vertex layout pipeline variant!");
+            variant = VK_NULL_HANDLE;
+        }
+    }
+}
+
+void VulkanRenderer::DestroyLayoutVariants(PipelineVariants& variants) {
+    for (auto& variant : variants) {
+        if (variant) {
+            vkDestroyPipeline(device, variant, nullptr);
+            variant = VK_NULL_HANDLE;
+        }
+    }
+}
+
 void VulkanRenderer::BindIndexBuffer(RefPtr<BufferBase> buffer,
                                       uint32_t slot) {
     if (!bFrameStarted) return;
     auto* vkBuf = dynamic_cast<VulkanBuffer*>(buffer.get());
     if (!vkBuf) return;
     vkCmdBindIndexBuffer(command, vkBuf->GetVkBuffer(), 0,
-                         VK_INDEX_TYPE_UINT32);
+                         vkBuf->GetIndexFormat() == IndexFormat::UInt16
+                             ? VK_INDEX_TYPE_UINT16
+                             : VK_INDEX_TYPE_UINT32);
 }
 
 void VulkanRenderer::BindConstantBuffer(RefPtr<BufferBase> buffer,
@@ -473,32 +654,34 @@ void VulkanRenderer::BindConstantBuffer(RefPtr<BufferBase> buffer,
     if (m_shadowPassActive && slot == 0 && size >= 128) {
         // In shadow mode: compute LightVP * World for the push constant
         // Buffer layout: [WVP (64 bytes)][World (64 bytes)]
-        // We need to replace WVP with LightVP * World
-        float shadowPC[32]; // 128 bytes = 2 x mat4
-        const float* srcWorld = reinterpret_cast<const float*>(
-            static_cast<const char*>(data) + 64);
-
-        // Matrix multiply: shadowWVP = World * LightVP (row-major)
-        for (int r = 0; r < 4; ++r) {
-            for (int c = 0; c < 4; ++c) {
-                float sum = 0.0f;
-                for (int k = 0; k < 4; ++k) {
-                    sum += srcWorld[r * 4 + k] * m_lightVP[k * 4 + c];
-                }
-                shadowPC[r * 4 + c] = sum;
-            }
-        }
-        // Copy World matrix to second half
-        memcpy(&shadowPC[16], srcWorld, 64);
-
-        vkCmdPushConstants(command, pipelineLay,
-                           VK_SHADER_STAGE_VERTEX_BIT, 0, 128, shadowPC);
+        PushShadowTransform(reinterpret_cast<const float*>(
+            static_cast<const char*>(data) + 64));
     } else {
         vkCmdPushConstants(command, pipelineLay,
                            VK_SHADER_STAGE_VERTEX_BIT, 0, size, data);
     }
 }
 
+void VulkanRenderer::PushShadowTransform(const float* world) {
+    float shadowPC[32]; // 128 bytes = 2 x mat4
+
+    // Matrix multiply: shadowWVP = World * LightVP (row-major)
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                sum += world[r * 4 + k] * m_lightVP[k * 4 + c];
+            }
+            shadowPC[r * 4 + c] = sum;
+        }
+    }
+    // Copy World matrix to second half
+    memcpy(&shadowPC[16], world, 64);
+
+    vkCmdPushConstants(command, pipelineLay,
+                       VK_SHADER_STAGE_VERTEX_BIT, 0, 128, shadowPC);
+}
+
 BufferBase* VulkanRenderer::CreateBuffer(BufferType type, uint32_t size,
                                           void* data) {
     auto* buffer = new VulkanBuffer(device, physicalDevice, size, type,
@@ -674,6 +857,7 @@ void VulkanRenderer::BeginSkyboxPass() {
 
     vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       skyboxPipeline);
+    m_vertexLayout = VertexLayout::Standard;
 
     if (CurrentFrameIndex < skyboxDescriptorSets.size()) {
         vkCmdBindDescriptorSets(
@@ -767,6 +951,7 @@ void VulkanRenderer::Cleanup() {
         vkDestroyPipeline(device, skinnedPipeline, nullptr);
         skinnedPipeline = VK_NULL_HANDLE;
     }
+    DestroyLayoutVariants(m_skinnedVariants);
     delete skinnedShader;
     skinnedShader = nullptr;
 
@@ -787,7 +972,19 @@ void VulkanRenderer::Cleanup() {
     // Destroy bone UBO resources
     CleanupBoneUBOResources();
 
+    // Destroy instance descriptor sets
+    if (m_instanceDescriptorPool) {
+        vkDestroyDescriptorPool(device, m_instanceDescriptorPool, nullptr);
+        m_instanceDescriptorPool = VK_NULL_HANDLE;
+        m_instanceDescriptorSets = {};
+        m_instanceSetBuffers = {};
+    }
+
     // Destroy descriptor set layouts
+    if (m_instanceDescriptorSetLayout) {
+        vkDestroyDescriptorSetLayout(device, m_instanceDescriptorSetLayout, nullptr);
+        m_instanceDescriptorSetLayout = VK_NULL_HANDLE;
+    }
     if (m_shadowSamplerDescriptorSetLayout) {
         vkDestroyDescriptorSetLayout(device, m_shadowSamplerDescriptorSetLayout, nullptr);
         m_shadowSamplerDescriptorSetLayout = VK_NULL_HANDLE;
@@ -805,8 +1002,9 @@ void VulkanRenderer::Cleanup() {
         descriptorSetLayout = VK_NULL_HANDLE;
     }
 
-    // Clean up depth resources
+    // Clean up depth resources, then the memory the attachments shared
     CleanupDepthResources();
+    CleanupTransientMemory();
 
     // Destroy swapchain
     if (swapChain && device) {
@@ -859,6 +1057,8 @@ void VulkanRenderer::Cleanup() {
         vkDestroyPipeline(device, pipeline, nullptr);
         pipeline = VK_NULL_HANDLE;
     }
+    DestroyLayoutVariants(m_mainVariants);
+    DestroyLayoutVariants(m_instancedVariants);
 
     // Destroy pipeline layout
     if (pipelineLay) {
@@ -1334,6 +1534,10 @@ bool VulkanRenderer::RecreateSwapChain() {
         SLEAK_ERROR("Failed to recreate MSAA color resources!");
         return false;
     }
+    if (!BuildFrameGraph()) {
+        SLEAK_ERROR("Failed to rebuild the frame graph!");
+        return false;
+    }
     if (!CreateFrameBuffer()) {
         SLEAK_ERROR("Failed to recreate framebuffers!");
         return false;
@@ -1345,6 +1549,7 @@ bool VulkanRenderer::RecreateSwapChain() {
 void VulkanRenderer::CleanupSwapChain() {
     CleanupDepthResources();
     CleanupMSAAColorResources();
+    CleanupTransientMemory();
 
     for (auto framebuffer : swapChainFramebuffers) {
         vkDestroyFramebuffer(device, framebuffer, nullptr);
@@ -1388,34 +1593,7 @@ bool VulkanRenderer::CreateMSAAColorResources() {
     if (vkCreateImage(device, &imageInfo, nullptr, &m_msaaColorImage) != VK_SUCCESS)
         SLEAK_RETURN_ERR("Failed to create MSAA color image!");
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(device, m_msaaColorImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(
-        memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &m_msaaColorImageMemory) != VK_SUCCESS)
-        SLEAK_RETURN_ERR("Failed to allocate MSAA color image memory!");
-
-    vkBindImageMemory(device, m_msaaColorImage, m_msaaColorImageMemory, 0);
-
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = m_msaaColorImage;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = scImageFormat;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    if (vkCreateImageView(device, &viewInfo, nullptr, &m_msaaColorImageView) != VK_SUCCESS)
-        SLEAK_RETURN_ERR("Failed to create MSAA color image view!");
-
+    // Memory and view come from BuildFrameGraph
     return true;
 }
 
@@ -1428,10 +1606,6 @@ void VulkanRenderer::CleanupMSAAColorResources() {
         vkDestroyImage(device, m_msaaColorImage, nullptr);
         m_msaaColorImage = VK_NULL_HANDLE;
     }
-    if (m_msaaColorImageMemory) {
-        vkFreeMemory(device, m_msaaColorImageMemory, nullptr);
-        m_msaaColorImageMemory = VK_NULL_HANDLE;
-    }
 }
 
 VkSampleCountFlagBits VulkanRenderer::GetMaxUsableSampleCount() {
@@ -1477,6 +1651,8 @@ void VulkanRenderer::ApplyMSAAChange() {
         vkDestroyPipeline(device, pipeline, nullptr);
         pipeline = VK_NULL_HANDLE;
     }
+    DestroyLayoutVariants(m_mainVariants);
+    DestroyLayoutVariants(m_instancedVariants);
     if (skyboxPipeline) {
         vkDestroyPipeline(device, skyboxPipeline, nullptr);
         skyboxPipeline = VK_NULL_HANDLE;
@@ -1485,6 +1661,7 @@ void VulkanRenderer::ApplyMSAAChange() {
         vkDestroyPipeline(device, skinnedPipeline, nullptr);
         skinnedPipeline = VK_NULL_HANDLE;
     }
+    DestroyLayoutVariants(m_skinnedVariants);
     if (debugLinePipeline) {
         vkDestroyPipeline(device, debugLinePipeline, nullptr);
         debugLinePipeline = VK_NULL_HANDLE;
@@ -1508,6 +1685,12 @@ void VulkanRenderer::ApplyMSAAChange() {
     CreateDepthResources();
     CreateMSAAColorResources();
     CreateRenderPass();
+    if (!BuildFrameGraph()) {
+        // Without the graph no pass runs and the attachments have no views
+        SLEAK_ERROR("Failed to rebuild the frame graph, rendering stopped!");
+        bRender = false;
+        return;
+    }
     CreateFrameBuffer();
     CreateGraphicsPipeline();
     CreateSkyboxPipeline();
@@ -1610,39 +1793,7 @@ bool VulkanRenderer::CreateDepthResources() {
         VK_SUCCESS)
         SLEAK_RETURN_ERR("Failed to create depth image!");
 
-    // Allocate memory
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(device, depthImage, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(
-        memRequirements.memoryTypeBits,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-    if (vkAllocateMemory(device, &allocInfo, nullptr, &depthImageMemory) !=
-        VK_SUCCESS)
-        SLEAK_RETURN_ERR("Failed to allocate depth image memory!");
-
-    vkBindImageMemory(device, depthImage, depthImageMemory, 0);
-
-    // Create image view
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = depthImage;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = depthFormat;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    if (vkCreateImageView(device, &viewInfo, nullptr, &depthImageView) !=
-        VK_SUCCESS)
-        SLEAK_RETURN_ERR("Failed to create depth image view!");
-
+    // Memory and view come from BuildFrameGraph
     return true;
 }
 
@@ -1655,10 +1806,173 @@ void VulkanRenderer::CleanupDepthResources() {
         vkDestroyImage(device, depthImage, nullptr);
         depthImage = VK_NULL_HANDLE;
     }
-    if (depthImageMemory) {
-        vkFreeMemory(device, depthImageMemory, nullptr);
-        depthImageMemory = VK_NULL_HANDLE;
+}
+
+// -----------------------------------------------------------------------
+// Frame Graph
+// -----------------------------------------------------------------------
+
+// Declares the frame's passes and places the transient attachments. Depth
+// and MSAA color only live during the main pass, so instead of a dedicated
+// allocation each, they are bound to the memory slots the graph compiled;
+// attachments whose passes never overlap share one.
+bool VulkanRenderer::BuildFrameGraph() {
+    CleanupTransientMemory();
+    m_frameGraph.Clear();
+
+    auto describe = [this](VkImage image) {
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device, image, &requirements);
+
+        FrameGraphResourceDesc desc;
+        desc.size = requirements.size;
+        desc.alignment = requirements.alignment;
+        desc.typeMask = requirements.memoryTypeBits;
+        return desc;
+    };
+
+    const uint32_t backbuffer = m_frameGraph.Import("Backbuffer");
+    const uint32_t depth = m_frameGraph.CreateTransient("Depth", describe(depthImage));
+    uint32_t msaaColor = FrameGraph::INVALID;
+    if (m_msaaColorImage)
+        msaaColor = m_frameGraph.CreateTransient("MSAAColor", describe(m_msaaColorImage));
+
+    // The shadow map keeps its own memory, but nothing reads it after the frame
+    uint32_t shadowMap = FrameGraph::INVALID;
+    if (m_shadowResourcesCreated) {
+        shadowMap = m_frameGraph.Import("ShadowMap", false);
+
+        uint32_t shadow = m_frameGraph.AddPass("Shadow", [this](RenderContext*) { RecordShadowPass(); });
+        m_frameGraph.Write(shadow, shadowMap);
+    }
+
+    uint32_t main = m_frameGraph.AddPass("Main", [this](RenderContext*) { BeginMainPass(); });
+    if (shadowMap != FrameGraph::INVALID && m_lightUBOCreated)
+        m_frameGraph.Read(main, shadowMap);
+    m_frameGraph.Write(main, depth);
+    if (msaaColor != FrameGraph::INVALID)
+        m_frameGraph.Write(main, msaaColor);
+    m_frameGraph.Write(main, backbuffer);
+
+    // The shadow map is the one image two passes share: the shadow pass
+    // leaves it a depth attachment, the barrier makes it readable
+    m_frameGraphImages.assign(m_frameGraph.GetResourceCount(), FrameGraphImage());
+    if (shadowMap != FrameGraph::INVALID) {
+        FrameGraphImage& image = m_frameGraphImages[shadowMap];
+        image.image = m_shadowImage;
+        image.aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+        image.writeLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        image.writeStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                           VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        image.writeAccess = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        image.readLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        image.readStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        image.readAccess = VK_ACCESS_SHADER_READ_BIT;
+    }
+
+    if (!m_frameGraph.Compile())
+        SLEAK_RETURN_ERR("Failed to compile the frame graph!");
+
+    const auto& slots = m_frameGraph.GetMemorySlots();
+    m_transientMemory.assign(slots.size(), VK_NULL_HANDLE);
+    for (size_t i = 0; i < slots.size(); ++i) {
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = slots[i].size;
+        allocInfo.memoryTypeIndex = FindMemoryType(
+            slots[i].typeMask, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &m_transientMemory[i]) != VK_SUCCESS)
+            SLEAK_RETURN_ERR("Failed to allocate transient attachment memory!");
+    }
+
+    auto bindAttachment = [this](VkImage image, uint32_t resource, VkFormat format,
+                                 VkImageAspectFlags aspect, VkImageView& view) {
+        uint32_t slot = m_frameGraph.GetMemorySlot(resource);
+        if (slot == FrameGraph::INVALID)
+            return true; // Its pass was culled
+
+        vkBindImageMemory(device, image, m_transientMemory[slot], 0);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = aspect;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        return vkCreateImageView(device, &viewInfo, nullptr, &view) == VK_SUCCESS;
+    };
+
+    if (!bindAttachment(depthImage, depth, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, depthImageView))
+        SLEAK_RETURN_ERR("Failed to create depth image view!");
+
+    if (msaaColor != FrameGraph::INVALID &&
+        !bindAttachment(m_msaaColorImage, msaaColor, scImageFormat, VK_IMAGE_ASPECT_COLOR_BIT, m_msaaColorImageView))
+        SLEAK_RETURN_ERR("Failed to create MSAA color image view!");
+
+    const auto& stats = m_frameGraph.GetStats();
+    SLEAK_INFO("Frame graph: {} passes ({} culled), {} barriers, {:.1f} MB transient in {} slots, {:.1f} MB saved by aliasing",
+               stats.passes, stats.culledPasses, stats.barriers,
+               stats.transientBytes / (1024.0 * 1024.0), stats.memorySlots,
+               stats.GetSavedBytes() / (1024.0 * 1024.0));
+    return true;
+}
+
+// Records the barriers the frame graph placed before a pass, between
+// render passes
+void VulkanRenderer::RecordBarriers(const std::vector<FrameGraphBarrier>& barriers) {
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+    VkPipelineStageFlags srcStages = 0;
+    VkPipelineStageFlags dstStages = 0;
+
+    for (const auto& barrier : barriers) {
+        if (barrier.resource >= m_frameGraphImages.size()) continue;
+        const FrameGraphImage& image = m_frameGraphImages[barrier.resource];
+        if (image.image == VK_NULL_HANDLE) continue;
+
+        const bool wrote = barrier.before == FrameGraphAccess::Write;
+        const bool writes = barrier.after == FrameGraphAccess::Write;
+
+        VkImageMemoryBarrier imageBarrier{};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        // Write after read only waits for the reads, nothing to flush
+        imageBarrier.srcAccessMask = wrote ? image.writeAccess : 0;
+        imageBarrier.dstAccessMask = writes ? image.writeAccess : image.readAccess;
+        imageBarrier.oldLayout = wrote ? image.writeLayout : image.readLayout;
+        imageBarrier.newLayout = writes ? image.writeLayout : image.readLayout;
+        imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        imageBarrier.image = image.image;
+        imageBarrier.subresourceRange.aspectMask = image.aspect;
+        imageBarrier.subresourceRange.baseMipLevel = 0;
+        imageBarrier.subresourceRange.levelCount = 1;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount = 1;
+        imageBarriers.push_back(imageBarrier);
+
+        srcStages |= wrote ? image.writeStage : image.readStage;
+        dstStages |= writes ? image.writeStage : image.readStage;
+    }
+
+    if (imageBarriers.empty()) return;
+
+    vkCmdPipelineBarrier(command, srcStages, dstStages, 0,
+                         0, nullptr, 0, nullptr,
+                         static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+}
+
+void VulkanRenderer::CleanupTransientMemory() {
+    for (auto memory : m_transientMemory) {
+        if (memory)
+            vkFreeMemory(device, memory, nullptr);
     }
+    m_transientMemory.clear();
 }
 
 VkFormat VulkanRenderer::FindDepthFormat() {
@@ -1772,6 +2086,23 @@ bool VulkanRenderer::CreateDescriptorSetLayout() {
                                      &m_shadowSamplerDescriptorSetLayout) != VK_SUCCESS)
         SLEAK_RETURN_ERR("Failed to create shadow sampler descriptor set layout!");
 
+    // Set 4: instance transforms (storage buffer)
+    VkDescriptorSetLayoutBinding instanceBinding{};
+    instanceBinding.binding = 0;
+    instanceBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    instanceBinding.descriptorCount = 1;
+    instanceBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    instanceBinding.pImmutableSamplers = nullptr;
+
+    VkDescriptorSetLayoutCreateInfo instanceLayoutInfo{};
+    instanceLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    instanceLayoutInfo.bindingCount = 1;
+    instanceLayoutInfo.pBindings = &instanceBinding;
+
+    if (vkCreateDescriptorSetLayout(device, &instanceLayoutInfo, nullptr,
+                                     &m_instanceDescriptorSetLayout) != VK_SUCCESS)
+        SLEAK_RETURN_ERR("Failed to create instance descriptor set layout!");
+
     return true;
 }
 
@@ -2064,12 +2395,14 @@ bool VulkanRenderer::CreateGraphicsPipeline() {
     pushConstantRange.offset = 0;
     pushConstantRange.size = 128;  // sizeof(mat4) * 2 = 128 bytes (WVP + World)
 
-    // Four descriptor set layouts:
+    // Five descriptor set layouts:
     // set 0 = texture sampler, set 1 = bone UBO,
-    // set 2 = light/shadow UBO, set 3 = shadow map sampler
-    std::array<VkDescriptorSetLayout, 4> setLayouts = {
+    // set 2 = light/shadow UBO, set 3 = shadow map sampler,
+    // set 4 = instance transforms
+    std::array<VkDescriptorSetLayout, 5> setLayouts = {
         descriptorSetLayout, boneDescriptorSetLayout,
-        m_lightUBODescriptorSetLayout, m_shadowSamplerDescriptorSetLayout
+        m_lightUBODescriptorSetLayout, m_shadowSamplerDescriptorSetLayout,
+        m_instanceDescriptorSetLayout
     };
 
     VkPipelineLayoutCreateInfo layoutInfo{};
@@ -2108,6 +2441,20 @@ bool VulkanRenderer::CreateGraphicsPipeline() {
     if (result != VK_SUCCESS)
         SLEAK_ERROR("Failed to create graphics pipeline!!");
 
+    CreateLayoutVariants(pipelineInfo, *simpleShader, m_mainVariants,
+                         {VertexLayout::StaticCompact, VertexLayout::SkinnedCompact});
+    // A binary older than its source keeps one draw per object
+    m_instancingSupported = simpleShader->HasVertexSpecConstant(1);
+    if (m_instancingSupported) {
+        CreateLayoutVariants(pipelineInfo, *simpleShader, m_instancedVariants,
+                             {VertexLayout::Standard, VertexLayout::StaticCompact,
+                              VertexLayout::SkinnedCompact},
+                             true);
+    } else {
+        SLEAK_WARN("VulkanRenderer: default_shader.vert.spv has no INSTANCED constant, "
+                   "rebuild it with glslc (CompileShaders); drawing one object per draw");
+    }
+
     return true;
 }
 
@@ -2814,6 +3161,7 @@ void VulkanRenderer::BeginDebugLinePass() {
     }
     vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS,
                       debugLinePipeline);
+    m_vertexLayout = VertexLayout::Standard;
 }
 
 void VulkanRenderer::EndDebugLinePass() {
@@ -3019,7 +3367,8 @@ bool VulkanRenderer::CreateSkinnedPipeline() {
 
     attributeDescs[5].binding = 0;
     attributeDescs[5].location = 5;
-    attributeDescs[5].format = VK_FORMAT_R32G32B32A32_SINT;
+    // Read as uvec4: the -1 of unused slots fails the MAX_BONES check
+    attributeDescs[5].format = VK_FORMAT_R32G32B32A32_UINT;
     attributeDescs[5].offset = offsetof(Vertex, boneIDs);
 
     attributeDescs[6].binding = 0;
@@ -3113,6 +3462,9 @@ bool VulkanRenderer::CreateSkinnedPipeline() {
         return false;
     }
 
+    CreateLayoutVariants(pipelineInfo, *skinnedShader, m_skinnedVariants,
+                         {VertexLayout::SkinnedCompact});
+
     SLEAK_INFO("VulkanRenderer: Skinned pipeline created successfully");
     return true;
 }
@@ -3124,7 +3476,8 @@ void VulkanRenderer::BeginSkinnedPass() {
     }
 
     vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      skinnedPipeline);
+                      GetLayoutPipeline(skinnedPipeline, m_skinnedVariants));
+    m_skinnedPassActive = true;
 
     // Do NOT rebind texture descriptor sets here — BindMaterialCommand already
     // bound the correct per-material texture at set 0 before this draw call.
@@ -3136,7 +3489,9 @@ void VulkanRenderer::EndSkinnedPass() {
     if (!bFrameStarted) return;
     // Restore main pipeline. Descriptor sets are preserved across compatible
     // pipeline switches so no rebinding needed.
-    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                      GetLayoutPipeline(pipeline, m_mainVariants));
+    m_skinnedPassActive = false;
 }
 
 void VulkanRenderer::BindBoneBuffer(RefPtr<BufferBase> buffer) {
@@ -3169,6 +3524,119 @@ void VulkanRenderer::BindBoneBuffer(RefPtr<BufferBase> buffer) {
                             0, nullptr);
 }
 
+// -----------------------------------------------------------------------
+// Instanced Draws
+// -----------------------------------------------------------------------
+
+bool VulkanRenderer::CreateInstanceDescriptorSets() {
+    if (m_instanceDescriptorPool) return true;
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = MAX_FRAMES_IN_FLIGHT;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+    poolInfo.maxSets = MAX_FRAMES_IN_FLIGHT;
+
+    if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_instanceDescriptorPool) != VK_SUCCESS) {
+        SLEAK_ERROR("Failed to create instance descriptor pool!");
+        return false;
+    }
+
+    std::array<VkDescriptorSetLayout, MAX_FRAMES_IN_FLIGHT> layouts;
+    layouts.fill(m_instanceDescriptorSetLayout);
+
+    VkDescriptorSetAllocateInfo dsAllocInfo{};
+    dsAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    dsAllocInfo.descriptorPool = m_instanceDescriptorPool;
+    dsAllocInfo.descriptorSetCount = MAX_FRAMES_IN_FLIGHT;
+    dsAllocInfo.pSetLayouts = layouts.data();
+
+    if (vkAllocateDescriptorSets(device, &dsAllocInfo, m_instanceDescriptorSets.data()) != VK_SUCCESS) {
+        SLEAK_ERROR("Failed to allocate instance descriptor sets!");
+        vkDestroyDescriptorPool(device, m_instanceDescriptorPool, nullptr);
+        m_instanceDescriptorPool = VK_NULL_HANDLE;
+        return false;
+    }
+
+    m_instanceSetBuffers = {};
+    return true;
+}
+
+// The skinned pipeline keeps its push constants, so its draws fall back
+// to one draw per object. The shadow pipeline does too, but reads the
+// World matrix of a single instance straight from the mapped buffer.
+bool VulkanRenderer::BeginInstancedDraw(RefPtr<BufferBase> instances,
+                                        uint32_t firstInstance) {
+    if (!bFrameStarted || m_skinnedPassActive) return false;
+
+    auto* vkBuf = dynamic_cast<VulkanBuffer*>(instances.get());
+    if (!vkBuf || vkBuf->GetVkBuffer() == VK_NULL_HANDLE) return false;
+
+    if (m_shadowPassActive) {
+        // {WVP, World} per instance, as the queue writes them
+        const auto* data = static_cast<const char*>(vkBuf->GetData());
+        const size_t offset = static_cast<size_t>(firstInstance) * 128;
+        if (!data || offset + 128 > vkBuf->GetSize()) return false;
+
+        PushShadowTransform(reinterpret_cast<const float*>(data + offset + 64));
+        return true;
+    }
+
+    VkPipeline instancedPipeline = GetLayoutPipeline(VK_NULL_HANDLE, m_instancedVariants);
+    if (instancedPipeline == VK_NULL_HANDLE) return false;
+    if (!CreateInstanceDescriptorSets()) return false;
+
+    // The queue uploads one instance buffer per frame. The set may only be
+    // rewritten before this frame's command buffer first binds it.
+    VkDescriptorSet set = m_instanceDescriptorSets[currentFrame];
+    if (m_instanceSetBuffers[currentFrame] != vkBuf->GetVkBuffer()) {
+        if (m_instanceSetBound[currentFrame]) return false;
+
+        VkDescriptorBufferInfo bufInfo{};
+        bufInfo.buffer = vkBuf->GetVkBuffer();
+        bufInfo.offset = 0;
+        bufInfo.range = VK_WHOLE_SIZE;
+
+        VkWriteDescriptorSet descriptorWrite{};
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.dstSet = set;
+        descriptorWrite.dstBinding = 0;
+        descriptorWrite.dstArrayElement = 0;
+        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrite.descriptorCount = 1;
+        descriptorWrite.pBufferInfo = &bufInfo;
+
+        vkUpdateDescriptorSets(device, 1, &descriptorWrite, 0, nullptr);
+        m_instanceSetBuffers[currentFrame] = vkBuf->GetVkBuffer();
+    }
+
+    if (!m_instanceSetBound[currentFrame]) {
+        vkCmdBindDescriptorSets(command, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                pipelineLay, 4, 1, &set, 0, nullptr);
+        m_instanceSetBound[currentFrame] = true;
+    }
+
+    vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS, instancedPipeline);
+    m_firstInstance = firstInstance;
+    m_instancedDrawActive = true;
+    return true;
+}
+
+void VulkanRenderer::EndInstancedDraw() {
+    if (!m_instancedDrawActive) return;
+    m_instancedDrawActive = false;
+    m_firstInstance = 0;
+
+    // Descriptor sets stay bound across the compatible pipeline switch
+    if (bFrameStarted)
+        vkCmdBindPipeline(command, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          GetLayoutPipeline(pipeline, m_mainVariants));
+}
+
 // -----------------------------------------------------------------------
 // Shadow Mapping Resources
 // -----------------------------------------------------------------------
@@ -3257,7 +3725,9 @@ bool VulkanRenderer::CreateShadowResources() {
     depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    // Left as written: the frame graph's barrier before the main pass
+    // moves it to SHADER_READ_ONLY_OPTIMAL
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
     VkAttachmentReference depthRef{};
     depthRef.attachment = 0;
@@ -3268,8 +3738,9 @@ bool VulkanRenderer::CreateShadowResources() {
     subpass.colorAttachmentCount = 0;
     subpass.pDepthStencilAttachment = &depthRef;
 
-    // Dependencies for layout transitions
-    std::array<VkSubpassDependency, 2> dependencies{};
+    // Last frame's main pass sampled the map before this one clears it.
+    // The way out to the main pass is the frame graph's barrier.
+    std::array<VkSubpassDependency, 1> dependencies{};
 
     dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
     dependencies[0].dstSubpass = 0;
@@ -3279,14 +3750,6 @@ bool VulkanRenderer::CreateShadowResources() {
     dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
     dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
-    dependencies[1].srcSubpass = 0;
-    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    dependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-    dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
     VkRenderPassCreateInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
     renderPassInfo.attachmentCount = 1;
@@ -3459,6 +3922,9 @@ bool VulkanRenderer::CreateShadowPipeline() {
         return false;
     }
 
+    CreateLayoutVariants(pipelineInfo, *m_shadowShader, m_shadowVariants,
+                         {VertexLayout::StaticCompact, VertexLayout::SkinnedCompact});
+
     SLEAK_INFO("VulkanRenderer: Shadow pipeline created successfully");
     return true;
 }
@@ -3597,6 +4063,7 @@ void VulkanRenderer::CleanupShadowResources() {
         vkDestroyPipeline(device, m_shadowPipeline, nullptr);
         m_shadowPipeline = VK_NULL_HANDLE;
     }
+    DestroyLayoutVariants(m_shadowVariants);
     delete m_shadowShader;
     m_shadowShader = nullptr;
 
@@ -1,7 +1,10 @@
 #include "../../include/private/Graphics/Vulkan/VulkanShader.hpp"
 #include "vulkan/vulkan_core.h"
 #include <Logger.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <utility>
 #include <vector>
 #include <fstream>
 
@@ -39,6 +42,7 @@ bool VulkanShader::compile(const std::string& vert, const std::string& frag) {
     vertShader = createShaderModule(vertCode);
     if(!vertShader)
         SLEAK_RETURN_ERR("Failed to create vertex shader!");
+    ReflectVertex(vertCode);
     
     fragShader = createShaderModule(fragCode);
     if(!fragShader)
@@ -70,6 +74,7 @@ bool VulkanShader::compileVertexOnly(const std::string& vertPath) {
     vertShader = createShaderModule(vertCode);
     if (!vertShader)
         SLEAK_RETURN_ERR("Failed to create vertex shader!");
+    ReflectVertex(vertCode);
 
     vertexInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
     vertexInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
@@ -80,6 +85,50 @@ bool VulkanShader::compileVertexOnly(const std::string& vertPath) {
     return true;
 }
 
+bool VulkanShader::HasVertexSpecConstant(uint32_t id) const {
+    return std::find(vertexSpecIds.begin(), vertexSpecIds.end(), id) != vertexSpecIds.end();
+}
+
+// Walks the module for OpDecorate <id> SpecId/Location and the Input
+// storage class OpVariables the locations belong to
+void VulkanShader::ReflectVertex(const std::vector<char>& code) {
+    constexpr uint32_t HEADER_WORDS = 5;
+    constexpr uint32_t OP_VARIABLE = 59;
+    constexpr uint32_t OP_DECORATE = 71;
+    constexpr uint32_t DECORATION_SPEC_ID = 1;
+    constexpr uint32_t DECORATION_LOCATION = 30;
+    constexpr uint32_t STORAGE_CLASS_INPUT = 1;
+
+    std::vector<uint32_t> words(code.size() / sizeof(uint32_t));
+    std::memcpy(words.data(), code.data(), words.size() * sizeof(uint32_t));
+
+    std::vector<std::pair<uint32_t, uint32_t>> locations;   // {id, location}
+    std::vector<uint32_t> inputs;
+    vertexSpecIds.clear();
+    vertexInputs.clear();
+
+    for (size_t i = HEADER_WORDS; i < words.size();) {
+        const uint32_t wordCount = words[i] >> 16;
+        const uint32_t opcode = words[i] & 0xFFFF;
+        if (wordCount == 0 || i + wordCount > words.size()) break;
+
+        if (opcode == OP_DECORATE && wordCount >= 4) {
+            if (words[i + 2] == DECORATION_SPEC_ID)
+                vertexSpecIds.push_back(words[i + 3]);
+            else if (words[i + 2] == DECORATION_LOCATION)
+                locations.emplace_back(words[i + 1], words[i + 3]);
+        } else if (opcode == OP_VARIABLE && wordCount >= 4 && words[i + 3] == STORAGE_CLASS_INPUT) {
+            inputs.push_back(words[i + 2]);
+        }
+        i += wordCount;
+    }
+
+    for (const auto& [id, location] : locations) {
+        if (std::find(inputs.begin(), inputs.end(), id) != inputs.end())
+            vertexInputs.push_back(location);
+    }
+}
+
 void VulkanShader::bind() {
 
 }
@@ -187,6 +187,9 @@ void Window::SetFullScreen(bool isFullscreen) {
 }
 
 void Window::SetRelativeMouseMode(bool enabled) {
+  // Never opened when running headless
+  if (!SDLWindow)
+    return;
   SDL_SetWindowRelativeMouseMode(SDLWindow, enabled);
 }
 
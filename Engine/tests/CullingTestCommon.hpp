@@ -0,0 +1,40 @@
+#ifndef _SLEAK_CULLING_TEST_COMMON_HPP_
+#define _SLEAK_CULLING_TEST_COMMON_HPP_
+
+// Shared setup for the frustum and culling tests: projections and
+// renderable objects the CullingSystem picks up.
+
+#include <Core/GameObject.hpp>
+#include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <Graphics/BufferBase.hpp>     // Complete for MeshComponent's buffers
+#include <Math/Matrix.hpp>
+#include <Math/Vector.hpp>
+
+namespace Sleak::Test {
+    // Row-vector, [0, 1] depth orthographic projection, as the shadow map uses
+    inline Math::Matrix4 Orthographic(float left, float right, float bottom, float top,
+                                      float nearPlane, float farPlane) {
+        Math::Matrix4 projection = Math::Matrix4::Identity();
+        projection(0, 0) = 2.0f / (right - left);
+        projection(1, 1) = 2.0f / (top - bottom);
+        projection(2, 2) = 1.0f / (farPlane - nearPlane);
+        projection(3, 0) = -(right + left) / (right - left);
+        projection(3, 1) = -(top + bottom) / (top - bottom);
+        projection(3, 2) = -nearPlane / (farPlane - nearPlane);
+        return projection;
+    }
+
+    // A unit box mesh at (x, 0, 50), in front of the projections above
+    inline GameObject* CreateRenderable(const char* name, float x, bool isStatic = false) {
+        auto* object = new GameObject(name);
+        object->SetStatic(isStatic);
+        object->AddComponent<TransformComponent>(Math::Vector3D(x, 0.0f, 50.0f));
+        object->AddComponent<MeshComponent>();
+        object->GetComponent<MeshComponent>()->SetLocalBounds(
+            Physics::AABB(Math::Vector3D(-1.0f, -1.0f, -1.0f), Math::Vector3D(1.0f, 1.0f, 1.0f)));
+        return object;
+    }
+}
+
+#endif // _SLEAK_CULLING_TEST_COMMON_HPP_
@@ -0,0 +1,240 @@
+// Compiles FrameGraphs on the CPU only and checks the passes it culls, the
+// barriers it places, how it aliases transient memory and what Execute runs.
+
+#include "TestCommon.hpp"
+
+#include <Graphics/FrameGraph.hpp>
+#include <Logger.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::RenderEngine;
+
+namespace {
+
+constexpr uint64_t MB = 1024 * 1024;
+
+FrameGraphResourceDesc Desc(uint64_t size, uint64_t alignment = 256, uint32_t typeMask = ~0u) {
+    FrameGraphResourceDesc desc;
+    desc.size = size;
+    desc.alignment = alignment;
+    desc.typeMask = typeMask;
+    return desc;
+}
+
+bool HasBarrier(const FrameGraph& graph, uint32_t pass, uint32_t resource,
+                FrameGraphAccess before, FrameGraphAccess after) {
+    for (const auto& barrier : graph.GetBarriers(pass)) {
+        if (barrier.resource == resource && barrier.before == before && barrier.after == after)
+            return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main() {
+    Logger::Init("FrameGraphTest");
+
+    // The renderer's graph: shadow map, then the main pass into the
+    // swapchain with its depth and MSAA attachments
+    {
+        FrameGraph graph;
+        const uint32_t backbuffer = graph.Import("Backbuffer");
+        const uint32_t depth = graph.CreateTransient("Depth", Desc(8 * MB));
+        const uint32_t msaa = graph.CreateTransient("MSAAColor", Desc(32 * MB));
+        const uint32_t shadowMap = graph.Import("ShadowMap", false);
+
+        const uint32_t shadow = graph.AddPass("Shadow", nullptr);
+        graph.Write(shadow, shadowMap);
+        const uint32_t main = graph.AddPass("Main", nullptr);
+        graph.Read(main, shadowMap);
+        graph.Write(main, depth);
+        graph.Write(main, msaa);
+        graph.Write(main, backbuffer);
+
+        CHECK(graph.Compile());
+        CHECK(!graph.IsCulled(shadow));
+        CHECK(!graph.IsCulled(main));
+        CHECK(graph.GetBarriers(shadow).empty());
+        CHECK(graph.GetBarriers(main).size() == 1);
+        CHECK(HasBarrier(graph, main, shadowMap, FrameGraphAccess::Write, FrameGraphAccess::Read));
+
+        // One pass uses both attachments: nothing to alias
+        CHECK(graph.GetMemorySlot(backbuffer) == FrameGraph::INVALID);
+        CHECK(graph.GetMemorySlot(shadowMap) == FrameGraph::INVALID);
+        CHECK(graph.GetMemorySlot(depth) != graph.GetMemorySlot(msaa));
+        CHECK(graph.GetStats().memorySlots == 2);
+        CHECK(graph.GetStats().transientBytes == 40 * MB);
+        CHECK(graph.GetStats().GetSavedBytes() == 0);
+
+        // Without a reader the shadow pass goes
+        graph.Clear();
+        const uint32_t target = graph.Import("Backbuffer");
+        const uint32_t unread = graph.Import("ShadowMap", false);
+        const uint32_t unused = graph.AddPass("Shadow", nullptr);
+        graph.Write(unused, unread);
+        const uint32_t kept = graph.AddPass("Main", nullptr);
+        graph.Write(kept, target);
+        CHECK(graph.Compile());
+        CHECK(graph.IsCulled(unused));
+        CHECK(!graph.IsCulled(kept));
+        CHECK(graph.GetStats().culledPasses == 1);
+    }
+
+    // A post-process chain: the bloom targets are dead before the
+    // tonemap output is written, so they share memory
+    {
+        FrameGraph graph;
+        const uint32_t backbuffer = graph.Import("Backbuffer");
+        const uint32_t scene = graph.CreateTransient("Scene", Desc(32 * MB));
+        const uint32_t bright = graph.CreateTransient("Bright", Desc(8 * MB));
+        const uint32_t blur = graph.CreateTransient("Blur", Desc(8 * MB));
+        const uint32_t tonemapped = graph.CreateTransient("Tonemapped", Desc(16 * MB));
+        const uint32_t debug = graph.CreateTransient("Debug", Desc(4 * MB));
+
+        const uint32_t geometry = graph.AddPass("Geometry", nullptr);
+        graph.Write(geometry, scene);
+        const uint32_t extract = graph.AddPass("Extract", nullptr);
+        graph.Read(extract, scene);
+        graph.Write(extract, bright);
+        const uint32_t blurPass = graph.AddPass("Blur", nullptr);
+        graph.Read(blurPass, bright);
+        graph.Write(blurPass, blur);
+        const uint32_t tonemap = graph.AddPass("Tonemap", nullptr);
+        graph.Read(tonemap, scene);
+        graph.Read(tonemap, blur);
+        graph.Write(tonemap, tonemapped);
+        const uint32_t present = graph.AddPass("Present", nullptr);
+        graph.Read(present, tonemapped);
+        graph.Write(present, backbuffer);
+        const uint32_t visualize = graph.AddPass("Visualize", nullptr);   // Nobody reads its output
+        graph.Read(visualize, scene);
+        graph.Write(visualize, debug);
+
+        CHECK(graph.Compile());
+        CHECK(graph.IsCulled(visualize));
+        CHECK(graph.GetMemorySlot(debug) == FrameGraph::INVALID);
+
+        // Read after write on every hand-over, reads of scene don't wait on each other
+        CHECK(HasBarrier(graph, extract, scene, FrameGraphAccess::Write, FrameGraphAccess::Read));
+        CHECK(HasBarrier(graph, blurPass, bright, FrameGraphAccess::Write, FrameGraphAccess::Read));
+        CHECK(HasBarrier(graph, tonemap, blur, FrameGraphAccess::Write, FrameGraphAccess::Read));
+        CHECK(!HasBarrier(graph, tonemap, scene, FrameGraphAccess::Read, FrameGraphAccess::Read));
+        CHECK(graph.GetStats().barriers == 4);
+
+        // Scene lives through tonemap, bright dies at blur and tonemapped
+        // starts after it: bright and tonemapped share a slot
+        CHECK(graph.GetMemorySlot(bright) == graph.GetMemorySlot(tonemapped));
+        CHECK(graph.GetMemorySlot(scene) != graph.GetMemorySlot(bright));
+        CHECK(graph.GetMemorySlot(blur) != graph.GetMemorySlot(bright));
+        CHECK(graph.GetStats().transientBytes == 64 * MB);
+        CHECK(graph.GetStats().allocatedBytes == 56 * MB);
+        CHECK(graph.GetStats().GetSavedBytes() == 8 * MB);
+
+        const auto& slots = graph.GetMemorySlots();
+        CHECK(slots[graph.GetMemorySlot(tonemapped)].size == 16 * MB);
+    }
+
+    // Write after read and write after write on one resource
+    {
+        FrameGraph graph;
+        const uint32_t history = graph.Import("History");
+        const uint32_t first = graph.AddPass("Resolve", nullptr);
+        graph.Write(first, history);
+        const uint32_t second = graph.AddPass("Sample", nullptr);
+        graph.Read(second, history);
+        graph.KeepPass(second);          // Writes nothing, would be culled
+        const uint32_t third = graph.AddPass("Overwrite", nullptr);
+        graph.Write(third, history);
+        const uint32_t fourth = graph.AddPass("Overwrite again", nullptr);
+        graph.Read(fourth, history);     // Read and write in one pass count as a write
+        graph.Write(fourth, history);
+
+        CHECK(graph.Compile());
+        CHECK(HasBarrier(graph, second, history, FrameGraphAccess::Write, FrameGraphAccess::Read));
+        CHECK(HasBarrier(graph, third, history, FrameGraphAccess::Read, FrameGraphAccess::Write));
+        CHECK(HasBarrier(graph, fourth, history, FrameGraphAccess::Write, FrameGraphAccess::Write));
+        CHECK(graph.GetBarriers(fourth).size() == 1);
+    }
+
+    // Incompatible memory types and alignment
+    {
+        FrameGraph graph;
+        const uint32_t backbuffer = graph.Import("Backbuffer");
+        const uint32_t first = graph.CreateTransient("First", Desc(1000, 256, 0x1));
+        const uint32_t second = graph.CreateTransient("Second", Desc(3000, 1024, 0x2));
+        const uint32_t third = graph.CreateTransient("Third", Desc(500, 4096, 0x3));
+
+        const uint32_t a = graph.AddPass("A", nullptr);
+        graph.Write(a, first);
+        const uint32_t b = graph.AddPass("B", nullptr);
+        graph.Read(b, first);
+        graph.Write(b, second);
+        const uint32_t c = graph.AddPass("C", nullptr);
+        graph.Read(c, second);
+        graph.Write(c, third);
+        const uint32_t d = graph.AddPass("D", nullptr);
+        graph.Read(d, third);
+        graph.Write(d, backbuffer);
+
+        CHECK(graph.Compile());
+        // First and second overlap in B; third fits either type but
+        // overlaps second in C, so it joins first
+        CHECK(graph.GetMemorySlot(first) != graph.GetMemorySlot(second));
+        CHECK(graph.GetMemorySlot(third) == graph.GetMemorySlot(first));
+
+        const FrameGraphMemorySlot& shared = graph.GetMemorySlots()[graph.GetMemorySlot(first)];
+        CHECK(shared.typeMask == 0x1);
+        CHECK(shared.alignment == 4096);
+        CHECK(shared.size == 4096);
+    }
+
+    // Declaring a missing pass or resource fails the compile
+    {
+        FrameGraph graph;
+        const uint32_t pass = graph.AddPass("Pass", nullptr);
+        graph.Write(pass, 7);
+        CHECK(!graph.Compile());
+        CHECK(!graph.IsCompiled());
+
+        graph.Clear();
+        graph.KeepPass(3);
+        CHECK(!graph.Compile());
+    }
+
+    // Execute runs kept passes in order, each after its barriers
+    {
+        FrameGraph graph;
+        std::vector<std::string> log;
+        const uint32_t backbuffer = graph.Import("Backbuffer");
+        const uint32_t color = graph.CreateTransient("Color", Desc(MB));
+        const uint32_t stats = graph.CreateTransient("Stats", Desc(MB));
+
+        graph.AddPass("Draw", [&log](RenderContext*) { log.push_back("Draw"); });
+        graph.Write(0, color);
+        graph.AddPass("Unused", [&log](RenderContext*) { log.push_back("Unused"); });
+        graph.Write(1, stats);
+        graph.AddPass("Marker", [&log](RenderContext*) { log.push_back("Marker"); });
+        graph.KeepPass(2);
+        graph.AddPass("Present", [&log](RenderContext*) { log.push_back("Present"); });
+        graph.Read(3, color);
+        graph.Write(3, backbuffer);
+
+        // Nothing runs before a compile
+        graph.Execute(nullptr);
+        CHECK(log.empty());
+
+        CHECK(graph.Compile());
+        graph.Execute(nullptr, [&log, &graph](const std::vector<FrameGraphBarrier>& barriers) {
+            for (const auto& barrier : barriers)
+                log.push_back("Barrier " + graph.GetResourceName(barrier.resource));
+        });
+        const std::vector<std::string> expected = {"Draw", "Marker", "Barrier Color", "Present"};
+        CHECK(log == expected);
+    }
+
+    return TEST_RESULT();
+}
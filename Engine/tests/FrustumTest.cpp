@@ -0,0 +1,118 @@
+// Checks ViewFrustum::TestAABBs, the batched box test the CullingSystem
+// runs on the leaves the frustum cuts, against the per-box IsAABBVisible.
+
+#include "CullingTestCommon.hpp"
+#include "TestCommon.hpp"
+
+#include <Camera/ViewFrustum.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/Vector.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::Math;
+using Sleak::Test::Orthographic;
+
+namespace {
+
+// Deterministic boxes spread around and across the frustum
+struct Boxes {
+    std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+
+    explicit Boxes(size_t count) {
+        uint32_t state = 12345u;
+        auto next = [&state](float low, float high) {
+            state = state * 1664525u + 1013904223u;
+            return low + (high - low) * static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+        };
+        for (size_t i = 0; i < count; ++i) {
+            const float x = next(-60.0f, 60.0f), y = next(-60.0f, 60.0f), z = next(-40.0f, 140.0f);
+            const float ex = next(0.1f, 8.0f), ey = next(0.1f, 8.0f), ez = next(0.1f, 8.0f);
+            Add(Vector3D(x - ex, y - ey, z - ez), Vector3D(x + ex, y + ey, z + ez));
+        }
+    }
+
+    void Add(const Vector3D& min, const Vector3D& max) {
+        minX.push_back(min.GetX()); minY.push_back(min.GetY()); minZ.push_back(min.GetZ());
+        maxX.push_back(max.GetX()); maxY.push_back(max.GetY()); maxZ.push_back(max.GetZ());
+    }
+
+    size_t Size() const { return minX.size(); }
+};
+
+// Every box, and every prefix length, matches the scalar test
+void CheckMatchesScalar(const ViewFrustum& frustum, const Boxes& boxes, size_t& visibleCount) {
+    std::vector<uint8_t> visible(boxes.Size(), 0xCD);
+    frustum.TestAABBs(boxes.minX.data(), boxes.minY.data(), boxes.minZ.data(),
+                      boxes.maxX.data(), boxes.maxY.data(), boxes.maxZ.data(),
+                      boxes.Size(), visible.data());
+
+    visibleCount = 0;
+    for (size_t i = 0; i < boxes.Size(); ++i) {
+        const bool expected = frustum.IsAABBVisible(Vector3D(boxes.minX[i], boxes.minY[i], boxes.minZ[i]),
+                                                    Vector3D(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]));
+        CHECK(visible[i] == (expected ? 1 : 0));
+        visibleCount += expected ? 1 : 0;
+    }
+}
+
+}  // namespace
+
+int main() {
+    // Axis-aligned: x and y in [-10, 10], z in [0, 100]
+    ViewFrustum box;
+    box.ExtractFromVP(Orthographic(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 100.0f));
+
+    Boxes known(0);
+    known.Add(Vector3D(-1.0f, -1.0f, 10.0f), Vector3D(1.0f, 1.0f, 12.0f));      // Inside
+    known.Add(Vector3D(9.0f, -1.0f, 10.0f), Vector3D(11.0f, 1.0f, 12.0f));      // Crosses the right plane
+    known.Add(Vector3D(11.0f, -1.0f, 10.0f), Vector3D(13.0f, 1.0f, 12.0f));     // Right of it
+    known.Add(Vector3D(-1.0f, -1.0f, -5.0f), Vector3D(1.0f, 1.0f, -1.0f));      // Behind the near plane
+    known.Add(Vector3D(-1.0f, -1.0f, 101.0f), Vector3D(1.0f, 1.0f, 102.0f));    // Past the far plane
+    known.Add(Vector3D(-50.0f, -50.0f, -50.0f), Vector3D(50.0f, 50.0f, 150.0f)); // Encloses the frustum
+
+    std::vector<uint8_t> visible(known.Size());
+    box.TestAABBs(known.minX.data(), known.minY.data(), known.minZ.data(),
+                  known.maxX.data(), known.maxY.data(), known.maxZ.data(),
+                  known.Size(), visible.data());
+    const uint8_t expected[] = {1, 1, 0, 0, 0, 1};
+    for (size_t i = 0; i < known.Size(); ++i)
+        CHECK(visible[i] == expected[i]);
+
+    // Nothing to test leaves the output alone
+    uint8_t untouched = 0xCD;
+    box.TestAABBs(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, 0, &untouched);
+    CHECK(untouched == 0xCD);
+
+    // Oblique planes: a rotated orthographic view and a perspective one
+    ViewFrustum rotated;
+    rotated.ExtractFromVP(Matrix4::LookTo(Vector<float, 3>({20.0f, 30.0f, -20.0f}),
+                                          Vector<float, 3>({-0.3f, -0.5f, 1.0f}),
+                                          Vector<float, 3>({0.0f, 1.0f, 0.0f})) *
+                          Orthographic(-25.0f, 25.0f, -15.0f, 15.0f, 1.0f, 120.0f));
+
+    ViewFrustum perspective;
+    perspective.ExtractFromVP(Matrix4::LookTo(Vector<float, 3>({0.0f, 5.0f, -10.0f}),
+                                              Vector<float, 3>({0.2f, -0.1f, 1.0f}),
+                                              Vector<float, 3>({0.0f, 1.0f, 0.0f})) *
+                              Matrix4::Perspective(1.0f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+    // Odd counts leave a tail after any vector width
+    for (size_t count : {1u, 7u, 37u, 1000u}) {
+        const Boxes boxes(count);
+        size_t inBox = 0, inRotated = 0, inPerspective = 0;
+        CheckMatchesScalar(box, boxes, inBox);
+        CheckMatchesScalar(rotated, boxes, inRotated);
+        CheckMatchesScalar(perspective, boxes, inPerspective);
+
+        // Both outcomes occur, so the comparison covers real work
+        if (count == 1000) {
+            CHECK(inBox > 0 && inBox < count);
+            CHECK(inRotated > 0 && inRotated < count);
+            CHECK(inPerspective > 0 && inPerspective < count);
+        }
+    }
+
+    return TEST_RESULT();
+}
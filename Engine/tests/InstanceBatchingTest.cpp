@@ -0,0 +1,201 @@
+// Checks the transform uploads OptimizeBatching defers when it merges draws
+// into an instanced draw: they stay off the buffers while nothing binds
+// them, reach a buffer that is later bound on its own, give way to a newer
+// upload, and let go of the buffers when the queue is cleared. The shadow
+// pass replays merged draws from the instance buffer by instance index,
+// and only uploads the transforms when the context cannot.
+
+#include "TestCommon.hpp"
+
+#include <Graphics/Null/NullRenderer.hpp>
+#include <Graphics/Null/NullResources.hpp>
+#include <Graphics/RenderCommandQueue.hpp>
+#include <Graphics/RenderCommands.hpp>
+#include <Graphics/ResourceManager.hpp>
+#include <Logger.hpp>
+#include <Math/Matrix.hpp>
+#include <Runtime/Material.hpp>
+#include <cstring>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::RenderEngine;
+
+namespace {
+
+constexpr uint32_t OBJECT_COUNT = 3;
+
+// Keeps the last contents and counts the uploads
+class CountingBuffer : public NullBuffer {
+public:
+    CountingBuffer(uint32_t size, BufferType type) : NullBuffer(size, type) {}
+
+    void Update(void* data, size_t size) override {
+        ++updates;
+        contents.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        NullBuffer::Update(data, size);
+    }
+
+    uint32_t updates = 0;
+    std::vector<uint8_t> contents;
+};
+
+class RecordingRenderer : public NullRenderer {
+public:
+    RecordingRenderer() : NullRenderer(64, 64) {}
+
+    bool BeginInstancedDraw(RefPtr<BufferBase> instances, uint32_t firstInstance) override {
+        if (!instancing) return false;
+        firstInstances.push_back(firstInstance);
+        return NullRenderer::BeginInstancedDraw(instances, firstInstance);
+    }
+
+    void DrawIndexedInstance(uint32_t instanceCount, uint32_t indexPerInstance,
+                             uint32_t startIndex, int32_t baseVertex) override {
+        instanceCounts.push_back(instanceCount);
+        NullRenderer::DrawIndexedInstance(instanceCount, indexPerInstance, startIndex, baseVertex);
+    }
+
+    void BindConstantBuffer(RefPtr<BufferBase> buffer, uint32_t slot) override {
+        boundConstants.push_back(buffer.get());
+        NullRenderer::BindConstantBuffer(buffer, slot);
+    }
+
+    BufferBase* CreateCountingBuffer(BufferType type, uint32_t size, void* data) {
+        auto* buffer = new CountingBuffer(size, type);
+        buffer->Initialize(data);
+        return buffer;
+    }
+
+    void ClearLog() {
+        firstInstances.clear();
+        instanceCounts.clear();
+        boundConstants.clear();
+    }
+
+    bool instancing = true;
+    std::vector<uint32_t> firstInstances;
+    std::vector<uint32_t> instanceCounts;
+    std::vector<const BufferBase*> boundConstants;
+};
+
+// {WVP, World} as TransformComponent uploads it
+struct TransformData {
+    Math::Matrix4 wvp;
+    Math::Matrix4 world;
+};
+
+Math::Matrix4 Translation(float x) {
+    Math::Matrix4 matrix = Math::Matrix4::Identity();
+    matrix(3, 0) = x;
+    return matrix;
+}
+
+}  // namespace
+
+int main() {
+    Logger::Init("InstanceBatchingTest");
+
+    RecordingRenderer renderer;
+    CHECK(renderer.Initialize());
+    ResourceManager::RegisterCreateBuffer(&renderer, &RecordingRenderer::CreateCountingBuffer);
+
+    auto* queue = RenderCommandQueue::GetInstance();
+    RefPtr<BufferBase> vertices(new NullBuffer(64, BufferType::Vertex));
+    RefPtr<BufferBase> indices(new NullBuffer(64, BufferType::Index));
+    Material material;
+    CHECK(material.IsInstancingEnabled());
+
+    std::vector<RefPtr<BufferBase>> transforms;
+    std::vector<CountingBuffer*> counters;
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i) {
+        auto* buffer = new CountingBuffer(sizeof(TransformData), BufferType::Constant);
+        transforms.push_back(RefPtr<BufferBase>(buffer));
+        counters.push_back(buffer);
+    }
+
+    auto submitObject = [&](uint32_t i) {
+        TransformData data{Translation(static_cast<float>(i)), Translation(static_cast<float>(i))};
+        queue->SubmitUpdateConstantBuffer(transforms[i], &data, sizeof(data));
+        queue->SubmitBindConstantBuffer(transforms[i], 0);
+        queue->SubmitBindMaterial(&material);
+        auto* draw = static_cast<DrawIndexedCommand*>(queue->SubmitDrawIndexed(vertices, indices, {}, 3));
+        draw->SetWorldMatrix(Translation(static_cast<float>(i)));
+    };
+
+    // One instanced draw; the transform uploads wait in their slots
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i) submitObject(i);
+    renderer.BeginRender();
+    queue->ExecuteCommands(&renderer);
+    renderer.EndRender();
+
+    CHECK(queue->GetDrawsMerged() == static_cast<int32_t>(OBJECT_COUNT) - 1);
+    CHECK(queue->GetTransformUploadsDeferred() == static_cast<int32_t>(OBJECT_COUNT));
+    CHECK(renderer.instanceCounts == std::vector<uint32_t>({OBJECT_COUNT}));
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i) {
+        CHECK(counters[i]->updates == 0);
+        CHECK(transforms[i]->GetDeferredSlot() != BufferBase::NO_DEFERRED_SLOT);
+        for (uint32_t j = 0; j < i; ++j)
+            CHECK(transforms[i]->GetDeferredSlot() != transforms[j]->GetDeferredSlot());
+    }
+
+    // The shadow pass reads each object's instance, nothing is uploaded
+    renderer.ClearLog();
+    queue->ExecuteShadowPass(&renderer);
+    CHECK(renderer.firstInstances == std::vector<uint32_t>({0, 1, 2}));
+    CHECK(renderer.instanceCounts == std::vector<uint32_t>({1, 1, 1}));
+    CHECK(renderer.boundConstants.empty());
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i)
+        CHECK(counters[i]->updates == 0);
+
+    // Without instancing it binds the transform buffers, which first get
+    // their deferred data
+    renderer.ClearLog();
+    renderer.instancing = false;
+    queue->ExecuteShadowPass(&renderer);
+    renderer.instancing = true;
+    CHECK(renderer.boundConstants.size() == OBJECT_COUNT);
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i) {
+        CHECK(counters[i]->updates == 1);
+        CHECK(counters[i]->contents.size() == sizeof(TransformData));
+        if (counters[i]->contents.size() == sizeof(TransformData)) {
+            TransformData uploaded;
+            std::memcpy(&uploaded, counters[i]->contents.data(), sizeof(uploaded));
+            CHECK(uploaded.world(3, 0) == static_cast<float>(i));
+        }
+    }
+
+    // Merge again, then bind one buffer on its own and update another
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i) submitObject(i);
+    renderer.BeginRender();
+    queue->ExecuteCommands(&renderer);
+    renderer.EndRender();
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i)
+        CHECK(counters[i]->updates == 1);
+
+    TransformData newer{Translation(10.0f), Translation(10.0f)};
+    queue->SubmitBindConstantBuffer(transforms[0], 0);
+    queue->SubmitUpdateConstantBuffer(transforms[1], &newer, sizeof(newer));
+    queue->SubmitBindConstantBuffer(transforms[1], 0);
+    queue->SubmitCustomCommand([](RenderContext*) {});
+    renderer.BeginRender();
+    queue->ExecuteCommands(&renderer);
+    renderer.EndRender();
+
+    CHECK(counters[0]->updates == 2);       // Its deferred data
+    CHECK(counters[1]->updates == 2);       // Only the newer upload
+    CHECK(counters[2]->updates == 1);       // Still deferred
+    TransformData uploaded;
+    std::memcpy(&uploaded, counters[1]->contents.data(), sizeof(uploaded));
+    CHECK(uploaded.world(3, 0) == 10.0f);
+
+    // Cleared, the queue lets go of the buffers and their slots
+    queue->Clear();
+    for (uint32_t i = 0; i < OBJECT_COUNT; ++i) {
+        CHECK(transforms[i]->GetDeferredSlot() == BufferBase::NO_DEFERRED_SLOT);
+        CHECK(transforms[i].use_count() == 1);
+    }
+
+    renderer.Cleanup();
+    return TEST_RESULT();
+}
@@ -0,0 +1,113 @@
+// Rasterizes a single occluder quad into the OcclusionBuffer without a
+// renderer and checks depth values and visibility of boxes around it,
+// serially and with tiles spread over the JobSystem.
+
+#include "TestCommon.hpp"
+
+#include <Camera/OcclusionBuffer.hpp>
+#include <Core/JobSystem.hpp>
+#include <Logger.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/Vector.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::Math;
+
+namespace {
+
+constexpr uint32_t WIDTH = 256;
+constexpr uint32_t HEIGHT = 128;
+constexpr float OCCLUDER_Z = 10.0f;
+
+// Camera at the origin looking down +Z, aspect matching the buffer
+Matrix4 CameraViewProjection() {
+    return Matrix4::LookTo(Vector<float, 3>({0.0f, 0.0f, 0.0f}),
+                           Vector<float, 3>({0.0f, 0.0f, 1.0f}),
+                           Vector<float, 3>({0.0f, 1.0f, 0.0f})) *
+           Matrix4::Perspective(1.0f, float(WIDTH) / float(HEIGHT), 0.1f, 100.0f);
+}
+
+// 6 x 6 quad facing the camera
+void AddQuad(OcclusionBuffer& buffer) {
+    const float positions[] = {
+        -3.0f, -3.0f, OCCLUDER_Z,
+         3.0f, -3.0f, OCCLUDER_Z,
+         3.0f,  3.0f, OCCLUDER_Z,
+        -3.0f,  3.0f, OCCLUDER_Z,
+    };
+    const uint32_t indices[] = {0, 1, 2, 0, 2, 3};
+    buffer.AddOccluder(positions, 4, indices, 6, Matrix4::Identity());
+}
+
+Physics::AABB Box(float x, float y, float z, float halfSize) {
+    return Physics::AABB(Vector3D(x - halfSize, y - halfSize, z - halfSize),
+                         Vector3D(x + halfSize, y + halfSize, z + halfSize));
+}
+
+std::vector<float> Render(OcclusionBuffer& buffer) {
+    buffer.Begin(CameraViewProjection());
+    AddQuad(buffer);
+    buffer.Rasterize();
+
+    std::vector<float> depth;
+    for (uint32_t y = 0; y < HEIGHT; ++y)
+        for (uint32_t x = 0; x < WIDTH; ++x)
+            depth.push_back(buffer.GetDepth(x, y));
+    return depth;
+}
+
+}  // namespace
+
+int main() {
+    Logger::Init("OcclusionBufferTest");
+
+    OcclusionBuffer buffer(WIDTH, HEIGHT);
+
+    // Nothing rasterized: everything is visible
+    buffer.Begin(CameraViewProjection());
+    buffer.Rasterize();
+    CHECK(buffer.GetTriangleCount() == 0);
+    CHECK(buffer.IsVisible(Box(0.0f, 0.0f, 30.0f, 1.0f)));
+
+    const std::vector<float> serial = Render(buffer);
+    CHECK(buffer.GetTriangleCount() == 2);
+
+    // Depth is 1/w: the quad sits at view depth 10, the corners stay empty
+    CHECK_NEAR(buffer.GetDepth(WIDTH / 2, HEIGHT / 2), 1.0f / OCCLUDER_Z, 1e-4f);
+    CHECK(buffer.GetDepth(0, 0) == 0.0f);
+    CHECK(buffer.GetDepth(WIDTH - 1, HEIGHT - 1) == 0.0f);
+
+    CHECK(!buffer.IsVisible(Box(0.0f, 0.0f, 30.0f, 1.0f)));     // Right behind it
+    CHECK(!buffer.IsVisible(Box(1.0f, -1.0f, 20.0f, 0.5f)));    // Behind, off center
+    CHECK(buffer.IsVisible(Box(0.0f, 0.0f, 5.0f, 1.0f)));       // In front of it
+    CHECK(buffer.IsVisible(Box(0.0f, 0.0f, 10.0f, 1.0f)));      // Pierces it
+    CHECK(buffer.IsVisible(Box(25.0f, 0.0f, 40.0f, 1.0f)));     // Beside it
+    CHECK(buffer.IsVisible(Box(9.0f, 0.0f, 30.0f, 2.0f)));      // Sticks out past its edge
+    CHECK(buffer.IsVisible(Box(0.0f, 0.0f, 30.0f, 20.0f)));     // Larger than its shadow
+
+    // The two triangles share the diagonal: the quad's inside has no holes
+    uint32_t left = WIDTH, right = 0, top = HEIGHT, bottom = 0;
+    for (uint32_t x = 0; x < WIDTH; ++x) {
+        if (buffer.GetDepth(x, HEIGHT / 2) > 0.0f) { left = std::min(left, x); right = x; }
+    }
+    for (uint32_t y = 0; y < HEIGHT; ++y) {
+        if (buffer.GetDepth(WIDTH / 2, y) > 0.0f) { top = std::min(top, y); bottom = y; }
+    }
+    CHECK(left < right && top < bottom);
+    uint32_t holes = 0;
+    for (uint32_t y = top; y <= bottom; ++y)
+        for (uint32_t x = left; x <= right; ++x)
+            holes += buffer.GetDepth(x, y) == 0.0f ? 1 : 0;
+    CHECK(holes == 0);
+
+    // Tiles rasterized on workers give the same buffer
+    JobSystem::Initialize(3);
+    const std::vector<float> parallel = Render(buffer);
+    JobSystem::Shutdown();
+    CHECK(serial == parallel);
+
+    return TEST_RESULT();
+}
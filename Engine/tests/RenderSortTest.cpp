@@ -0,0 +1,311 @@
+// Checks RenderSortKey's field packing and clamping, then submits known
+// draws to the RenderCommandQueue and checks the order they execute in:
+// passes in order, opaque front to back, transparent back to front, and
+// barriers (custom commands, render state, draws without a key) keeping
+// their position.
+
+#include "TestCommon.hpp"
+
+#include <Graphics/Null/NullRenderer.hpp>
+#include <Graphics/RenderCommandQueue.hpp>
+#include <Graphics/RenderCommands.hpp>
+#include <Logger.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::RenderEngine;
+
+namespace {
+
+constexpr uint8_t OPAQUE_MODE = 0;
+constexpr uint8_t CUTOUT_MODE = 1;
+constexpr uint8_t TRANSPARENT_MODE = RenderSortKey::TRANSPARENT_MODE;
+
+uint64_t Bits(uint64_t key, uint32_t shift, uint32_t bits) {
+    return (key >> shift) & ((1ull << bits) - 1);
+}
+
+void TestPacking() {
+    const uint64_t key = RenderSortKey::Make(SortPass::Overlay, CUTOUT_MODE, 17, 300, 2049, 4.0f);
+    CHECK(Bits(key, RenderSortKey::PASS_SHIFT, 2) == static_cast<uint64_t>(SortPass::Overlay));
+    CHECK(Bits(key, RenderSortKey::MODE_SHIFT, 2) == CUTOUT_MODE);
+    CHECK(RenderSortKey::GetShader(key) == 17);
+    CHECK(RenderSortKey::GetMaterial(key) == 300);
+    CHECK(RenderSortKey::GetMesh(key) == 2049);
+    // Not transparent: the depth goes to the low bits, the far field stays empty
+    CHECK(Bits(key, RenderSortKey::FAR_DEPTH_SHIFT, RenderSortKey::FAR_DEPTH_BITS) == 0);
+    CHECK(Bits(key, 0, RenderSortKey::NEAR_DEPTH_BITS) ==
+          RenderSortKey::QuantizeDepth(4.0f, RenderSortKey::NEAR_DEPTH_BITS));
+
+    // Transparent: inverted depth in the far field, the low bits stay empty
+    const uint64_t transparent = RenderSortKey::Make(SortPass::Main, TRANSPARENT_MODE, 1, 2, 3, 4.0f);
+    const uint32_t far = RenderSortKey::QuantizeDepth(4.0f, RenderSortKey::FAR_DEPTH_BITS);
+    CHECK(Bits(transparent, RenderSortKey::FAR_DEPTH_SHIFT, RenderSortKey::FAR_DEPTH_BITS) ==
+          (~far & ((1u << RenderSortKey::FAR_DEPTH_BITS) - 1)));
+    CHECK(Bits(transparent, 0, RenderSortKey::NEAR_DEPTH_BITS) == 0);
+    CHECK(RenderSortKey::GetShader(transparent) == 1);
+    CHECK(RenderSortKey::GetMaterial(transparent) == 2);
+    CHECK(RenderSortKey::GetMesh(transparent) == 3);
+}
+
+void TestFieldOverflow() {
+    // Oversized IDs wrap around inside their field instead of spilling
+    // into the next one
+    const uint32_t shaderLimit = (1u << RenderSortKey::SHADER_BITS) - 1;
+    const uint32_t meshLimit = (1u << RenderSortKey::MESH_BITS) - 1;
+    const uint64_t key = RenderSortKey::Make(SortPass::Background, OPAQUE_MODE,
+                                             5000, 1u << 20, 0xFFFFFFFFu, 0.0f);
+    CHECK(RenderSortKey::GetShader(key) == 1 + (5000 - 1) % shaderLimit);
+    CHECK(RenderSortKey::GetMaterial(key) != 0);
+    CHECK(RenderSortKey::GetMesh(key) == 1 + (0xFFFFFFFFu - 1) % meshLimit);
+    CHECK(Bits(key, RenderSortKey::PASS_SHIFT, 2) == 0);
+    CHECK(Bits(key, RenderSortKey::MODE_SHIFT, 2) == 0);
+    CHECK(Bits(key, RenderSortKey::FAR_DEPTH_SHIFT, RenderSortKey::FAR_DEPTH_BITS) == 0);
+    CHECK(Bits(key, 0, RenderSortKey::NEAR_DEPTH_BITS) == 0);
+
+    // The last ID that fits is kept, the ones after it stay apart
+    auto meshOf = [](uint32_t mesh) {
+        return RenderSortKey::GetMesh(RenderSortKey::Make(SortPass::Main, OPAQUE_MODE, 1, 1, mesh, 0.0f));
+    };
+    CHECK(meshOf(meshLimit) == meshLimit);
+    CHECK(meshOf(meshLimit + 1) == 1);
+    CHECK(meshOf(meshLimit + 2) == 2);
+    CHECK(meshOf(meshLimit + 1) != meshOf(meshLimit + 2));
+    CHECK(meshOf(0) == 0);
+
+    // Negative depth counts as the camera position
+    CHECK(RenderSortKey::QuantizeDepth(-3.0f, 10) == 0);
+    CHECK(RenderSortKey::Make(SortPass::Main, OPAQUE_MODE, 1, 1, 1, -3.0f) ==
+          RenderSortKey::Make(SortPass::Main, OPAQUE_MODE, 1, 1, 1, 0.0f));
+
+    // The largest depths still fit their field
+    const float infinity = std::numeric_limits<float>::infinity();
+    CHECK(RenderSortKey::QuantizeDepth(infinity, RenderSortKey::NEAR_DEPTH_BITS) <
+          (1u << RenderSortKey::NEAR_DEPTH_BITS));
+    CHECK(RenderSortKey::QuantizeDepth(infinity, RenderSortKey::FAR_DEPTH_BITS) <
+          (1u << RenderSortKey::FAR_DEPTH_BITS));
+    const uint64_t deep = RenderSortKey::Make(SortPass::Main, OPAQUE_MODE, 7, 8, 9, infinity);
+    CHECK(RenderSortKey::GetMesh(deep) == 9);
+    const uint64_t deepTransparent = RenderSortKey::Make(SortPass::Main, TRANSPARENT_MODE, 7, 8, 9, infinity);
+    CHECK(RenderSortKey::GetShader(deepTransparent) == 7);
+    CHECK(Bits(deepTransparent, RenderSortKey::MODE_SHIFT, 2) == TRANSPARENT_MODE);
+}
+
+void TestOrdering() {
+    // Depth quantization never reorders
+    uint32_t previousNear = 0, previousFar = 0;
+    for (float depth = 0.0f; depth < 10000.0f; depth = depth * 1.01f + 0.01f) {
+        const uint32_t nearDepth = RenderSortKey::QuantizeDepth(depth, RenderSortKey::NEAR_DEPTH_BITS);
+        const uint32_t farDepth = RenderSortKey::QuantizeDepth(depth, RenderSortKey::FAR_DEPTH_BITS);
+        CHECK(nearDepth >= previousNear);
+        CHECK(farDepth >= previousFar);
+        previousNear = nearDepth;
+        previousFar = farDepth;
+    }
+
+    auto key = [](SortPass pass, uint8_t mode, uint32_t shader, float depth) {
+        return RenderSortKey::Make(pass, mode, shader, 1, 1, depth);
+    };
+
+    // Pass first, then mode, whatever the depth
+    CHECK(key(SortPass::Background, TRANSPARENT_MODE, 9, 1.0f) < key(SortPass::Main, OPAQUE_MODE, 0, 900.0f));
+    CHECK(key(SortPass::Main, TRANSPARENT_MODE, 9, 1.0f) < key(SortPass::Overlay, OPAQUE_MODE, 0, 900.0f));
+    CHECK(key(SortPass::Main, OPAQUE_MODE, 9, 900.0f) < key(SortPass::Main, CUTOUT_MODE, 0, 1.0f));
+    CHECK(key(SortPass::Main, CUTOUT_MODE, 9, 900.0f) < key(SortPass::Main, TRANSPARENT_MODE, 0, 1.0f));
+
+    // Opaque groups by state before depth, then goes front to back
+    CHECK(key(SortPass::Main, OPAQUE_MODE, 1, 900.0f) < key(SortPass::Main, OPAQUE_MODE, 2, 1.0f));
+    CHECK(key(SortPass::Main, OPAQUE_MODE, 1, 1.0f) < key(SortPass::Main, OPAQUE_MODE, 1, 2.0f));
+
+    // Transparent goes back to front before grouping by state
+    CHECK(key(SortPass::Main, TRANSPARENT_MODE, 2, 900.0f) < key(SortPass::Main, TRANSPARENT_MODE, 1, 1.0f));
+    CHECK(key(SortPass::Main, TRANSPARENT_MODE, 1, 2.0f) < key(SortPass::Main, TRANSPARENT_MODE, 1, 1.0f));
+}
+
+// Logs the draws and barriers in the order the queue executes them. A draw
+// shows as the label of the constant buffer its group bound, then the label
+// of its vertex buffer, so a group that came apart shows as well.
+class RecordingRenderer : public NullRenderer {
+public:
+    RecordingRenderer() : NullRenderer(64, 64) {}
+
+    // One draw per object: nothing is merged into instanced draws
+    bool SupportsInstancing() const override { return false; }
+
+    void BindVertexBuffer(RefPtr<BufferBase> buffer, uint32_t slot) override {
+        log.push_back(labels[buffer.get()]);
+        NullRenderer::BindVertexBuffer(buffer, slot);
+    }
+
+    void BindConstantBuffer(RefPtr<BufferBase> buffer, uint32_t slot) override {
+        log.push_back("cb:" + labels[buffer.get()]);
+        NullRenderer::BindConstantBuffer(buffer, slot);
+    }
+
+    void SetRenderMode(RenderMode mode) override {
+        log.push_back("mode");
+        NullRenderer::SetRenderMode(mode);
+    }
+
+    RefPtr<BufferBase> MakeBuffer(BufferType type, const std::string& label) {
+        RefPtr<BufferBase> buffer(CreateBuffer(type, 64, nullptr));
+        labels[buffer.get()] = label;
+        return buffer;
+    }
+
+    std::unordered_map<const BufferBase*, std::string> labels;
+    std::vector<std::string> log;
+};
+
+class Frame {
+public:
+    explicit Frame(RecordingRenderer& renderer)
+        : m_renderer(renderer), m_queue(RenderCommandQueue::GetInstance()) {
+        m_indices = renderer.MakeBuffer(BufferType::Index, "indices");
+    }
+
+    // A draw and the constant buffer bind its group carries along
+    RenderCommandBase* Draw(const std::string& label) {
+        RefPtr<BufferBase> constants = m_renderer.MakeBuffer(BufferType::Constant, label);
+        m_queue->SubmitBindConstantBuffer(constants, 1);
+        m_expected[label] = {"cb:" + label, label};
+        m_keep.push_back(constants);
+
+        RefPtr<BufferBase> vertices = m_renderer.MakeBuffer(BufferType::Vertex, label);
+        m_keep.push_back(vertices);
+        return m_queue->SubmitDrawIndexed(vertices, m_indices, {}, 3);
+    }
+
+    void Draw(const std::string& label, SortPass pass, uint8_t mode, uint32_t shader, float depth) {
+        Draw(label)->SetSortKey(RenderSortKey::Make(pass, mode, shader, 1, 1, depth));
+    }
+
+    void Barrier() {
+        m_queue->SubmitCustomCommand([this](RenderContext*) { m_renderer.log.push_back("barrier"); });
+    }
+
+    void SetRenderMode() { m_queue->SubmitSetRenderMode(RenderEngine::RenderMode::Fill); }
+
+    // Executes the frame and checks it ran in the given order
+    bool Check(const std::vector<std::string>& order) {
+        m_renderer.log.clear();
+        m_renderer.BeginRender();
+        m_queue->ExecuteCommands(&m_renderer);
+        m_renderer.EndRender();
+
+        std::vector<std::string> expected;
+        for (const auto& entry : order) {
+            auto it = m_expected.find(entry);
+            if (it == m_expected.end()) {
+                expected.push_back(entry);
+            } else {
+                expected.insert(expected.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        if (m_renderer.log == expected) return true;
+        std::printf("executed:");
+        for (const auto& entry : m_renderer.log) std::printf(" %s", entry.c_str());
+        std::printf("\n");
+        return false;
+    }
+
+    int32_t GetStateChangesSaved() const { return m_queue->GetStateChangesSaved(); }
+
+private:
+    RecordingRenderer& m_renderer;
+    RenderCommandQueue* m_queue;
+    RefPtr<BufferBase> m_indices;
+    std::unordered_map<std::string, std::vector<std::string>> m_expected;
+    std::vector<RefPtr<BufferBase>> m_keep;
+};
+
+void TestQueueOrder(RecordingRenderer& renderer) {
+    {
+        // Passes in order, opaque and cutout front to back, transparent back to front
+        Frame frame(renderer);
+        frame.Draw("transparent5", SortPass::Main, TRANSPARENT_MODE, 1, 5.0f);
+        frame.Draw("opaque30", SortPass::Main, OPAQUE_MODE, 1, 30.0f);
+        frame.Draw("overlay", SortPass::Overlay, OPAQUE_MODE, 1, 1.0f);
+        frame.Draw("transparent50", SortPass::Main, TRANSPARENT_MODE, 1, 50.0f);
+        frame.Draw("opaque10", SortPass::Main, OPAQUE_MODE, 1, 10.0f);
+        frame.Draw("background", SortPass::Background, OPAQUE_MODE, 1, 100.0f);
+        frame.Draw("opaque20", SortPass::Main, OPAQUE_MODE, 1, 20.0f);
+        frame.Draw("transparent25", SortPass::Main, TRANSPARENT_MODE, 1, 25.0f);
+        frame.Draw("cutout1", SortPass::Main, CUTOUT_MODE, 1, 1.0f);
+        CHECK(frame.Check({"background", "opaque10", "opaque20", "opaque30", "cutout1",
+                           "transparent50", "transparent25", "transparent5", "overlay"}));
+    }
+    {
+        // Opaque groups by shader first; equal keys keep submission order
+        Frame frame(renderer);
+        frame.Draw("shader2near", SortPass::Main, OPAQUE_MODE, 2, 1.0f);
+        frame.Draw("shader1far", SortPass::Main, OPAQUE_MODE, 1, 40.0f);
+        frame.Draw("shader2mid", SortPass::Main, OPAQUE_MODE, 2, 2.0f);
+        frame.Draw("shader1near", SortPass::Main, OPAQUE_MODE, 1, 3.0f);
+        frame.Draw("first", SortPass::Main, OPAQUE_MODE, 3, 5.0f);
+        frame.Draw("second", SortPass::Main, OPAQUE_MODE, 3, 5.0f);
+        CHECK(frame.Check({"shader1near", "shader1far", "shader2near", "shader2mid", "first", "second"}));
+        // Four shader switches in submission order, two sorted
+        CHECK(frame.GetStateChangesSaved() == 2);
+    }
+    {
+        // Nothing crosses a barrier; each segment sorts on its own
+        Frame frame(renderer);
+        frame.Draw("transparentA", SortPass::Main, TRANSPARENT_MODE, 1, 5.0f);
+        frame.Draw("opaqueA", SortPass::Main, OPAQUE_MODE, 1, 20.0f);
+        frame.Barrier();
+        frame.Draw("opaqueB30", SortPass::Main, OPAQUE_MODE, 1, 30.0f);
+        frame.Draw("opaqueB10", SortPass::Main, OPAQUE_MODE, 1, 10.0f);
+        frame.SetRenderMode();
+        frame.Draw("overlayC", SortPass::Overlay, OPAQUE_MODE, 1, 1.0f);
+        frame.Draw("backgroundC", SortPass::Background, OPAQUE_MODE, 1, 1.0f);
+        frame.Draw("unkeyed");
+        frame.Draw("opaqueD30", SortPass::Main, OPAQUE_MODE, 1, 30.0f);
+        frame.Draw("opaqueD10", SortPass::Main, OPAQUE_MODE, 1, 10.0f);
+        CHECK(frame.Check({"opaqueA", "transparentA", "barrier", "opaqueB10", "opaqueB30", "mode",
+                           "backgroundC", "overlayC", "unkeyed", "opaqueD10", "opaqueD30"}));
+    }
+}
+
+} // namespace
+
+void TestSortIDsFolded() {
+    auto* queue = RenderCommandQueue::GetInstance();
+    const uint32_t shaderLimit = (1u << RenderSortKey::SHADER_BITS) - 1;
+
+    // Only the shader IDs past the field's range are counted
+    static char resources[1100];
+    for (uint32_t i = 0; i < 1100; ++i)
+        queue->GetSortID(SortResource::Shader, &resources[i]);
+    for (uint32_t i = 0; i < 10; ++i)
+        queue->GetSortID(SortResource::Mesh, &resources[i]);
+    queue->SubmitFrame();
+    CHECK(queue->GetSortIDsFolded() == 1100 - shaderLimit);
+
+    // IDs start over every frame
+    CHECK(queue->GetSortID(SortResource::Shader, &resources[1099]) == 1);
+    queue->SubmitFrame();
+    CHECK(queue->GetSortIDsFolded() == 0);
+}
+
+int main() {
+    Logger::Init("RenderSortTest");
+
+    TestPacking();
+    TestFieldOverflow();
+    TestOrdering();
+
+    RecordingRenderer renderer;
+    CHECK(renderer.Initialize());
+    TestQueueOrder(renderer);
+    TestSortIDsFolded();
+
+    RenderCommandQueue::GetInstance()->Clear();
+    renderer.Cleanup();
+    return TEST_RESULT();
+}
@@ -0,0 +1,192 @@
+// Runs hand-built command lists through RenderStateCache::Filter and checks
+// which commands it drops: repeated binds per constant buffer slot, binds
+// after a slot was overwritten when all slots share one storage (Vulkan
+// push constants), and the state forgotten after skinned, instanced and
+// custom commands.
+
+#include "TestCommon.hpp"
+
+#include <Graphics/Null/NullResources.hpp>
+#include <Graphics/RenderCommands.hpp>
+#include <Graphics/RenderContext.hpp>
+#include <Graphics/RenderStateCache.hpp>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::RenderEngine;
+
+namespace {
+
+constexpr bool KEEP = false;
+constexpr bool DROP = true;
+
+RefPtr<BufferBase> MakeBuffer() {
+    return RefPtr<BufferBase>(new NullBuffer(64, BufferType::Constant));
+}
+
+// Owns the commands and the buffer arrays the draws refer to
+class CommandList {
+public:
+    ~CommandList() {
+        m_commands.clear();    // Destroys the spans' elements
+        for (void* span : m_spans)
+            ::operator delete(span);
+    }
+
+    void Bind(const RefPtr<BufferBase>& buffer, int slot) {
+        Add<BindConstantBufferCommand>(buffer, slot);
+    }
+
+    void Update(const RefPtr<BufferBase>& buffer) {
+        Add<UpdateConstantBufferCommand>(buffer, m_data, static_cast<uint16_t>(sizeof(m_data)));
+    }
+
+    void Mode(RenderMode mode) { Add<SetRenderModeCommand>(mode); }
+    void Face(RenderFace face) { Add<SetRenderFaceCommand>(face); }
+    void Custom() { Add<CustomCommand>([](RenderContext*) {}); }
+
+    // A draw that binds no buffers of its own
+    void Draw() { Add<DrawIndexedCommand>(MakeBuffer(), MakeBuffer(), BufferSpan(), 3u); }
+
+    // Binds the bone buffer and switches to the skinned pipeline and back
+    void SkinnedDraw(const RefPtr<BufferBase>& bones) {
+        Add<DrawIndexedCommand>(MakeBuffer(), MakeBuffer(), Span({bones}), 3u);
+    }
+
+    // Binds its extra buffers, stays on the same pipeline
+    void DrawWithBuffers(const RefPtr<BufferBase>& buffer) {
+        Add<DrawCommand>(MakeBuffer(), Span({buffer}), 3u);
+    }
+
+    void InstancedDraw(const RefPtr<BufferBase>& transform) {
+        Add<DrawIndexedInstancedCommand>(MakeBuffer(), MakeBuffer(), 3u, 0u, 0, 0u, Span({transform}));
+    }
+
+    // Filters the list from a reset cache, true where a command was dropped
+    std::vector<bool> Filter(bool independentSlots) const {
+        RenderStateCache cache;
+        cache.Reset(independentSlots);
+
+        std::vector<bool> dropped;
+        for (const auto& command : m_commands)
+            dropped.push_back(cache.Filter(command.get()));
+        return dropped;
+    }
+
+private:
+    template<typename T, typename... Args>
+    void Add(Args&&... args) {
+        m_commands.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+    }
+
+    BufferSpan Span(std::initializer_list<RefPtr<BufferBase>> buffers) {
+        BufferSpan span;
+        span.data = static_cast<RefPtr<BufferBase>*>(::operator new(sizeof(RefPtr<BufferBase>) * buffers.size()));
+        for (const auto& buffer : buffers)
+            new (&span.data[span.count++]) RefPtr<BufferBase>(buffer);
+        m_spans.push_back(span.data);
+        return span;
+    }
+
+    std::vector<std::unique_ptr<RenderCommandBase>> m_commands;
+    std::vector<void*> m_spans;
+    float m_data[4] = {};
+};
+
+void TestIndependentSlots() {
+    RefPtr<BufferBase> a = MakeBuffer(), b = MakeBuffer();
+
+    CommandList list;
+    list.Bind(a, 0);
+    list.Bind(a, 0);    // Same buffer, same slot
+    list.Bind(b, 1);
+    list.Bind(a, 0);    // Slot 1 does not touch slot 0
+    list.Bind(b, 1);
+    list.Bind(b, 0);    // Same buffer, another slot
+    list.Bind(a, 1);
+    list.Bind(b, 0);
+    list.Update(a);     // New contents must reach the context again
+    list.Bind(a, 1);
+    list.Bind(a, 1);
+    list.Bind(RefPtr<BufferBase>(), 2);    // Unknown never matches
+    list.Bind(RefPtr<BufferBase>(), 2);
+    list.Mode(RenderMode::Fill);
+    list.Mode(RenderMode::Fill);
+    list.Mode(RenderMode::Wireframe);
+    list.Face(RenderFace::Back);
+    list.Face(RenderFace::Back);
+    list.Face(RenderFace::Front);
+
+    const std::vector<bool> expected = {
+        KEEP, DROP, KEEP, DROP, DROP, KEEP, KEEP, DROP,
+        KEEP, KEEP, DROP, KEEP, KEEP,
+        KEEP, DROP, KEEP, KEEP, DROP, KEEP
+    };
+    CHECK(list.Filter(true) == expected);
+}
+
+void TestSharedSlots() {
+    RefPtr<BufferBase> a = MakeBuffer(), b = MakeBuffer();
+
+    CommandList list;
+    list.Bind(a, 0);
+    list.Bind(a, 0);    // Nothing else was bound in between
+    list.Bind(b, 1);    // Overwrites the storage slot 0 used
+    list.Bind(a, 0);
+    list.Bind(b, 1);
+    list.Bind(b, 1);
+
+    CHECK(list.Filter(false) == std::vector<bool>({KEEP, DROP, KEEP, KEEP, KEEP, DROP}));
+    // With independent slots the same list only binds each slot once
+    CHECK(list.Filter(true) == std::vector<bool>({KEEP, DROP, KEEP, DROP, DROP, DROP}));
+}
+
+void TestResets() {
+    RefPtr<BufferBase> a = MakeBuffer(), b = MakeBuffer(), bones = MakeBuffer();
+
+    CommandList list;
+    list.Bind(a, 0);
+    list.Mode(RenderMode::Fill);
+    list.Draw();                  // Plain draw: everything stays bound
+    list.Bind(a, 0);
+    list.Mode(RenderMode::Fill);
+
+    list.SkinnedDraw(bones);      // Pipeline switch: everything is unknown
+    list.Bind(a, 0);
+    list.Mode(RenderMode::Fill);
+
+    list.DrawWithBuffers(b);      // Only the constant buffers are unknown
+    list.Bind(a, 0);
+    list.Mode(RenderMode::Fill);
+
+    list.InstancedDraw(a);        // Pipeline switch
+    list.Bind(a, 0);
+    list.Mode(RenderMode::Fill);
+    list.Face(RenderFace::Back);
+
+    list.Custom();                // Could have done anything
+    list.Bind(a, 0);
+    list.Mode(RenderMode::Fill);
+    list.Face(RenderFace::Back);
+
+    const std::vector<bool> expected = {
+        KEEP, KEEP, KEEP, DROP, DROP,
+        KEEP, KEEP, KEEP,
+        KEEP, KEEP, DROP,
+        KEEP, KEEP, KEEP, KEEP,
+        KEEP, KEEP, KEEP, KEEP
+    };
+    CHECK(list.Filter(true) == expected);
+    CHECK(list.Filter(false) == expected);
+}
+
+} // namespace
+
+int main() {
+    TestIndependentSlots();
+    TestSharedSlots();
+    TestResets();
+    return TEST_RESULT();
+}
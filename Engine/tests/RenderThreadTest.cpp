@@ -0,0 +1,249 @@
+// Runs the same scene for a number of frames on the null renderer, once
+// executing each frame on the main thread and once on a RenderThread, and
+// checks both render the same draws. Halfway through, objects are created
+// and destroyed while the render thread may still execute the previous
+// frame: RenderThread::Sync (from ResourceManager and from the scene's
+// deferred destruction) must keep both off the frame in flight.
+
+#include "TestCommon.hpp"
+
+#include <Core/GameObject.hpp>
+#include <Core/SceneBase.hpp>
+#include <ECS/Components/MaterialComponent.hpp>
+#include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <Graphics/Null/NullRenderer.hpp>
+#include <Graphics/RenderCommandQueue.hpp>
+#include <Graphics/RenderThread.hpp>
+#include <Graphics/ResourceManager.hpp>
+#include <Logger.hpp>
+#include <Math/Vector.hpp>
+#include <Runtime/Material.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::Math;
+using namespace Sleak::RenderEngine;
+
+namespace {
+
+constexpr uint32_t FRAME_COUNT = 60;
+constexpr uint32_t OBJECT_COUNT = 24;
+constexpr uint32_t CREATE_FRAME = 20;      // Objects added from here on...
+constexpr uint32_t DESTROY_FRAME = 30;     // ...and destroyed from here on
+constexpr uint32_t CHANGED_OBJECTS = 6;
+constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+// Knows when a frame executes, and on which thread. Frames take a little
+// while, so work the main thread does unsynchronized overlaps them.
+class TrackingRenderer : public NullRenderer {
+public:
+    TrackingRenderer() : NullRenderer(64, 64) {
+        ResourceManager::RegisterCreateBuffer(this, &TrackingRenderer::CreateBuffer);
+    }
+
+    void BeginRender() override {
+        m_renderThread = std::this_thread::get_id();
+        m_inFlight = true;
+        NullRenderer::BeginRender();
+    }
+
+    void EndRender() override {
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        NullRenderer::EndRender();
+        frames.push_back(GetFrameStats());
+        m_inFlight = false;
+    }
+
+    BufferBase* CreateBuffer(BufferType type, uint32_t size, void* data) override {
+        CheckOffFrame();
+        if (m_inFlight && std::this_thread::get_id() == m_renderThread)
+            ++frameAllocations;
+        return NullRenderer::CreateBuffer(type, size, data);
+    }
+
+    // The frame being executed may use what another thread touches now
+    void CheckOffFrame() {
+        if (m_inFlight && std::this_thread::get_id() != m_renderThread)
+            ++violations;
+    }
+
+    std::vector<NullRenderStats> frames;
+    std::atomic<uint32_t> violations = 0;
+    std::atomic<uint32_t> frameAllocations = 0;     // Made by the frame itself
+
+private:
+    std::atomic<bool> m_inFlight = false;
+    std::thread::id m_renderThread;
+};
+
+TrackingRenderer* s_renderer = nullptr;
+
+// Reports a destruction that overlaps a frame in flight
+class DestroyWatch final : public Component {
+public:
+    explicit DestroyWatch(GameObject* object) : Component(object) {}
+    ~DestroyWatch() override { s_renderer->CheckOffFrame(); }
+    bool Initialize() override { return true; }
+    void Update(float) override {}
+};
+
+struct SharedMesh {
+    RefPtr<Material> material;
+    RefPtr<BufferBase> vertices;
+    RefPtr<BufferBase> indices;
+};
+
+RefPtr<BufferBase> CreateBuffer(BufferType type, uint32_t size) {
+    return RefPtr<BufferBase>(ResourceManager::CreateBuffer(type, size, nullptr));
+}
+
+GameObject* CreateObject(const SharedMesh& shared, uint32_t index) {
+    const float seed = static_cast<float>(index);
+
+    auto* object = new GameObject("Object");
+    object->AddComponent<TransformComponent>(Vector3D(seed, 0.0f, 10.0f + seed));
+
+    // Shared meshes merge into instanced draws, own ones draw alone
+    if (index % 2 == 0) {
+        object->AddComponent<MaterialComponent>(shared.material);
+        object->AddComponent<MeshComponent>(shared.vertices, shared.indices, 3u, 3u);
+    } else {
+        object->AddComponent<MaterialComponent>(new Material());
+        object->AddComponent<MeshComponent>(CreateBuffer(BufferType::Vertex, 3 * 64),
+                                            CreateBuffer(BufferType::Index, 3 * 4), 3u, 3u);
+    }
+
+    object->AddComponent<DestroyWatch>();
+    return object;
+}
+
+class TestScene final : public SceneBase {
+public:
+    TestScene() : SceneBase("RenderThreadScene") {
+        m_shared.material = RefPtr<Material>(new Material());
+        m_shared.vertices = CreateBuffer(BufferType::Vertex, 3 * 64);
+        m_shared.indices = CreateBuffer(BufferType::Index, 3 * 4);
+
+        for (uint32_t i = 0; i < OBJECT_COUNT; ++i) {
+            m_objects.push_back(CreateObject(m_shared, i));
+            AddObject(m_objects.back());
+        }
+    }
+
+    void Begin() override { SceneBase::Begin(); }
+    void Update(float deltaTime) override { SceneBase::Update(deltaTime); }
+
+    void Step(uint32_t frame) {
+        FixedUpdate(DELTA_TIME);
+        Update(DELTA_TIME);
+        LateUpdate(DELTA_TIME);
+
+        // After recording, while the previous frame may still execute
+        if (frame >= CREATE_FRAME && frame < CREATE_FRAME + CHANGED_OBJECTS) {
+            // Initialized before joining, as GameObject::CreateCube does
+            m_objects.push_back(CreateObject(m_shared, OBJECT_COUNT + frame));
+            m_objects.back()->Initialize();
+            AddObject(m_objects.back());
+        }
+        // Destroyed by the next Update
+        if (frame >= DESTROY_FRAME && frame < DESTROY_FRAME + CHANGED_OBJECTS)
+            DestroyObject(m_objects[frame - DESTROY_FRAME]);
+    }
+
+private:
+    SharedMesh m_shared;
+    std::vector<GameObject*> m_objects;
+};
+
+struct RunResult {
+    std::vector<NullRenderStats> frames;
+    NullRenderStats total;
+    uint32_t violations = 0;
+    uint32_t frameAllocations = 0;
+};
+
+RunResult Run(bool threaded) {
+    TrackingRenderer renderer;
+    s_renderer = &renderer;
+    CHECK(renderer.Initialize());
+
+    auto* queue = RenderCommandQueue::GetInstance();
+    RenderThread renderThread;
+    if (threaded) CHECK(renderThread.Start(&renderer));
+
+    {
+        TestScene scene;
+        scene.Activate();
+
+        for (uint32_t frame = 0; frame < FRAME_COUNT; ++frame) {
+            // As Application::BeginFrame, UpdateFrame and EndFrame do
+            if (!threaded) renderer.BeginRender();
+            scene.Step(frame);
+
+            if (threaded) {
+                renderThread.Submit();
+            } else {
+                queue->ExecuteCommands(renderer.GetContext());
+                queue->AddFrameStats(&renderer);
+                renderer.EndRender();
+            }
+        }
+
+        // Destroys every object while the last frame may be in flight
+        scene.Unload();
+    }
+
+    if (threaded) {
+        renderThread.Stop();
+        CHECK(renderThread.GetFramesRendered() == FRAME_COUNT);
+    }
+    queue->Clear();
+
+    RunResult result;
+    result.frames = renderer.frames;
+    result.total = renderer.GetTotalStats();
+    result.violations = renderer.violations;
+    result.frameAllocations = renderer.frameAllocations;
+    renderer.Cleanup();
+    s_renderer = nullptr;
+    return result;
+}
+
+}  // namespace
+
+int main() {
+    Logger::Init("RenderThreadTest");
+
+    const RunResult serial = Run(false);
+    const RunResult threaded = Run(true);
+
+    CHECK(serial.violations == 0);
+    CHECK(threaded.violations == 0);
+    // Buffers, the instance buffer included, are made while recording
+    CHECK(threaded.frameAllocations == 0);
+
+    CHECK(serial.frames.size() == FRAME_COUNT);
+    CHECK(threaded.frames.size() == FRAME_COUNT);
+    for (size_t i = 0; i < serial.frames.size() && i < threaded.frames.size(); ++i) {
+        CHECK(serial.frames[i].drawCalls == threaded.frames[i].drawCalls);
+        CHECK(serial.frames[i].instances == threaded.frames[i].instances);
+        CHECK(serial.frames[i].triangles == threaded.frames[i].triangles);
+        CHECK(serial.frames[i].bufferBinds == threaded.frames[i].bufferBinds);
+    }
+
+    // Resources are counted in whichever frame was open when they were made
+    CHECK(serial.total.resourcesCreated == threaded.total.resourcesCreated);
+    CHECK(serial.total.drawCalls == threaded.total.drawCalls);
+    CHECK(serial.total.instances == threaded.total.instances);
+
+    // The scene really drew, merged, and changed halfway
+    CHECK(serial.total.drawCalls > 0);
+    CHECK(serial.total.instances > serial.total.drawCalls);
+    CHECK(serial.frames[DESTROY_FRAME].drawCalls > serial.frames[FRAME_COUNT - 1].drawCalls);
+
+    return TEST_RESULT();
+}
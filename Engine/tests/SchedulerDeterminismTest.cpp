@@ -0,0 +1,498 @@
+// Runs the same small world for a number of frames through the
+// SystemScheduler: serially, with overlapping systems, and serially in the
+// reversed order the declarations allow. Checks all three end with
+// bit-identical world transforms.
+//
+// The second half drives a real SceneBase on the null renderer, so the
+// engine's own system declarations are what decides the overlap: object
+// updates, animators evaluated on workers and uploaded on the main
+// thread, and physics moving dynamic rigidbodies.
+
+#include "TestCommon.hpp"
+
+#include <Core/GameObject.hpp>
+#include <Core/JobSystem.hpp>
+#include <Core/SceneBase.hpp>
+#include <ECS/Components/AnimatorComponent.hpp>
+#include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <Graphics/Null/NullRenderer.hpp>
+#include <Graphics/Null/NullResources.hpp>
+#include <Graphics/RenderCommandQueue.hpp>
+#include <Graphics/ResourceManager.hpp>
+#include <ECS/SystemScheduler.hpp>
+#include <ECS/TransformHierarchy.hpp>
+#include <Logger.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/Quaternion.hpp>
+#include <Math/Vector.hpp>
+#include <Physics/ColliderComponent.hpp>
+#include <Physics/RigidbodyComponent.hpp>
+#include <Runtime/AnimationClip.hpp>
+#include <Runtime/Skeleton.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::Math;
+
+namespace {
+
+constexpr uint32_t ROOT_COUNT = 256;
+constexpr uint32_t CHAIN_LENGTH = 3;     // Children below each root
+constexpr uint32_t FRAME_COUNT = 120;
+constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+enum class Order {
+    Serial,     // Registration order
+    Scheduled,  // Overlapping on the JobSystem
+    Reversed    // Serial, latest system first wherever the accesses allow
+};
+
+void Configure(SystemScheduler& scheduler, Order order) {
+    scheduler.SetParallel(order == Order::Scheduled);
+    scheduler.SetReverseOrder(order == Order::Reversed);
+}
+
+class Velocity final : public Component {
+public:
+    Velocity(GameObject* object, const Vector3D& linear, float angular)
+        : Component(object), linear(linear), angular(angular) {}
+    bool Initialize() override { return true; }
+    void Update(float) override {}
+
+    Vector3D linear;
+    float angular;
+};
+
+class Drag final : public Component {
+public:
+    Drag(GameObject* object, float factor) : Component(object), factor(factor) {}
+    bool Initialize() override { return true; }
+    void Update(float) override {}
+
+    float factor;
+};
+
+class Sampler final : public Component {
+public:
+    Sampler(GameObject* object) : Component(object) {}
+    bool Initialize() override { return true; }
+    void Update(float) override {}
+
+    float accumulated = 0.0f;
+};
+
+struct World {
+    List<GameObject*> objects;      // Roots, for the hierarchy pass
+    std::vector<GameObject*> all;   // Every object in creation order
+    TransformHierarchy hierarchy;
+    SystemScheduler scheduler;
+    uint32_t frame = 0;
+
+    World() {
+        for (uint32_t i = 0; i < ROOT_COUNT; ++i) {
+            const float seed = static_cast<float>(i);
+            auto* root = new GameObject("Root");
+            root->AddComponent<TransformComponent>(
+                Vector3D(std::sin(seed) * 50.0f, seed * 0.25f, std::cos(seed) * 50.0f));
+            root->AddComponent<Velocity>(Vector3D(std::cos(seed), 0.5f, std::sin(seed * 0.5f)),
+                                         0.1f + 0.01f * seed);
+            root->AddComponent<Drag>(0.98f);
+            root->AddComponent<Sampler>();
+            objects.add(root);
+            all.push_back(root);
+
+            GameObject* parent = root;
+            for (uint32_t depth = 0; depth < CHAIN_LENGTH; ++depth) {
+                auto* child = new GameObject("Child");
+                child->AddComponent<TransformComponent>(Vector3D(1.0f, 0.0f, 0.0f),
+                                                        Quaternion(Vector3D(0.0f, 1.0f, 0.0f), 0.3f),
+                                                        Vector3D(0.9f, 0.9f, 0.9f));
+                child->AddComponent<Sampler>();
+                parent->AddChild(child);
+                all.push_back(child);
+                parent = child;
+            }
+        }
+
+        RegisterSystems();
+    }
+
+    ~World() {
+        // Children are only detached by their parent: delete every object
+        for (GameObject* object : all) delete object;
+    }
+
+    void RegisterSystems() {
+        // Steering pulls every root toward the centroid of the previous frame
+        scheduler.AddSystem({"Steer", SystemPhase::Update,
+            SystemAccess().Write<Velocity>().Read<TransformComponent>(),
+            [this](float) {
+                Vector3D centroid(0.0f, 0.0f, 0.0f);
+                for (size_t i = 0; i < objects.GetSize(); ++i)
+                    centroid += objects[i]->GetComponent<TransformComponent>()->GetLocalPosition();
+                centroid = centroid * (1.0f / static_cast<float>(objects.GetSize()));
+
+                ComponentStorage::Get().ForEach<Velocity, TransformComponent>(
+                    [&](GameObject*, Velocity* velocity, TransformComponent* transform) {
+                        velocity->linear += (centroid - transform->GetLocalPosition()) * 0.001f;
+                    });
+            }});
+
+        // Disjoint from Steer and Integrate: may overlap them
+        scheduler.AddSystem({"Wobble", SystemPhase::Update,
+            SystemAccess().Write<Drag>(),
+            [this](float) {
+                const float phase = static_cast<float>(frame) * 0.1f;
+                ComponentStorage::Get().ForEach<Drag>([&](GameObject*, Drag* drag) {
+                    drag->factor = 0.97f + 0.02f * std::sin(phase);
+                });
+            }});
+
+        scheduler.AddSystem({"Integrate", SystemPhase::Update,
+            SystemAccess().Read<Velocity>().Write<TransformComponent>(),
+            [](float deltaTime) {
+                ComponentStorage::Get().ForEach<Velocity, TransformComponent>(
+                    [&](GameObject*, Velocity* velocity, TransformComponent* transform) {
+                        transform->Translate(velocity->linear * deltaTime);
+                        transform->Rotate(Quaternion(Vector3D(0.0f, 1.0f, 0.0f),
+                                                     velocity->angular * deltaTime));
+                    });
+            }});
+
+        scheduler.AddSystem({"ApplyDrag", SystemPhase::Update,
+            SystemAccess().Read<Drag>().Write<Velocity>(),
+            [](float) {
+                ComponentStorage::Get().ForEach<Drag, Velocity>(
+                    [](GameObject*, Drag* drag, Velocity* velocity) {
+                        velocity->linear = velocity->linear * drag->factor;
+                    });
+            }});
+
+        scheduler.AddSystem({"TransformHierarchy", SystemPhase::Update,
+            SystemAccess().Write<TransformComponent>(),
+            [this](float) {
+                // Outside a scene transforms do not report their changes
+                hierarchy.MarkChanged();
+                hierarchy.Update(objects);
+            }});
+
+        scheduler.AddSystem({"Probe", SystemPhase::Update,
+            SystemAccess().Read<TransformComponent>().Write<Sampler>(),
+            [](float) {
+                ComponentStorage::Get().ForEach<TransformComponent, Sampler>(
+                    [](GameObject*, TransformComponent* transform, Sampler* sampler) {
+                        sampler->accumulated += transform->GetWorldPosition().GetY();
+                    });
+            }});
+    }
+
+    std::vector<float> Run(Order order, uint32_t frames) {
+        Configure(scheduler, order);
+        for (frame = 0; frame < frames; ++frame)
+            scheduler.Run(SystemPhase::Update, DELTA_TIME);
+
+        std::vector<float> state;
+        for (GameObject* object : all) {
+            const Matrix4 world = object->GetComponent<TransformComponent>()->GetWorldMatrix();
+            for (int row = 0; row < 4; ++row)
+                for (int column = 0; column < 4; ++column)
+                    state.push_back(world(row, column));
+            state.push_back(object->GetComponent<Sampler>()->accumulated);
+        }
+        return state;
+    }
+};
+
+std::vector<float> Simulate(Order order, uint32_t frames) {
+    World world;
+    return world.Run(order, frames);
+}
+
+// --- Scene ---
+
+constexpr uint32_t BODY_COUNT = 48;
+constexpr uint32_t ANIMATED_COUNT = 32;
+constexpr uint32_t BONE_COUNT = 4;
+
+// Keeps what was last uploaded and a digest of every upload in order.
+// Uploads reflect what each system saw when it ran, so a system running
+// out of order shows here even when the final state comes out the same.
+class RecordingBuffer final : public RenderEngine::NullBuffer {
+public:
+    RecordingBuffer(uint32_t size, RenderEngine::BufferType type)
+        : NullBuffer(size, type), sequence(NextSequence()++) {
+        Live().push_back(this);
+    }
+
+    ~RecordingBuffer() override {
+        auto& live = Live();
+        live.erase(std::find(live.begin(), live.end(), this));
+    }
+
+    void Update(void* data, size_t size) override {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        contents.assign(bytes, bytes + size);
+        for (size_t i = 0; i < size; ++i)
+            digest = (digest ^ bytes[i]) * 1099511628211ull;
+    }
+
+    // Buffers in creation order, which both runs share
+    static std::vector<RecordingBuffer*>& Live() {
+        static std::vector<RecordingBuffer*> live;
+        return live;
+    }
+
+    static uint64_t& NextSequence() {
+        static uint64_t sequence = 0;
+        return sequence;
+    }
+
+    const uint64_t sequence;
+    std::vector<unsigned char> contents;
+    uint64_t digest = 14695981039346656037ull;
+};
+
+struct RecordingFactory {
+    RenderEngine::BufferBase* CreateBuffer(RenderEngine::BufferType type, uint32_t size, void* data) {
+        auto* buffer = new RecordingBuffer(size, type);
+        buffer->Initialize(data);
+        return buffer;
+    }
+};
+
+// A bone chain swinging around its own axis
+struct Rig {
+    Skeleton skeleton;
+    AnimationClip clip;
+
+    Rig() {
+        for (uint32_t i = 0; i < BONE_COUNT; ++i) {
+            const std::string name = "Bone" + std::to_string(i);
+            Bone bone;
+            bone.name = name;
+            bone.offsetMatrix = Matrix4::Translate(Vector3D(0.0f, -float(i), 0.0f));
+            const int id = skeleton.AddBone(bone);
+            if (i > 0) skeleton.SetBoneParent(id, id - 1);
+
+            NodeData node;
+            node.name = name;
+            node.defaultTransform = Matrix4::Translate(Vector3D(0.0f, 1.0f, 0.0f));
+            node.boneIndex = id;
+            const int index = skeleton.AddNode(node);
+            if (i > 0) skeleton.AddNodeChild(index - 1, index);
+
+            AnimationChannel channel;
+            channel.boneName = name;
+            for (int key = 0; key <= 4; ++key) {
+                const float time = float(key) * 6.0f;
+                const float angle = 0.4f * std::sin(float(key + i));
+                channel.positionKeys.push_back({time, Vector3D(0.0f, 1.0f, 0.1f * float(key))});
+                channel.rotationKeys.push_back({time, Quaternion(Vector3D(0.0f, 0.0f, 1.0f), angle)});
+                channel.scaleKeys.push_back({time, Vector3D(1.0f, 1.0f, 1.0f)});
+            }
+            clip.channels.push_back(channel);
+        }
+        clip.name = "Swing";
+        clip.duration = 24.0f;
+        clip.BuildLookup();
+    }
+};
+
+class TestScene final : public SceneBase {
+public:
+    explicit TestScene(Rig& rig) : SceneBase("SchedulerDeterminismScene") {
+        // Static floor the bodies land on
+        auto* floor = new GameObject("Floor");
+        floor->AddComponent<TransformComponent>(Vector3D(0.0f, -1.0f, 0.0f));
+        floor->AddComponent<ColliderComponent>(
+            Physics::AABB(Vector3D(-100.0f, -1.0f, -100.0f), Vector3D(100.0f, 1.0f, 100.0f)));
+        floor->AddComponent<RigidbodyComponent>(BodyType::Static);
+        AddObject(floor);
+
+        for (uint32_t i = 0; i < BODY_COUNT; ++i) {
+            const float seed = static_cast<float>(i);
+            auto* body = new GameObject("Body");
+            body->AddComponent<TransformComponent>(
+                Vector3D(std::sin(seed) * 20.0f, 2.0f + seed * 0.5f, std::cos(seed) * 20.0f));
+            body->AddComponent<ColliderComponent>(
+                Physics::AABB(Vector3D(-0.5f, -0.5f, -0.5f), Vector3D(0.5f, 0.5f, 0.5f)));
+            body->AddComponent<RigidbodyComponent>(BodyType::Dynamic);
+            auto* rigidbody = body->GetComponent<RigidbodyComponent>();
+            rigidbody->SetUseGravity(true);
+            rigidbody->SetVelocity(Vector3D(std::cos(seed), 0.0f, std::sin(seed)));
+            m_bodies.push_back(body);
+            AddObject(body);
+        }
+
+        for (uint32_t i = 0; i < ANIMATED_COUNT; ++i) {
+            const float seed = static_cast<float>(i);
+            auto* animated = new GameObject("Animated");
+            animated->AddComponent<TransformComponent>(Vector3D(seed * 3.0f, 0.0f, -10.0f));
+            animated->AddComponent<MeshComponent>();
+            animated->AddComponent<AnimatorComponent>(&rig.skeleton,
+                                                      std::vector<AnimationClip*>{&rig.clip});
+
+            // Attached below the animated root, moved by the hierarchy pass
+            auto* prop = new GameObject("Prop");
+            prop->AddComponent<TransformComponent>(Vector3D(0.0f, 2.0f, 0.0f),
+                                                   Quaternion(Vector3D(0.0f, 1.0f, 0.0f), seed),
+                                                   Vector3D(0.5f, 0.5f, 0.5f));
+            animated->AddChild(prop);
+
+            m_animated.push_back(animated);
+            AddObject(animated);
+            AddObject(prop);        // Children belong to the scene as well
+        }
+    }
+
+    void Begin() override {
+        SceneBase::Begin();
+        for (size_t i = 0; i < m_animated.size(); ++i) {
+            auto* animator = m_animated[i]->GetComponent<AnimatorComponent>();
+            animator->Play(0, true);
+            animator->SetSpeed(0.5f + 0.1f * float(i % 7));
+        }
+    }
+
+    void Update(float deltaTime) override { SceneBase::Update(deltaTime); }
+
+    std::vector<float> Capture() const {
+        std::vector<float> state;
+        auto append = [&](GameObject* object) {
+            const Matrix4 world = object->GetComponent<TransformComponent>()->GetWorldMatrix();
+            for (int row = 0; row < 4; ++row)
+                for (int column = 0; column < 4; ++column)
+                    state.push_back(world(row, column));
+        };
+
+        for (GameObject* body : m_bodies) {
+            append(body);
+            const Vector3D velocity = body->GetComponent<RigidbodyComponent>()->GetVelocity();
+            state.push_back(velocity.GetX());
+            state.push_back(velocity.GetY());
+            state.push_back(velocity.GetZ());
+        }
+
+        for (GameObject* animated : m_animated) {
+            append(animated);
+            append(animated->GetChildren()[0]);
+
+            auto bones = animated->GetComponent<AnimatorComponent>()->GetBoneBuffer();
+            const auto& contents = static_cast<RecordingBuffer*>(bones.get())->contents;
+            const size_t count = contents.size() / sizeof(float);
+            state.resize(state.size() + count);
+            std::memcpy(state.data() + state.size() - count, contents.data(), count * sizeof(float));
+        }
+        return state;
+    }
+
+private:
+    std::vector<GameObject*> m_bodies;
+    std::vector<GameObject*> m_animated;
+};
+
+struct SceneResult {
+    std::vector<float> state;
+    std::vector<uint64_t> uploads;  // Digest per live buffer
+};
+
+SceneResult SimulateScene(RenderEngine::NullRenderer& renderer, Order order, uint32_t frames) {
+    Rig rig;
+    SceneResult result;
+    {
+        // Buffers kept from an earlier run (the instance ring) start over
+        for (RecordingBuffer* buffer : RecordingBuffer::Live())
+            buffer->digest = 14695981039346656037ull;
+
+        TestScene scene(rig);
+        Configure(scene.GetScheduler(), order);
+        scene.Activate();
+
+        auto* queue = RenderEngine::RenderCommandQueue::GetInstance();
+        for (uint32_t frame = 0; frame < frames; ++frame) {
+            // As Application::UpdateFrame and EndFrame do
+            renderer.BeginRender();
+            scene.FixedUpdate(DELTA_TIME);
+            scene.Update(DELTA_TIME);
+            scene.LateUpdate(DELTA_TIME);
+            queue->ExecuteCommands(renderer.GetContext());
+            renderer.EndRender();
+        }
+
+        // Otherwise animators fall back to the per-object pass and the
+        // Animation / AnimationUpload systems are not covered
+        CHECK(scene.GetScheduler().GetSystemUpdatedComponents() &
+              ComponentTypeRegistry::MaskOf(ComponentTypeRegistry::Get<AnimatorComponent>()));
+
+        result.state = scene.Capture();
+        for (RecordingBuffer* buffer : RecordingBuffer::Live())
+            result.uploads.push_back(buffer->digest);
+        scene.Unload();
+    }
+    RenderEngine::RenderCommandQueue::GetInstance()->Clear();
+    return result;
+}
+
+}  // namespace
+
+int main() {
+    Logger::Init("SchedulerDeterminismTest");
+    JobSystem::Initialize(3);    // Overlap systems even on small machines
+
+    const std::vector<float> initial = Simulate(Order::Serial, 0);
+    const std::vector<float> serial = Simulate(Order::Serial, FRAME_COUNT);
+    const std::vector<float> scheduled = Simulate(Order::Scheduled, FRAME_COUNT);
+    const std::vector<float> reversed = Simulate(Order::Reversed, FRAME_COUNT);
+
+    CHECK(serial.size() == ROOT_COUNT * (CHAIN_LENGTH + 1) * 17);
+    CHECK(serial.size() == scheduled.size());
+    CHECK(std::memcmp(serial.data(), scheduled.data(), serial.size() * sizeof(float)) == 0);
+    CHECK(serial.size() == reversed.size());
+    CHECK(std::memcmp(serial.data(), reversed.data(), serial.size() * sizeof(float)) == 0);
+
+    // The world moved, so the comparison covers real work
+    CHECK(initial.size() == serial.size());
+    CHECK(std::memcmp(initial.data(), serial.data(), serial.size() * sizeof(float)) != 0);
+
+    // The engine's default systems on a real scene
+    RenderEngine::NullRenderer renderer(1280, 720);
+    CHECK(renderer.Initialize());
+    RecordingFactory factory;
+    RenderEngine::ResourceManager::RegisterCreateBuffer(&factory, &RecordingFactory::CreateBuffer);
+
+    const SceneResult sceneInitial = SimulateScene(renderer, Order::Serial, 1);
+    const SceneResult sceneSerial = SimulateScene(renderer, Order::Serial, FRAME_COUNT);
+    const SceneResult sceneScheduled = SimulateScene(renderer, Order::Scheduled, FRAME_COUNT);
+    const SceneResult sceneReversed = SimulateScene(renderer, Order::Reversed, FRAME_COUNT);
+
+    constexpr size_t BODY_FLOATS = 16 + 3;
+    constexpr size_t ANIMATED_FLOATS = 16 * 2 + 16 * BONE_COUNT;
+    const std::vector<float>& serialState = sceneSerial.state;
+    const std::vector<float>& scheduledState = sceneScheduled.state;
+    CHECK(serialState.size() == BODY_COUNT * BODY_FLOATS + ANIMATED_COUNT * ANIMATED_FLOATS);
+    CHECK(serialState.size() == scheduledState.size());
+    CHECK(std::memcmp(serialState.data(), scheduledState.data(),
+                      serialState.size() * sizeof(float)) == 0);
+    CHECK(!sceneSerial.uploads.empty());
+    CHECK(sceneSerial.uploads == sceneScheduled.uploads);
+
+    // Deterministic counterpart: catches a missing declaration even when
+    // the threads happen not to race
+    CHECK(serialState.size() == sceneReversed.state.size());
+    CHECK(std::memcmp(serialState.data(), sceneReversed.state.data(),
+                      serialState.size() * sizeof(float)) == 0);
+    CHECK(sceneSerial.uploads == sceneReversed.uploads);
+
+    // Bodies fell and animators advanced
+    CHECK(sceneInitial.state.size() == serialState.size());
+    CHECK(std::memcmp(sceneInitial.state.data(), serialState.data(),
+                      serialState.size() * sizeof(float)) != 0);
+
+    renderer.Cleanup();
+    JobSystem::Shutdown();
+    return TEST_RESULT();
+}
@@ -0,0 +1,68 @@
+// Checks that the CullingSystem keeps objects outside the camera but
+// inside the shadow frustum submitted, so the shadow pass still draws them.
+
+#include "CullingTestCommon.hpp"
+#include "TestCommon.hpp"
+
+#include <Camera/ViewFrustum.hpp>
+#include <ECS/CullingSystem.hpp>
+#include <ECS/TransformHierarchy.hpp>
+#include <Logger.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/Vector.hpp>
+
+using namespace Sleak;
+using namespace Sleak::Math;
+using Sleak::Test::CreateRenderable;
+using Sleak::Test::Orthographic;
+
+int main() {
+    Logger::Init("ShadowCasterCullingTest");
+
+    // The camera sees x in [-10, 10], the shadow map x in [-10, 30]
+    const Matrix4 viewProjection = Orthographic(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 100.0f);
+    ViewFrustum camera;
+    camera.ExtractFromVP(viewProjection);
+    ViewFrustum shadow;
+    shadow.ExtractFromVP(Orthographic(-10.0f, 30.0f, -10.0f, 10.0f, 0.0f, 100.0f));
+
+    List<GameObject*> objects;
+    GameObject* inView = CreateRenderable("InView", 0.0f);
+    GameObject* caster = CreateRenderable("Caster", 20.0f);
+    GameObject* outside = CreateRenderable("Outside", 50.0f);
+    objects.add(inView);
+    objects.add(caster);
+    objects.add(outside);
+
+    TransformHierarchy hierarchy;
+    hierarchy.MarkChanged();
+    hierarchy.Update(objects);
+
+    CullingSystem culling;
+    culling.SetOcclusionEnabled(false);
+
+    // Without shadows only the camera counts
+    culling.Update(hierarchy, camera, viewProjection);
+    CHECK(culling.GetRenderableCount() == 3);
+    CHECK(!inView->IsCulled());
+    CHECK(caster->IsCulled());
+    CHECK(outside->IsCulled());
+    CHECK(culling.GetShadowCasterCount() == 0);
+    CHECK(culling.GetCulledCount() == 2);
+
+    culling.Update(hierarchy, camera, viewProjection, &shadow);
+    CHECK(!inView->IsCulled());
+    CHECK(!caster->IsCulled());
+    CHECK(outside->IsCulled());
+    CHECK(culling.GetShadowCasterCount() == 1);
+    CHECK(culling.GetSubmittedCount() == 2);
+    CHECK(culling.GetCulledCount() == 1);
+
+    // Casters are re-evaluated every pass, like visible objects
+    culling.Update(hierarchy, camera, viewProjection);
+    CHECK(caster->IsCulled());
+    CHECK(culling.GetShadowCasterCount() == 0);
+
+    for (size_t i = 0; i < objects.GetSize(); ++i) delete objects[i];
+    return TEST_RESULT();
+}
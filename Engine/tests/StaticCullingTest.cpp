@@ -0,0 +1,71 @@
+// Checks that the CullingSystem puts objects marked GameObject::IsStatic
+// in its static tree when they are registered, and that unmarked objects
+// only get there after STATIC_AFTER_FRAMES frames without moving.
+
+#include "CullingTestCommon.hpp"
+#include "TestCommon.hpp"
+
+#include <Camera/ViewFrustum.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <ECS/CullingSystem.hpp>
+#include <ECS/TransformHierarchy.hpp>
+#include <Logger.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/Vector.hpp>
+
+using namespace Sleak;
+using namespace Sleak::Math;
+using Sleak::Test::CreateRenderable;
+using Sleak::Test::Orthographic;
+
+int main() {
+    Logger::Init("StaticCullingTest");
+
+    const Matrix4 viewProjection = Orthographic(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 100.0f);
+    ViewFrustum camera;
+    camera.ExtractFromVP(viewProjection);
+
+    List<GameObject*> objects;
+    GameObject* marked = CreateRenderable("Marked", -5.0f, true);
+    GameObject* unmarked = CreateRenderable("Unmarked", 5.0f, false);
+    GameObject* outside = CreateRenderable("Outside", 50.0f, true);
+    objects.add(marked);
+    objects.add(unmarked);
+    objects.add(outside);
+
+    TransformHierarchy hierarchy;
+    hierarchy.MarkChanged();
+    hierarchy.Update(objects);
+
+    CullingSystem culling;
+    culling.SetOcclusionEnabled(false);
+
+    // Marked objects are static from the first frame and cull as usual
+    culling.Update(hierarchy, camera, viewProjection);
+    CHECK(culling.GetRenderableCount() == 3);
+    CHECK(culling.GetStaticCount() == 2);
+    CHECK(!marked->IsCulled());
+    CHECK(!unmarked->IsCulled());
+    CHECK(outside->IsCulled());
+
+    // The rest waits for the heuristic
+    for (uint32_t frame = 2; frame < CullingSystem::STATIC_AFTER_FRAMES; ++frame)
+        culling.Update(hierarchy, camera, viewProjection);
+    CHECK(culling.GetStaticCount() == 2);
+    culling.Update(hierarchy, camera, viewProjection);
+    culling.Update(hierarchy, camera, viewProjection);
+    CHECK(culling.GetStaticCount() == 3);
+
+    // A marked object that moves anyway goes back to the dynamic tree
+    // (without a scene, report the move the way TransformComponent does)
+    marked->GetComponent<TransformComponent>()->SetPosition(Vector3D(-6.0f, 0.0f, 50.0f));
+    hierarchy.MarkChanged();
+    hierarchy.RecordMoved(marked->GetHandle());
+    hierarchy.Update(objects);
+    culling.Update(hierarchy, camera, viewProjection);
+    CHECK(culling.GetStaticCount() == 2);
+    CHECK(!marked->IsCulled());
+
+    for (size_t i = 0; i < objects.GetSize(); ++i) delete objects[i];
+    return TEST_RESULT();
+}
@@ -0,0 +1,32 @@
+#ifndef _SLEAK_TEST_COMMON_HPP_
+#define _SLEAK_TEST_COMMON_HPP_
+
+// Minimal checks for the engine's test executables: a failed CHECK prints
+// its location and marks the run failed, TEST_RESULT() is main's return.
+
+#include <cstdio>
+
+namespace Sleak::Test {
+    inline int& Failures() {
+        static int failures = 0;
+        return failures;
+    }
+}
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition)) {                                                     \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,        \
+                        #condition);                                            \
+            ++::Sleak::Test::Failures();                                        \
+        }                                                                       \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) CHECK(((a) - (b)) <= (tolerance) && ((b) - (a)) <= (tolerance))
+
+#define TEST_RESULT()                                                           \
+    (::Sleak::Test::Failures() == 0                                             \
+         ? (std::printf("All checks passed\n"), 0)                              \
+         : (std::printf("%d checks failed\n", ::Sleak::Test::Failures()), 1))
+
+#endif // _SLEAK_TEST_COMMON_HPP_
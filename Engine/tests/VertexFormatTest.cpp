@@ -0,0 +1,231 @@
+// Encodes vertices into the compact layouts and decodes them back, checking
+// each attribute stays within its precision: octahedral normals over the
+// whole sphere, half UVs and tangents, and bone weights summing to 255.
+
+#include "TestCommon.hpp"
+
+#include <Logger.hpp>
+#include <Runtime/MeshData.hpp>
+#include <Runtime/VertexFormat.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace Sleak;
+
+namespace {
+
+// Angle between two unit vectors, in degrees
+float AngleBetween(float ax, float ay, float az, float bx, float by, float bz) {
+    const float cx = ay * bz - az * by;
+    const float cy = az * bx - ax * bz;
+    const float cz = ax * by - ay * bx;
+    const float dot = ax * bx + ay * by + az * bz;
+    return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) * 57.29578f;
+}
+
+Vertex MakeVertex(float nx, float ny, float nz) {
+    const float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+    Vertex vertex(1.5f, -2.25f, 1000.125f, nx / length, ny / length, nz / length,
+                  0.6f, -0.8f, 0.0f, -1.0f, 0.3333f, 1.75f);
+    vertex.r = 0.2f;
+    vertex.g = 0.4f;
+    vertex.b = 0.6f;
+    vertex.a = 1.0f;
+    return vertex;
+}
+
+}  // namespace
+
+int main() {
+    Logger::Init("VertexFormatTest");
+
+    CHECK(VertexFormat::GetStride(VertexLayout::Standard) == sizeof(Vertex));
+    CHECK(VertexFormat::GetStride(VertexLayout::StaticCompact) == 32);
+    CHECK(VertexFormat::GetStride(VertexLayout::SkinnedCompact) == 40);
+
+    // Octahedral normals: the axes, including -Z where the octahedron
+    // folds, come back exact
+    const float axes[][3] = {
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+    };
+    for (const auto& axis : axes) {
+        int16_t packed[2];
+        float x, y, z;
+        VertexFormat::EncodeOctahedral(axis[0], axis[1], axis[2], packed);
+        VertexFormat::DecodeOctahedral(packed, x, y, z);
+        CHECK_NEAR(x, axis[0], 1e-6f);
+        CHECK_NEAR(y, axis[1], 1e-6f);
+        CHECK_NEAR(z, axis[2], 1e-6f);
+    }
+
+    // Everywhere else within a hundredth of a degree, both hemispheres
+    float worst = 0.0f;
+    for (int i = 0; i < 64; ++i) {
+        for (int j = 0; j <= 32; ++j) {
+            const float azimuth = i * (6.2831853f / 64.0f);
+            const float polar = j * (3.1415927f / 32.0f);
+            const float nx = std::sin(polar) * std::cos(azimuth);
+            const float ny = std::sin(polar) * std::sin(azimuth);
+            const float nz = std::cos(polar);
+
+            int16_t packed[2];
+            float x, y, z;
+            VertexFormat::EncodeOctahedral(nx, ny, nz, packed);
+            VertexFormat::DecodeOctahedral(packed, x, y, z);
+            CHECK_NEAR(x * x + y * y + z * z, 1.0f, 1e-5f);
+            worst = std::fmax(worst, AngleBetween(nx, ny, nz, x, y, z));
+        }
+    }
+    CHECK(worst < 0.01f);
+
+    // A zero normal still decodes to a unit vector
+    {
+        int16_t packed[2];
+        float x, y, z;
+        VertexFormat::EncodeOctahedral(0.0f, 0.0f, 0.0f, packed);
+        VertexFormat::DecodeOctahedral(packed, x, y, z);
+        CHECK_NEAR(z, 1.0f, 1e-6f);
+    }
+
+    // Halves: exact where representable, round to nearest even otherwise
+    CHECK(VertexFormat::FloatToHalf(1.0f) == 0x3C00);
+    CHECK(VertexFormat::FloatToHalf(-2.0f) == 0xC000);
+    CHECK(VertexFormat::FloatToHalf(65504.0f) == 0x7BFF);
+    CHECK(VertexFormat::FloatToHalf(1e6f) == 0x7C00);
+    CHECK(VertexFormat::FloatToHalf(1.0f + 1.0f / 2048.0f) == 0x3C00);
+    CHECK(VertexFormat::FloatToHalf(1.0f + 3.0f / 2048.0f) == 0x3C02);
+    CHECK(VertexFormat::HalfToFloat(0x0001) == std::ldexp(1.0f, -24));
+    CHECK(std::isnan(VertexFormat::HalfToFloat(VertexFormat::FloatToHalf(std::nanf("")))));
+    for (uint32_t bits = 0; bits < 0x7C00; ++bits) {
+        const uint16_t half = static_cast<uint16_t>(bits);
+        if (VertexFormat::FloatToHalf(VertexFormat::HalfToFloat(half)) != half) {
+            CHECK(false);
+            break;
+        }
+    }
+
+    // StaticCompact: position exact, normal, tangent, color and UVs
+    // within their precision, no bones
+    {
+        const Vertex source = MakeVertex(0.3f, -0.5f, -0.8f);
+        StaticCompactVertex packed;
+        Vertex decoded;
+        VertexFormat::Encode(source, packed);
+        VertexFormat::Decode(packed, decoded);
+
+        CHECK(decoded.px == source.px && decoded.py == source.py && decoded.pz == source.pz);
+        CHECK(AngleBetween(source.nx, source.ny, source.nz, decoded.nx, decoded.ny, decoded.nz) < 0.01f);
+        CHECK_NEAR(decoded.tx, source.tx, 1e-3f);
+        CHECK_NEAR(decoded.ty, source.ty, 1e-3f);
+        CHECK(decoded.tz == 0.0f);
+        CHECK(decoded.tw == -1.0f);                 // Handedness sign survives
+        CHECK_NEAR(decoded.r, source.r, 0.5f / 255.0f);
+        CHECK_NEAR(decoded.g, source.g, 0.5f / 255.0f);
+        CHECK_NEAR(decoded.b, source.b, 0.5f / 255.0f);
+        CHECK(decoded.a == 1.0f);
+        CHECK_NEAR(decoded.u, source.u, 1e-3f * source.u);
+        CHECK(decoded.v == 1.75f);
+        for (int i = 0; i < 4; ++i)
+            CHECK(decoded.boneIDs[i] == -1 && decoded.boneWeights[i] == 0.0f);
+    }
+
+    // SkinnedCompact: weights normalized to 8 bits always sum to 255
+    {
+        const float weightSets[][4] = {
+            {1.0f, 0.0f, 0.0f, 0.0f},
+            {0.5f, 0.5f, 0.0f, 0.0f},
+            {1.0f / 3.0f, 1.0f / 3.0f, 1.0f / 3.0f, 0.0f},
+            {0.25f, 0.25f, 0.25f, 0.25f},
+            {0.7f, 0.1f, 0.1f, 0.1f},
+            {0.002f, 0.499f, 0.001f, 0.498f},
+            {2.0f, 1.0f, 1.0f, 0.0f},                 // Not normalized in the source
+        };
+        for (const auto& weights : weightSets) {
+            Vertex source = MakeVertex(-0.2f, 0.9f, -0.1f);
+            for (int i = 0; i < 4; ++i) {
+                source.boneIDs[i] = weights[i] > 0.0f ? 250 + i : -1;
+                source.boneWeights[i] = weights[i];
+            }
+
+            SkinnedCompactVertex packed;
+            Vertex decoded;
+            VertexFormat::Encode(source, packed);
+            VertexFormat::Decode(packed, decoded);
+
+            int sum = 0;
+            float total = 0.0f;
+            for (int i = 0; i < 4; ++i) {
+                sum += packed.boneWeights[i];
+                total += weights[i];
+            }
+            CHECK(sum == 255);
+
+            for (int i = 0; i < 4; ++i) {
+                CHECK_NEAR(decoded.boneWeights[i], weights[i] / total, 2.0f / 255.0f);
+                if (packed.boneWeights[i])
+                    CHECK(decoded.boneIDs[i] == 250 + i);
+                else
+                    CHECK(decoded.boneIDs[i] == -1);
+            }
+            CHECK(AngleBetween(source.nx, source.ny, source.nz, decoded.nx, decoded.ny, decoded.nz) < 0.01f);
+        }
+    }
+
+    // Bones past 8 bits can't be packed, and static meshes have none
+    {
+        Vertex skinned = MakeVertex(0.0f, 1.0f, 0.0f);
+        skinned.boneIDs[0] = VertexFormat::MAX_COMPACT_BONE;
+        skinned.boneWeights[0] = 1.0f;
+        CHECK(VertexFormat::CanEncode(&skinned, 1, VertexLayout::SkinnedCompact));
+        CHECK(!VertexFormat::CanEncode(&skinned, 1, VertexLayout::StaticCompact));
+
+        skinned.boneIDs[1] = VertexFormat::MAX_COMPACT_BONE + 1;
+        skinned.boneWeights[1] = 0.0f;                // Unweighted slots don't count
+        CHECK(VertexFormat::CanEncode(&skinned, 1, VertexLayout::SkinnedCompact));
+        skinned.boneWeights[1] = 0.5f;
+        CHECK(!VertexFormat::CanEncode(&skinned, 1, VertexLayout::SkinnedCompact));
+
+        const Vertex plain = MakeVertex(0.0f, 0.0f, 1.0f);
+        CHECK(VertexFormat::CanEncode(&plain, 1, VertexLayout::StaticCompact));
+    }
+
+    // UVs past the half float range that stays precise keep the float layout
+    {
+        Vertex tiled = MakeVertex(0.0f, 0.0f, 1.0f);
+        tiled.u = -VertexFormat::MAX_COMPACT_UV;
+        tiled.v = VertexFormat::MAX_COMPACT_UV;
+        CHECK(VertexFormat::CanEncode(&tiled, 1, VertexLayout::StaticCompact));
+
+        tiled.v = 8.0f;
+        CHECK(!VertexFormat::CanEncode(&tiled, 1, VertexLayout::StaticCompact));
+        CHECK(!VertexFormat::CanEncode(&tiled, 1, VertexLayout::SkinnedCompact));
+        CHECK(VertexFormat::CanEncode(&tiled, 1, VertexLayout::Standard));
+
+        tiled.v = -2.5f;
+        CHECK(!VertexFormat::CanEncode(&tiled, 1, VertexLayout::StaticCompact));
+        tiled.v = std::numeric_limits<float>::quiet_NaN();
+        CHECK(!VertexFormat::CanEncode(&tiled, 1, VertexLayout::StaticCompact));
+    }
+
+    // EncodeVertices packs at the layout's stride, in order
+    {
+        const Vertex vertices[] = {MakeVertex(1, 0, 0), MakeVertex(0, 0, -1), MakeVertex(1, 1, 1)};
+        for (VertexLayout layout : {VertexLayout::Standard, VertexLayout::StaticCompact,
+                                    VertexLayout::SkinnedCompact}) {
+            const std::vector<uint8_t> data = VertexFormat::EncodeVertices(vertices, 3, layout);
+            CHECK(data.size() == 3 * VertexFormat::GetStride(layout));
+        }
+
+        const std::vector<uint8_t> data = VertexFormat::EncodeVertices(vertices, 3, VertexLayout::StaticCompact);
+        StaticCompactVertex second;
+        std::memcpy(&second, data.data() + sizeof(StaticCompactVertex), sizeof(second));
+        Vertex decoded;
+        VertexFormat::Decode(second, decoded);
+        CHECK_NEAR(decoded.nz, -1.0f, 1e-6f);
+    }
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,105 @@
+// Replays a render command capture (see RenderCapture.hpp) in a loop and
+// reports how long the command queue takes to process it.
+//
+//   CommandReplay <capture> [-r <renderer>] [-loops <count>]
+//
+// The renderer defaults to "null", which measures the queue's CPU work on
+// its own. Any other renderer runs the same stream against real backends.
+
+#include <Graphics/RendererFactory.hpp>
+#include <Graphics/RenderCapture.hpp>
+#include <Graphics/RenderCommandQueue.hpp>
+#include <Window.hpp>
+#include <Logger.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace Sleak;
+using namespace Sleak::RenderEngine;
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::printf("usage: %s <capture> [-r <renderer>] [-loops <count>]\n", argv[0]);
+        return 1;
+    }
+
+    std::string capturePath = argv[1];
+    std::string rendererArg = "null";
+    uint32_t loops = 100;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "-r")
+            rendererArg = argv[i + 1];
+        else if (arg == "-loops")
+            loops = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+    }
+
+    Logger::Init("CommandReplay");
+
+    RenderCapturePlayer player;
+    if (!player.Load(capturePath) || player.GetFrameCount() == 0)
+        return 1;
+
+    Window window(1280, 720, "CommandReplay");
+    Renderer* renderer = RendererFactory::ParseArg(rendererArg, &window);
+    if (renderer->GetType() != RendererType::Null && !window.InitializeWindow())
+        return 1;
+    if (!renderer->Initialize()) {
+        SLEAK_FATAL("Unable to initialize the {} renderer", rendererArg);
+        return 1;
+    }
+
+    if (!player.CreateResources())
+        return 1;
+    if (player.GetSkippedCommands() != 0)
+        SLEAK_WARN("{} custom commands in the capture are not replayed", player.GetSkippedCommands());
+
+    using Clock = std::chrono::steady_clock;
+    auto* queue = RenderCommandQueue::GetInstance();
+    auto* context = renderer->GetContext();
+
+    double submitSeconds = 0.0;
+    double executeSeconds = 0.0;
+    uint64_t commands = 0;
+    int64_t drawsMerged = 0;
+    int64_t stateChangesSaved = 0;
+    int64_t redundantFiltered = 0;
+
+    for (uint32_t loop = 0; loop < loops; ++loop) {
+        for (uint32_t frame = 0; frame < player.GetFrameCount(); ++frame) {
+            renderer->BeginRender();
+
+            auto start = Clock::now();
+            player.SubmitFrame(frame, queue);
+            auto submitted = Clock::now();
+            queue->ExecuteCommands(context);
+            auto executed = Clock::now();
+
+            queue->AddFrameStats(renderer);
+            renderer->EndRender();
+
+            submitSeconds += std::chrono::duration<double>(submitted - start).count();
+            executeSeconds += std::chrono::duration<double>(executed - submitted).count();
+            commands += player.GetCommandCount(frame);
+            drawsMerged += queue->GetDrawsMerged();
+            stateChangesSaved += queue->GetStateChangesSaved();
+            redundantFiltered += queue->GetRedundantStateFiltered();
+        }
+    }
+
+    const double frames = static_cast<double>(loops) * player.GetFrameCount();
+    std::printf("%s: %u frames x %u loops on %s\n", capturePath.c_str(), player.GetFrameCount(), loops,
+                renderer->GetTypeStr());
+    std::printf("  submit  %.4f ms/frame\n", submitSeconds * 1000.0 / frames);
+    std::printf("  execute %.4f ms/frame\n", executeSeconds * 1000.0 / frames);
+    std::printf("  %.0f commands/s\n", commands / (submitSeconds + executeSeconds));
+    std::printf("  per frame: %.1f draws merged, %.1f state changes saved, %.1f redundant binds filtered\n",
+                drawsMerged / frames, stateChangesSaved / frames, redundantFiltered / frames);
+
+    queue->Clear();
+    player.ReleaseResources();
+    renderer->Cleanup();
+    delete renderer;
+    return 0;
+}
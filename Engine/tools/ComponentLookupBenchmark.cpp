@@ -0,0 +1,127 @@
+// Times GameObject component lookups over a population of objects.
+//
+//   ComponentLookupBenchmark [-objects <count>] [-loops <count>]
+//
+// Exact-type hits and misses go through the component mask and slot
+// table, base-class lookups through the derived-type mask. Each case is also
+// timed against the dynamic_cast scan GetComponent used to do, run over a
+// copy of every object's component list.
+
+#include <Core/GameObject.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <Physics/RigidbodyComponent.hpp>
+#include <Logger.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Sleak;
+
+namespace {
+
+class Health final : public Component {
+public:
+    Health(GameObject* object) : Component(object) {}
+    bool Initialize() override { return true; }
+    void Update(float) override {}
+    float value = 100.0f;
+};
+
+class Behaviour : public Component {
+public:
+    Behaviour(GameObject* object) : Component(object) {}
+    bool Initialize() override { return true; }
+    void Update(float) override {}
+};
+
+class Patrol final : public Behaviour {
+public:
+    Patrol(GameObject* object) : Behaviour(object) {}
+};
+
+// An object as the old lookup saw it: its components in insertion order
+struct Entry {
+    GameObject* object;
+    std::vector<Component*> components;
+};
+
+// The lookup GetComponent did before the component mask
+template <typename T>
+T* ScanComponents(const Entry& entry) {
+    for (Component* component : entry.components) {
+        if (T* match = dynamic_cast<T*>(component)) return match;
+    }
+    return nullptr;
+}
+
+template <typename Lookup>
+double Time(const std::vector<Entry>& entries, uint32_t loops, Lookup lookup, size_t& found) {
+    using Clock = std::chrono::steady_clock;
+    found = 0;
+
+    const auto start = Clock::now();
+    for (uint32_t loop = 0; loop < loops; ++loop) {
+        for (const Entry& entry : entries)
+            found += lookup(entry) ? 1 : 0;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return ns / (double(loops) * entries.size());
+}
+
+template <typename T>
+void Measure(const char* name, const std::vector<Entry>& entries, uint32_t loops) {
+    size_t found = 0;
+    size_t scanned = 0;
+    const double lookupNs = Time(entries, loops,
+        [](const Entry& entry) { return entry.object->GetComponent<T>() != nullptr; }, found);
+    const double scanNs = Time(entries, loops,
+        [](const Entry& entry) { return ScanComponents<T>(entry) != nullptr; }, scanned);
+
+    std::printf("%-34s %8.2f ns  %8.2f ns  %6.1fx  (%zu found)\n", name, lookupNs, scanNs,
+                scanNs / lookupNs, found);
+    if (found != scanned)
+        std::printf("  mismatch: the scan found %zu\n", scanned);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint32_t objectCount = 10000;
+    uint32_t loops = 200;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "-objects")
+            objectCount = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+        else if (arg == "-loops")
+            loops = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+    }
+
+    Logger::Init("ComponentLookupBenchmark");
+
+    std::vector<Entry> entries;
+    entries.reserve(objectCount);
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        Entry entry{new GameObject("Object" + std::to_string(i)), {}};
+        entry.object->AddComponent<TransformComponent>(Math::Vector3D(float(i), 0.0f, 0.0f));
+        entry.object->AddComponent<Health>();
+        entry.components.push_back(entry.object->GetComponent<TransformComponent>());
+        entry.components.push_back(entry.object->GetComponent<Health>());
+        if (i % 2 == 0) {
+            entry.object->AddComponent<Patrol>();
+            entry.components.push_back(entry.object->GetComponent<Patrol>());
+        }
+        entries.push_back(std::move(entry));
+    }
+
+    std::printf("%u objects, %u passes\n", objectCount, loops);
+    std::printf("%-34s %11s  %11s  %7s\n", "", "lookup", "scan", "speedup");
+    Measure<TransformComponent>("GetComponent<Transform> (hit)", entries, loops);
+    Measure<Health>("GetComponent<Health> (game type)", entries, loops);
+    // Static colliders in PhysicsWorld take this path every step
+    Measure<RigidbodyComponent>("GetComponent<Rigidbody> (miss)", entries, loops);
+    Measure<Behaviour>("GetComponent<Behaviour> (base)", entries, loops);
+
+    for (Entry& entry : entries) delete entry.object;
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Times the OcclusionBuffer on a synthetic city: a grid of box buildings
+// as occluders and a field of small boxes tested behind them.
+//
+//   OcclusionBenchmark [-occluders <count>] [-boxes <count>] [-loops <count>] [-workers <count>]
+//
+// Prints setup (transform and binning), rasterization and query times per
+// frame, and the share of boxes reported occluded.
+
+#include <Camera/OcclusionBuffer.hpp>
+#include <Core/JobSystem.hpp>
+#include <Logger.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/Vector.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::Math;
+
+namespace {
+
+// Unit cube centred on the origin, 12 triangles
+const float CUBE_POSITIONS[] = {
+    -0.5f, -0.5f, -0.5f,   0.5f, -0.5f, -0.5f,   0.5f, 0.5f, -0.5f,   -0.5f, 0.5f, -0.5f,
+    -0.5f, -0.5f,  0.5f,   0.5f, -0.5f,  0.5f,   0.5f, 0.5f,  0.5f,   -0.5f, 0.5f,  0.5f,
+};
+const uint32_t CUBE_INDICES[] = {
+    0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   0, 1, 5, 0, 5, 4,
+    3, 6, 2, 3, 7, 6,   0, 4, 7, 0, 7, 3,   1, 2, 6, 1, 6, 5,
+};
+
+Matrix4 Building(float x, float z, float height) {
+    Matrix4 world = Matrix4::Identity();
+    world(0, 0) = 6.0f;
+    world(1, 1) = height;
+    world(2, 2) = 6.0f;
+    world(3, 0) = x;
+    world(3, 1) = height * 0.5f;
+    world(3, 2) = z;
+    return world;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint32_t occluderCount = 256;
+    uint32_t boxCount = 10000;
+    uint32_t loops = 100;
+    uint32_t workers = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        const uint32_t value = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+        if (arg == "-occluders") occluderCount = value;
+        else if (arg == "-boxes") boxCount = value;
+        else if (arg == "-loops") loops = value;
+        else if (arg == "-workers") workers = value;
+    }
+
+    Logger::Init("OcclusionBenchmark");
+    JobSystem::Initialize(workers);
+
+    // Standing at the edge of the grid, looking into it
+    const Matrix4 viewProjection =
+        Matrix4::LookTo(Vector<float, 3>({0.0f, 2.0f, -20.0f}),
+                        Vector<float, 3>({0.0f, -0.05f, 1.0f}),
+                        Vector<float, 3>({0.0f, 1.0f, 0.0f})) *
+        Matrix4::Perspective(1.2f, 2.0f, 0.1f, 500.0f);
+
+    const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(float(occluderCount))));
+    const float extent = side * 6.0f;
+    std::vector<Matrix4> buildings;
+    for (uint32_t i = 0; i < occluderCount; ++i) {
+        const float x = float(i % side) * 12.0f - extent;
+        const float z = float(i / side) * 12.0f;
+        buildings.push_back(Building(x, z, 8.0f + float((i * 7) % 13)));
+    }
+
+    std::vector<Physics::AABB> boxes;
+    uint32_t state = 12345u;
+    auto next = [&state](float low, float high) {
+        state = state * 1664525u + 1013904223u;
+        return low + (high - low) * static_cast<float>(state >> 8) / static_cast<float>(1u << 24);
+    };
+    for (uint32_t i = 0; i < boxCount; ++i) {
+        const Vector3D center(next(-extent, extent), next(0.5f, 4.0f), next(0.0f, extent * 2.0f));
+        boxes.emplace_back(center - Vector3D(0.5f, 0.5f, 0.5f), center + Vector3D(0.5f, 0.5f, 0.5f));
+    }
+
+    using Clock = std::chrono::steady_clock;
+    OcclusionBuffer buffer;
+    double setupMs = 0.0, rasterizeMs = 0.0, queryMs = 0.0;
+    uint32_t occluded = 0;
+
+    for (uint32_t loop = 0; loop < loops; ++loop) {
+        const auto start = Clock::now();
+        buffer.Begin(viewProjection);
+        for (const Matrix4& world : buildings)
+            buffer.AddOccluder(CUBE_POSITIONS, 8, CUBE_INDICES, 36, world);
+        const auto added = Clock::now();
+        buffer.Rasterize();
+        const auto rasterized = Clock::now();
+
+        occluded = 0;
+        for (const Physics::AABB& box : boxes)
+            occluded += buffer.IsVisible(box) ? 0 : 1;
+        const auto queried = Clock::now();
+
+        setupMs += std::chrono::duration<double, std::milli>(added - start).count();
+        rasterizeMs += std::chrono::duration<double, std::milli>(rasterized - added).count();
+        queryMs += std::chrono::duration<double, std::milli>(queried - rasterized).count();
+    }
+
+    std::printf("%u occluders (%u triangles), %u boxes, %ux%u buffer, %u loops\n", occluderCount,
+                buffer.GetTriangleCount(), boxCount, buffer.GetWidth(), buffer.GetHeight(), loops);
+    std::printf("  setup     %8.4f ms/frame\n", setupMs / loops);
+    std::printf("  rasterize %8.4f ms/frame\n", rasterizeMs / loops);
+    std::printf("  queries   %8.4f ms/frame  (%.1f ns/box)\n", queryMs / loops,
+                queryMs * 1e6 / (double(loops) * boxCount));
+    std::printf("  occluded  %u of %u boxes (%.1f%%)\n", occluded, boxCount, 100.0 * occluded / boxCount);
+
+    JobSystem::Shutdown();
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Compares Queue<T> with the List-backed queue it replaced.
+//
+//   QueueBenchmark [-loops <count>]
+//
+// Each size is measured twice: filling the queue and draining it, and a
+// steady stream where every push is matched by a pop at a fixed depth. The
+// List-backed queue erases from the front, so its pops shift every element.
+
+#include <Utility/Container/List.hpp>
+#include <Utility/Container/Queue.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+using namespace Sleak;
+
+namespace {
+
+// Stand-in for a queued render command
+struct Payload {
+    uint64_t key;
+    uint32_t values[6];
+};
+
+// The previous Queue<T>, kept here as the baseline
+template <typename T>
+class ListQueue {
+public:
+    void push(const T& value) { data.add(value); }
+
+    T pop() {
+        T front = std::move(data[0]);
+        data.erase(0);
+        return front;
+    }
+
+    bool isEmpty() const { return data.GetSize() == 0; }
+
+private:
+    List<T> data;
+};
+
+template <typename QueueType>
+uint64_t FillAndDrain(uint32_t count) {
+    QueueType queue;
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < count; ++i)
+        queue.push(Payload{i, {i, i, i, i, i, i}});
+    while (!queue.isEmpty())
+        checksum += queue.pop().key;
+    return checksum;
+}
+
+template <typename QueueType>
+uint64_t Stream(uint32_t depth) {
+    QueueType queue;
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < depth; ++i)
+        queue.push(Payload{i, {}});
+    for (uint32_t i = 0; i < depth; ++i) {
+        queue.push(Payload{depth + i, {}});
+        checksum += queue.pop().key;
+    }
+    return checksum;
+}
+
+template <typename Run>
+double Measure(uint32_t loops, Run run) {
+    using Clock = std::chrono::steady_clock;
+    volatile uint64_t sink = 0;
+    const auto start = Clock::now();
+    for (uint32_t loop = 0; loop < loops; ++loop)
+        sink = sink + run();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / loops;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint32_t loops = 3;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "-loops")
+            loops = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+    }
+
+    std::printf("%-8s %-14s %12s %12s %9s\n", "size", "pattern", "List ms", "ring ms", "speedup");
+    for (uint32_t size : {1000u, 10000u, 100000u}) {
+        const double listFill = Measure(loops, [&] { return FillAndDrain<ListQueue<Payload>>(size); });
+        const double ringFill = Measure(loops, [&] { return FillAndDrain<Queue<Payload>>(size); });
+        std::printf("%-8u %-14s %12.3f %12.3f %8.1fx\n", size, "fill + drain", listFill, ringFill,
+                    listFill / ringFill);
+
+        const double listStream = Measure(loops, [&] { return Stream<ListQueue<Payload>>(size); });
+        const double ringStream = Measure(loops, [&] { return Stream<Queue<Payload>>(size); });
+        std::printf("%-8u %-14s %12.3f %12.3f %8.1fx\n", size, "steady stream", listStream, ringStream,
+                    listStream / ringStream);
+    }
+    return 0;
+}
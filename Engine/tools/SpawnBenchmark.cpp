@@ -0,0 +1,134 @@
+// Spawns primitive cubes on the null renderer and reports time, memory
+// and GPU resources for both spawn paths.
+//
+//   SpawnBenchmark [-objects <count>]
+//
+// "per-object" rebuilds the cube mesh, its buffers and a fresh material for
+// every object, as primitives were created before PrimitiveCache existed.
+// "cached" goes through GameObject::CreateCube, which shares one mesh and
+// the default material between all cubes.
+
+#include <Core/GameObject.hpp>
+#include <Debug/SystemMetrics.hpp>
+#include <ECS/Components/MaterialComponent.hpp>
+#include <ECS/Components/MeshComponent.hpp>
+#include <ECS/Components/TransformComponent.hpp>
+#include <Graphics/Null/NullRenderer.hpp>
+#include <Graphics/RendererFactory.hpp>
+#include <Graphics/ResourceManager.hpp>
+#include <Logger.hpp>
+#include <Physics/ColliderComponent.hpp>
+#include <Physics/RigidbodyComponent.hpp>
+#include <Runtime/InternalGeometry.hpp>
+#include <Runtime/Material.hpp>
+#include <Runtime/PrimitiveCache.hpp>
+#include <Window.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Sleak;
+using namespace Sleak::RenderEngine;
+
+namespace {
+
+// Forwards resource creation to the null renderer and counts what is made
+struct CountingFactory {
+    NullRenderer* renderer = nullptr;
+    uint64_t buffers = 0;
+    uint64_t bufferBytes = 0;
+    uint64_t shaders = 0;
+
+    BufferBase* CreateBuffer(BufferType type, uint32_t size, void* data) {
+        ++buffers;
+        bufferBytes += size;
+        return renderer->CreateBuffer(type, size, data);
+    }
+
+    Shader* CreateShader(const std::string& path) {
+        ++shaders;
+        return renderer->CreateShader(path);
+    }
+};
+
+GameObject* SpawnPerObject(const Math::Vector3D& position) {
+    auto* object = new GameObject("Cube");
+    MeshData meshData = GetCubeMesh();
+    object->AddComponent<ColliderComponent>(meshData, Physics::ColliderType::AABB);
+    object->AddComponent<RigidbodyComponent>(BodyType::Static);
+    object->AddComponent<TransformComponent>(position);
+
+    auto* material = new Material();
+    material->SetShader("assets/shaders/default_shader.hlsl");
+    object->AddComponent<MaterialComponent>(material);
+
+    object->AddComponent<MeshComponent>(std::move(meshData));
+    object->Initialize();
+    return object;
+}
+
+GameObject* SpawnCached(const Math::Vector3D& position) {
+    return GameObject::CreateCube(position);
+}
+
+void Measure(const char* name, CountingFactory& factory, uint32_t count,
+             GameObject* (*spawn)(const Math::Vector3D&)) {
+    using Clock = std::chrono::steady_clock;
+    std::vector<GameObject*> objects;
+    objects.reserve(count);
+
+    factory.buffers = factory.bufferBytes = factory.shaders = 0;
+    const float ramBefore = SystemMetrics::Query().RamUsageMB;
+
+    const auto start = Clock::now();
+    for (uint32_t i = 0; i < count; ++i)
+        objects.push_back(spawn(Math::Vector3D(float(i % 100) * 2.0f, 0.0f, float(i / 100) * 2.0f)));
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    const float ramAfter = SystemMetrics::Query().RamUsageMB;
+
+    std::printf("%-12s %9.2f ms  %7.3f us/object  RSS +%.1f MB\n", name, ms, ms * 1000.0 / count,
+                ramAfter - ramBefore);
+    std::printf("%-12s %9llu buffers (%.1f MB)  %llu shaders  %zu cached meshes\n", "",
+                static_cast<unsigned long long>(factory.buffers), factory.bufferBytes / (1024.0 * 1024.0),
+                static_cast<unsigned long long>(factory.shaders), PrimitiveCache::GetMeshCount());
+
+    for (GameObject* object : objects) delete object;
+    PrimitiveCache::Clear();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    uint32_t objectCount = 10000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "-objects")
+            objectCount = static_cast<uint32_t>(std::stoul(argv[i + 1]));
+    }
+
+    Logger::Init("SpawnBenchmark");
+    SystemMetrics::Initialize();
+
+    Window window(1280, 720, "SpawnBenchmark");
+    auto* renderer = static_cast<NullRenderer*>(RendererFactory::ParseArg("null", &window));
+    if (!renderer || !renderer->Initialize()) {
+        std::fprintf(stderr, "failed to create the null renderer\n");
+        return 1;
+    }
+
+    CountingFactory factory;
+    factory.renderer = renderer;
+    ResourceManager::RegisterCreateBuffer(&factory, &CountingFactory::CreateBuffer);
+    ResourceManager::RegisterCreateShader(&factory, &CountingFactory::CreateShader);
+
+    std::printf("%u cubes\n", objectCount);
+    Measure("per-object", factory, objectCount, &SpawnPerObject);
+    Measure("cached", factory, objectCount, &SpawnCached);
+
+    SystemMetrics::Shutdown();
+    renderer->Cleanup();
+    delete renderer;
+    return 0;
+}